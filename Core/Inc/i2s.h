@@ -34,6 +34,7 @@ extern "C" {
 extern I2S_HandleTypeDef hi2s3;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_spi3_tx;
 
 /* USER CODE END Private defines */
 
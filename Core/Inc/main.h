@@ -47,6 +47,9 @@ extern "C" {
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
+/* Runs from SRAM, copied there by the startup (.ramfunc in the linker script). Called indirectly,
+ * since the SRAM is too far from the flash for a direct branch. */
+#define RAMFUNC __attribute__((section(".ramfunc"), long_call, noinline))
 
 /* USER CODE END EM */
 
@@ -91,6 +94,48 @@ void Error_Handler(void);
 #define SD_SPI_HANDLE   hspi1
 #define SD_CS_GPIO_Port SD_SELECT_GPIO_Port
 #define SD_CS_Pin       SD_SELECT_Pin
+
+/* Set to 1 to run the modules in prioritized threads (see Processes/os) instead of a super-loop. */
+#define APP_USE_RTOS 0
+
+/* Set to 1 to send the LOG_* lines as binary frames, decoded on the host by tools/logdecode.py. */
+#define APP_LOG_BINARY 0
+
+/* Set to 1 to keep a copy of the logs on the SD card (see Processes/services/fileLogSink.h). */
+#define APP_USE_FILE_LOG 1
+
+/* Sectors of 512 B in each of the file log's two buffers, a power of two from 8 (RAM vs writes). */
+#define APP_FILE_LOG_BUFFER_SECTORS 8
+
+/* Set to 1 to accept file uploads over USART2 (see Processes/services/fileTransfer.h). */
+#define APP_USE_FILE_TRANSFER 1
+
+/* Set to 1 to answer tools/pcsample.py (see Processes/services/pcSampler.h). */
+#define APP_USE_PC_SAMPLER 1
+
+/* Set to 1 to be able to benchmark the SD card (see Processes/services/sdBenchmark.h). */
+#define APP_USE_SD_BENCHMARK 1
+
+/* Set to 1 to also benchmark the SD card during the POST, failing it for a slow card. */
+#define APP_SD_BENCHMARK_ON_POST 0
+
+/* Set to 1 to defer the diagnostics of the boot until the application is live (deferredInit.h). */
+#define APP_FAST_BOOT 0
+
+/* Set to 1 to serve malloc and operator new from the TLSF heap instead of newlib's (tlsf.h). */
+#define APP_USE_TLSF 1
+
+/* Set to 1 to read the asset bundle flashed in DATA_FLASH (see Processes/services/assetFs.h). */
+#define APP_USE_ASSETS 1
+
+/* Set to 1 to play sounds on I2S3 (see Processes/services/audioEngine.h). */
+#define APP_USE_AUDIO 1
+
+/* Set to 1 to resample the streamed sounds, to lock them to a clock (driftEstimator.h). */
+#define APP_AUDIO_DRIFT_COMPENSATION 1
+
+/* Set to 1 to keep the settings in DATA_FLASH instead of writing cfg.ini back (settings.h). */
+#define APP_USE_SETTINGS 0
 /* USER CODE END Private defines */
 
 #ifdef __cplusplus
@@ -34,12 +34,16 @@ extern "C" {
 extern UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
 
 /* USER CODE END Private defines */
 
 void MX_USART2_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+/* Called from the UART's interrupt handler when the line goes idle, see uartRxDma.h. */
+void UART_IdleLineCallback(UART_HandleTypeDef* huart);
 
 /* USER CODE END Prototypes */
 
@@ -37,6 +37,7 @@
 #include <string.h>
 #include "ff_gen_drv.h"
 
+#include "user_diskio.h"
 #include "user_diskio_spi.h"
 
 /* Private typedef -----------------------------------------------------------*/
@@ -46,6 +47,47 @@
 /* Disk status */
 static volatile DSTATUS Stat = STA_NOINIT;
 
+/* Latency and volume of each kind of operation */
+static USER_OpStats OpStats[USER_OP_COUNT];
+
+/* Private functions ---------------------------------------------------------*/
+static void RecordOp(USER_Op op, uint32_t startCycles, DRESULT res, UINT sectors)
+{
+  uint32_t      us     = USER_SPI_ElapsedUs(startCycles);
+  USER_OpStats* stats  = &OpStats[op];
+  uint32_t      bucket = us == 0 ? 0 : 32 - __builtin_clz(us);
+
+  stats->calls++;
+  stats->errors += res != RES_OK;
+  stats->sectors += sectors;
+  stats->multiSector += sectors > 1;
+  stats->totalUs += us;
+  if (us > stats->maxUs)
+  {
+    stats->maxUs = us;
+  }
+  stats->histogram[bucket < USER_LATENCY_BUCKETS ? bucket : USER_LATENCY_BUCKETS - 1]++;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void USER_GetStats(USER_Stats* stats)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memcpy(stats->ops, OpStats, sizeof(OpStats));
+  stats->spi = USER_SPI_counters;
+  __set_PRIMASK(primask);
+}
+
+void USER_ResetStats(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memset(OpStats, 0, sizeof(OpStats));
+  memset(&USER_SPI_counters, 0, sizeof(USER_SPI_counters));
+  __set_PRIMASK(primask);
+}
+
 /* USER CODE END DECL */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -118,7 +160,10 @@ DRESULT USER_read (
 )
 {
   /* USER CODE BEGIN READ */
-    return USER_SPI_read(pdrv, buff, sector, count);
+    uint32_t start = DWT->CYCCNT;
+    DRESULT  res   = USER_SPI_read(pdrv, buff, sector, count);
+    RecordOp(USER_OP_READ, start, res, count);
+    return res;
   /* USER CODE END READ */
 }
 
@@ -139,8 +184,10 @@ DRESULT USER_write (
 )
 {
   /* USER CODE BEGIN WRITE */
-    /* USER CODE HERE */
-    return USER_SPI_write(pdrv, buff, sector, count);
+    uint32_t start = DWT->CYCCNT;
+    DRESULT  res   = USER_SPI_write(pdrv, buff, sector, count);
+    RecordOp(USER_OP_WRITE, start, res, count);
+    return res;
   /* USER CODE END WRITE */
 }
 #endif /* _USE_WRITE == 1 */
@@ -160,7 +207,10 @@ DRESULT USER_ioctl (
 )
 {
   /* USER CODE BEGIN IOCTL */
-    return USER_SPI_ioctl(pdrv, cmd, buff);
+    uint32_t start = DWT->CYCCNT;
+    DRESULT  res   = USER_SPI_ioctl(pdrv, cmd, buff);
+    RecordOp(USER_OP_IOCTL, start, res, 0);
+    return res;
   /* USER CODE END IOCTL */
 }
 #endif /* _USE_IOCTL == 1 */
@@ -30,11 +30,48 @@
 /* USER CODE BEGIN 0 */
 
 /* Includes ------------------------------------------------------------------*/
-/* Exported types ------------------------------------------------------------*/
+#include "user_diskio_spi.h"
+
+#include <stdint.h>
+
 /* Exported constants --------------------------------------------------------*/
+/* Bucket 0 counts the operations under 1 us, bucket n those of [2^(n-1), 2^n) us, the last one
+ * everything above. */
+#define USER_LATENCY_BUCKETS 24
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  USER_OP_READ = 0,
+  USER_OP_WRITE,
+  USER_OP_IOCTL,
+  USER_OP_COUNT
+} USER_Op;
+
+typedef struct
+{
+  uint32_t calls;
+  uint32_t errors;      /* Calls that didn't return RES_OK */
+  uint32_t sectors;     /* Sectors moved, 0 for ioctl */
+  uint32_t multiSector; /* Calls moving more than one sector */
+  uint64_t totalUs;
+  uint32_t maxUs;
+  uint32_t histogram[USER_LATENCY_BUCKETS];
+} USER_OpStats;
+
+typedef struct
+{
+  USER_OpStats      ops[USER_OP_COUNT];
+  USER_SPI_Counters spi;
+} USER_Stats;
+
 /* Exported functions ------------------------------------------------------- */
 extern Diskio_drvTypeDef  USER_Driver;
 
+/* Copies the counters of the driver, safe from any context */
+void USER_GetStats(USER_Stats* stats);
+void USER_ResetStats(void);
+
 /* USER CODE END 0 */
 
 #ifdef __cplusplus
@@ -26,6 +26,7 @@
 
 #include "user_diskio_spi.h"
 
+#include "main.h"          /* RAMFUNC */
 #include "stm32f4xx_hal.h" /* Provide the low-level HAL functions */
 
 // Make sure you set #define SD_SPI_HANDLE as some hspix in main.h
@@ -98,6 +99,8 @@ static volatile DSTATUS Stat = STA_NOINIT; /* Physical drive status */
 
 static BYTE CardType; /* Card type flags */
 
+USER_SPI_Counters USER_SPI_counters; /* Reset by USER_ResetStats() */
+
 uint32_t spiTimerTickStart;
 uint32_t spiTimerTickDelay;
 
@@ -125,26 +128,45 @@ static BYTE xchg_spi(BYTE dat /* Data to send */
     return rxDat;
 }
 
+/* Exchange a byte on the registers, for the data blocks: inlined in the RAMFUNC below, the pump
+ * keeps up with the SPI clock without the HAL's per-byte overhead. The SPI was enabled by the
+ * commands that came before, through xchg_spi. */
+static inline BYTE pump_spi(SPI_TypeDef* spi, BYTE dat)
+{
+    while ((spi->SR & SPI_SR_TXE) == 0)
+    {
+    }
+    *(__IO uint8_t*)&spi->DR = dat;
+    while ((spi->SR & SPI_SR_RXNE) == 0)
+    {
+    }
+    return (BYTE)spi->DR;
+}
+
 /* Receive multiple byte */
-static void rcvr_spi_multi(BYTE* buff, /* Pointer to data buffer */
-                           UINT  btr   /* Number of bytes to receive (even number) */
+RAMFUNC static void rcvr_spi_multi(BYTE* buff, /* Pointer to data buffer */
+                                   UINT  btr   /* Number of bytes to receive (even number) */
 )
 {
+    SPI_TypeDef* spi = SD_SPI_HANDLE.Instance;
     for (UINT i = 0; i < btr; i++)
     {
-        *(buff + i) = xchg_spi(0xFF);
+        BYTE d = pump_spi(spi, 0xFF);
+        if (buff)
+            *(buff + i) = d; /* No buffer: the data is discarded */
     }
 }
 
 #if _USE_WRITE
 /* Send multiple byte */
-static void xmit_spi_multi(const BYTE* buff, /* Pointer to the data */
-                           UINT        btx   /* Number of bytes to send (even number) */
+RAMFUNC static void xmit_spi_multi(const BYTE* buff, /* Pointer to the data */
+                                   UINT        btx   /* Number of bytes to send (even number) */
 )
 {
+    SPI_TypeDef* spi = SD_SPI_HANDLE.Instance;
     for (UINT i = 0; i < btx; i++)
     {
-        xchg_spi(*(buff + i));
+        pump_spi(spi, *(buff + i));
     }
 }
 #endif
@@ -162,6 +184,9 @@ static int wait_ready(        /* 1:Ready, 0:Timeout */
     // spi_timer functions
     uint32_t waitSpiTimerTickStart;
     uint32_t waitSpiTimerTickDelay;
+    uint32_t startCycles = DWT->CYCCNT;
+    uint32_t elapsedUs;
+    uint32_t bucket;
 
     waitSpiTimerTickStart = HAL_GetTick();
     waitSpiTimerTickDelay = (uint32_t)wt;
@@ -173,6 +198,17 @@ static int wait_ready(        /* 1:Ready, 0:Timeout */
     } while (d != 0xFF && ((HAL_GetTick() - waitSpiTimerTickStart) <
                            waitSpiTimerTickDelay)); /* Wait for card goes ready or timeout */
 
+    elapsedUs = USER_SPI_ElapsedUs(startCycles);
+    bucket    = elapsedUs == 0 ? 0 : 32 - __builtin_clz(elapsedUs);
+    USER_SPI_counters.busyWaits++;
+    USER_SPI_counters.busyUs += elapsedUs;
+    if (elapsedUs > USER_SPI_counters.busyMaxUs)
+        USER_SPI_counters.busyMaxUs = elapsedUs;
+    USER_SPI_counters
+      .busyHistogram[bucket < USER_SPI_BUSY_BUCKETS ? bucket : USER_SPI_BUSY_BUCKETS - 1]++;
+    if (d != 0xFF)
+        USER_SPI_counters.busyTimeouts++;
+
     return (d == 0xFF) ? 1 : 0;
 
     // TODO This function does not seem to work as intended...
@@ -214,7 +250,8 @@ static int rcvr_datablock(            /* 1:OK, 0:Error */
                           UINT  btr   /* Data block length (byte) */
 )
 {
-    BYTE token;
+    BYTE     token;
+    uint32_t startCycles = DWT->CYCCNT;
 
     SPI_Timer_On(200);
     do
@@ -223,8 +260,12 @@ static int rcvr_datablock(            /* 1:OK, 0:Error */
         /* This loop will take a time. Insert rot_rdq() here for multitask
          * envilonment. */
     } while ((token == 0xFF) && SPI_Timer_Status());
+    USER_SPI_counters.tokenWaitUs += USER_SPI_ElapsedUs(startCycles);
     if (token != 0xFE)
+    {
+        USER_SPI_counters.tokenTimeouts++;
         return 0; /* Function fails if invalid DataStart token or timeout */
+    }
 
     rcvr_spi_multi(buff, btr); /* Store trailing data to the buffer */
     xchg_spi(0xFF);
@@ -257,7 +298,10 @@ static int xmit_datablock(                  /* 1:OK, 0:Failed */
 
         resp = xchg_spi(0xFF); /* Receive data resp */
         if ((resp & 0x1F) != 0x05)
+        {
+            USER_SPI_counters.rejectedBlocks++;
             return 0; /* Function fails if the data packet was not accepted */
+        }
     }
     return 1;
 }
@@ -287,7 +331,10 @@ static BYTE send_cmd(           /* Return value: R1 resp (bit7==1:Failed to send
     {
         despiselect();
         if (!spiselect())
+        {
+            USER_SPI_counters.cmdFailures++;
             return 0xFF;
+        }
     }
 
     /* Send command packet */
@@ -311,6 +358,8 @@ static BYTE send_cmd(           /* Return value: R1 resp (bit7==1:Failed to send
     {
         res = xchg_spi(0xFF);
     } while ((res & 0x80) && --n);
+    if (res & 0x80)
+        USER_SPI_counters.cmdFailures++;
 
     return res; /* Return received response */
 }
@@ -359,8 +408,9 @@ inline DSTATUS USER_SPI_initialize(BYTE drv /* Physical drive number (0) */
                 ocr[n] = xchg_spi(0xFF); /* Get 32 bit return value of R7 resp */
             if (ocr[2] == 0x01 && ocr[3] == 0xAA)
             { /* Is the card supports vcc of 2.7-3.6V? */
+                /* Wait for end of initialization with ACMD41(HCS) */
                 while (SPI_Timer_Status() && send_cmd(ACMD41, 1UL << 30))
-                    ; /* Wait for end of initialization with ACMD41(HCS) */
+                    USER_SPI_counters.initRetries++;
                 if (SPI_Timer_Status() && send_cmd(CMD58, 0) == 0)
                 { /* Check CCS bit in the OCR */
                     for (n = 0; n < 4; n++)
@@ -382,7 +432,7 @@ inline DSTATUS USER_SPI_initialize(BYTE drv /* Physical drive number (0) */
                 cmd = CMD1; /* MMCv3 (CMD1(0)) */
             }
             while (SPI_Timer_Status() && send_cmd(cmd, 0))
-                ; /* Wait for end of initialization */
+                USER_SPI_counters.initRetries++; /* Wait for end of initialization */
             if (!SPI_Timer_Status() || send_cmd(CMD16, 512) != 0) /* Set block length: 512 */
                 ty = 0;
         }
@@ -450,7 +500,8 @@ inline DRESULT USER_SPI_read(BYTE  drv,    /* Physical drive number (0) */
             {
                 if (!rcvr_datablock(buff, 512))
                     break;
-                buff += 512;
+                if (buff)
+                    buff += 512;
             } while (--count);
             send_cmd(CMD12, 0); /* STOP_TRANSMISSION */
         }
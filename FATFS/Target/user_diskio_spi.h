@@ -22,6 +22,40 @@
 #include "diskio.h" //from FatFs middleware library
 #include "ff_gen_drv.h" //from FatFs middleware library
 
+#include "stm32f4xx_hal.h"
+
+#include <stdint.h>
+
+/* Bucket 0 counts the busy waits under 1 us, bucket n those of [2^(n-1), 2^n) us, the last one
+ * everything above */
+#define USER_SPI_BUSY_BUCKETS 20
+
+/* Counters of the SPI link, see USER_GetStats() in user_diskio.h */
+typedef struct
+{
+    uint32_t busyWaits;      /* Waits for the card to be ready (wait_ready) */
+    uint32_t busyTimeouts;   /* ...that timed out */
+    uint64_t busyUs;         /* Total time spent in them */
+    uint32_t busyMaxUs;
+    uint32_t busyHistogram[USER_SPI_BUSY_BUCKETS];
+    uint32_t tokenTimeouts;  /* Reads where the data start token never came */
+    uint64_t tokenWaitUs;    /* Total time waiting for data start tokens */
+    uint32_t cmdFailures;    /* Commands the card didn't answer */
+    uint32_t initRetries;    /* ACMD41/CMD1 sent again while the card initializes */
+    uint32_t rejectedBlocks; /* Written blocks the card didn't accept */
+} USER_SPI_Counters;
+
+extern USER_SPI_Counters USER_SPI_counters;
+
+/* Microseconds since a reading of the cycle counter (started by Profiler::Init()) */
+static inline uint32_t USER_SPI_ElapsedUs(uint32_t startCycles)
+{
+    return (DWT->CYCCNT - startCycles) / (SystemCoreClock / 1000000U);
+}
+
+// USER_SPI_read accepts a null buffer, to clock the data out of the card without storing it
+// (see Processes/services/sdBenchmark.h).
+
 //we define these as inline because we don't want them to be actual function calls (they get "called" from the cubemx autogenerated user_diskio file)
 //we define them as extern because they are defined in a separate .c file to user_diskio.c (which #includes this .h file)
 
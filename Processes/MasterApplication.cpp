@@ -24,13 +24,26 @@
 #include "NilaiTFO/defines/pin.h"
 
 #include "NilaiTFO/drivers/i2cModule.hpp"
-#include "NilaiTFO/drivers/uartModule.hpp"
 #include "NilaiTFO/interfaces/heartbeatModule.h"
 #include "NilaiTFO/services/filesystem.h"
 #include "NilaiTFO/services/logger.hpp"
 
 #include "NilaiTFO/services/IniParser.h"
 
+#include "Processes/drivers/uartRxDma.h"
+#include "Processes/drivers/uartTxDma.h"
+#include "Processes/services/assetFs.h"
+#include "Processes/services/audioEngine.h"
+#include "Processes/services/bootTimeline.h"
+#include "Processes/services/deferredInit.h"
+#include "Processes/services/fileLogSink.h"
+#include "Processes/services/fileTransfer.h"
+#include "Processes/services/pcSampler.h"
+#include "Processes/services/ramFuncBench.h"
+#include "Processes/services/sdBenchmark.h"
+#include "Processes/services/settings.h"
+#include "Processes/services/umoDispatcher.h"
+
 
 #define HAS_SECTION(section)         (ini.HasSection(section) ? "true" : "false")
 #define HAS_VALUE_STR(section, name) section, name, ini.HasValue(section, name) ? "true" : "false"
@@ -46,9 +59,16 @@ MasterApplication::MasterApplication()
 void MasterApplication::Init()
 {
     InitializeHal();
+    BootTimeline::Mark("InitializeHal");
     InitializeModules();
+    BootTimeline::Mark("InitializeModules");
 
+#if APP_FAST_BOOT
+    DeferredInit::Defer("CheckParser", [] { s_instance->CheckParser(); });
+#else
     CheckParser();
+    BootTimeline::Mark("CheckParser");
+#endif
 }
 
 bool MasterApplication::DoPost()
@@ -59,34 +79,56 @@ bool MasterApplication::DoPost()
     }
     m_logger->Log("\n\r----- Started POST...\n\r");
 
-    bool   allModulesPassedPost = true;
-    size_t start                = HAL_GetTick();
+    bool            allModulesPassedPost = true;
+    Profiler::Ticks start                = Profiler::Now();
 
     if (!cep::Filesystem::IsMounted())
     {
         m_logger->Log("POST Error: File system is not mounted!\n\r");
         allModulesPassedPost = false;
     }
+    if (!MemStats::DoPost())
+    {
+        allModulesPassedPost = false;
+    }
+#if APP_USE_ASSETS
+    if (!AssetFs::DoPost())
+    {
+        allModulesPassedPost = false;
+    }
+#endif
+    // Measurements, not checks: they run once the application is live, out of the POST's time.
+    DeferredInit::Defer("RamFuncBench", &RamFuncBench::Run);
+#if APP_USE_AUDIO
+    DeferredInit::Defer("FlacBench", [] { AudioEngine::Get()->TimeFlacFrame(); });
+#endif
 
     for (auto module = s_instance->m_modules.rbegin(); module != s_instance->m_modules.rend();
          module++)
     {
-        if (!module->second->DoPost())
+        Profiler::Ticks moduleStart = Profiler::Now();
+        bool            passed      = module->second.module->DoPost();
+        float           us          = Profiler::ToMicroseconds(Profiler::Now() - moduleStart);
+        if (!passed)
         {
-            LOG_ERROR("%s POST failed!", module->second->GetLabel().c_str());
+            LOG_ERROR("{} POST failed! {:.1} us.", module->first.c_str(), us);
             allModulesPassedPost = false;
         }
+        else
+        {
+            LOG_DEBUG("{} POST OK, {:.1} us.", module->first.c_str(), us);
+        }
     }
 
-    uint32_t timeTaken = (HAL_GetTick() - start);
+    float timeTaken = Profiler::ToMicroseconds(Profiler::Now() - start) / 1000.0f;
 
     if (allModulesPassedPost)
     {
-        LOG_INFO("----- POST OK! %0.3f seconds.\n\r", (float)(timeTaken) / 1000.0f);
+        LOG_INFO("----- POST OK! {:.3} ms.\n\r", timeTaken);
     }
     else
     {
-        LOG_ERROR("----- POST ERROR! %0.3f seconds.\n\r", (float)(timeTaken) / 1000.0f);
+        LOG_ERROR("----- POST ERROR! {:.3} ms.\n\r", timeTaken);
     }
 
     return allModulesPassedPost;
@@ -94,20 +136,28 @@ bool MasterApplication::DoPost()
 
 [[noreturn]] void MasterApplication::Run()
 {
+#if APP_USE_RTOS
+    // Each priority group of modules gets its own thread.
+    ThreadedApplication::Run();
+#else
     while (true)
     {
         for (auto& module : s_instance->m_modules)
         {
-            module.second->Run();
+            MemStats::OwnerScope owner(module.second.owner);
+            Profiler::Ticks      start = Profiler::Now();
+            module.second.module->Run();
+            module.second.runZone->Record(Profiler::Now() - start);
         }
     }
+#endif
 }
 
 cep::Module* MasterApplication::GetModule(const std::string& moduleName)
 {
     CEP_ASSERT(s_instance->m_modules.find(moduleName) != s_instance->m_modules.end(),
                "Module does not exist!");
-    return s_instance->m_modules.at(moduleName);
+    return s_instance->m_modules.at(moduleName).module;
 }
 
 /*****************************************************************************/
@@ -129,74 +179,144 @@ void MasterApplication::InitializeModules()
 {
     // --- Connectivity ---
     // UART CONFIG
-    UartModule* uart2 = new UartModule(&huart2, "uart2");
-    AddModule(uart2);
-    m_logger = new Logger(uart2);
+    // Reception runs continuously in a circular DMA, the data is read in place from its buffer.
+    AddModule(new UartRxDma(&huart2, &hdma_usart2_rx, "uart2"), ModulePriority::Logging);
+    // The logs are queued and sent by DMA, logging never waits on the UART.
+    new UartTxDma(&huart2, &hdma_usart2_tx);
+    m_logger = new Logger(nullptr,
+                          [](const char* msg, size_t len) { UartTxDma::Get()->Write(msg, len); });
     Logger::Get()->Log("\n\n\r");
     Logger::Get()->Log(
       "================================================================================\n\r");
     Logger::Get()->Log("Application started.\n\r");
+    BootTimeline::Mark("Logger");
+    // Binary commands, sharing USART2 with the logs. Its deferred commands can touch the SD card.
+    AddModule(new UmoDispatcher("umo"), ModulePriority::Storage);
 
     // --- Drivers ---
+#if APP_USE_AUDIO
+    AddModule(new AudioEngine(&hi2s3, &hdma_spi3_tx, "audio"), ModulePriority::Audio);
+#endif
 
     // --- Interfaces ---
     cep::Filesystem::Init();
     cep::Filesystem::Mount("", true);    // Mount the SD card, if one is found.
+    BootTimeline::Mark("Mount");
+#if APP_USE_SETTINGS
+    Settings::Init();
+#    if APP_USE_AUDIO
+    // An erase would stall the interrupts that keep the DMA playing, for up to 2 s.
+    Settings::SetBusyCheck(
+      [] { return AudioEngine::Get() != nullptr && AudioEngine::Get()->IsPlaying(); });
+#    endif
+#endif
+#if APP_USE_ASSETS
+    AssetFs::Mount();
+#    if APP_USE_AUDIO
+    // Played in place, straight from DATA_FLASH, before the POST verifies the bundle: the sound
+    // is checked on its own, the DMA mustn't get corrupted data.
+    AssetFs::Asset bootSound = AssetFs::Find("SOUNDS/BOOT.WAV");
+    if (AssetFs::Verify(bootSound))
+    {
+        AudioEngine::Get()->PlayWav(bootSound.data, bootSound.size);
+    }
+    else if (bootSound)
+    {
+        LOG_ERROR("SOUNDS/BOOT.WAV is corrupted, not played!");
+    }
+#    endif
+#endif
+#if APP_USE_FILE_LOG
+    AddModule(new FileLogSink("fileLog"), ModulePriority::Storage);
+    UartTxDma::Get()->SetTap(&FileLogSink::Tap);
+#endif
+#if APP_USE_FILE_TRANSFER
+    AddModule(new FileTransfer("fileTransfer"), ModulePriority::Storage);
+    for (uint8_t id :
+         {FileTransfer::Open, FileTransfer::Data, FileTransfer::Close, FileTransfer::Abort})
+    {
+        UmoDispatcher::Get()->Register(id, &FileTransfer::OnFrame);
+    }
+#endif
+#if APP_USE_PC_SAMPLER
+    for (uint8_t id :
+         {PcSampler::StartSampling, PcSampler::StopSampling, PcSampler::GetSamples})
+    {
+        UmoDispatcher::Get()->Register(id, &PcSampler::OnFrame);
+    }
+#endif
+#if APP_USE_SD_BENCHMARK
+    AddModule(new SdBenchmark("sdBenchmark"), ModulePriority::Storage);
+    for (uint8_t id : {SdBenchmark::StartBenchmark, SdBenchmark::GetStatus})
+    {
+        UmoDispatcher::Get()->Register(id, &SdBenchmark::OnFrame);
+    }
+#endif
 
     // --- Processes ---
     AddModule(new HeartbeatModule({LED_GPIO_Port, LED_Pin}, "heartbeat"));
+    // Last to run, reports the boot timeline.
+    AddModule(new DeferredInit("deferredInit"), ModulePriority::Background);
 
 
     LOG_INFO("Application Initialized!");
 }
 void MasterApplication::CheckParser()
 {
+    static const uint8_t s_owner = MemStats::RegisterOwner("CheckParser");
+    MemStats::OwnerScope owner(s_owner);
+
     cep::IniParser ini("cfg.ini");
 
     if (ini.GetError() != 0)
     {
-        LOG_ERROR("ini failed to be parsed: %i", ini.GetError());
+        LOG_ERROR("ini failed to be parsed: {}", ini.GetError());
         return;
     }
+#if APP_USE_SETTINGS
+    // What cfg.ini says, for Export() to only store what was changed from it.
+    const Settings::Values file = Settings::Snapshot(ini);
+    LOG_DEBUG("{} settings from the flash.", Settings::Import(ini));
+#endif
 
     LOG_DEBUG("HasSection:");
-    LOG_DEBUG("Has section 1: %s", HAS_SECTION("section 1"));
-    LOG_DEBUG("Has section 2: %s", HAS_SECTION("section 2"));
-    LOG_DEBUG("Has section 3: %s", HAS_SECTION("section 3"));
-    LOG_DEBUG("Has section 4: %s", HAS_SECTION("section 4"));
+    LOG_DEBUG("Has section 1: {}", HAS_SECTION("section 1"));
+    LOG_DEBUG("Has section 2: {}", HAS_SECTION("section 2"));
+    LOG_DEBUG("Has section 3: {}", HAS_SECTION("section 3"));
+    LOG_DEBUG("Has section 4: {}", HAS_SECTION("section 4"));
 
     LOG_DEBUG("\n\rHasValue:");
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 1", "s1"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 1", "s2"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 2", "i1"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 2", "i2"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 2", "i3"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 3", "f1"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 3", "f2"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 4", "b1"));
-    LOG_DEBUG("Has %s - %s: %s", HAS_VALUE_STR("section 4", "b2"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 1", "s1"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 1", "s2"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 2", "i1"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 2", "i2"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 2", "i3"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 3", "f1"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 3", "f2"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 4", "b1"));
+    LOG_DEBUG("Has {} - {}: {}", HAS_VALUE_STR("section 4", "b2"));
 
     LOG_DEBUG("\n\rGetString:");
-    LOG_DEBUG("s1: %s", ini.Get<std::string>("section 1", "s1").c_str());
-    LOG_DEBUG("s2: %s", ini.Get<std::string>("section 1", "s2").c_str());
+    LOG_DEBUG("s1: {}", ini.Get<std::string>("section 1", "s1").c_str());
+    LOG_DEBUG("s2: {}", ini.Get<std::string>("section 1", "s2").c_str());
 
     LOG_DEBUG("\n\rGetInteger:");
-    LOG_DEBUG("i1: %d", ini.Get<int>("section 2", "i1"));
-    LOG_DEBUG("i2: %d", ini.Get<int>("section 2", "i2"));
-    LOG_DEBUG("i3: %d", ini.Get<int>("section 2", "i3"));
+    LOG_DEBUG("i1: {}", ini.Get<int>("section 2", "i1"));
+    LOG_DEBUG("i2: {}", ini.Get<int>("section 2", "i2"));
+    LOG_DEBUG("i3: {}", ini.Get<int>("section 2", "i3"));
 
     LOG_DEBUG("\n\rGetDecimal:");
-    LOG_DEBUG("f1: %0.4f", ini.Get<float>("section 3", "f1"));
-    LOG_DEBUG("f2: %0.4f", ini.Get<float>("section 3", "f2"));
+    LOG_DEBUG("f1: {:.4}", ini.Get<float>("section 3", "f1"));
+    LOG_DEBUG("f2: {:.4}", ini.Get<float>("section 3", "f2"));
 
     LOG_DEBUG("\n\rGetBoolean:");
-    LOG_DEBUG("b1: %s", ini.Get<bool>("section 4", "b1") ? "true" : "false");
-    LOG_DEBUG("b2: %s", ini.Get<bool>("section 4", "b2") ? "true" : "false");
+    LOG_DEBUG("b1: {}", ini.Get<bool>("section 4", "b1") ? "true" : "false");
+    LOG_DEBUG("b2: {}", ini.Get<bool>("section 4", "b2") ? "true" : "false");
 
     LOG_DEBUG("\n\rIterators:");
     for (auto& [k, v] : ini)
     {
-        LOG_DEBUG("%s = %s", k.c_str(), v.c_str());
+        LOG_DEBUG("{} = {}", k.c_str(), v.c_str());
     }
 
     ini.SetStr("section 5", "str", "asdf");
@@ -205,7 +325,11 @@ void MasterApplication::CheckParser()
     ini.SetDouble("section 5", "double", 123.456f);
     ini.SetBool("section 5", "bool", false);
 
+#if APP_USE_SETTINGS
+    Settings::Export(ini, file);
+#else
     ini.Save();
+#endif
 }
 
 extern "C" void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
@@ -19,11 +19,17 @@
 #    include "NilaiTFO/defines/module.hpp"
 #    include "NilaiTFO//processes/application.hpp"
 
-#    include "NilaiTFO/drivers/uartModule.hpp"
+#    include "Processes/drivers/uartRxDma.h"
 
 #    include "NilaiTFO/services/logger.hpp"
 #    include "NilaiTFO/services/umoModule.h"
 
+#    include "Core/Inc/main.h"
+#    include "Processes/os/threadedApplication.h"
+#    include "Processes/services/log.h"
+#    include "Processes/services/memStats.h"
+#    include "Processes/services/profiler.h"
+
 
 #    include <map>
 
@@ -35,7 +41,7 @@
 // Explanation of static_cast: https://stackoverflow.com/a/1255015/11443498
 
 // DRIVERS
-#    define UART2_MODULE (static_cast<UartModule*>(MasterApplication::GetModule("uart2")))
+#    define UART2_MODULE (static_cast<UartRxDma*>(MasterApplication::GetModule("uart2")))
 
 // SERVICES
 
@@ -45,7 +51,13 @@
 
 /*****************************************************************************/
 /* Exported types */
-class MasterApplication : public cep::Application
+#    if APP_USE_RTOS
+using ApplicationBase = ThreadedApplication;
+#    else
+using ApplicationBase = cep::Application;
+#    endif
+
+class MasterApplication : public ApplicationBase
 {
 public:
     MasterApplication();
@@ -55,15 +67,34 @@ public:
     void              Init() override;
     [[noreturn]] void Run() override;
 
-    void AddModule(cep::Module* newModule) { m_modules[newModule->GetLabel()] = newModule; }
+    void AddModule(cep::Module* newModule, ModulePriority priority = ModulePriority::Background)
+    {
+        // Every module's Run() is timed, and its allocations counted, under its label.
+        const char* label                = newModule->GetLabel().c_str();
+        auto*       runZone              = new Profiler::Zone(label);
+        uint8_t     owner                = MemStats::RegisterOwner(label);
+        m_modules[newModule->GetLabel()] = {newModule, runZone, owner};
+#    if APP_USE_RTOS
+        AssignModule(newModule, priority, runZone, owner);
+#    else
+        (void)priority;
+#    endif
+    }
 
     static cep::Module* GetModule(const std::string& moduleName);
 
     static MasterApplication* Get() { return s_instance; }
 
 private:
-    std::map<std::string, cep::Module*> m_modules;
-    Logger*                             m_logger = nullptr;
+    struct RegisteredModule
+    {
+        cep::Module*    module  = nullptr;
+        Profiler::Zone* runZone = nullptr;
+        uint8_t         owner   = 0;    //!< See MemStats.
+    };
+
+    std::map<std::string, RegisteredModule> m_modules;
+    Logger*                                 m_logger = nullptr;
 
 private:
     static MasterApplication* s_instance;
@@ -94,10 +94,10 @@
 #define NILAI_USE_TAS5707
 
 // Services
-//#define NILAI_USE_UMO
+//#define NILAI_USE_UMO    // Replaced by Processes/services/umoDispatcher.
 //#define NILAI_USE_SYSTEM
 #define NILAI_USE_LOGGER
-//#define NILAI_USE_FILE_LOGGER
+//#define NILAI_USE_FILE_LOGGER    // Replaced by Processes/services/fileLogSink.
 #define NILAI_USE_FILESYSTEM
 #define NILAI_USE_INI_PARSER
 
@@ -0,0 +1,77 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    ccmRam.h
+ * @brief   Placement in the 64 KiB of core-coupled RAM (CCM) at 0x10000000.
+ *
+ * The CCM is only on the CPU's data bus: it's accessed without wait state and without
+ * contending with the DMAs for the main RAM, but the DMAs can't reach it, nor can the CPU fetch
+ * instructions from it. It's meant for what only the CPU touches: the threads' stacks, scratch
+ * buffers for the decoders and the DSP.
+ *      CCM_BSS static uint8_t s_scratch[1024];       // Zeroed by the startup.
+ *      CCM_NOINIT static uint8_t s_stack[2048];      // Left as it is, painted by the kernel.
+ * Neither is loaded from the flash, an initial value other than 0 is lost.
+ *
+ * A buffer given to a DMA (UART, SPI, I2S) must stay in the main RAM: the drivers assert it with
+ * IsDmaCapable. This excludes the UART's TX ring, which the log lines are formatted into.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_DRIVERS_CCMRAM_H
+#    define NILAIINI_DRIVERS_CCMRAM_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported defines */
+#    define CCM_BSS    __attribute__((section(".ccmbss")))
+#    define CCM_NOINIT __attribute__((section(".ccmnoinit")))
+
+/*****************************************************************************/
+/* Exported functions */
+extern "C"
+{
+    // Defined by the linker script.
+    extern uint8_t _eccmram;
+}
+
+namespace CcmRam
+{
+static constexpr uintptr_t BEGIN = 0x10000000;
+static constexpr size_t    SIZE  = 64 * 1024;
+
+[[nodiscard]] inline bool Contains(const void* ptr)
+{
+    return reinterpret_cast<uintptr_t>(ptr) - BEGIN < SIZE;
+}
+
+/**
+ * @returns True if no byte of [@p ptr, @p ptr + @p len) is in the CCM.
+ */
+[[nodiscard]] inline bool IsDmaCapable(const void* ptr, size_t len)
+{
+    auto begin = reinterpret_cast<uintptr_t>(ptr);
+    return begin + len <= BEGIN || begin >= BEGIN + SIZE;
+}
+
+/**
+ * @returns The bytes placed in the CCM.
+ */
+[[nodiscard]] inline size_t GetUsed()
+{
+    return reinterpret_cast<uintptr_t>(&_eccmram) - BEGIN;
+}
+}    // namespace CcmRam
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_DRIVERS_CCMRAM_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    criticalSection.h
+ * @brief   Masks the interrupts for the lifetime of a scope.
+ *
+ *      {
+ *          CriticalSection lock;
+ *          ...    // No interrupt handler runs here.
+ *      }
+ * PRIMASK is restored rather than cleared: a CriticalSection opened in another, or with the
+ * interrupts already masked, doesn't unmask them when it ends.
+ *
+ * The host benchmarks are single-threaded, it does nothing there.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_DRIVERS_CRITICALSECTION_H
+#    define NILAIINI_DRIVERS_CRITICALSECTION_H
+
+/*****************************************************************************/
+/* Includes */
+#    if defined(__ARM_ARCH_7EM__)
+#        include "Core/Inc/main.h"
+#    endif
+
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+class CriticalSection
+{
+public:
+#    if defined(__ARM_ARCH_7EM__)
+    CriticalSection() : m_primask(__get_PRIMASK()) { __disable_irq(); }
+    ~CriticalSection() { __set_PRIMASK(m_primask); }
+
+private:
+    uint32_t m_primask;
+#    else
+    CriticalSection() {}
+    ~CriticalSection() {}
+#    endif
+
+public:
+    CriticalSection(const CriticalSection&)            = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_DRIVERS_CRITICALSECTION_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    i2sClock.cpp
+ * @brief   The PLLI2S and I2S prescaler settings for each sample rate.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "i2sClock.h"
+
+#include <iterator>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+using I2sClock::Compute;
+
+// The rates of the header's doc, in mHz.
+static_assert(Compute(44100).GetRealRate() == 44108072 && Compute(44100).GetErrorPpm() == 183);
+static_assert(Compute(48000).GetRealRate() == 47991071 && Compute(48000).GetErrorPpm() == -186);
+static_assert(Compute(8000).GetErrorPpm() == 0);
+}    // namespace
+
+namespace I2sClock
+{
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+const Config* Find(uint32_t sampleRate)
+{
+    for (const Config& config : TABLE)
+    {
+        if (config.sampleRate == sampleRate && sampleRate != 0)
+        {
+            return &config;
+        }
+    }
+    return nullptr;
+}
+
+bool Apply(I2S_HandleTypeDef* i2s, const Config& config)
+{
+    // The PLLs' input is set once, by SystemClock_Config.
+    if (HSE_VALUE / (RCC->PLLCFGR & RCC_PLLCFGR_PLLM) != VCO_INPUT ||
+        (i2s->Instance->I2SCFGR & SPI_I2SCFGR_I2SE) != 0)
+    {
+        return false;
+    }
+
+    // Stops the PLLI2S, sets N and R, then waits for it to lock.
+    RCC_PeriphCLKInitTypeDef clock = {};
+    clock.PeriphClockSelection     = RCC_PERIPHCLK_I2S;
+    clock.PLLI2S.PLLI2SN           = config.plln;
+    clock.PLLI2S.PLLI2SR           = config.pllr;
+    if (HAL_RCCEx_PeriphCLKConfig(&clock) != HAL_OK)
+    {
+        return false;
+    }
+
+    // HAL_I2S_Init would round its own dividers from the I2S clock, those of TABLE are set as is.
+    i2s->Instance->I2SPR = config.div | (config.odd ? SPI_I2SPR_ODD : 0) |
+                           (i2s->Init.MCLKOutput == I2S_MCLKOUTPUT_ENABLE ? SPI_I2SPR_MCKOE : 0);
+    i2s->Init.AudioFreq = config.sampleRate;
+    return true;
+}
+}    // namespace I2sClock
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
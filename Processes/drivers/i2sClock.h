@@ -0,0 +1,138 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    i2sClock.h
+ * @brief   The PLLI2S and I2S prescaler settings for each sample rate.
+ *
+ * With the master clock out, the I2S plays at VCO_INPUT * N / R / (256 * (2 * DIV + ODD)). The
+ * PLLs' input is fixed by the system clock, the rest is searched at compile time, for each rate
+ * of TABLE, for the smallest error:
+ *      44.1 kHz: N 271, R 2, DIV 6       44108.07 Hz, +183 ppm
+ *      48 kHz:   N 172, R 2, DIV 3, ODD  47991.07 Hz, -186 ppm (as MX_I2S3_Init's N 258, R 3)
+ * The 11.025 kHz family and the 48 kHz one can't both be exact from 1 MHz: the errors are those
+ * of the reference manual's table, and what's left to correct by resampling.
+ *
+ * Apply() reprograms the PLLI2S, which stops the I2S's clock: only between streams.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_DRIVERS_I2SCLOCK_H
+#    define NILAIINI_DRIVERS_I2SCLOCK_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Core/Inc/main.h"
+
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace I2sClock
+{
+//! HSE (25 MHz) over PLLM (25), shared with the main PLL, see SystemClock_Config.
+static constexpr uint32_t VCO_INPUT  = 1000000;
+static constexpr uint32_t MIN_VCO    = 100000000;
+static constexpr uint32_t MAX_VCO    = 432000000;
+static constexpr uint32_t MAX_I2SCLK = 192000000;
+static constexpr uint32_t MCLK_RATIO = 256;    //!< Of the master clock to the sample rate.
+
+struct Config
+{
+    uint32_t sampleRate = 0;    //!< Nominal.
+    uint16_t plln       = 0;
+    uint8_t  pllr       = 0;
+    uint8_t  div        = 0;    //!< I2SDIV, 2 to 255.
+    bool     odd        = false;
+
+    [[nodiscard]] constexpr uint32_t GetDivider() const { return 2 * div + (odd ? 1 : 0); }
+
+    //! In mHz.
+    [[nodiscard]] constexpr uint64_t GetRealRate() const
+    {
+        return uint64_t(VCO_INPUT) * plln * 1000 / (uint64_t(pllr) * MCLK_RATIO * GetDivider());
+    }
+
+    //! Of the real rate, in parts per million.
+    [[nodiscard]] constexpr int32_t GetErrorPpm() const
+    {
+        int64_t nominal = int64_t(sampleRate) * 1000;
+        int64_t error   = (int64_t(GetRealRate()) - nominal) * 1000000;
+        return static_cast<int32_t>((error + (error < 0 ? -nominal : nominal) / 2) / nominal);
+    }
+};
+
+/**
+ * @brief Tries every N and R, with the dividers closest to @p sampleRate.
+ * @returns The first of the smallest error, sampleRate 0 if none can.
+ */
+constexpr Config Compute(uint32_t sampleRate)
+{
+    Config   best;
+    uint64_t bestError = UINT64_MAX;
+    for (uint32_t n = MIN_VCO / VCO_INPUT; n <= MAX_VCO / VCO_INPUT; n++)
+    {
+        for (uint32_t r = 2; r <= 7; r++)
+        {
+            uint64_t vco = uint64_t(VCO_INPUT) * n;
+            if (vco / r > MAX_I2SCLK)
+            {
+                continue;
+            }
+            uint64_t divider = vco / (uint64_t(MCLK_RATIO) * sampleRate * r);
+            for (uint64_t d = divider; d <= divider + 1; d++)
+            {
+                if (d < 4 || d > 511)
+                {
+                    continue;
+                }
+                // |vco / (R * 256 * d) - rate|, times 256 to stay in integers.
+                uint64_t ideal = uint64_t(MCLK_RATIO) * sampleRate * d * r;
+                uint64_t error = (vco > ideal ? vco - ideal : ideal - vco) * 1000000 / (d * r);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best      = {sampleRate,
+                                 static_cast<uint16_t>(n),
+                                 static_cast<uint8_t>(r),
+                                 static_cast<uint8_t>(d / 2),
+                                 (d & 1) != 0};
+                }
+            }
+        }
+    }
+    return best;
+}
+
+static constexpr Config TABLE[] = {
+  Compute(8000),
+  Compute(11025),
+  Compute(16000),
+  Compute(22050),
+  Compute(32000),
+  Compute(44100),
+  Compute(48000),
+  Compute(88200),
+  Compute(96000),
+};
+
+/**
+ * @returns The settings for @p sampleRate, nullptr if it isn't in TABLE.
+ */
+const Config* Find(uint32_t sampleRate);
+
+/**
+ * @brief Reprograms the PLLI2S and the prescaler of @p i2s, which must be disabled.
+ */
+bool Apply(I2S_HandleTypeDef* i2s, const Config& config);
+}    // namespace I2sClock
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_DRIVERS_I2SCLOCK_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
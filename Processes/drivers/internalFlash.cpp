@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    internalFlash.cpp
+ * @brief   Source for the InternalFlash.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "internalFlash.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+/**
+ * @brief The data cache may hold what was read before the flash changed.
+ */
+void ResetDataCache()
+{
+    if ((FLASH->ACR & FLASH_ACR_DCEN) != 0)
+    {
+        __HAL_FLASH_DATA_CACHE_DISABLE();
+        __HAL_FLASH_DATA_CACHE_RESET();
+        __HAL_FLASH_DATA_CACHE_ENABLE();
+    }
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+InternalFlash::InternalFlash(uint32_t firstSector, size_t count)
+: m_firstSector(firstSector), m_count(count)
+{
+    CEP_ASSERT(firstSector >= FIRST_SECTOR && count != 0 && firstSector + count - 1 <= LAST_SECTOR,
+               "The sectors must be in DATA_FLASH, from 8 to 11!");
+}
+
+const uint8_t* InternalFlash::GetSector(size_t sector) const
+{
+    uintptr_t address = BASE + (m_firstSector + sector - FIRST_SECTOR) * SECTOR_SIZE;
+    return reinterpret_cast<const uint8_t*>(address);
+}
+
+bool InternalFlash::Erase(size_t sector)
+{
+    FLASH_EraseInitTypeDef erase = {};
+    erase.TypeErase              = FLASH_TYPEERASE_SECTORS;
+    erase.Sector                 = m_firstSector + sector;
+    erase.NbSectors              = 1;
+    erase.VoltageRange           = FLASH_VOLTAGE_RANGE_3;
+
+    uint32_t failed = 0;
+    HAL_FLASH_Unlock();
+    // Flushes the caches once done.
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &failed);
+    HAL_FLASH_Lock();
+    m_erases++;
+    return status == HAL_OK;
+}
+
+bool InternalFlash::Program(size_t sector, size_t offset, const void* data, size_t size)
+{
+    const uint8_t*    in      = static_cast<const uint8_t*>(data);
+    uint32_t          address = static_cast<uint32_t>(
+      reinterpret_cast<uintptr_t>(GetSector(sector)) + offset);
+    HAL_StatusTypeDef status  = HAL_OK;
+
+    HAL_FLASH_Unlock();
+    for (size_t i = 0; i < size && status == HAL_OK; i += sizeof(uint32_t))
+    {
+        uint32_t word = 0;
+        std::memcpy(&word, &in[i], sizeof(word));
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i, word);
+    }
+    HAL_FLASH_Lock();
+    ResetDataCache();
+    return status == HAL_OK;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
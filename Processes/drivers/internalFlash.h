@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    internalFlash.h
+ * @brief   128 KiB sectors of the internal flash, erased and programmed through HAL_FLASH.
+ *
+ * Backs a KvStore with consecutive sectors of the first 512 KiB of DATA_FLASH, sectors 8
+ * (0x08080000) to 11. Only those: sectors 0 to 7 are CODE_FLASH, the firmware. The words are
+ * programmed one at a time, at 2.7 V to 3.6 V (FLASH_VOLTAGE_RANGE_3).
+ *
+ * @note Sectors 8 to 11 are in the first bank, with the code: the CPU stalls on any read of it
+ *       while they're being erased or programmed. Erasing a sector takes 1 to 2 s, during which
+ *       nothing runs from the flash, interrupts included. Programming a word takes 16 us. The
+ *       second bank, at 0x08100000, stays readable: the asset bundle is there.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_DRIVERS_INTERNALFLASH_H
+#    define NILAIINI_DRIVERS_INTERNALFLASH_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Core/Inc/main.h"
+
+#    include "Processes/services/kvStore.h"
+
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+class InternalFlash : public KvStore::Flash
+{
+public:
+    static constexpr size_t    SECTOR_SIZE  = 128 * 1024;
+    static constexpr uint32_t  FIRST_SECTOR = FLASH_SECTOR_8;    //!< The first of DATA_FLASH.
+    static constexpr uint32_t  LAST_SECTOR  = FLASH_SECTOR_11;
+    static constexpr uintptr_t BASE         = 0x08080000;    //!< Of FIRST_SECTOR.
+
+    /**
+     * @param firstSector FLASH_SECTOR_x, from FIRST_SECTOR.
+     */
+    InternalFlash(uint32_t firstSector, size_t count);
+    ~InternalFlash() override = default;
+
+    [[nodiscard]] size_t         GetSectorCount() const override { return m_count; }
+    [[nodiscard]] size_t         GetSectorSize() const override { return SECTOR_SIZE; }
+    [[nodiscard]] const uint8_t* GetSector(size_t sector) const override;
+
+    bool Erase(size_t sector) override;
+    bool Program(size_t sector, size_t offset, const void* data, size_t size) override;
+
+    //! Since boot.
+    [[nodiscard]] uint32_t GetErases() const { return m_erases; }
+
+private:
+    uint32_t m_firstSector;
+    size_t   m_count;
+    uint32_t m_erases = 0;
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_DRIVERS_INTERNALFLASH_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
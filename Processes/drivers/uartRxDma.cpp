@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    uartRxDma.cpp
+ * @brief   Source for the UartRxDma.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "uartRxDma.h"
+
+#include "Core/Inc/usart.h"
+
+#include "Processes/drivers/ccmRam.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+
+#include <algorithm>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t POS_MASK = UartRxDma::RX_SIZE - 1;
+
+static_assert((UartRxDma::RX_SIZE & POS_MASK) == 0, "RX_SIZE must be a power of two");
+static_assert(UartRxDma::RX_SIZE <= UINT16_MAX, "RX_SIZE must fit in the DMA's counter");
+}    // namespace
+
+UartRxDma* UartRxDma::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+UartRxDma::UartRxDma(UART_HandleTypeDef* uart, DMA_HandleTypeDef* dma, const std::string& label)
+: m_label(label), m_uart(uart), m_dma(dma)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of UartRxDma!");
+    CEP_ASSERT(uart != nullptr && dma != nullptr, "Invalid UART or DMA handle!");
+    CEP_ASSERT(dma->Init.Mode == DMA_CIRCULAR, "The RX DMA must be in circular mode!");
+    CEP_ASSERT(CcmRam::IsDmaCapable(m_buffer, sizeof(m_buffer)), "The RX ring can't be in the CCM!");
+    s_instance = this;
+
+    Start();
+}
+
+bool UartRxDma::DoPost()
+{
+    return HAL_DMA_GetState(m_dma) == HAL_DMA_STATE_BUSY;
+}
+
+void UartRxDma::Run()
+{
+    if (m_needsRestart)
+    {
+        m_needsRestart = false;
+        Start();
+    }
+}
+
+UartRxDma::Spans UartRxDma::Peek()
+{
+    uint32_t head = Head();
+    if (head - m_tail > RX_SIZE)
+    {
+        // The DMA lapped us, the oldest data was overwritten.
+        m_overruns++;
+        m_tail = head - RX_SIZE;
+    }
+
+    size_t available = head - m_tail;
+    size_t pos       = m_tail & POS_MASK;
+    size_t first     = std::min(available, RX_SIZE - pos);
+
+    Spans spans;
+    spans.first  = {&m_buffer[pos], first};
+    spans.second = {&m_buffer[0], available - first};
+    return spans;
+}
+
+void UartRxDma::Consume(size_t len)
+{
+    uint32_t head = Head();
+    m_tail += static_cast<uint32_t>(std::min<size_t>(len, head - m_tail));
+}
+
+void UartRxDma::OnIdleLine()
+{
+    if (m_rxCallback != nullptr)
+    {
+        m_rxCallback();
+    }
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+bool UartRxDma::Start()
+{
+    HAL_DMA_Abort(m_dma);
+    CLEAR_BIT(m_uart->Instance->CR3, USART_CR3_DMAR);
+
+    m_dma->XferCpltCallback     = &TransferCompleteCallback;
+    m_dma->XferHalfCpltCallback = &HalfTransferCallback;
+    m_dma->XferErrorCallback    = &ErrorCallback;
+
+    // Restart from a clean slate, whatever was in the buffer is lost anyway.
+    m_laps = 0;
+    m_tail = 0;
+
+    if (HAL_DMA_Start_IT(m_dma,
+                         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&m_uart->Instance->DR)),
+                         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_buffer)),
+                         RX_SIZE) != HAL_OK)
+    {
+        return false;
+    }
+
+    // A pending overrun would block the reception.
+    __HAL_UART_CLEAR_OREFLAG(m_uart);
+    SET_BIT(m_uart->Instance->CR3, USART_CR3_DMAR);
+    __HAL_UART_ENABLE_IT(m_uart, UART_IT_IDLE);
+    return true;
+}
+
+/**
+ * @brief Free-running position of the DMA, in bytes since it was started.
+ */
+uint32_t UartRxDma::Head() const
+{
+    uint32_t laps      = 0;
+    uint32_t remaining = 0;
+    do
+    {
+        laps      = m_laps;
+        remaining = __HAL_DMA_GET_COUNTER(m_dma);
+    } while (laps != m_laps);
+
+    uint32_t head = laps * RX_SIZE + (RX_SIZE - remaining);
+
+    // The counter reloads before the transfer complete interrupt counts the lap. If it couldn't
+    // run yet (interrupts masked), the position appears to go backward.
+    if (head - m_tail > UINT32_MAX / 2)
+    {
+        head += RX_SIZE;
+    }
+    return head;
+}
+
+void UartRxDma::TransferCompleteCallback(DMA_HandleTypeDef* hdma)
+{
+    if (s_instance != nullptr && s_instance->m_dma == hdma)
+    {
+        s_instance->m_laps = s_instance->m_laps + 1;
+        s_instance->OnIdleLine();
+    }
+}
+
+void UartRxDma::HalfTransferCallback(DMA_HandleTypeDef* hdma)
+{
+    if (s_instance != nullptr && s_instance->m_dma == hdma)
+    {
+        s_instance->OnIdleLine();
+    }
+}
+
+void UartRxDma::ErrorCallback(DMA_HandleTypeDef* hdma)
+{
+    if (s_instance != nullptr && s_instance->m_dma == hdma)
+    {
+        // The stream is disabled by the hardware on error, Run restarts it.
+        s_instance->m_needsRestart = true;
+    }
+}
+
+/*****************************************************************************/
+/* C-callable hooks                                                          */
+/*****************************************************************************/
+extern "C" void UART_IdleLineCallback(UART_HandleTypeDef* huart)
+{
+    if (UartRxDma::Get() != nullptr && huart == &huart2)
+    {
+        UartRxDma::Get()->OnIdleLine();
+    }
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
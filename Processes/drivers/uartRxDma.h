@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    uartRxDma.h
+ * @brief   UART reception into a ring buffer by a circular DMA, without per-byte interrupts.
+ *
+ * The DMA runs continuously and never needs re-arming. The position it writes at is read from
+ * its counter whenever a consumer asks, so the received data is available right away. The
+ * interrupts only serve to count the laps of the DMA around the ring (transfer complete) and
+ * to tell the consumer that there is something to read (half transfer, transfer complete and
+ * IDLE line, which marks the end of a burst of data, a frame for most protocols).
+ *
+ * The consumer gets the received data in place, as up to two spans when it wraps around the end
+ * of the ring, and consumes it once done. A consumer that falls more than RX_SIZE bytes behind
+ * loses the oldest data, which is counted as an overrun.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_DRIVERS_UARTRXDMA_H
+#    define NILAIINI_DRIVERS_UARTRXDMA_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include "Core/Inc/main.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class UartRxDma : public cep::Module
+{
+public:
+    static constexpr size_t RX_SIZE = 2048;    //!< Must be a power of two.
+
+    struct Span
+    {
+        uint8_t* data = nullptr;
+        size_t   len  = 0;
+    };
+
+    /**
+     * @brief The received data, in order: first then second.
+     */
+    struct Spans
+    {
+        Span first;
+        Span second;
+
+        size_t Size() const { return first.len + second.len; }
+    };
+
+    //! Called from an interrupt when data was received.
+    using RxCallback = void (*)();
+
+    UartRxDma(UART_HandleTypeDef* uart, DMA_HandleTypeDef* dma, const std::string& label);
+    ~UartRxDma() override = default;
+
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    /**
+     * @brief Returns the data received and not consumed yet, without copying it.
+     * @note The spans stay valid until Consume, as long as the DMA doesn't catch up with them.
+     * The consumer may modify them in place, to decode a packet for instance.
+     */
+    Spans Peek();
+
+    void   Consume(size_t len);
+    size_t Available() { return Peek().Size(); }
+
+    void SetRxCallback(RxCallback callback) { m_rxCallback = callback; }
+
+    uint32_t GetOverruns() const { return m_overruns; }
+
+    static UartRxDma* Get() { return s_instance; }
+
+    /**
+     * @brief Called by the UART's interrupt handler, through UART_IdleLineCallback.
+     */
+    void OnIdleLine();
+
+private:
+    std::string         m_label;
+    UART_HandleTypeDef* m_uart = nullptr;
+    DMA_HandleTypeDef*  m_dma  = nullptr;
+
+    alignas(4) uint8_t m_buffer[RX_SIZE] = {};
+
+    volatile uint32_t m_laps         = 0;    //!< Times the DMA wrapped around the buffer.
+    uint32_t          m_tail         = 0;    //!< Free-running read position.
+    uint32_t          m_overruns     = 0;
+    volatile bool     m_needsRestart = false;
+    RxCallback        m_rxCallback   = nullptr;
+
+private:
+    static UartRxDma* s_instance;
+
+private:
+    bool     Start();
+    uint32_t Head() const;
+
+    static void TransferCompleteCallback(DMA_HandleTypeDef* hdma);
+    static void HalfTransferCallback(DMA_HandleTypeDef* hdma);
+    static void ErrorCallback(DMA_HandleTypeDef* hdma);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_DRIVERS_UARTRXDMA_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,417 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    uartTxDma.cpp
+ * @brief   Source for the UartTxDma.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "uartTxDma.h"
+
+#include "Processes/drivers/ccmRam.h"
+#include "Processes/drivers/criticalSection.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t IDX_MASK     = 0x00FFFFFFU;    //!< Indices are free-running over 24 bits.
+constexpr uint32_t WRITER_SHIFT = 24;
+constexpr uint32_t WRITER_ONE   = 1U << WRITER_SHIFT;
+constexpr uint32_t POS_MASK     = UartTxDma::RING_SIZE - 1;
+
+//! The largest message that is guaranteed to fit once everything that can be dropped is dropped.
+constexpr size_t MAX_MESSAGE = UartTxDma::RING_SIZE - UartTxDma::MAX_DMA_CHUNK;
+
+//! Iterations of the busy loops in Flush, more than enough for a full ring at 9600 bauds.
+constexpr uint32_t FLUSH_TIMEOUT = 0x00FFFFFFU;
+
+static_assert((UartTxDma::RING_SIZE & POS_MASK) == 0, "RING_SIZE must be a power of two");
+static_assert(UartTxDma::RING_SIZE <= IDX_MASK, "RING_SIZE must fit in the index");
+
+inline uint32_t Distance(uint32_t from, uint32_t to)
+{
+    return (to - from) & IDX_MASK;
+}
+}    // namespace
+
+UartTxDma* UartTxDma::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+UartTxDma::UartTxDma(UART_HandleTypeDef* uart, DMA_HandleTypeDef* dma) : m_uart(uart), m_dma(dma)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of UartTxDma!");
+    CEP_ASSERT(uart != nullptr && dma != nullptr, "Invalid UART or DMA handle!");
+    CEP_ASSERT(CcmRam::IsDmaCapable(m_ring, sizeof(m_ring)), "The TX ring can't be in the CCM!");
+    s_instance = this;
+
+    // An error also ends the transfer, the data is lost but the queue keeps moving.
+    m_dma->XferCpltCallback     = &TransferCompleteCallback;
+    m_dma->XferHalfCpltCallback = nullptr;
+    m_dma->XferErrorCallback    = &TransferCompleteCallback;
+
+    SET_BIT(m_uart->Instance->CR3, USART_CR3_DMAT);
+}
+
+bool UartTxDma::Write(const char* msg, size_t len, bool tap)
+{
+    if (msg == nullptr)
+    {
+        return true;
+    }
+    return WriteInPlace(
+      len, [msg, len](RingWriter& writer) { writer.Write(msg, len); }, tap);
+}
+
+void UartTxDma::Flush()
+{
+    __disable_irq();
+
+    if (m_busy)
+    {
+        uint32_t timeout = FLUSH_TIMEOUT;
+        while (__HAL_DMA_GET_COUNTER(m_dma) != 0 && --timeout != 0)
+        {
+        }
+        uint32_t remaining = __HAL_DMA_GET_COUNTER(m_dma);
+        HAL_DMA_Abort(m_dma);
+
+        if (m_sendingMarker)
+        {
+            PollSend(reinterpret_cast<const uint8_t*>(m_marker) + (m_markerLen - remaining),
+                     remaining);
+        }
+        else
+        {
+            m_tail = (m_tail - remaining) & IDX_MASK;
+        }
+        m_sendingMarker = false;
+        m_busy          = false;
+    }
+
+    // Writers interrupted for good never finish their copy, only send what was complete.
+    uint32_t state = m_state.load(std::memory_order_acquire);
+    uint32_t end   = (state >> WRITER_SHIFT) == 0 ? (state & IDX_MASK) : m_published;
+
+    if (m_dropped != 0)
+    {
+        // The DMA may have stopped in the middle of a message, the marker goes after it.
+        PollSendRing(m_tail == end || IsStart(m_tail) ? m_tail : NextStart(m_tail, end));
+        PollSend(reinterpret_cast<const uint8_t*>(m_marker), FormatMarker());
+    }
+    PollSendRing(end);
+    m_sent      = m_tail;
+    m_published = m_tail;
+
+    uint32_t timeout = FLUSH_TIMEOUT;
+    while ((m_uart->Instance->SR & USART_SR_TC) == 0 && --timeout != 0)
+    {
+    }
+}
+
+void UartTxDma::RingWriter::Write(const char* data, size_t len)
+{
+    len = std::min(len, m_left);
+    while (len != 0)
+    {
+        uint32_t pos   = m_pos & POS_MASK;
+        size_t   chunk = std::min(len, RING_SIZE - pos);
+        std::memcpy(&m_ring[pos], data, chunk);
+        data += chunk;
+        len -= chunk;
+        m_left -= chunk;
+        m_pos = (m_pos + chunk) & IDX_MASK;
+    }
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Reserves room and registers as a writer in one go.
+ * @note @p len is truncated to the largest message that can fit.
+ */
+bool UartTxDma::Reserve(size_t& len, uint32_t& start)
+{
+    len = std::min(len, MAX_MESSAGE);
+
+    uint32_t state = m_state.load(std::memory_order_relaxed);
+    while (true)
+    {
+        start = state & IDX_MASK;
+        if (Distance(m_sent, start) + len > RING_SIZE)
+        {
+            if (!MakeRoom(len))
+            {
+                return false;
+            }
+            state = m_state.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        uint32_t next = ((state & ~IDX_MASK) + WRITER_ONE) | ((start + len) & IDX_MASK);
+        if (m_state.compare_exchange_weak(
+              state, next, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            MarkStart(start, len);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Done copying. The last writer out makes everything visible to the DMA, in Kick.
+ */
+void UartTxDma::Commit()
+{
+    m_state.fetch_sub(WRITER_ONE, std::memory_order_release);
+    Kick();
+}
+
+/**
+ * @brief Marks that a message starts at @p start, and that none does in the rest of its @p len
+ * bytes.
+ * @note The writer owns its bytes of the ring, but shares the words at both ends of their bits
+ * with the writers before and after it.
+ */
+void UartTxDma::MarkStart(uint32_t start, size_t len)
+{
+    for (size_t done = 0; done < len;)
+    {
+        uint32_t pos   = (start + done) & POS_MASK;
+        uint32_t bit   = pos % 32;
+        size_t   count = std::min<size_t>(len - done, 32 - bit);
+        uint32_t mask  = count == 32 ? 0xFFFFFFFFU : ((1U << count) - 1U) << bit;
+        m_starts[pos / 32].fetch_and(~mask, std::memory_order_relaxed);
+        done += count;
+    }
+    uint32_t pos = start & POS_MASK;
+    m_starts[pos / 32].fetch_or(1U << (pos % 32), std::memory_order_relaxed);
+}
+
+bool UartTxDma::IsStart(uint32_t index) const
+{
+    uint32_t pos = index & POS_MASK;
+    return ((m_starts[pos / 32].load(std::memory_order_relaxed) >> (pos % 32)) & 1U) != 0;
+}
+
+/**
+ * @returns The start of the first message after @p from, @p end if there is none before it.
+ */
+uint32_t UartTxDma::NextStart(uint32_t from, uint32_t end) const
+{
+    uint32_t index = from;
+    while (index != end)
+    {
+        index = (index + 1) & IDX_MASK;
+        if (IsStart(index))
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Drops the oldest pending messages until @p len bytes are free.
+ * @returns False if the incoming message must be dropped instead.
+ */
+bool UartTxDma::MakeRoom(size_t len)
+{
+    CriticalSection cs;
+
+    uint32_t state = m_state.load(std::memory_order_relaxed);
+    if ((state >> WRITER_SHIFT) != 0)
+    {
+        // We interrupted a writer, its reserved bytes can't be moved. Drop this message instead.
+        m_dropped++;
+        m_totalDropped++;
+        return false;
+    }
+
+    uint32_t end  = state & IDX_MASK;
+    size_t   used = Distance(m_sent, end);
+    if (used + len <= RING_SIZE)
+    {
+        // The DMA freed enough room in the meantime.
+        return true;
+    }
+    size_t needed = used + len - RING_SIZE;
+
+    // Only the data that wasn't handed to the DMA yet can go, one whole message at a time. The
+    // DMA may have stopped in the middle of a message, the rest of it stays.
+    uint32_t first    = m_tail == end || IsStart(m_tail) ? m_tail : NextStart(m_tail, end);
+    uint32_t cut      = first;
+    uint32_t messages = 0;
+    while (Distance(first, cut) < needed && cut != end)
+    {
+        cut = NextStart(cut, end);
+        messages++;
+    }
+
+    if (Distance(first, cut) < needed)
+    {
+        m_dropped++;
+        m_totalDropped++;
+        return false;
+    }
+
+    // Move the messages that follow down to where the dropped ones started, with their marks.
+    uint32_t dst = first;
+    for (uint32_t src = cut; src != end; src = (src + 1) & IDX_MASK)
+    {
+        uint32_t               pos  = dst & POS_MASK;
+        std::atomic<uint32_t>& word = m_starts[pos / 32];
+        uint32_t               bit  = 1U << (pos % 32);
+        uint32_t               bits = word.load(std::memory_order_relaxed);
+        word.store(IsStart(src) ? (bits | bit) : (bits & ~bit), std::memory_order_relaxed);
+        m_ring[pos] = m_ring[src & POS_MASK];
+        dst         = (dst + 1) & IDX_MASK;
+    }
+
+    m_state.store(dst, std::memory_order_relaxed);
+    m_published = dst;
+    m_dropped += messages;
+    m_totalDropped += messages;
+
+    return true;
+}
+
+/**
+ * @brief Starts the next DMA transfer, if the DMA is idle and there is something to send.
+ */
+void UartTxDma::Kick()
+{
+    CriticalSection cs;
+
+    uint32_t state = m_state.load(std::memory_order_acquire);
+    if ((state >> WRITER_SHIFT) == 0)
+    {
+        m_published = state & IDX_MASK;
+    }
+
+    if (m_busy)
+    {
+        return;
+    }
+
+    const uint8_t* src = nullptr;
+    size_t         len = 0;
+    if (m_dropped != 0 && (m_tail == m_published || IsStart(m_tail)))
+    {
+        src             = reinterpret_cast<const uint8_t*>(m_marker);
+        len             = FormatMarker();
+        m_sendingMarker = true;
+    }
+    else if (m_tail != m_published)
+    {
+        uint32_t pos = m_tail & POS_MASK;
+        len = std::min({static_cast<size_t>(Distance(m_tail, m_published)), RING_SIZE - pos,
+                        MAX_DMA_CHUNK});
+        if (m_dropped != 0)
+        {
+            // Finish the message that was being sent, the marker goes right after it.
+            len = Distance(m_tail, NextStart(m_tail, (m_tail + len) & IDX_MASK));
+        }
+        src = &m_ring[pos];
+        m_tail = (m_tail + len) & IDX_MASK;
+    }
+    else
+    {
+        return;
+    }
+
+    m_busy = true;
+    if (HAL_DMA_Start_IT(m_dma,
+                         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(src)),
+                         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&m_uart->Instance->DR)),
+                         len) != HAL_OK)
+    {
+        // Try again on the next write.
+        if (!m_sendingMarker)
+        {
+            m_tail = (m_tail - len) & IDX_MASK;
+        }
+        m_sendingMarker = false;
+        m_busy          = false;
+    }
+}
+
+void UartTxDma::OnTransferComplete()
+{
+    if (m_sendingMarker)
+    {
+        m_sendingMarker = false;
+    }
+    else
+    {
+        m_sent = m_tail;
+    }
+    m_busy = false;
+
+    Kick();
+}
+
+void UartTxDma::PollSend(const uint8_t* data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        uint32_t timeout = FLUSH_TIMEOUT;
+        while ((m_uart->Instance->SR & USART_SR_TXE) == 0 && --timeout != 0)
+        {
+        }
+        m_uart->Instance->DR = data[i];
+    }
+}
+
+/**
+ * @brief Sends the data of the ring from the tail up to @p end, without the DMA.
+ */
+void UartTxDma::PollSendRing(uint32_t end)
+{
+    while (m_tail != end)
+    {
+        uint32_t pos = m_tail & POS_MASK;
+        size_t   len = std::min<size_t>(Distance(m_tail, end), RING_SIZE - pos);
+        PollSend(&m_ring[pos], len);
+        m_tail = (m_tail + len) & IDX_MASK;
+    }
+}
+
+/**
+ * @brief Formats the dropped messages marker and resets the count.
+ */
+size_t UartTxDma::FormatMarker()
+{
+    int len = snprintf(m_marker,
+                       sizeof(m_marker),
+                       "--- %lu message(s) dropped ---\n\r",
+                       static_cast<unsigned long>(m_dropped));
+    m_dropped   = 0;
+    m_markerLen = std::min(static_cast<size_t>(std::max(len, 0)), sizeof(m_marker) - 1);
+    return m_markerLen;
+}
+
+void UartTxDma::TransferCompleteCallback(DMA_HandleTypeDef* hdma)
+{
+    if (s_instance != nullptr && s_instance->m_dma == hdma)
+    {
+        s_instance->OnTransferComplete();
+    }
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
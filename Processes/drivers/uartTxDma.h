@@ -0,0 +1,182 @@
+/**
+ ******************************************************************************
+ * @addtogroup drivers
+ * @{
+ * @file    uartTxDma.h
+ * @brief   Non-blocking UART transmitter backed by a ring buffer and the TX DMA stream.
+ *
+ * Writers copy their message into the ring buffer and return immediately, the DMA drains it in
+ * the background. Writing never blocks and is safe from any context, interrupts included:
+ *  - Reserving room in the ring is a compare-and-swap on a single word that packs the write
+ *    index with the number of writers currently copying, so a writer preempted by an interrupt
+ *    that also logs never corrupts the buffer.
+ *  - The data only becomes visible to the DMA once the last active writer is done.
+ *
+ * When the ring is full, the oldest pending messages (not yet handed to the DMA) are dropped to
+ * make room and a "--- N message(s) dropped ---" marker is sent in their place. The ring also
+ * carries binary frames (FrameLink, BinaryLog), so the messages aren't found by their content:
+ * every reservation marks where its message starts in a bitmap, one bit per byte of the ring.
+ * Only whole messages are dropped, and the marker is only sent between two messages.
+ *
+ * Flush() sends everything synchronously, for the paths that will never return (Error_Handler).
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_DRIVERS_UARTTXDMA_H
+#    define NILAIINI_DRIVERS_UARTTXDMA_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Core/Inc/main.h"
+
+#    include <atomic>
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+class UartTxDma
+{
+public:
+    static constexpr size_t RING_SIZE     = 4096;    //!< Must be a power of two.
+    static constexpr size_t MAX_DMA_CHUNK = 256;     //!< Bytes per DMA transfer.
+
+    /**
+     * Receives a copy of every message, in two parts when it wraps around the end of the ring.
+     */
+    using TapFunc = void (*)(const char* first,
+                             size_t      firstLen,
+                             const char* second,
+                             size_t      secondLen);
+
+    UartTxDma(UART_HandleTypeDef* uart, DMA_HandleTypeDef* dma);
+    ~UartTxDma() = default;
+
+    /**
+     * @brief Writes a message directly into its reserved place in the ring.
+     */
+    class RingWriter
+    {
+    public:
+        void Write(const char* data, size_t len);
+
+    private:
+        friend class UartTxDma;
+        RingWriter(uint8_t* ring, uint32_t start, size_t len)
+        : m_ring(ring), m_pos(start), m_left(len)
+        {
+        }
+
+        uint8_t* m_ring;
+        uint32_t m_pos;
+        size_t   m_left;
+    };
+
+    /**
+     * @brief Queues @p len bytes for transmission.
+     * @note Never blocks, can be called from an interrupt.
+     * @param tap Gives a copy to the tap. Binary traffic that isn't part of the log opts out.
+     * @returns False if the message had to be dropped.
+     */
+    bool Write(const char* msg, size_t len, bool tap = true);
+
+    /**
+     * @brief Reserves @p len bytes in the ring and lets @p fill write them in place, which saves
+     * formatting the message in an intermediate buffer.
+     * @note @p fill must write exactly @p len bytes, the rest is padded with spaces.
+     * @note Never blocks, can be called from an interrupt.
+     * @returns False if the message had to be dropped, in which case @p fill isn't called.
+     */
+    template<typename Fill>
+    bool WriteInPlace(size_t len, Fill&& fill, bool tap = true)
+    {
+        if (len == 0)
+        {
+            return true;
+        }
+        uint32_t start = 0;
+        if (!Reserve(len, start))
+        {
+            return false;
+        }
+        RingWriter writer(m_ring, start, len);
+        fill(writer);
+        while (writer.m_left != 0)
+        {
+            writer.Write(" ", 1);
+        }
+        if (tap && m_tap != nullptr)
+        {
+            // Still reserved, the data can't move until the commit.
+            size_t pos   = start & (RING_SIZE - 1);
+            size_t first = len < RING_SIZE - pos ? len : RING_SIZE - pos;
+            m_tap(reinterpret_cast<const char*>(&m_ring[pos]),
+                  first,
+                  reinterpret_cast<const char*>(&m_ring[0]),
+                  len - first);
+        }
+        Commit();
+        return true;
+    }
+
+    /**
+     * @brief Synchronously sends everything that was queued, with interrupts disabled.
+     * @note Meant for fatal paths only, interrupts stay disabled afterwards.
+     */
+    void Flush();
+
+    uint32_t GetDroppedMessages() const { return m_totalDropped; }
+
+    void SetTap(TapFunc tap) { m_tap = tap; }
+
+    static UartTxDma* Get() { return s_instance; }
+
+private:
+    UART_HandleTypeDef* m_uart = nullptr;
+    DMA_HandleTypeDef*  m_dma  = nullptr;
+
+    uint8_t m_ring[RING_SIZE] = {};
+    //! One bit per byte of the ring, set where a message starts. Valid for the pending data.
+    std::atomic<uint32_t> m_starts[RING_SIZE / 32] = {};
+
+    //! Bits 0-23: write index, bits 24-31: number of writers copying into the ring.
+    std::atomic<uint32_t> m_state {0};
+    uint32_t              m_published = 0;    //!< End of the data the DMA may send.
+    volatile uint32_t     m_sent      = 0;    //!< Start of the data still in the ring.
+    uint32_t              m_tail      = 0;    //!< End of the data handed to the DMA.
+
+    volatile bool m_busy          = false;
+    bool          m_sendingMarker = false;
+    uint32_t      m_dropped       = 0;    //!< Messages dropped since the last marker.
+    uint32_t      m_totalDropped  = 0;
+    char          m_marker[40]    = {};
+    TapFunc       m_tap           = nullptr;
+    size_t        m_markerLen     = 0;
+
+private:
+    static UartTxDma* s_instance;
+
+private:
+    bool Reserve(size_t& len, uint32_t& start);
+    void Commit();
+    void MarkStart(uint32_t start, size_t len);
+    [[nodiscard]] bool     IsStart(uint32_t index) const;
+    [[nodiscard]] uint32_t NextStart(uint32_t from, uint32_t end) const;
+    bool MakeRoom(size_t len);
+    void Kick();
+    void OnTransferComplete();
+    void PollSend(const uint8_t* data, size_t len);
+    void PollSendRing(uint32_t end);
+    size_t FormatMarker();
+
+    static void TransferCompleteCallback(DMA_HandleTypeDef* hdma);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_DRIVERS_UARTTXDMA_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
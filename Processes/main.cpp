@@ -18,6 +18,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "Processes/MasterApplication.h"
+#include "Processes/drivers/uartTxDma.h"
+#include "Processes/services/bootTimeline.h"
+#include "Processes/services/memStats.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
@@ -61,22 +64,32 @@ void SystemClock_Config();
  */
 int main()
 {
+    // Before anything gets timed, or deep into the stack.
+    MemStats::PaintStack();
+    BootTimeline::Start();
+
     /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
     HAL_Init();
+    BootTimeline::Mark("HAL_Init");
     // Make sure that SYSCLK isn't set to PLL before configuring it.
     CLEAR_BIT(RCC->CFGR, RCC_CFGR_SW);
 
     /* Configure the system clock */
     SystemClock_Config();
+    BootTimeline::Mark("SystemClock_Config");
 
     /* Initialize program */
     MasterApplication app;
 
     app.Init();
-    if (app.DoPost())
+    bool passed = app.DoPost();
+    BootTimeline::Mark("DoPost");
+    if (passed)
     {
         app.Run();
     }
+    // Only when the POST failed, to know how far the boot went.
+    BootTimeline::Report();
 
     /* We should never get here as control is now taken by the scheduler */
     /* Infinite loop */
@@ -147,6 +160,11 @@ extern "C" void Error_Handler(void)
     /* USER CODE BEGIN Error_Handler_Debug */
     /* User can add his own implementation to report the HAL error return state */
     LOG_CRITICAL("The error handler was called");
+    if (UartTxDma::Get() != nullptr)
+    {
+        // Nothing will ever drain the queue from now on.
+        UartTxDma::Get()->Flush();
+    }
     __disable_irq();
     while (true)
     {
@@ -167,7 +185,7 @@ extern "C" void assert_failed(uint8_t* file, uint32_t line)
     /* USER CODE BEGIN 6 */
     /* User can add his own implementation to report the file name and line number,
        ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
-    LOG_ERROR("An assertion failed at line %d of %s", line, file);
+    LOG_ERROR("An assertion failed at line {} of {}", line, reinterpret_cast<const char*>(file));
     /* USER CODE END 6 */
 }
 #endif /* USE_FULL_ASSERT */
\ No newline at end of file
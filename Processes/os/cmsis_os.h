@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    cmsis_os.h
+ * @brief   Subset of the CMSIS-RTOS2 API implemented by the in-tree kernel.
+ *
+ * Only the calls needed by the application and by FatFs' option/syscall.c are provided.
+ * The names, types and semantics follow CMSIS-RTOS2 so that the code can be moved over to a
+ * full RTOS (FreeRTOS through CubeMX, for example) without being rewritten.
+ *
+ * The kernel is a fixed-priority preemptive scheduler. Threads of equal priority are scheduled
+ * round-robin on every tick. Mutexes use priority inheritance, transitively: a thread holding a
+ * mutex that a waiter is blocked on inherits the waiter's priority, and so does the owner of the
+ * mutex that thread waits on in turn.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_OS_CMSIS_OS_H
+#    define NILAIINI_OS_CMSIS_OS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <stddef.h>
+#    include <stdint.h>
+
+#    ifdef __cplusplus
+extern "C" {
+#    endif
+
+/*****************************************************************************/
+/* Exported defines */
+#    define osCMSIS 0x20001U    //!< API version (2.1).
+
+#    define osWaitForever 0xFFFFFFFFU    //!< Wait forever timeout value.
+
+//! Maximum number of objects of each kind. Control blocks are statically allocated.
+#    define OS_MAX_THREADS    8U
+#    define OS_MAX_MUTEXES    8U
+#    define OS_MAX_SEMAPHORES 8U
+
+//! Frequency of the kernel tick, in Hz. Matches the 1ms HAL tick.
+#    define OS_TICK_FREQ 1000U
+
+/*****************************************************************************/
+/* Exported types */
+typedef enum
+{
+    osOK             = 0,
+    osError          = -1,
+    osErrorTimeout   = -2,
+    osErrorResource  = -3,
+    osErrorParameter = -4,
+    osErrorNoMemory  = -5,
+    osErrorISR       = -6,
+} osStatus_t;
+
+typedef enum
+{
+    osPriorityNone        = 0,
+    osPriorityIdle        = 1,
+    osPriorityLow         = 8,
+    osPriorityBelowNormal = 16,
+    osPriorityNormal      = 24,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh        = 40,
+    osPriorityRealtime    = 48,
+    osPriorityISR         = 56,
+} osPriority_t;
+
+typedef enum
+{
+    osKernelInactive = 0,
+    osKernelReady    = 1,
+    osKernelRunning  = 2,
+} osKernelState_t;
+
+typedef void (*osThreadFunc_t)(void* argument);
+
+typedef struct osThread_s*    osThreadId_t;
+typedef struct osMutex_s*     osMutexId_t;
+typedef struct osSemaphore_s* osSemaphoreId_t;
+
+typedef struct
+{
+    const char*  name;          //!< Name of the thread, for debugging only.
+    uint32_t     attr_bits;     //!< Unused.
+    void*        cb_mem;        //!< Unused, control blocks are statically allocated.
+    uint32_t     cb_size;       //!< Unused.
+    void*        stack_mem;     //!< Memory for the stack, 8-byte aligned. NULL to allocate.
+    uint32_t     stack_size;    //!< Size of the stack, in bytes. 0 for the default size.
+    osPriority_t priority;      //!< Priority of the thread. osPriorityNone for Normal.
+    uint32_t     tz_module;     //!< Unused.
+    uint32_t     reserved;      //!< Unused.
+} osThreadAttr_t;
+
+typedef struct
+{
+    const char* name;
+    uint32_t    attr_bits;
+    void*       cb_mem;
+    uint32_t    cb_size;
+} osMutexAttr_t;
+
+typedef struct
+{
+    const char* name;
+    uint32_t    attr_bits;
+    void*       cb_mem;
+    uint32_t    cb_size;
+} osSemaphoreAttr_t;
+
+/*****************************************************************************/
+/* Exported functions */
+// Kernel.
+osStatus_t      osKernelInitialize(void);
+osStatus_t      osKernelStart(void);
+osKernelState_t osKernelGetState(void);
+uint32_t        osKernelGetTickCount(void);
+uint32_t        osKernelGetTickFreq(void);
+
+// Threads.
+osThreadId_t osThreadNew(osThreadFunc_t func, void* argument, const osThreadAttr_t* attr);
+osThreadId_t osThreadGetId(void);
+const char*  osThreadGetName(osThreadId_t thread_id);
+osPriority_t osThreadGetPriority(osThreadId_t thread_id);
+uint32_t     osThreadGetStackSpace(osThreadId_t thread_id);
+osStatus_t   osThreadYield(void);
+void         osThreadExit(void);
+
+// Delays.
+osStatus_t osDelay(uint32_t ticks);
+osStatus_t osDelayUntil(uint32_t ticks);
+
+// Mutexes.
+osMutexId_t  osMutexNew(const osMutexAttr_t* attr);
+osStatus_t   osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t   osMutexRelease(osMutexId_t mutex_id);
+osThreadId_t osMutexGetOwner(osMutexId_t mutex_id);
+osStatus_t   osMutexDelete(osMutexId_t mutex_id);
+
+// Semaphores. Release and zero-timeout Acquire may be called from interrupts.
+osSemaphoreId_t osSemaphoreNew(uint32_t                 max_count,
+                               uint32_t                 initial_count,
+                               const osSemaphoreAttr_t* attr);
+osStatus_t      osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout);
+osStatus_t      osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+uint32_t        osSemaphoreGetCount(osSemaphoreId_t semaphore_id);
+osStatus_t      osSemaphoreDelete(osSemaphoreId_t semaphore_id);
+
+/**
+ * Advances the kernel tick. Must be called once per millisecond from the tick interrupt
+ * (SysTick_Handler on target, the tick thread in the POSIX port).
+ */
+void osSysTickHandler(void);
+
+#    ifdef __cplusplus
+}
+#    endif
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_OS_CMSIS_OS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
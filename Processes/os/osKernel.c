@@ -0,0 +1,733 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    osKernel.c
+ * @brief   Architecture-independent part of the kernel.
+ *
+ * The number of threads is small (OS_MAX_THREADS), so the scheduler simply scans the thread
+ * table instead of maintaining ready lists. Blocked threads are found the same way when a
+ * mutex or semaphore is released.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "Processes/os/osPort.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************/
+/* Private defines */
+#define OS_DEFAULT_STACK_SIZE 1024U
+#define OS_IDLE_STACK_SIZE    256U
+#define OS_STACK_PAINT        0xA5A5A5A5U
+
+/*****************************************************************************/
+/* Private types */
+struct osMutex_s
+{
+    bool               used;
+    const char*        name;
+    struct osThread_s* owner;
+    uint32_t           lockCount;
+};
+
+struct osSemaphore_s
+{
+    bool        used;
+    const char* name;
+    uint32_t    count;
+    uint32_t    maxCount;
+};
+
+/*****************************************************************************/
+/* Private variables */
+struct osThread_s* volatile g_osCurrent = NULL;
+struct osThread_s* volatile g_osNext    = NULL;
+
+static struct osThread_s    s_threads[OS_MAX_THREADS];
+static struct osMutex_s     s_mutexes[OS_MAX_MUTEXES];
+static struct osSemaphore_s s_semaphores[OS_MAX_SEMAPHORES];
+
+static volatile osKernelState_t s_state = osKernelInactive;
+static volatile uint32_t        s_tick  = 0;
+
+static uint32_t s_idleStack[OS_IDLE_STACK_SIZE / sizeof(uint32_t)];
+
+/*****************************************************************************/
+/* Private functions */
+static void IdleThread(void* argument)
+{
+    (void)argument;
+    for (;;)
+    {
+        osPortIdle();
+    }
+}
+
+/**
+ * @brief Selects the next thread and requests a context switch if it isn't the current one.
+ * @note Must be called from within a critical section.
+ */
+static void Reschedule(void)
+{
+    if (s_state != osKernelRunning)
+    {
+        return;
+    }
+
+    osKernelSelectNext();
+    if (g_osNext != g_osCurrent)
+    {
+        osPortRequestSwitch();
+    }
+}
+
+static bool IsValidMutex(const struct osMutex_s* mutex);
+
+static struct osThread_s* HighestWaiter(const void* object)
+{
+    struct osThread_s* best = NULL;
+    for (size_t i = 0; i < OS_MAX_THREADS; i++)
+    {
+        struct osThread_s* t = &s_threads[i];
+        if (t->state == osThreadStateBlocked && t->waitObject == object &&
+            (best == NULL || t->priority > best->priority))
+        {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void Wake(struct osThread_s* thread, osStatus_t result)
+{
+    thread->state      = osThreadStateReady;
+    thread->waitObject = NULL;
+    thread->hasTimeout = false;
+    thread->waitResult = result;
+}
+
+/**
+ * @brief Blocks the current thread on @p object.
+ * @note Must be called from within a critical section. The switch happens when leaving it.
+ */
+static void Block(void* object, uint32_t timeout)
+{
+    struct osThread_s* self = g_osCurrent;
+    self->state             = osThreadStateBlocked;
+    self->waitObject        = object;
+    self->hasTimeout        = timeout != osWaitForever;
+    self->wakeTick          = s_tick + timeout;
+    self->waitResult        = osErrorTimeout;
+    Reschedule();
+}
+
+/**
+ * @brief Recomputes the effective priority of a thread from the waiters of the mutexes it owns.
+ *
+ * Inheritance is transitive: if the thread is itself blocked on a mutex, the owner of that one
+ * is updated in turn, and so on up the chain. The chain is at most OS_MAX_THREADS long, which
+ * also bounds the walk if the threads deadlock each other.
+ */
+static void UpdateInheritedPriority(struct osThread_s* thread)
+{
+    for (size_t depth = 0; thread != NULL && depth < OS_MAX_THREADS; depth++)
+    {
+        uint8_t priority = thread->basePriority;
+        for (size_t i = 0; i < OS_MAX_MUTEXES; i++)
+        {
+            if (s_mutexes[i].used && s_mutexes[i].owner == thread)
+            {
+                struct osThread_s* waiter = HighestWaiter(&s_mutexes[i]);
+                if (waiter != NULL && waiter->priority > priority)
+                {
+                    priority = waiter->priority;
+                }
+            }
+        }
+        if (priority == thread->priority)
+        {
+            // Nothing changes further up the chain either.
+            return;
+        }
+        thread->priority = priority;
+
+        struct osMutex_s* mutex = (struct osMutex_s*)thread->waitObject;
+        thread = thread->state == osThreadStateBlocked && IsValidMutex(mutex) ? mutex->owner : NULL;
+    }
+}
+
+static bool IsValidThread(const struct osThread_s* thread)
+{
+    return thread >= &s_threads[0] && thread < &s_threads[OS_MAX_THREADS] &&
+           thread->state != osThreadStateUnused;
+}
+
+static bool IsValidMutex(const struct osMutex_s* mutex)
+{
+    return mutex >= &s_mutexes[0] && mutex < &s_mutexes[OS_MAX_MUTEXES] && mutex->used;
+}
+
+static bool IsValidSemaphore(const struct osSemaphore_s* sem)
+{
+    return sem >= &s_semaphores[0] && sem < &s_semaphores[OS_MAX_SEMAPHORES] && sem->used;
+}
+
+/*****************************************************************************/
+/* Kernel */
+void osKernelSelectNext(void)
+{
+    // Start looking right after the current thread so that threads of equal priority are
+    // scheduled round-robin.
+    size_t start = 0;
+    if (g_osCurrent != NULL)
+    {
+        start = (size_t)(g_osCurrent - &s_threads[0]) + 1;
+    }
+
+    struct osThread_s* best = NULL;
+    for (size_t i = 0; i < OS_MAX_THREADS; i++)
+    {
+        struct osThread_s* t = &s_threads[(start + i) % OS_MAX_THREADS];
+        if (t->state == osThreadStateReady && (best == NULL || t->priority > best->priority))
+        {
+            best = t;
+        }
+    }
+
+    g_osNext = best;
+}
+
+osStatus_t osKernelInitialize(void)
+{
+    if (s_state != osKernelInactive)
+    {
+        return osError;
+    }
+
+    memset(s_threads, 0, sizeof(s_threads));
+    memset(s_mutexes, 0, sizeof(s_mutexes));
+    memset(s_semaphores, 0, sizeof(s_semaphores));
+    s_state = osKernelReady;
+
+    const osThreadAttr_t idleAttr = {
+      .name       = "idle",
+      .stack_mem  = s_idleStack,
+      .stack_size = sizeof(s_idleStack),
+      .priority   = osPriorityIdle,
+    };
+    return osThreadNew(IdleThread, NULL, &idleAttr) != NULL ? osOK : osError;
+}
+
+osStatus_t osKernelStart(void)
+{
+    if (s_state != osKernelReady)
+    {
+        return osError;
+    }
+
+    (void)osPortEnterCritical();
+    s_state     = osKernelRunning;
+    g_osCurrent = NULL;
+    osKernelSelectNext();
+    g_osCurrent = g_osNext;
+    osPortStartFirstThread();
+
+    // Unreachable.
+    return osError;
+}
+
+osKernelState_t osKernelGetState(void)
+{
+    return s_state;
+}
+
+uint32_t osKernelGetTickCount(void)
+{
+    return s_tick;
+}
+
+uint32_t osKernelGetTickFreq(void)
+{
+    return OS_TICK_FREQ;
+}
+
+void osSysTickHandler(void)
+{
+    uint32_t state = osPortEnterCritical();
+    s_tick++;
+
+    if (s_state == osKernelRunning)
+    {
+        for (size_t i = 0; i < OS_MAX_THREADS; i++)
+        {
+            struct osThread_s* t = &s_threads[i];
+            if (t->state != osThreadStateBlocked || !t->hasTimeout ||
+                (int32_t)(s_tick - t->wakeTick) < 0)
+            {
+                continue;
+            }
+
+            void* object = t->waitObject;
+            // A plain delay has no wait object and completes successfully.
+            Wake(t, object == NULL ? osOK : osErrorTimeout);
+            if (IsValidMutex((struct osMutex_s*)object))
+            {
+                UpdateInheritedPriority(((struct osMutex_s*)object)->owner);
+            }
+        }
+
+        // Time slicing between threads of equal priority.
+        Reschedule();
+    }
+
+    osPortExitCritical(state);
+}
+
+/*****************************************************************************/
+/* Threads */
+osThreadId_t osThreadNew(osThreadFunc_t func, void* argument, const osThreadAttr_t* attr)
+{
+    if (func == NULL || osPortIsInIsr() || s_state == osKernelInactive)
+    {
+        return NULL;
+    }
+
+    const char*  name      = attr != NULL ? attr->name : NULL;
+    void*        stackMem  = attr != NULL ? attr->stack_mem : NULL;
+    uint32_t     stackSize = attr != NULL ? attr->stack_size : 0;
+    osPriority_t priority  = attr != NULL ? attr->priority : osPriorityNone;
+
+    if (stackSize == 0)
+    {
+        stackSize = OS_DEFAULT_STACK_SIZE;
+    }
+    if (priority == osPriorityNone)
+    {
+        priority = osPriorityNormal;
+    }
+    if (priority < osPriorityIdle || priority >= osPriorityISR ||
+        ((uintptr_t)stackMem & 7U) != 0)
+    {
+        return NULL;
+    }
+
+    if (stackMem == NULL)
+    {
+        stackMem = malloc(stackSize);
+        if (stackMem == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    uint32_t           state  = osPortEnterCritical();
+    struct osThread_s* thread = NULL;
+    for (size_t i = 0; i < OS_MAX_THREADS; i++)
+    {
+        if (s_threads[i].state == osThreadStateUnused)
+        {
+            thread = &s_threads[i];
+            break;
+        }
+    }
+
+    if (thread == NULL)
+    {
+        osPortExitCritical(state);
+        if (attr == NULL || attr->stack_mem == NULL)
+        {
+            free(stackMem);
+        }
+        return NULL;
+    }
+
+    memset(thread, 0, sizeof(*thread));
+    thread->func         = func;
+    thread->argument     = argument;
+    thread->name         = name;
+    thread->stackBase    = (uint32_t*)stackMem;
+    thread->stackSize    = stackSize & ~7U;
+    thread->basePriority = (uint8_t)priority;
+    thread->priority     = (uint8_t)priority;
+
+    for (uint32_t i = 0; i < thread->stackSize / sizeof(uint32_t); i++)
+    {
+        thread->stackBase[i] = OS_STACK_PAINT;
+    }
+
+    osPortInitThread(thread, osThreadExit);
+    thread->state = osThreadStateReady;
+    Reschedule();
+    osPortExitCritical(state);
+
+    return thread;
+}
+
+osThreadId_t osThreadGetId(void)
+{
+    return g_osCurrent;
+}
+
+const char* osThreadGetName(osThreadId_t thread_id)
+{
+    return IsValidThread(thread_id) ? thread_id->name : NULL;
+}
+
+osPriority_t osThreadGetPriority(osThreadId_t thread_id)
+{
+    return IsValidThread(thread_id) ? (osPriority_t)thread_id->priority : osPriorityNone;
+}
+
+uint32_t osThreadGetStackSpace(osThreadId_t thread_id)
+{
+    if (!IsValidThread(thread_id))
+    {
+        return 0;
+    }
+
+    // The stack grows downward, untouched paint at the bottom is free space.
+    uint32_t free = 0;
+    while (free < thread_id->stackSize / sizeof(uint32_t) &&
+           thread_id->stackBase[free] == OS_STACK_PAINT)
+    {
+        free++;
+    }
+    return free * sizeof(uint32_t);
+}
+
+osStatus_t osThreadYield(void)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+
+    uint32_t state = osPortEnterCritical();
+    Reschedule();
+    osPortExitCritical(state);
+    return osOK;
+}
+
+void osThreadExit(void)
+{
+    (void)osPortEnterCritical();
+    g_osCurrent->state = osThreadStateTerminated;
+    Reschedule();
+    osPortExitCritical(0);
+
+    // The thread is never scheduled again.
+    for (;;)
+    {
+    }
+}
+
+/*****************************************************************************/
+/* Delays */
+osStatus_t osDelay(uint32_t ticks)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+    if (ticks == 0)
+    {
+        return osErrorParameter;
+    }
+
+    uint32_t state = osPortEnterCritical();
+    Block(NULL, ticks);
+    osPortExitCritical(state);
+    return osOK;
+}
+
+osStatus_t osDelayUntil(uint32_t ticks)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+
+    uint32_t state = osPortEnterCritical();
+    uint32_t delay = ticks - s_tick;
+    if (delay == 0 || delay > 0x7FFFFFFFU)
+    {
+        osPortExitCritical(state);
+        return osErrorParameter;
+    }
+    Block(NULL, delay);
+    osPortExitCritical(state);
+    return osOK;
+}
+
+/*****************************************************************************/
+/* Mutexes */
+osMutexId_t osMutexNew(const osMutexAttr_t* attr)
+{
+    if (osPortIsInIsr())
+    {
+        return NULL;
+    }
+
+    uint32_t          state = osPortEnterCritical();
+    struct osMutex_s* mutex = NULL;
+    for (size_t i = 0; i < OS_MAX_MUTEXES; i++)
+    {
+        if (!s_mutexes[i].used)
+        {
+            mutex            = &s_mutexes[i];
+            mutex->used      = true;
+            mutex->name      = attr != NULL ? attr->name : NULL;
+            mutex->owner     = NULL;
+            mutex->lockCount = 0;
+            break;
+        }
+    }
+    osPortExitCritical(state);
+    return mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+    if (!IsValidMutex(mutex_id))
+    {
+        return osErrorParameter;
+    }
+
+    uint32_t           state = osPortEnterCritical();
+    struct osThread_s* self  = g_osCurrent;
+
+    if (mutex_id->owner == NULL || s_state != osKernelRunning)
+    {
+        // Before the kernel is started there is only one context, the mutex is always free.
+        mutex_id->owner = self;
+        mutex_id->lockCount++;
+        osPortExitCritical(state);
+        return osOK;
+    }
+    if (mutex_id->owner == self)
+    {
+        // Mutexes are always recursive.
+        mutex_id->lockCount++;
+        osPortExitCritical(state);
+        return osOK;
+    }
+    if (timeout == 0)
+    {
+        osPortExitCritical(state);
+        return osErrorResource;
+    }
+
+    // Priority inheritance: the owner, and whoever it waits on, runs at least at our priority
+    // until it releases.
+    Block(mutex_id, timeout);
+    UpdateInheritedPriority(mutex_id->owner);
+    Reschedule();
+    osPortExitCritical(state);
+
+    // Ownership was handed over by osMutexRelease if the result is osOK.
+    return self->waitResult;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+    if (!IsValidMutex(mutex_id))
+    {
+        return osErrorParameter;
+    }
+
+    uint32_t state = osPortEnterCritical();
+    if (mutex_id->lockCount == 0 ||
+        (s_state == osKernelRunning && mutex_id->owner != g_osCurrent))
+    {
+        osPortExitCritical(state);
+        return osErrorResource;
+    }
+
+    if (--mutex_id->lockCount == 0)
+    {
+        struct osThread_s* previous = mutex_id->owner;
+        struct osThread_s* waiter   = HighestWaiter(mutex_id);
+        mutex_id->owner             = waiter;
+        if (waiter != NULL)
+        {
+            mutex_id->lockCount = 1;
+            Wake(waiter, osOK);
+            UpdateInheritedPriority(waiter);
+        }
+        if (previous != NULL)
+        {
+            UpdateInheritedPriority(previous);
+        }
+        Reschedule();
+    }
+
+    osPortExitCritical(state);
+    return osOK;
+}
+
+osThreadId_t osMutexGetOwner(osMutexId_t mutex_id)
+{
+    return IsValidMutex(mutex_id) ? mutex_id->owner : NULL;
+}
+
+osStatus_t osMutexDelete(osMutexId_t mutex_id)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+    if (!IsValidMutex(mutex_id))
+    {
+        return osErrorParameter;
+    }
+
+    uint32_t           state = osPortEnterCritical();
+    struct osThread_s* waiter;
+    while ((waiter = HighestWaiter(mutex_id)) != NULL)
+    {
+        Wake(waiter, osErrorResource);
+    }
+    if (mutex_id->owner != NULL)
+    {
+        struct osThread_s* owner = mutex_id->owner;
+        mutex_id->owner          = NULL;
+        UpdateInheritedPriority(owner);
+    }
+    mutex_id->used = false;
+    Reschedule();
+    osPortExitCritical(state);
+    return osOK;
+}
+
+/*****************************************************************************/
+/* Semaphores */
+osSemaphoreId_t osSemaphoreNew(uint32_t                 max_count,
+                               uint32_t                 initial_count,
+                               const osSemaphoreAttr_t* attr)
+{
+    if (osPortIsInIsr() || max_count == 0 || initial_count > max_count)
+    {
+        return NULL;
+    }
+
+    uint32_t              state = osPortEnterCritical();
+    struct osSemaphore_s* sem   = NULL;
+    for (size_t i = 0; i < OS_MAX_SEMAPHORES; i++)
+    {
+        if (!s_semaphores[i].used)
+        {
+            sem           = &s_semaphores[i];
+            sem->used     = true;
+            sem->name     = attr != NULL ? attr->name : NULL;
+            sem->count    = initial_count;
+            sem->maxCount = max_count;
+            break;
+        }
+    }
+    osPortExitCritical(state);
+    return sem;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    if (!IsValidSemaphore(semaphore_id))
+    {
+        return osErrorParameter;
+    }
+    if (osPortIsInIsr() && timeout != 0)
+    {
+        return osErrorParameter;
+    }
+
+    uint32_t state = osPortEnterCritical();
+    if (semaphore_id->count > 0)
+    {
+        semaphore_id->count--;
+        osPortExitCritical(state);
+        return osOK;
+    }
+    if (timeout == 0 || s_state != osKernelRunning)
+    {
+        osPortExitCritical(state);
+        return timeout == 0 ? osErrorResource : osError;
+    }
+
+    struct osThread_s* self = g_osCurrent;
+    Block(semaphore_id, timeout);
+    osPortExitCritical(state);
+
+    // The token was handed over by osSemaphoreRelease if the result is osOK.
+    return self->waitResult;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
+{
+    if (!IsValidSemaphore(semaphore_id))
+    {
+        return osErrorParameter;
+    }
+
+    osStatus_t         status = osOK;
+    uint32_t           state  = osPortEnterCritical();
+    struct osThread_s* waiter = HighestWaiter(semaphore_id);
+    if (waiter != NULL)
+    {
+        Wake(waiter, osOK);
+        Reschedule();
+    }
+    else if (semaphore_id->count < semaphore_id->maxCount)
+    {
+        semaphore_id->count++;
+    }
+    else
+    {
+        status = osErrorResource;
+    }
+    osPortExitCritical(state);
+    return status;
+}
+
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id)
+{
+    return IsValidSemaphore(semaphore_id) ? semaphore_id->count : 0;
+}
+
+osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id)
+{
+    if (osPortIsInIsr())
+    {
+        return osErrorISR;
+    }
+    if (!IsValidSemaphore(semaphore_id))
+    {
+        return osErrorParameter;
+    }
+
+    uint32_t           state = osPortEnterCritical();
+    struct osThread_s* waiter;
+    while ((waiter = HighestWaiter(semaphore_id)) != NULL)
+    {
+        Wake(waiter, osErrorResource);
+    }
+    semaphore_id->used = false;
+    Reschedule();
+    osPortExitCritical(state);
+    return osOK;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
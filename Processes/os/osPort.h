@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    osPort.h
+ * @brief   Interface between the kernel and its architecture ports.
+ *
+ * Two ports exist:
+ *  - osPortCm4.c: Cortex-M4 (soft-float), PendSV context switching driven by SysTick.
+ *  - osPortPosix.c: Host simulation, one pthread per thread with a single "CPU" token so that
+ *                   only one thread runs at a time, exactly like on target.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_OS_OSPORT_H
+#    define NILAIINI_OS_OSPORT_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Processes/os/cmsis_os.h"
+
+#    include <stdbool.h>
+#    include <stdint.h>
+
+#    ifdef __cplusplus
+extern "C" {
+#    endif
+
+/*****************************************************************************/
+/* Exported types */
+typedef enum
+{
+    osThreadStateUnused = 0,
+    osThreadStateReady,
+    osThreadStateBlocked,
+    osThreadStateTerminated,
+} osThreadState_t;
+
+struct osThread_s
+{
+    //! Saved stack pointer. Must stay the first member, the Cm4 port accesses it from assembly.
+    uint32_t* sp;
+
+    osThreadFunc_t  func;
+    void*           argument;
+    const char*     name;
+    uint32_t*       stackBase;
+    uint32_t        stackSize;
+    uint8_t         basePriority;    //!< Priority as requested by the user.
+    uint8_t         priority;        //!< Effective priority, raised by priority inheritance.
+    osThreadState_t state;
+    void*           waitObject;    //!< Mutex or semaphore the thread is blocked on, if any.
+    uint32_t        wakeTick;      //!< Tick at which a blocked thread times out.
+    bool            hasTimeout;
+    osStatus_t      waitResult;
+    void*           portData;    //!< Port-specific data (pthread, condition variable, ...).
+};
+
+/*****************************************************************************/
+/* Exported variables */
+//! Thread currently running and thread selected to run next. Owned by the kernel.
+extern struct osThread_s* volatile g_osCurrent;
+extern struct osThread_s* volatile g_osNext;
+
+/*****************************************************************************/
+/* Exported functions */
+// Implemented by the port.
+uint32_t osPortEnterCritical(void);
+void     osPortExitCritical(uint32_t state);
+bool     osPortIsInIsr(void);
+void     osPortInitThread(struct osThread_s* thread, void (*exitFunc)(void));
+void     osPortRequestSwitch(void);
+//! Called from within a critical section, never returns.
+void     osPortStartFirstThread(void);
+void     osPortIdle(void);
+
+// Implemented by the kernel, called by the port.
+void osKernelSelectNext(void);
+
+#    ifdef __cplusplus
+}
+#    endif
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_OS_OSPORT_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
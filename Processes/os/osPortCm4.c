@@ -0,0 +1,145 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    osPortCm4.c
+ * @brief   Cortex-M4 port of the kernel.
+ *
+ * Threads run in thread mode on the process stack (PSP), interrupts keep using the main stack.
+ * Context switches happen in PendSV, which runs at the lowest priority so that it never
+ * preempts another interrupt. Only r4-r11 are saved by software, the FPU is not enabled in this
+ * project so there is no floating point context to preserve.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#if defined(__ARM_ARCH_7EM__)
+#    include "main.h"
+#    include "Processes/os/osPort.h"
+
+#    if defined(__VFP_FP__) && !defined(__SOFTFP__)
+#        error "The Cortex-M4 port does not save the FPU context."
+#    endif
+
+/*****************************************************************************/
+/* Private functions */
+static void StartFirstThread(void) __attribute__((naked, noreturn));
+static void StartFirstThread(void)
+{
+    __asm volatile("    ldr     r0, =g_osCurrent    \n"
+                   "    ldr     r0, [r0]            \n"
+                   "    ldr     r1, [r0]            \n" /* Saved stack pointer.              */
+                   "    adds    r1, r1, #32         \n" /* Skip r4-r11.                      */
+                   "    ldr     r0, [r1, #0]        \n" /* r0: argument.                     */
+                   "    ldr     r3, [r1, #20]       \n" /* lr: exit function.                */
+                   "    ldr     r2, [r1, #24]       \n" /* pc: entry point.                  */
+                   "    adds    r1, r1, #32         \n" /* Discard the exception frame.      */
+                   "    msr     psp, r1             \n"
+                   "    movs    r1, #2              \n" /* Thread mode uses PSP.             */
+                   "    msr     control, r1         \n"
+                   "    isb                         \n"
+                   "    orr     r2, r2, #1          \n" /* Thumb bit.                        */
+                   "    mov     lr, r3              \n"
+                   "    cpsie   i                   \n"
+                   "    bx      r2                  \n"
+                   "    .ltorg                      \n");
+}
+
+/*****************************************************************************/
+/* Port interface */
+uint32_t osPortEnterCritical(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+void osPortExitCritical(uint32_t state)
+{
+    // A pending PendSV is taken as soon as interrupts are re-enabled.
+    __set_PRIMASK(state);
+}
+
+bool osPortIsInIsr(void)
+{
+    return __get_IPSR() != 0;
+}
+
+void osPortInitThread(struct osThread_s* thread, void (*exitFunc)(void))
+{
+    uint32_t* sp = thread->stackBase + (thread->stackSize / sizeof(uint32_t));
+
+    // Exception frame, popped by the hardware on exception return.
+    *--sp = 0x01000000U;                           // xPSR, Thumb state.
+    *--sp = (uint32_t)thread->func & ~1U;          // PC.
+    *--sp = (uint32_t)exitFunc;                    // LR, in case the thread returns.
+    *--sp = 0;                                     // R12.
+    *--sp = 0;                                     // R3.
+    *--sp = 0;                                     // R2.
+    *--sp = 0;                                     // R1.
+    *--sp = (uint32_t)(uintptr_t)thread->argument;    // R0.
+
+    // R11-R4, restored by PendSV.
+    for (int i = 0; i < 8; i++)
+    {
+        *--sp = 0;
+    }
+
+    thread->sp = sp;
+}
+
+void osPortRequestSwitch(void)
+{
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    __DSB();
+}
+
+void osPortStartFirstThread(void)
+{
+    // PendSV must never preempt another interrupt.
+    NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+    StartFirstThread();
+}
+
+void osPortIdle(void)
+{
+    __WFI();
+}
+
+/*****************************************************************************/
+/* Exception handlers */
+#    if APP_USE_RTOS
+/**
+ * @brief Saves the context of g_osCurrent and restores the one of g_osNext.
+ * @note Replaces the empty handler from stm32f4xx_it.c when APP_USE_RTOS is set.
+ */
+void PendSV_Handler(void) __attribute__((naked));
+void PendSV_Handler(void)
+{
+    __asm volatile("    mrs     r0, psp             \n"
+                   "    isb                         \n"
+                   "    ldr     r3, =g_osCurrent    \n"
+                   "    ldr     r2, [r3]            \n"
+                   "    stmdb   r0!, {r4-r11}       \n"
+                   "    str     r0, [r2]            \n" /* g_osCurrent->sp = psp             */
+                   "    cpsid   i                   \n"
+                   "    ldr     r1, =g_osNext       \n"
+                   "    ldr     r1, [r1]            \n"
+                   "    str     r1, [r3]            \n" /* g_osCurrent = g_osNext            */
+                   "    cpsie   i                   \n"
+                   "    ldr     r0, [r1]            \n"
+                   "    ldmia   r0!, {r4-r11}       \n"
+                   "    msr     psp, r0             \n"
+                   "    isb                         \n"
+                   "    bx      lr                  \n"
+                   "    .ltorg                      \n");
+}
+#    endif
+
+#endif
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,198 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    osPortPosix.c
+ * @brief   POSIX (Linux) simulation port of the kernel.
+ *
+ * Every thread is backed by a pthread, but only the thread holding the "CPU" runs: the others
+ * wait on their own condition variable. Handing the CPU over is therefore equivalent to a
+ * context switch on target, and the scheduling decisions are made by the exact same kernel
+ * code.
+ *
+ * The tick is generated by a separate pthread that plays the role of the SysTick interrupt.
+ * Since a running pthread can't be interrupted, preemption takes effect at the next kernel
+ * call made by the running thread (leaving any critical section is a preemption point).
+ * Modules' Run() functions are short and return to the kernel between calls, so this is
+ * enough to observe priorities, time slicing and wake-up latency, bench/kernelTest.cpp does.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#if defined(__unix__) || defined(__APPLE__)
+#    include "Processes/os/osPort.h"
+
+#    include <pthread.h>
+#    include <stdlib.h>
+#    include <time.h>
+#    include <unistd.h>
+
+/*****************************************************************************/
+/* Private types */
+typedef struct
+{
+    pthread_t      handle;
+    pthread_cond_t cond;
+    bool           running;
+} PosixThread;
+
+/*****************************************************************************/
+/* Private variables */
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t       s_tickThread;
+
+static __thread uint32_t t_criticalDepth = 0;
+static __thread bool     t_isIsr         = false;
+
+/*****************************************************************************/
+/* Private functions */
+static void WaitForCpu(PosixThread* thread)
+{
+    while (!thread->running)
+    {
+        pthread_cond_wait(&thread->cond, &s_lock);
+    }
+}
+
+/**
+ * @brief Hands the CPU from g_osCurrent to g_osNext and waits to get it back.
+ * @note Must be called with s_lock held.
+ */
+static void Switch(void)
+{
+    struct osThread_s* previous = g_osCurrent;
+    struct osThread_s* next     = g_osNext;
+    g_osCurrent                 = next;
+
+    PosixThread* p = (PosixThread*)previous->portData;
+    PosixThread* n = (PosixThread*)next->portData;
+    p->running     = false;
+    n->running     = true;
+    pthread_cond_signal(&n->cond);
+
+    WaitForCpu(p);
+}
+
+static void* ThreadEntry(void* arg)
+{
+    struct osThread_s* thread = (struct osThread_s*)arg;
+
+    pthread_mutex_lock(&s_lock);
+    WaitForCpu((PosixThread*)thread->portData);
+    pthread_mutex_unlock(&s_lock);
+
+    thread->func(thread->argument);
+    osThreadExit();
+    return NULL;
+}
+
+static void* TickEntry(void* arg)
+{
+    (void)arg;
+    t_isIsr = true;
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (;;)
+    {
+        next.tv_nsec += 1000000000L / OS_TICK_FREQ;
+        if (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        osSysTickHandler();
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* Port interface */
+uint32_t osPortEnterCritical(void)
+{
+    if (t_criticalDepth++ == 0)
+    {
+        pthread_mutex_lock(&s_lock);
+    }
+    return 0;
+}
+
+void osPortExitCritical(uint32_t state)
+{
+    (void)state;
+    if (--t_criticalDepth != 0)
+    {
+        return;
+    }
+
+    // Leaving the outermost critical section is where a pending switch takes effect, just like
+    // a pending PendSV on target. The tick thread is an interrupt, it never switches itself.
+    if (!t_isIsr && g_osCurrent != NULL && g_osNext != NULL && g_osNext != g_osCurrent &&
+        osKernelGetState() == osKernelRunning)
+    {
+        Switch();
+    }
+    pthread_mutex_unlock(&s_lock);
+}
+
+bool osPortIsInIsr(void)
+{
+    return t_isIsr;
+}
+
+void osPortInitThread(struct osThread_s* thread, void (*exitFunc)(void))
+{
+    (void)exitFunc;
+
+    PosixThread* p = (PosixThread*)calloc(1, sizeof(PosixThread));
+    if (p == NULL)
+    {
+        abort();
+    }
+    pthread_cond_init(&p->cond, NULL);
+    thread->portData = p;
+
+    // The pthread's own stack is used, the one given to the kernel only holds the paint.
+    if (pthread_create(&p->handle, NULL, ThreadEntry, thread) != 0)
+    {
+        abort();
+    }
+}
+
+void osPortRequestSwitch(void)
+{
+    // Nothing to do, the switch happens in osPortExitCritical.
+}
+
+void osPortStartFirstThread(void)
+{
+    PosixThread* first = (PosixThread*)g_osCurrent->portData;
+    first->running     = true;
+    pthread_cond_signal(&first->cond);
+
+    pthread_create(&s_tickThread, NULL, TickEntry, NULL);
+
+    // The calling thread is not a kernel thread, it simply stops here.
+    t_criticalDepth = 0;
+    pthread_mutex_unlock(&s_lock);
+    for (;;)
+    {
+        pause();
+    }
+}
+
+void osPortIdle(void)
+{
+    usleep(100);
+    // Preemption point for threads woken up by the tick.
+    osPortExitCritical(osPortEnterCritical());
+}
+
+#endif
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,176 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    threadedApplication.cpp
+ * @brief   Source for the ThreadedApplication.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "threadedApplication.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+
+#include "Processes/drivers/ccmRam.h"
+#include "Processes/services/log.h"
+#include "Processes/services/memStats.h"
+
+/*****************************************************************************/
+/* Private types */
+namespace
+{
+struct GroupConfig
+{
+    const char*  name;
+    osPriority_t priority;
+    uint32_t     period;       //!< Maximum time between two passes, in ticks.
+    size_t       stackSize;    //!< In bytes.
+};
+
+constexpr std::array<GroupConfig, static_cast<size_t>(ModulePriority::Count)> s_groupConfigs = {{
+  {"audio", osPriorityRealtime, 1, 2048},
+  {"storage", osPriorityHigh, 2, 4096},
+  {"logging", osPriorityBelowNormal, 5, 1024},
+  {"background", osPriorityLow, 10, 2048},
+}};
+
+// Statically allocated so that the stack usage shows up in the memory usage report. In the CCM,
+// the kernel paints them when it creates the threads: no DMA buffer may live on these stacks.
+CCM_NOINIT alignas(8) uint8_t s_audioStack[s_groupConfigs[0].stackSize];
+CCM_NOINIT alignas(8) uint8_t s_storageStack[s_groupConfigs[1].stackSize];
+CCM_NOINIT alignas(8) uint8_t s_loggingStack[s_groupConfigs[2].stackSize];
+CCM_NOINIT alignas(8) uint8_t s_backgroundStack[s_groupConfigs[3].stackSize];
+
+constexpr std::array<uint8_t*, static_cast<size_t>(ModulePriority::Count)> s_stacks = {
+  s_audioStack,
+  s_storageStack,
+  s_loggingStack,
+  s_backgroundStack,
+};
+}    // namespace
+
+ThreadedApplication* ThreadedApplication::s_threadedInstance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+ThreadedApplication::ThreadedApplication()
+{
+    CEP_ASSERT(s_threadedInstance == nullptr, "Cannot have multiple instances of Application!");
+    s_threadedInstance = this;
+
+    // The kernel objects (FatFs' mutex among others) are created during Init, before Run.
+    osKernelInitialize();
+}
+
+[[noreturn]] void ThreadedApplication::Run()
+{
+    for (size_t i = 0; i < m_groups.size(); i++)
+    {
+        Group& group = m_groups[i];
+        if (group.modules.empty())
+        {
+            continue;
+        }
+
+        osSemaphoreAttr_t semAttr = {};
+        semAttr.name              = s_groupConfigs[i].name;
+        group.wake                = osSemaphoreNew(1, 0, &semAttr);
+
+        osThreadAttr_t attr = {};
+        attr.name           = s_groupConfigs[i].name;
+        attr.priority       = s_groupConfigs[i].priority;
+        attr.stack_mem      = s_stacks[i];
+        attr.stack_size     = s_groupConfigs[i].stackSize;
+        group.thread        = osThreadNew(&GroupThread, &group, &attr);
+        CEP_ASSERT(group.wake != nullptr && group.thread != nullptr,
+                   "Unable to create module thread!");
+    }
+
+    osKernelStart();
+
+    // osKernelStart never returns once the kernel is running.
+    while (true)
+    {
+    }
+}
+
+void ThreadedApplication::Notify(ModulePriority group)
+{
+    if (s_threadedInstance == nullptr || group >= ModulePriority::Count)
+    {
+        return;
+    }
+
+    osSemaphoreId_t wake = s_threadedInstance->m_groups[static_cast<size_t>(group)].wake;
+    if (wake != nullptr)
+    {
+        // Returns osErrorResource when already notified, which is fine.
+        osSemaphoreRelease(wake);
+    }
+}
+
+void ThreadedApplication::LogStackUsage()
+{
+    if (s_threadedInstance == nullptr)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < s_threadedInstance->m_groups.size(); i++)
+    {
+        osThreadId_t thread = s_threadedInstance->m_groups[i].thread;
+        if (thread != nullptr)
+        {
+            auto size = static_cast<uint32_t>(s_groupConfigs[i].stackSize);
+            LOG_INFO("Thread {}: {} B used of {} B.",
+                     s_groupConfigs[i].name,
+                     size - osThreadGetStackSpace(thread),
+                     size);
+        }
+    }
+}
+
+/*****************************************************************************/
+/* Protected Method Definitions                                              */
+/*****************************************************************************/
+void ThreadedApplication::AssignModule(cep::Module*    module,
+                                       ModulePriority  priority,
+                                       Profiler::Zone* runZone,
+                                       uint8_t         owner)
+{
+    CEP_ASSERT(priority < ModulePriority::Count, "Invalid module priority!");
+    m_groups[static_cast<size_t>(priority)].modules.push_back({module, runZone, owner});
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+[[noreturn]] void ThreadedApplication::GroupThread(void* arg)
+{
+    Group&             group  = *static_cast<Group*>(arg);
+    const GroupConfig& config = s_groupConfigs[&group - &s_threadedInstance->m_groups[0]];
+
+    while (true)
+    {
+        for (const Slot& slot : group.modules)
+        {
+            MemStats::OwnerScope owner(slot.owner);
+            Profiler::Ticks      start = Profiler::Now();
+            slot.module->Run();
+            if (slot.runZone != nullptr)
+            {
+                slot.runZone->Record(Profiler::Now() - start);
+            }
+        }
+
+        osSemaphoreAcquire(group.wake, config.period);
+    }
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
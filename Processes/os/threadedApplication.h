@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @addtogroup os
+ * @{
+ * @file    threadedApplication.h
+ * @brief   Application that runs its modules in prioritized threads instead of a super-loop.
+ *
+ * Modules are assigned to a priority group when they are added. Each group that has at least
+ * one module gets its own thread, which calls the Run() function of its modules in turn and
+ * then sleeps until its period elapses or until it is notified (from a DMA interrupt, for
+ * example).
+ *
+ * Groups, from highest to lowest priority:
+ *  - Audio:      Refilling of the audio buffers. Must never wait behind the SD card.
+ *  - Storage:    Everything that touches FatFs.
+ *  - Logging:    Draining of the log sinks.
+ *  - Background: Everything else (heartbeat, ...).
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_OS_THREADEDAPPLICATION_H
+#    define NILAIINI_OS_THREADEDAPPLICATION_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+#    include "NilaiTFO/processes/application.hpp"
+
+#    include "Processes/os/cmsis_os.h"
+#    include "Processes/services/profiler.h"
+
+#    include <array>
+#    include <cstddef>
+#    include <vector>
+
+/*****************************************************************************/
+/* Exported types */
+enum class ModulePriority : size_t
+{
+    Audio = 0,
+    Storage,
+    Logging,
+    Background,
+    Count,
+};
+
+class ThreadedApplication : public cep::Application
+{
+public:
+    ThreadedApplication();
+    ~ThreadedApplication() override = default;
+
+    /**
+     * @brief Creates the threads of every group that has modules and starts the kernel.
+     */
+    [[noreturn]] void Run() override;
+
+    /**
+     * @brief Wakes the thread of a group without waiting for the end of its period.
+     * @note Can be called from an interrupt.
+     */
+    static void Notify(ModulePriority group);
+
+    /**
+     * @brief Logs how much of its stack each thread used so far. Nothing before Run().
+     */
+    static void LogStackUsage();
+
+protected:
+    /**
+     * @param runZone Times the module's Run(), can be null.
+     * @param owner   Of the allocations made in the module's Run(), see MemStats.
+     */
+    void AssignModule(cep::Module*    module,
+                      ModulePriority  priority,
+                      Profiler::Zone* runZone,
+                      uint8_t         owner);
+
+private:
+    struct Slot
+    {
+        cep::Module*    module  = nullptr;
+        Profiler::Zone* runZone = nullptr;
+        uint8_t         owner   = 0;
+    };
+
+    struct Group
+    {
+        std::vector<Slot> modules;
+        osThreadId_t              thread = nullptr;
+        osSemaphoreId_t           wake   = nullptr;
+    };
+
+    std::array<Group, static_cast<size_t>(ModulePriority::Count)> m_groups;
+
+private:
+    static ThreadedApplication* s_threadedInstance;
+
+private:
+    [[noreturn]] static void GroupThread(void* arg);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_OS_THREADEDAPPLICATION_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
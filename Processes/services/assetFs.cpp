@@ -0,0 +1,238 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    assetFs.cpp
+ * @brief   Source for the AssetFs.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "assetFs.h"
+
+#include "Core/Inc/main.h"
+
+#include "Processes/services/crc32.h"
+#include "Processes/services/deferredInit.h"
+#include "Processes/services/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C"
+{
+    // Defined by the linker script.
+    extern const uint8_t _sassets;
+    extern uint8_t       _Assets_Size;
+}
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+const uint8_t*        s_bundle  = nullptr;    //!< Null when nothing is mounted.
+AssetFs::Header       s_header  = {};
+const AssetFs::Entry* s_entries = nullptr;
+
+char ToUpper(char c)
+{
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+bool EqualsNoCase(const char* name, std::string_view path)
+{
+    for (char c : path)
+    {
+        if (*name == '\0' || ToUpper(*name) != ToUpper(c))
+        {
+            return false;
+        }
+        name++;
+    }
+    return *name == '\0';
+}
+
+std::string_view Normalize(std::string_view path)
+{
+    while (!path.empty() && path.front() == '/')
+    {
+        path.remove_prefix(1);
+    }
+    return path;
+}
+
+/**
+ * @brief Checks what Find and GetPath rely on: every path and every file within the bundle,
+ *        the entries sorted by their hash.
+ */
+bool CheckIndex(const uint8_t* bundle, const AssetFs::Header& header)
+{
+    const size_t indexEnd = sizeof(AssetFs::Header) + header.count * sizeof(AssetFs::Entry);
+    if (header.dataOffset < indexEnd || header.dataOffset > header.size ||
+        Crc32::Compute(&bundle[sizeof(AssetFs::Header)],
+                       header.dataOffset - sizeof(AssetFs::Header)) != header.indexCrc)
+    {
+        return false;
+    }
+
+    const auto* entries  = reinterpret_cast<const AssetFs::Entry*>(&bundle[sizeof(header)]);
+    uint32_t    prevHash = 0;
+    for (size_t i = 0; i < header.count; i++)
+    {
+        const AssetFs::Entry& entry = entries[i];
+        if (entry.name < indexEnd || entry.name >= header.dataOffset ||
+            std::memchr(&bundle[entry.name], '\0', header.dataOffset - entry.name) == nullptr ||
+            entry.offset < header.dataOffset || entry.offset > header.size ||
+            entry.size > header.size - entry.offset || entry.hash < prevHash ||
+            entry.hash != AssetFs::Hash(reinterpret_cast<const char*>(&bundle[entry.name])))
+        {
+            return false;
+        }
+        prevHash = entry.hash;
+    }
+    return true;
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace AssetFs
+{
+bool Mount()
+{
+    return Mount(&_sassets, reinterpret_cast<uintptr_t>(&_Assets_Size));
+}
+
+bool Mount(const void* bundle, size_t size)
+{
+    s_bundle  = nullptr;
+    s_entries = nullptr;
+
+    Header header = {};
+    if (bundle == nullptr || size < sizeof(header))
+    {
+        return false;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(bundle);
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.size > size ||
+        header.size < sizeof(header) || !CheckIndex(bytes, header))
+    {
+        return false;
+    }
+
+    s_header  = header;
+    s_entries = reinterpret_cast<const Entry*>(&bytes[sizeof(header)]);
+    s_bundle  = bytes;
+    return true;
+}
+
+bool IsMounted()
+{
+    return s_bundle != nullptr;
+}
+
+Asset Find(std::string_view path)
+{
+    if (s_bundle == nullptr)
+    {
+        return {};
+    }
+    path          = Normalize(path);
+    uint32_t hash = Hash(path);
+
+    const Entry* end   = &s_entries[s_header.count];
+    const Entry* entry = std::lower_bound(
+      s_entries, end, hash, [](const Entry& e, uint32_t h) { return e.hash < h; });
+    for (; entry != end && entry->hash == hash; entry++)
+    {
+        if (EqualsNoCase(reinterpret_cast<const char*>(&s_bundle[entry->name]), path))
+        {
+            return {&s_bundle[entry->offset], entry->size, entry->crc};
+        }
+    }
+    return {};
+}
+
+size_t GetCount()
+{
+    return s_bundle != nullptr ? s_header.count : 0;
+}
+
+const char* GetPath(size_t index)
+{
+    if (index >= GetCount())
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const char*>(&s_bundle[s_entries[index].name]);
+}
+
+bool Verify()
+{
+    if (s_bundle == nullptr)
+    {
+        return false;
+    }
+    return Crc32::Compute(&s_bundle[s_header.dataOffset], s_header.size - s_header.dataOffset) ==
+           s_header.dataCrc;
+}
+
+bool Verify(const Asset& asset)
+{
+    return asset.data != nullptr && Crc32::Compute(asset.data, asset.size) == asset.crc;
+}
+
+uint32_t Hash(std::string_view path)
+{
+    uint32_t hash = 2166136261u;
+    for (char c : path)
+    {
+        hash ^= static_cast<uint8_t>(ToUpper(c));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool DoPost()
+{
+    if (s_bundle == nullptr)
+    {
+        uint32_t magic = 0;
+        std::memcpy(&magic, &_sassets, sizeof(magic));
+        if (magic == MAGIC)
+        {
+            LOG_ERROR("The index of the asset bundle is corrupted!");
+            return false;
+        }
+        LOG_INFO("No asset bundle in DATA_FLASH.");
+        return true;
+    }
+
+    LOG_INFO("Assets: {} files, {} B.", s_header.count, s_header.size);
+#if APP_FAST_BOOT
+    // The whole bundle goes through the CRC, a corrupted one is only logged.
+    DeferredInit::Defer("assetFs", [] {
+        if (!Verify())
+        {
+            LOG_ERROR("The data of the asset bundle is corrupted!");
+        }
+    });
+    return true;
+#else
+    if (!Verify())
+    {
+        LOG_ERROR("The data of the asset bundle is corrupted!");
+        return false;
+    }
+    return true;
+#endif
+}
+}    // namespace AssetFs
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
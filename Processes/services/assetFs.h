@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    assetFs.h
+ * @brief   Read-only files from an asset bundle in the internal flash, read in place.
+ *
+ * The bundle is built by tools/assetpack.py and flashed in the second bank of DATA_FLASH
+ * (_sassets in the linker script), apart from the firmware:
+ *      tools/assetpack.py assets/ build/assets.bin
+ *      openocd ... -c "program build/assets.bin 0x08100000 verify reset exit"
+ * The boot sounds and the default configuration are then read without the SD card, and without
+ * copying them: Find() gives the file's bytes in the flash.
+ *
+ * Layout, little-endian:
+ * | Header | Entry[count] | names, null-terminated | data, each file aligned on ALIGN |
+ * The entries are sorted by the hash of their path (FNV-1a, ASCII uppercased), then by path: a
+ * lookup is a binary search. Paths are the same as on the SD card, without leading '/', and are
+ * compared regardless of the case, as FatFs does.
+ *
+ * Mount() only checks the header and the index, Verify() checks the CRC of the data, in the POST.
+ * Each entry also has the CRC of its file: a file used before the POST, as the boot sound is, is
+ * checked on its own with Verify(asset).
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_ASSETFS_H
+#    define NILAIINI_SERVICES_ASSETFS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+#    include <string_view>
+
+/*****************************************************************************/
+/* Exported types */
+namespace AssetFs
+{
+static constexpr uint32_t MAGIC   = 0x3142414E;    //!< "NAB1".
+static constexpr uint16_t VERSION = 2;
+static constexpr size_t   ALIGN   = 4;
+
+struct Header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;         //!< Entries.
+    uint32_t size;          //!< Of the whole bundle.
+    uint32_t dataOffset;    //!< Where the names end and the data begins.
+    uint32_t indexCrc;      //!< CRC-32 of the entries and the names.
+    uint32_t dataCrc;       //!< CRC-32 of the data.
+};
+static_assert(sizeof(Header) == 24, "The header is shared with tools/assetpack.py");
+
+struct Entry
+{
+    uint32_t hash;
+    uint32_t name;      //!< Offset of the path in the bundle.
+    uint32_t offset;    //!< Offset of the data in the bundle.
+    uint32_t size;
+    uint32_t crc;       //!< CRC-32 of the data.
+};
+static_assert(sizeof(Entry) == 20, "The entries are shared with tools/assetpack.py");
+
+struct Asset
+{
+    const uint8_t* data = nullptr;    //!< In the flash, valid as long as the bundle is mounted.
+    size_t         size = 0;
+    uint32_t       crc  = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+/**
+ * @brief Mounts the bundle flashed in DATA_FLASH.
+ * @returns False if there is none, or if its index is corrupted.
+ */
+bool Mount();
+
+/**
+ * @brief Mounts the bundle at @p bundle, of at most @p size bytes.
+ */
+bool Mount(const void* bundle, size_t size);
+
+[[nodiscard]] bool IsMounted();
+
+/**
+ * @returns The file at @p path, empty if there is no such file.
+ */
+[[nodiscard]] Asset Find(std::string_view path);
+
+[[nodiscard]] size_t GetCount();
+
+/**
+ * @returns The path of the file at @p index, in the order of the index, null past the last one.
+ */
+[[nodiscard]] const char* GetPath(size_t index);
+
+/**
+ * @returns True if the data matches its CRC.
+ */
+[[nodiscard]] bool Verify();
+
+/**
+ * @returns True if the data of @p asset matches its CRC, false for an empty asset.
+ */
+[[nodiscard]] bool Verify(const Asset& asset);
+
+/**
+ * @brief The hash of the index: 32-bit FNV-1a of the path, uppercased.
+ */
+[[nodiscard]] uint32_t Hash(std::string_view path);
+
+/**
+ * @brief Logs the bundle and verifies it.
+ * @returns False if a bundle is there but corrupted, a missing bundle isn't an error.
+ */
+bool DoPost();
+}    // namespace AssetFs
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_ASSETFS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,901 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    audioEngine.cpp
+ * @brief   Source for the AudioEngine.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "audioEngine.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+#include "NilaiTFO/services/filesystem.h"
+
+#include "Processes/drivers/ccmRam.h"
+#include "Processes/drivers/criticalSection.h"
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/log.h"
+#include "Processes/services/profiler.h"
+#include "Processes/services/wav.h"
+
+#if APP_USE_RTOS
+#    include "Processes/os/threadedApplication.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint8_t SILENT_PERIODS = 2;    //!< Both buffers, the last samples are then out.
+
+static_assert(AudioEngine::PERIOD_SAMPLES <= UINT16_MAX, "A period must fit in the DMA's counter");
+
+uint32_t Address(const volatile void* ptr)
+{
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ptr));
+}
+
+//! A frame of 4096 samples of 16-bit stereo, verbatim with a 17-bit side channel, is 16.9 KiB.
+constexpr size_t FLAC_BUFFER = 18 * 1024;
+
+//! What the FileSource read, a block or frames. Only the CPU reads the SD card, it can be in CCM.
+CCM_BSS uint8_t s_fileBuffer[std::max(Qoa::MaxFrameSize(Qoa::MAX_CHANNELS), FLAC_BUFFER)];
+
+//! The FileSource's, too big for the AudioEngine.
+CCM_BSS Flac::Decoder s_flac;
+
+constexpr size_t BENCH_CHUNK = 64;    //!< Frames read at once by TimeFlacFrame().
+
+/**
+ * @brief Writes the file of AudioEngine::TimeFlacFrame(), unless it's already there. The frame
+ *        is built in s_fileBuffer.
+ * @returns The size of a frame, 0 if the file can't be written.
+ */
+size_t WriteFlacBenchFile()
+{
+    Flac::StreamInfo info;
+    size_t           frameSize = Flac::WriteBenchFrame(s_fileBuffer, sizeof(s_fileBuffer), info);
+    info.totalSamples          = Flac::MAX_BLOCK_SIZE * AudioEngine::FLAC_BENCH_FRAMES;
+    uint8_t header[Flac::STREAMINFO_END];
+    if (frameSize == 0 || Flac::WriteStreamInfo(header, sizeof(header), info) == 0)
+    {
+        return 0;
+    }
+
+    FILINFO existing;
+    FSIZE_t size = sizeof(header) + FSIZE_t(frameSize) * AudioEngine::FLAC_BENCH_FRAMES;
+    if (f_stat(AudioEngine::FLAC_BENCH_FILE, &existing) == FR_OK && existing.fsize == size)
+    {
+        return frameSize;
+    }
+
+    FIL  file;
+    UINT written = 0;
+    if (f_open(&file, AudioEngine::FLAC_BENCH_FILE, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    {
+        return 0;
+    }
+    bool ok = f_write(&file, header, sizeof(header), &written) == FR_OK &&
+              written == sizeof(header);
+    for (size_t i = 0; ok && i < AudioEngine::FLAC_BENCH_FRAMES; i++)
+    {
+        ok = f_write(&file, s_fileBuffer, frameSize, &written) == FR_OK && written == frameSize;
+    }
+    ok = f_close(&file) == FR_OK && ok;
+    return ok ? frameSize : 0;
+}
+}    // namespace
+
+AudioEngine* AudioEngine::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+AudioEngine::AudioEngine(I2S_HandleTypeDef* i2s, DMA_HandleTypeDef* dma, const std::string& label)
+: m_label(label), m_i2s(i2s), m_dma(dma)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of AudioEngine!");
+    CEP_ASSERT(i2s != nullptr && dma != nullptr, "Invalid I2S or DMA handle!");
+    CEP_ASSERT(i2s->Init.DataFormat == I2S_DATAFORMAT_16B && i2s->Init.AudioFreq == SAMPLE_RATE,
+               "The I2S must be 16-bit at SAMPLE_RATE!");
+    CEP_ASSERT(dma->Init.MemDataAlignment == DMA_MDATAALIGN_HALFWORD,
+               "The I2S DMA must move half-words!");
+    CEP_ASSERT(CcmRam::IsDmaCapable(m_buffers, sizeof(m_buffers)),
+               "The audio buffers can't be in the CCM!");
+    s_instance = this;
+
+    // In double-buffer mode, the HAL calls one per buffer.
+    m_dma->XferCpltCallback       = &M0CompleteCallback;
+    m_dma->XferM1CpltCallback     = &M1CompleteCallback;
+    m_dma->XferErrorCallback      = &ErrorCallback;
+    m_dma->XferHalfCpltCallback   = nullptr;
+    m_dma->XferM1HalfCpltCallback = nullptr;
+}
+
+bool AudioEngine::DoPost()
+{
+    return HAL_I2S_GetState(m_i2s) == HAL_I2S_STATE_READY &&
+           HAL_DMA_GetState(m_dma) == HAL_DMA_STATE_READY;
+}
+
+void AudioEngine::Run()
+{
+    if (m_state == State::Stopping)
+    {
+        StopDma();
+        return;
+    }
+    if (m_state != State::Streaming || m_pending == 0)
+    {
+        return;
+    }
+
+#if APP_AUDIO_DRIFT_COMPENSATION
+    UpdateDrift();
+#endif
+    uint8_t pending = m_pending;
+    for (size_t period = 0; period < 2; period++)
+    {
+        if ((pending & (1U << period)) != 0)
+        {
+            Fill(period);
+        }
+    }
+    CriticalSection lock;
+    m_pending = m_pending & ~pending;
+}
+
+bool AudioEngine::PlayPcm(const int16_t* samples, size_t frames, bool loop, uint32_t sampleRate)
+{
+    if (samples == nullptr || frames == 0 || !CanPlayInPlace(samples))
+    {
+        return false;
+    }
+    Stop();
+    if (!SetSampleRate(sampleRate))
+    {
+        return false;
+    }
+
+    m_clip   = {samples, frames * CHANNELS};
+    m_next   = {};
+    m_pos    = 0;
+    m_loop   = loop;
+    m_silent = 0;
+    m_state  = State::InPlace;
+    return Start();
+}
+
+bool AudioEngine::QueuePcm(const int16_t* samples, size_t frames)
+{
+    if (samples == nullptr || frames == 0 || !CanPlayInPlace(samples))
+    {
+        return false;
+    }
+    {
+        CriticalSection lock;
+        if (m_state == State::InPlace)
+        {
+            m_next = {samples, frames * CHANNELS};
+            return true;
+        }
+    }
+    return PlayPcm(samples, frames, false, m_clock->sampleRate);
+}
+
+bool AudioEngine::Play(Source* source, bool loop, uint32_t sampleRate)
+{
+    if (source == nullptr)
+    {
+        return false;
+    }
+    Stop();
+    if (!SetSampleRate(sampleRate))
+    {
+        return false;
+    }
+
+    m_source  = source;
+    m_loop    = loop;
+    m_pending = 0;
+    m_silent  = 0;
+    m_state   = State::Streaming;
+#if APP_AUDIO_DRIFT_COMPENSATION
+    // From the cycle counter, the drift starts as the error of the I2S's rate.
+    m_resampler.Reset();
+    m_estimator.Start(sampleRate,
+                      m_reference != nullptr ? m_tickRate : SystemCoreClock,
+                      m_clock->GetErrorPpm());
+    m_resampler.SetStep(m_estimator.GetStep());
+    m_hasTimestamp = false;
+#endif
+    return Start();
+}
+
+bool AudioEngine::PlayWav(const uint8_t* file, size_t size, bool loop)
+{
+    Wav::Format format;
+    bool        parsed = Wav::Parse(file, size, format) &&
+                  I2sClock::Find(format.sampleRate) != nullptr && format.channels <= CHANNELS;
+    if (parsed && format.encoding == Wav::ImaAdpcm && format.bitsPerSample == 4)
+    {
+        ImaAdpcm::Decoder decoder;
+        if (decoder.Open(format.data, format.size, format.channels, format.blockAlign))
+        {
+            Stop();
+            m_imaSource.decoder = decoder;
+            return Play(&m_imaSource, loop, format.sampleRate);
+        }
+    }
+    if (!parsed || format.encoding != Wav::Pcm || format.bitsPerSample != 16)
+    {
+        LOG_WARNING("[{}]: Unsupported WAV format.", m_label);
+        return false;
+    }
+
+    size_t frames = format.size / format.blockAlign;
+    if (format.channels == CHANNELS && CanPlayInPlace(format.data))
+    {
+        return PlayPcm(
+          reinterpret_cast<const int16_t*>(format.data), frames, loop, format.sampleRate);
+    }
+    Stop();
+    m_pcmSource.Open(format.data, frames, format.channels);
+    return Play(&m_pcmSource, loop, format.sampleRate);
+}
+
+bool AudioEngine::PlayQoa(const uint8_t* file, size_t size, bool loop)
+{
+    Qoa::Decoder decoder;
+    if (!decoder.Open(file, size) || I2sClock::Find(decoder.GetSampleRate()) == nullptr)
+    {
+        LOG_WARNING("[{}]: Unsupported QOA file.", m_label);
+        return false;
+    }
+    Stop();
+    m_qoaSource.decoder = decoder;
+    return Play(&m_qoaSource, loop, decoder.GetSampleRate());
+}
+
+bool AudioEngine::PlayFile(const char* path, bool loop)
+{
+    Stop();
+    if (!m_fileSource.Open(path))
+    {
+        LOG_WARNING("[{}]: Unable to play '{}'.", m_label, path);
+        return false;
+    }
+    return Play(&m_fileSource, loop, m_fileSource.GetSampleRate());
+}
+
+void AudioEngine::Stop()
+{
+    if (m_state != State::Idle)
+    {
+        StopDma();
+    }
+}
+
+void AudioEngine::TimeFlacFrame()
+{
+    // What plays from memory doesn't use the FileSource, such as the boot sound.
+    if (IsPlaying() && m_source == &m_fileSource)
+    {
+        LOG_WARNING("[{}]: Unable to time the FLAC decoder while playing a file.", m_label);
+        return;
+    }
+    if (!cep::Filesystem::IsMounted())
+    {
+        LOG_INFO("[{}]: No SD card, the FLAC decoder isn't timed.", m_label);
+        return;
+    }
+    size_t frameSize = WriteFlacBenchFile();
+    if (frameSize == 0 || !m_fileSource.Open(FLAC_BENCH_FILE))
+    {
+        LOG_ERROR("[{}]: Unable to write or open {}.", m_label, FLAC_BENCH_FILE);
+        return;
+    }
+
+    // A period is what a Run() reads: the decode of the frame it reaches, and before it, the
+    // refill of the buffer when that frame was cut by its end. The interrupts are counted, as
+    // when playing. Read by chunks, so that the period needs no buffer.
+    int16_t  out[BENCH_CHUNK * CHANNELS];
+    uint32_t worst  = 0;
+    uint64_t total  = 0;
+    size_t   frames = 0;
+    size_t   read   = PERIOD_FRAMES;
+    while (read == PERIOD_FRAMES)
+    {
+        Profiler::Ticks start = Profiler::Now();
+        read                  = 0;
+        while (read < PERIOD_FRAMES)
+        {
+            size_t chunk = m_fileSource.Read(out, std::min(BENCH_CHUNK, PERIOD_FRAMES - read));
+            if (chunk == 0)
+            {
+                break;
+            }
+            read += chunk;
+        }
+        uint32_t cycles = Profiler::Now() - start;
+        worst           = std::max(worst, cycles);
+        total += cycles;
+        frames += read;
+    }
+    m_fileSource.Close();
+    if (frames != FLAC_BENCH_FRAMES * Flac::MAX_BLOCK_SIZE)
+    {
+        LOG_ERROR("[{}]: {} doesn't decode.", m_label, FLAC_BENCH_FILE);
+        return;
+    }
+
+    uint32_t period = static_cast<uint32_t>(static_cast<uint64_t>(Profiler::TicksPerSecond()) *
+                                            PERIOD_FRAMES / SAMPLE_RATE);
+    LOG_INFO("----- FLAC: {} frames of {} B, {} samples of stereo, LPC of order {}.",
+             FLAC_BENCH_FRAMES,
+             frameSize,
+             Flac::MAX_BLOCK_SIZE,
+             Flac::MAX_LPC_ORDER);
+    LOG_INFO("Decode and refill, worst period: {} cycles, {:.1} us, {}% of a period. {} cycles "
+             "per frame.",
+             worst,
+             Profiler::ToMicroseconds(worst),
+             static_cast<uint32_t>(static_cast<uint64_t>(worst) * 100 / period),
+             static_cast<uint32_t>(total / FLAC_BENCH_FRAMES));
+}
+
+void AudioEngine::SetReferenceClock(ReferenceClock clock, uint32_t tickRate)
+{
+#if APP_AUDIO_DRIFT_COMPENSATION
+    CriticalSection lock;
+    m_reference = clock;
+    m_tickRate  = tickRate;
+#else
+    (void)clock;
+    (void)tickRate;
+#endif
+}
+
+float AudioEngine::GetDriftPpm() const
+{
+#if APP_AUDIO_DRIFT_COMPENSATION
+    return m_estimator.GetDriftPpm();
+#else
+    return 0.0f;
+#endif
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Reprograms the I2S's clock for @p sampleRate, if it isn't already. Only while stopped.
+ */
+bool AudioEngine::SetSampleRate(uint32_t sampleRate)
+{
+    if (sampleRate == m_clock->sampleRate)
+    {
+        return true;
+    }
+    const I2sClock::Config* clock = I2sClock::Find(sampleRate);
+    if (clock == nullptr || !I2sClock::Apply(m_i2s, *clock))
+    {
+        LOG_ERROR("[{}]: Unable to play at {} Hz.", m_label, sampleRate);
+        return false;
+    }
+    m_clock = clock;
+    LOG_INFO("[{}]: Playing at {} Hz, {}.{:03} Hz real ({} ppm).",
+             m_label,
+             sampleRate,
+             static_cast<uint32_t>(clock->GetRealRate() / 1000),
+             static_cast<uint32_t>(clock->GetRealRate() % 1000),
+             clock->GetErrorPpm());
+    return true;
+}
+
+/**
+ * @brief Computes both periods and starts the DMA, then the I2S' requests.
+ */
+bool AudioEngine::Start()
+{
+    const int16_t* first  = nullptr;
+    const int16_t* second = nullptr;
+    if (m_state == State::Streaming)
+    {
+        Fill(0);
+        first = m_buffers[0];
+        if (m_state == State::Streaming)
+        {
+            Fill(1);
+            second = m_buffers[1];
+        }
+        else
+        {
+            // The source ended in the first period.
+            second = Next(1);
+        }
+    }
+    else
+    {
+        first  = Next(0);
+        second = Next(1);
+    }
+
+    if (HAL_DMAEx_MultiBufferStart_IT(m_dma,
+                                      Address(first),
+                                      Address(&m_i2s->Instance->DR),
+                                      Address(second),
+                                      PERIOD_SAMPLES) != HAL_OK)
+    {
+        LOG_ERROR("[{}]: Unable to start the DMA.", m_label);
+        m_state = State::Idle;
+        return false;
+    }
+    SET_BIT(m_i2s->Instance->CR2, SPI_CR2_TXDMAEN);
+    __HAL_I2S_ENABLE(m_i2s);
+    return true;
+}
+
+void AudioEngine::StopDma()
+{
+    CLEAR_BIT(m_i2s->Instance->CR2, SPI_CR2_TXDMAEN);
+    HAL_DMA_Abort(m_dma);
+
+    // The I2S is only turned off once its last sample went out.
+    uint32_t start = HAL_GetTick();
+    while (((m_i2s->Instance->SR & SPI_SR_TXE) == 0 || (m_i2s->Instance->SR & SPI_SR_BSY) != 0) &&
+           HAL_GetTick() - start < 2)
+    {
+    }
+    __HAL_I2S_DISABLE(m_i2s);
+    if (m_source == &m_fileSource)
+    {
+        m_fileSource.Close();
+    }
+
+    CriticalSection lock;
+    m_state   = State::Idle;
+    m_source  = nullptr;
+    m_pending = 0;
+}
+
+/**
+ * @brief Refills @p period from the source. Once it's done, pads it with silence and drains.
+ */
+void AudioEngine::Fill(size_t period)
+{
+    int16_t* out     = m_buffers[period];
+    size_t   frames  = 0;
+    bool     rewound = false;
+#if APP_AUDIO_DRIFT_COMPENSATION
+    m_positions[period] = m_resampler.GetPosition();
+#endif
+    while (frames < PERIOD_FRAMES)
+    {
+        size_t read = ReadSource(&out[frames * CHANNELS], PERIOD_FRAMES - frames);
+        if (read == 0)
+        {
+            // Rewinding twice in a row means the source is empty.
+            if (m_loop && !rewound && m_source->Rewind())
+            {
+                rewound = true;
+                continue;
+            }
+            break;
+        }
+        rewound = false;
+        frames += read;
+    }
+
+    if (frames < PERIOD_FRAMES)
+    {
+        std::fill(&out[frames * CHANNELS], &out[PERIOD_SAMPLES], int16_t(0));
+        CriticalSection lock;
+        if (m_state == State::Streaming)
+        {
+            m_state = State::Draining;
+        }
+    }
+}
+
+/**
+ * @brief Reads the source, through the resampler with the drift compensation.
+ * @returns 0 once the source is done.
+ */
+size_t AudioEngine::ReadSource(int16_t* out, size_t frames)
+{
+#if APP_AUDIO_DRIFT_COMPENSATION
+    size_t done = 0;
+    while ((done += m_resampler.Read(&out[done * CHANNELS], frames - done)) < frames)
+    {
+        size_t   space = 0;
+        int16_t* in    = m_resampler.GetInput(space);
+        size_t   read  = m_source->Read(in, space);
+        if (read == 0)
+        {
+            break;
+        }
+        m_resampler.Commit(read);
+    }
+    return done;
+#else
+    return m_source->Read(out, frames);
+#endif
+}
+
+#if APP_AUDIO_DRIFT_COMPENSATION
+/**
+ * @brief Corrects the step of the resampler with the timestamp of the last period that started.
+ */
+void AudioEngine::UpdateDrift()
+{
+    Timestamp timestamp;
+    {
+        CriticalSection lock;
+        if (!m_hasTimestamp)
+        {
+            return;
+        }
+        timestamp      = m_timestamp;
+        m_hasTimestamp = false;
+    }
+    m_estimator.Update(timestamp.position, timestamp.ticks);
+    m_resampler.SetStep(m_estimator.GetStep());
+}
+
+/**
+ * @brief Reads the reference clock, from the DMA's interrupt.
+ * @note The cycle counter wraps every 25.6 s at 168 MHz: the periods, every 10.7 ms, extend it.
+ *       A gap between two streams is a jump, the estimator starts over anyway.
+ */
+RAMFUNC uint64_t AudioEngine::GetReferenceTicks()
+{
+    if (m_reference != nullptr)
+    {
+        return m_reference();
+    }
+    uint32_t cycles = Profiler::Now();
+    m_cycles += cycles - m_lastCycles;
+    m_lastCycles = cycles;
+    return m_cycles;
+}
+#endif
+
+/**
+ * @returns What @p period plays next, when not streaming.
+ */
+RAMFUNC const int16_t* AudioEngine::Next(size_t period)
+{
+    if (m_state == State::InPlace)
+    {
+        return NextInPlace(period);
+    }
+
+    std::fill(&m_buffers[period][0], &m_buffers[period][PERIOD_SAMPLES], int16_t(0));
+    if (m_state == State::Draining && ++m_silent >= SILENT_PERIODS)
+    {
+        m_state = State::Stopping;
+    }
+    return m_buffers[period];
+}
+
+/**
+ * @returns The next period of the clip where it is, or in the buffer of @p period when it holds
+ *          the end of the clip.
+ */
+RAMFUNC const int16_t* AudioEngine::NextInPlace(size_t period)
+{
+    if (m_clip.length - m_pos >= PERIOD_SAMPLES)
+    {
+        const int16_t* samples = &m_clip.samples[m_pos];
+        m_pos += PERIOD_SAMPLES;
+        m_stats.inPlace++;
+        return samples;
+    }
+
+    int16_t* out    = m_buffers[period];
+    size_t   filled = 0;
+    while (filled < PERIOD_SAMPLES)
+    {
+        size_t left = m_clip.length - m_pos;
+        if (left == 0)
+        {
+            if (m_loop)
+            {
+                m_pos = 0;
+            }
+            else if (m_next.samples != nullptr)
+            {
+                m_clip = m_next;
+                m_next = {};
+                m_pos  = 0;
+            }
+            else
+            {
+                std::fill(&out[filled], &out[PERIOD_SAMPLES], int16_t(0));
+                m_state = State::Draining;
+                break;
+            }
+            continue;
+        }
+        size_t count = std::min(left, PERIOD_SAMPLES - filled);
+        std::memcpy(&out[filled], &m_clip.samples[m_pos], count * sizeof(int16_t));
+        filled += count;
+        m_pos += count;
+    }
+    return out;
+}
+
+/**
+ * @brief The DMA is done with @p period and now plays the other one: @p period can be changed.
+ */
+RAMFUNC void AudioEngine::OnComplete(size_t period)
+{
+    m_stats.periods++;
+    if (m_state == State::Streaming)
+    {
+        // The other period, playing now, was never refilled.
+        if ((m_pending & (1U << (1 - period))) != 0)
+        {
+            m_stats.underruns++;
+        }
+        m_pending = m_pending | (1U << period);
+#if APP_AUDIO_DRIFT_COMPENSATION
+        m_timestamp    = {m_positions[1 - period], GetReferenceTicks()};
+        m_hasTimestamp = true;
+#endif
+#if APP_USE_RTOS
+        ThreadedApplication::Notify(ModulePriority::Audio);
+#endif
+        return;
+    }
+    if (m_state == State::Stopping)
+    {
+        return;
+    }
+
+    HAL_DMAEx_ChangeMemory(m_dma, Address(Next(period)), period == 0 ? MEMORY0 : MEMORY1);
+}
+
+bool AudioEngine::CanPlayInPlace(const void* samples)
+{
+    return reinterpret_cast<uintptr_t>(samples) % alignof(int16_t) == 0 &&
+           CcmRam::IsDmaCapable(samples, 1);
+}
+
+RAMFUNC void AudioEngine::M0CompleteCallback(DMA_HandleTypeDef* dma)
+{
+    (void)dma;
+    s_instance->OnComplete(0);
+}
+
+RAMFUNC void AudioEngine::M1CompleteCallback(DMA_HandleTypeDef* dma)
+{
+    (void)dma;
+    s_instance->OnComplete(1);
+}
+
+void AudioEngine::ErrorCallback(DMA_HandleTypeDef* dma)
+{
+    (void)dma;
+    s_instance->m_stats.errors++;
+    s_instance->m_state = State::Stopping;
+}
+
+void AudioEngine::PcmSource::Open(const uint8_t* data, size_t frames, uint16_t channels)
+{
+    m_data     = data;
+    m_frames   = frames;
+    m_pos      = 0;
+    m_channels = channels;
+}
+
+size_t AudioEngine::PcmSource::Read(int16_t* out, size_t frames)
+{
+    frames = std::min(frames, m_frames - m_pos);
+    for (size_t i = 0; i < frames; i++)
+    {
+        const uint8_t* in = &m_data[(m_pos + i) * m_channels * sizeof(int16_t)];
+        out[2 * i]        = static_cast<int16_t>(ByteOrder::GetLe16(in));
+        out[2 * i + 1]    = m_channels == 1
+                              ? out[2 * i]
+                              : static_cast<int16_t>(ByteOrder::GetLe16(&in[sizeof(int16_t)]));
+    }
+    m_pos += frames;
+    return frames;
+}
+
+bool AudioEngine::PcmSource::Rewind()
+{
+    m_pos = 0;
+    return true;
+}
+
+bool AudioEngine::FileSource::Open(const char* path)
+{
+    Close();
+    if (!cep::Filesystem::IsMounted() || f_open(&m_file, path, FA_READ) != FR_OK)
+    {
+        return false;
+    }
+    m_isOpen = true;
+
+    UINT        read = 0;
+    Wav::Format format;
+    if (f_read(&m_file, s_fileBuffer, sizeof(s_fileBuffer), &read) != FR_OK)
+    {
+        Close();
+        return false;
+    }
+    if (m_qoa.Open(s_fileBuffer, read))
+    {
+        m_codec      = Codec::Qoa;
+        m_channels   = m_qoa.GetChannels();
+        m_sampleRate = m_qoa.GetSampleRate();
+        m_start      = Qoa::FILE_HEADER;
+        m_end        = f_size(&m_file);
+    }
+    else if (Wav::Parse(s_fileBuffer, read, format) && format.encoding == Wav::ImaAdpcm &&
+             format.bitsPerSample == 4 && format.blockAlign <= sizeof(s_fileBuffer) &&
+             m_ima.Open(format.data, format.size, format.channels, format.blockAlign))
+    {
+        m_codec      = Codec::ImaAdpcm;
+        m_channels   = format.channels;
+        m_blockAlign = format.blockAlign;
+        m_sampleRate = format.sampleRate;
+        m_start      = format.data - s_fileBuffer;
+        // Parse() cut the "data" chunk to what was read, its header has its real size.
+        m_end = std::min<FSIZE_t>(m_start + ByteOrder::GetLe32(format.data - 4), f_size(&m_file));
+    }
+    else if (Flac::ParseStreamInfo(s_fileBuffer, read, m_flacInfo) &&
+             m_flacInfo.maxFrameSize <= sizeof(s_fileBuffer) && SkipFlacMetadata())
+    {
+        m_codec      = Codec::Flac;
+        m_channels   = m_flacInfo.channels;
+        m_sampleRate = m_flacInfo.sampleRate;
+        m_start      = f_tell(&m_file);
+        m_end        = f_size(&m_file);
+    }
+    else
+    {
+        Close();
+        return false;
+    }
+
+    if (I2sClock::Find(m_sampleRate) == nullptr || !Rewind())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void AudioEngine::FileSource::Close()
+{
+    if (m_isOpen)
+    {
+        f_close(&m_file);
+        m_isOpen = false;
+    }
+}
+
+size_t AudioEngine::FileSource::Read(int16_t* out, size_t frames)
+{
+    size_t done = 0;
+    while (done < frames)
+    {
+        size_t read = 0;
+        switch (m_codec)
+        {
+            case Codec::ImaAdpcm: read = m_ima.Read(&out[done * CHANNELS], frames - done); break;
+            case Codec::Qoa: read = m_qoa.Read(&out[done * CHANNELS], frames - done); break;
+            case Codec::Flac: read = s_flac.Read(&out[done * CHANNELS], frames - done); break;
+        }
+        if (read == 0 && !Refill())
+        {
+            break;
+        }
+        done += read;
+    }
+    return done;
+}
+
+/**
+ * @brief Drops what's left of the block or frame being decoded, with it.
+ */
+bool AudioEngine::FileSource::Rewind()
+{
+    m_fill = 0;
+    s_flac.OpenFrames(s_fileBuffer, 0, m_flacInfo);
+    return m_isOpen && f_lseek(&m_file, m_start) == FR_OK && Refill();
+}
+
+/**
+ * @brief Reads the next block or frame, for the decoder to decode.
+ * @returns False at the end of the file, or if it can't be read.
+ */
+bool AudioEngine::FileSource::Refill()
+{
+    UINT    read = 0;
+    FSIZE_t left = m_end - f_tell(&m_file);
+    if (m_codec == Codec::ImaAdpcm)
+    {
+        size_t size = static_cast<size_t>(std::min<FSIZE_t>(m_blockAlign, left));
+        return size != 0 && f_read(&m_file, s_fileBuffer, size, &read) == FR_OK && read == size &&
+               m_ima.Open(s_fileBuffer, size, m_channels, m_blockAlign);
+    }
+    if (m_codec == Codec::Flac)
+    {
+        return RefillFlac();
+    }
+
+    if (left < Qoa::FRAME_HEADER ||
+        f_read(&m_file, s_fileBuffer, Qoa::FRAME_HEADER, &read) != FR_OK ||
+        read != Qoa::FRAME_HEADER)
+    {
+        return false;
+    }
+    size_t size = Qoa::GetFrameSize(s_fileBuffer);
+    if (size <= Qoa::FRAME_HEADER || size > sizeof(s_fileBuffer) ||
+        f_read(&m_file, &s_fileBuffer[Qoa::FRAME_HEADER], size - Qoa::FRAME_HEADER, &read) !=
+          FR_OK ||
+        read != size - Qoa::FRAME_HEADER)
+    {
+        return false;
+    }
+    return m_qoa.OpenFrames(s_fileBuffer, size, m_channels, m_sampleRate);
+}
+
+/**
+ * @brief Moves the frame the decoder stopped at, cut by the end of the buffer, to its start,
+ *        then fills the rest.
+ * @returns False at the end of the file, if it can't be read, or if a frame doesn't fit.
+ */
+bool AudioEngine::FileSource::RefillFlac()
+{
+    size_t consumed = s_flac.GetConsumed();
+    std::memmove(s_fileBuffer, &s_fileBuffer[consumed], m_fill - consumed);
+    m_fill -= consumed;
+
+    UINT    read = 0;
+    FSIZE_t left = m_end - f_tell(&m_file);
+    size_t  size = static_cast<size_t>(std::min<FSIZE_t>(sizeof(s_fileBuffer) - m_fill, left));
+    if (size == 0 || f_read(&m_file, &s_fileBuffer[m_fill], size, &read) != FR_OK || read != size)
+    {
+        return false;
+    }
+    m_fill += size;
+    return s_flac.OpenFrames(s_fileBuffer, m_fill, m_flacInfo);
+}
+
+/**
+ * @brief Seeks past the metadata blocks that follow the STREAMINFO, to the first frame.
+ */
+bool AudioEngine::FileSource::SkipFlacMetadata()
+{
+    FSIZE_t next   = Flac::MARKER_SIZE;
+    bool    isLast = false;
+    while (!isLast)
+    {
+        UINT    read = 0;
+        uint8_t header[Flac::HEADER_SIZE];
+        if (f_lseek(&m_file, next) != FR_OK ||
+            f_read(&m_file, header, sizeof(header), &read) != FR_OK || read != sizeof(header))
+        {
+            return false;
+        }
+        next += Flac::GetMetadataSize(header, isLast);
+    }
+    return f_lseek(&m_file, next) == FR_OK;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
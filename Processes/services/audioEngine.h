@@ -0,0 +1,348 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    audioEngine.h
+ * @brief   Playback on I2S3, by the DMA in double-buffer mode.
+ *
+ * The DMA alternates between two periods of PERIOD_FRAMES frames, and the CPU only steps in
+ * when one ends, to point it at the one after the next. Two ways to fill them:
+ *  - In place: the samples are already in the I2S's format (16-bit stereo) and in memory the DMA
+ *    can read, such as the asset bundle in DATA_FLASH (see AssetFs). The DMA reads the periods
+ *    straight from there, without copy nor CPU. Only the period that holds the end of a sound is
+ *    copied to RAM, with the start of what follows: the sound itself when it loops, the one
+ *    queued with QueuePcm(), or silence.
+ *  - Streamed: a Source writes the periods in RAM from Run(), for the formats that can't be
+ *    played as they are (mono, decoders, ...). A period that Run() didn't refill in time is
+ *    played again, and counted as an underrun.
+ *
+ * The compressed formats, IMA-ADPCM WAV (4 bits per sample) and QOA (3.2 bits), are streamed,
+ * from memory or from the SD card: PlayFile() reads them a block or a frame at a time from Run(),
+ * a quarter of the 192 kB/s that 16-bit stereo at 48 kHz needs. PlayFile() also streams FLAC,
+ * lossless, at about 60% of it. A FLAC frame, up to 4096 samples, is decoded at once by the Run()
+ * that needs it: it must take less than the period left to play, 10.7 ms. The "flac frame" zone
+ * of the profiler holds how long the decode takes. TimeFlacFrame() logs the worst case at boot:
+ * a period's decode, and the refill from the card that comes with it.
+ *
+ * Each stream is played at its own rate: between two streams of different rates, the PLLI2S is
+ * reprogrammed to the closest it can get (see I2sClock), so that 44.1 kHz plays without being
+ * resampled. The error of the real rate, within 200 ppm, is logged and kept in GetRateErrorPpm().
+ *
+ * With APP_AUDIO_DRIFT_COMPENSATION, what's streamed goes through a Resampler, steered by a
+ * DriftEstimator to keep it locked to a reference clock: the CPU's cycle counter, which makes up
+ * for the rate error of the I2S, or the clock of an external timeline (SetReferenceClock()). The
+ * DMA's interrupt timestamps the start of each period, Run() corrects the step of the resampler
+ * before filling the next. What's played in place isn't resampled.
+ *
+ * Playback stops by itself, once the last period went out.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_AUDIOENGINE_H
+#    define NILAIINI_SERVICES_AUDIOENGINE_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include "Core/Inc/main.h"
+#    include "FATFS/App/fatfs.h"
+
+#    include "Processes/drivers/i2sClock.h"
+
+#    include "Processes/services/driftEstimator.h"
+#    include "Processes/services/flac.h"
+#    include "Processes/services/imaAdpcm.h"
+#    include "Processes/services/qoa.h"
+#    include "Processes/services/resampler.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class AudioEngine : public cep::Module
+{
+public:
+    static constexpr uint32_t SAMPLE_RATE       = 48000;    //!< Of I2S3 at boot, see MX_I2S3_Init.
+    static constexpr size_t   CHANNELS          = 2;
+    static constexpr size_t   PERIOD_FRAMES     = 512;    //!< Per DMA buffer, 10.7 ms.
+    static constexpr size_t   PERIOD_SAMPLES    = PERIOD_FRAMES * CHANNELS;
+    static constexpr size_t   FLAC_BENCH_FRAMES = 8;    //!< Of the file of TimeFlacFrame().
+
+    //! Written on the SD card by TimeFlacFrame(), and kept.
+    static constexpr const char* FLAC_BENCH_FILE = "BENCH.FLA";
+
+    /**
+     * @brief Produces the frames of the streamed playback, from Run().
+     */
+    class Source
+    {
+    public:
+        virtual ~Source() = default;
+
+        /**
+         * @brief Writes up to @p frames interleaved stereo frames into @p out.
+         * @returns The frames written, 0 once the end is reached.
+         */
+        virtual size_t Read(int16_t* out, size_t frames) = 0;
+
+        /**
+         * @brief Goes back to the start, to loop.
+         * @returns False if the source can't.
+         */
+        virtual bool Rewind() { return false; }
+    };
+
+    struct Stats
+    {
+        uint32_t periods   = 0;    //!< Played.
+        uint32_t inPlace   = 0;    //!< Played straight from where the samples are.
+        uint32_t underruns = 0;
+        uint32_t errors    = 0;    //!< Of the DMA.
+    };
+
+    /**
+     * @brief Ticks of the reference the streamed playback is locked to. Called from the DMA's
+     *        interrupt.
+     */
+    using ReferenceClock = uint64_t (*)();
+
+    AudioEngine(I2S_HandleTypeDef* i2s, DMA_HandleTypeDef* dma, const std::string& label);
+    ~AudioEngine() override = default;
+
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    /**
+     * @brief Stops what's playing and plays @p samples in place.
+     * @param samples 16-bit stereo, must stay valid until it's done playing.
+     * @returns False if the DMA can't read @p samples (misaligned or in the CCM), or if
+     *          @p sampleRate isn't one of I2sClock::TABLE.
+     */
+    bool PlayPcm(const int16_t* samples,
+                 size_t         frames,
+                 bool           loop       = false,
+                 uint32_t       sampleRate = SAMPLE_RATE);
+
+    /**
+     * @brief Plays @p samples after what's playing in place, without gap, at the same rate.
+     *        Replaces what was queued before, plays right away if nothing is playing in place.
+     */
+    bool QueuePcm(const int16_t* samples, size_t frames);
+
+    /**
+     * @brief Stops what's playing and streams @p source, which must outlive the playback.
+     */
+    bool Play(Source* source, bool loop = false, uint32_t sampleRate = SAMPLE_RATE);
+
+    /**
+     * @brief Plays a WAV file, in place if its samples allow it, streamed otherwise.
+     * @returns False if its format isn't supported.
+     */
+    bool PlayWav(const uint8_t* file, size_t size, bool loop = false);
+
+    /**
+     * @brief Streams a QOA file from memory.
+     */
+    bool PlayQoa(const uint8_t* file, size_t size, bool loop = false);
+
+    /**
+     * @brief Streams an IMA-ADPCM WAV, a QOA or a FLAC file from the SD card.
+     * @returns False if it can't be opened or its format isn't supported.
+     */
+    bool PlayFile(const char* path, bool loop = false);
+
+    void Stop();
+
+    /**
+     * @brief Streams FLAC_BENCH_FRAMES of Flac::WriteBenchFrame()'s frame, the worst case, from
+     *        FLAC_BENCH_FILE on the SD card through the FileSource, a period at a time as Run()
+     *        does, and logs the cycles of the slowest period against its duration.
+     * @note The file is written once, and kept. Not while a file plays, the FileSource is used.
+     */
+    void TimeFlacFrame();
+
+    /**
+     * @brief Locks the streamed playback to @p clock, of @p tickRate Hz, from the next stream on.
+     *        nullptr for the CPU's cycle counter.
+     */
+    void SetReferenceClock(ReferenceClock clock, uint32_t tickRate);
+
+    [[nodiscard]] bool  IsPlaying() const { return m_state != State::Idle; }
+    [[nodiscard]] Stats GetStats() const { return m_stats; }
+
+    //! Nominal, of the stream playing or that played last.
+    [[nodiscard]] uint32_t GetSampleRate() const { return m_clock->sampleRate; }
+    //! Of the real rate of the I2S to GetSampleRate().
+    [[nodiscard]] int32_t GetRateErrorPpm() const { return m_clock->GetErrorPpm(); }
+    //! Of the I2S against the reference clock, as estimated. 0 without drift compensation.
+    [[nodiscard]] float GetDriftPpm() const;
+
+    static AudioEngine* Get() { return s_instance; }
+
+private:
+    /**
+     * @brief 16-bit PCM that can't be played in place: mono, or out of the DMA's
+     *        reach.
+     */
+    class PcmSource : public Source
+    {
+    public:
+        void   Open(const uint8_t* data, size_t frames, uint16_t channels);
+        size_t Read(int16_t* out, size_t frames) override;
+        bool   Rewind() override;
+
+    private:
+        const uint8_t* m_data     = nullptr;
+        size_t         m_frames   = 0;
+        size_t         m_pos      = 0;
+        uint16_t       m_channels = 0;
+    };
+
+    /**
+     * @brief Plays what a decoder decodes from memory.
+     */
+    template<typename Decoder>
+    class DecoderSource : public Source
+    {
+    public:
+        size_t Read(int16_t* out, size_t frames) override { return decoder.Read(out, frames); }
+        bool   Rewind() override { return decoder.Rewind(); }
+
+        Decoder decoder;
+    };
+
+    /**
+     * @brief A compressed file on the SD card, read a block (IMA-ADPCM) or a frame (QOA) at a
+     *        time, in a buffer that the decoder decodes from. FLAC frames have no size in their
+     *        header: the buffer is kept full instead, and what the decoder didn't consume yet is
+     *        moved to its start on each refill.
+     */
+    class FileSource : public Source
+    {
+    public:
+        bool   Open(const char* path);
+        void   Close();
+        size_t Read(int16_t* out, size_t frames) override;
+        bool   Rewind() override;
+
+        [[nodiscard]] uint32_t GetSampleRate() const { return m_sampleRate; }
+
+    private:
+        enum class Codec : uint8_t
+        {
+            ImaAdpcm,
+            Qoa,
+            Flac,
+        };
+
+        FIL               m_file       = {};
+        bool              m_isOpen     = false;
+        Codec             m_codec      = Codec::ImaAdpcm;
+        FSIZE_t           m_start      = 0;    //!< Of the first block or frame.
+        FSIZE_t           m_end        = 0;    //!< Of the last one.
+        size_t            m_channels   = 0;
+        size_t            m_blockAlign = 0;
+        uint32_t          m_sampleRate = 0;
+        size_t            m_fill       = 0;    //!< Of the buffer, for FLAC.
+        Flac::StreamInfo  m_flacInfo;
+        ImaAdpcm::Decoder m_ima;
+        Qoa::Decoder      m_qoa;
+
+    private:
+        bool Refill();
+        bool RefillFlac();
+        bool SkipFlacMetadata();
+    };
+
+    struct Clip
+    {
+        const int16_t* samples = nullptr;
+        size_t         length  = 0;    //!< In samples, of all channels.
+    };
+
+    enum class State : uint8_t
+    {
+        Idle,
+        InPlace,
+        Streaming,
+        Draining,    //!< The last period is out, silence until it's played.
+        Stopping,    //!< Played, Run() stops the DMA.
+    };
+
+    std::string        m_label;
+    I2S_HandleTypeDef* m_i2s;
+    DMA_HandleTypeDef* m_dma;
+
+    volatile State   m_state   = State::Idle;
+    Clip             m_clip;
+    Clip             m_next;    //!< Queued after m_clip.
+    size_t           m_pos     = 0;    //!< In m_clip, in samples.
+    bool             m_loop    = false;
+    Source*          m_source  = nullptr;
+    volatile uint8_t m_pending = 0;    //!< Bit per period that Run() must refill.
+    uint8_t          m_silent  = 0;    //!< Periods of silence since Draining.
+    Stats            m_stats;
+    PcmSource        m_pcmSource;
+
+    const I2sClock::Config* m_clock = I2sClock::Find(SAMPLE_RATE);    //!< Of the I2S.
+
+#    if APP_AUDIO_DRIFT_COMPENSATION
+    struct Timestamp
+    {
+        uint64_t position = 0;    //!< In the content, of the period that started, Q32.
+        uint64_t ticks    = 0;    //!< Of the reference, when it started.
+    };
+
+    Resampler      m_resampler;
+    DriftEstimator m_estimator;
+    ReferenceClock m_reference    = nullptr;
+    uint32_t       m_tickRate     = 0;
+    uint64_t       m_cycles       = 0;    //!< The cycle counter, extended to 64 bits.
+    uint32_t       m_lastCycles   = 0;
+    uint64_t       m_positions[2] = {};    //!< In the content, where each period starts.
+    Timestamp      m_timestamp;
+    volatile bool  m_hasTimestamp = false;    //!< Set by the interrupt, for Run().
+#    endif
+
+    DecoderSource<ImaAdpcm::Decoder> m_imaSource;
+    DecoderSource<Qoa::Decoder>      m_qoaSource;
+    FileSource                       m_fileSource;
+
+    //! The periods that aren't played in place. Must stay out of the CCM.
+    alignas(4) int16_t m_buffers[2][PERIOD_SAMPLES] = {};
+
+private:
+    static AudioEngine* s_instance;
+
+private:
+    bool           SetSampleRate(uint32_t sampleRate);
+    bool           Start();
+    void           StopDma();
+    void           Fill(size_t period);
+    size_t         ReadSource(int16_t* out, size_t frames);
+#    if APP_AUDIO_DRIFT_COMPENSATION
+    void     UpdateDrift();
+    uint64_t GetReferenceTicks();
+#    endif
+    const int16_t* Next(size_t period);
+    const int16_t* NextInPlace(size_t period);
+    void           OnComplete(size_t period);
+
+    static bool CanPlayInPlace(const void* samples);
+    static void M0CompleteCallback(DMA_HandleTypeDef* dma);
+    static void M1CompleteCallback(DMA_HandleTypeDef* dma);
+    static void ErrorCallback(DMA_HandleTypeDef* dma);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_AUDIOENGINE_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,82 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    binaryLog.cpp
+ * @brief   Source for the binary log mode.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "binaryLog.h"
+
+#include "Core/Inc/main.h"
+
+#include "Processes/drivers/uartTxDma.h"
+
+namespace BinaryLog
+{
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+FrameWriter::FrameWriter(const char* fmt)
+{
+    // .nilai_log_fmt is linked at address 0, the address of a string is its offset.
+    uint16_t id   = static_cast<uint16_t>(reinterpret_cast<uintptr_t>(fmt));
+    uint32_t tick = HAL_GetTick();
+
+    m_buf[0] = FRAME_START;
+    m_len    = 2;
+    Put(&id, sizeof(id));
+    Put(&tick, sizeof(tick));
+}
+
+void FrameWriter::Pack(const Fmt::Arg& arg)
+{
+    uint8_t tag = static_cast<uint8_t>(arg.type);
+    Put(&tag, sizeof(tag));
+
+    switch (arg.type)
+    {
+        case Fmt::Arg::Type::Int: Put(&arg.i, sizeof(arg.i)); break;
+        case Fmt::Arg::Type::Uint: Put(&arg.u, sizeof(arg.u)); break;
+        case Fmt::Arg::Type::Int64: Put(&arg.i64, sizeof(arg.i64)); break;
+        case Fmt::Arg::Type::Uint64: Put(&arg.u64, sizeof(arg.u64)); break;
+        case Fmt::Arg::Type::Float: Put(&arg.f, sizeof(arg.f)); break;
+        case Fmt::Arg::Type::Bool: Put(&arg.b, sizeof(arg.b)); break;
+        case Fmt::Arg::Type::Char: Put(&arg.c, sizeof(arg.c)); break;
+        case Fmt::Arg::Type::String:
+            Put(arg.s.data, arg.s.len < MAX_STRING ? arg.s.len : MAX_STRING);
+            Put("", 1);
+            break;
+        case Fmt::Arg::Type::Pointer:
+        {
+            uint32_t value = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg.p));
+            Put(&value, sizeof(value));
+            break;
+        }
+    }
+}
+
+void FrameWriter::Send()
+{
+    uint8_t checksum = 0;
+    for (size_t i = 2; i < m_len; i++)
+    {
+        checksum ^= m_buf[i];
+    }
+    m_buf[1]       = static_cast<uint8_t>(m_len - 2);
+    m_buf[m_len++] = checksum;
+
+    if (UartTxDma::Get() != nullptr)
+    {
+        UartTxDma::Get()->Write(reinterpret_cast<const char*>(m_buf), m_len);
+    }
+}
+}    // namespace BinaryLog
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
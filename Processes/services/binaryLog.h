@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    binaryLog.h
+ * @brief   Binary log mode: the target sends an ID and the raw arguments, the host formats.
+ *
+ * When APP_LOG_BINARY is set, the LOG_* macros of the application (see log.h) stop formatting
+ * on target. Each call site instead places its format string (with its level and location) in
+ * the .nilai_log_fmt section, which is kept in the ELF but never loaded on target. The offset of
+ * the string in that section is the ID of the call site.
+ *
+ * A log line is then sent as a frame:
+ * | 0xB1 | len | id (u16) | tick (u32) | arguments... | checksum |
+ * where len counts the bytes from the ID to the last argument, and the checksum is the XOR of
+ * those bytes. Everything is little-endian.
+ *
+ * Each argument is a Fmt::Arg::Type tag followed by its value:
+ *  - Int, Uint, Pointer: 4 bytes. Int64, Uint64: 8 bytes.
+ *  - Float: the 4 bytes of the float, doubles are narrowed.
+ *  - Bool, Char: 1 byte.
+ *  - String: the characters followed by a null terminator, truncated to MAX_STRING characters.
+ *
+ * The frames share the UART with plain text (NilaiTFO's own logs, the banner, ...). 0xB1 never
+ * appears in the ASCII logs, which lets tools/logdecode.py tell them apart.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_BINARYLOG_H
+#    define NILAIINI_SERVICES_BINARYLOG_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Processes/services/format.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <cstring>
+
+/*****************************************************************************/
+/* Exported types */
+namespace BinaryLog
+{
+constexpr uint8_t FRAME_START  = 0xB1;
+constexpr size_t  MAX_FRAME    = 128;    //!< Arguments that don't fit are truncated.
+constexpr size_t  MAX_STRING   = 48;
+constexpr size_t  HEADER_SIZE  = 2 + sizeof(uint16_t) + sizeof(uint32_t);
+constexpr size_t  TRAILER_SIZE = 1;
+
+class FrameWriter
+{
+public:
+    FrameWriter(const char* fmt);
+
+    void Put(const void* data, size_t len)
+    {
+        size_t room = MAX_FRAME - TRAILER_SIZE - m_len;
+        len         = len < room ? len : room;
+        std::memcpy(&m_buf[m_len], data, len);
+        m_len += len;
+    }
+
+    void Pack(const Fmt::Arg& arg);
+
+    /**
+     * @brief Seals the frame and queues it for transmission.
+     */
+    void Send();
+
+private:
+    uint8_t m_buf[MAX_FRAME] = {};
+    size_t  m_len            = 0;
+};
+
+/**
+ * @brief Sends a log line.
+ * @param fmt The entry of the call site in .nilai_log_fmt.
+ * @note The FMT_STRING is only there to check the arguments at compile time.
+ */
+template<typename S, typename... Args>
+void Log(S, const char* fmt, const Args&... args)
+{
+    Fmt::Detail::Check<S, Args...>();
+
+    FrameWriter writer(fmt);
+    (writer.Pack(Fmt::Detail::MakeArg(args)), ...);
+    writer.Send();
+}
+}    // namespace BinaryLog
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_BINARYLOG_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
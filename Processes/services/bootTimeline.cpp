@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    bootTimeline.cpp
+ * @brief   Source for the BootTimeline.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "bootTimeline.h"
+
+#include "Processes/services/log.h"
+#include "Processes/services/profiler.h"
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+struct Entry
+{
+    const char*     phase;
+    Profiler::Ticks end;
+    uint32_t        clock;    //!< Profiler::TicksPerSecond() at the mark.
+};
+
+Entry           s_entries[BootTimeline::MAX_MARKS] = {};
+size_t          s_count                            = 0;
+Profiler::Ticks s_start                            = 0;
+uint32_t        s_startClock                       = 0;
+bool            s_reported                         = false;
+
+/**
+ * @brief Duration of the phase ending at @p index, at the clock it started with.
+ *        Counted separately, the counter wraps every 25 s at 168 MHz.
+ */
+uint32_t PhaseUs(size_t index)
+{
+    Profiler::Ticks begin = index == 0 ? s_start : s_entries[index - 1].end;
+    uint32_t        clock = index == 0 ? s_startClock : s_entries[index - 1].clock;
+    return static_cast<uint32_t>(static_cast<uint64_t>(s_entries[index].end - begin) * 1000000u /
+                                 clock);
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace BootTimeline
+{
+void Start()
+{
+    Profiler::Init();
+    s_start      = Profiler::Now();
+    s_startClock = Profiler::TicksPerSecond();
+    s_count      = 0;
+}
+
+void Mark(const char* phase)
+{
+    Profiler::Ticks now = Profiler::Now();
+    if (s_count < MAX_MARKS)
+    {
+        s_entries[s_count++] = {phase, now, Profiler::TicksPerSecond()};
+    }
+}
+
+uint32_t GetElapsedUs()
+{
+    uint32_t total = 0;
+    for (size_t i = 0; i < s_count; i++)
+    {
+        total += PhaseUs(i);
+    }
+    return total;
+}
+
+void Report()
+{
+    if (s_reported)
+    {
+        return;
+    }
+    s_reported = true;
+
+    LOG_INFO("----- Boot timeline, {:.3} ms:", static_cast<float>(GetElapsedUs()) / 1000.0f);
+    uint32_t at = 0;
+    for (size_t i = 0; i < s_count; i++)
+    {
+        uint32_t us = PhaseUs(i);
+        at += us;
+        LOG_INFO("{:<20} {:>10.3} ms {:>10.3} ms",
+                 s_entries[i].phase,
+                 static_cast<float>(us) / 1000.0f,
+                 static_cast<float>(at) / 1000.0f);
+    }
+    if (s_count == MAX_MARKS)
+    {
+        LOG_WARNING("The boot timeline is full, the last marks were dropped.");
+    }
+}
+}    // namespace BootTimeline
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    bootTimeline.h
+ * @brief   Timestamps the phases of the boot with the cycle counter, and logs them once live.
+ *
+ * Start() is the first thing main() does, each phase then ends with a Mark() naming it:
+ *      HAL_Init();
+ *      BootTimeline::Mark("HAL_Init");
+ * Marks cost a load and a few stores, they can be taken before the clocks, the UART or the
+ * logger are up. Report() logs the duration of each phase and when it ended, once the
+ * application is live (see DeferredInit):
+ *      [INFO]: ----- Boot timeline, 412.345 ms:
+ *      [INFO]: HAL_Init                  0.512 ms      0.512 ms
+ *      [INFO]: SystemClock_Config        1.870 ms      2.382 ms
+ *
+ * The counter runs at the CPU's clock, which SystemClock_Config changes: each phase is converted
+ * at the clock it started with. What runs before main() (the copy of .data, the static
+ * constructors) isn't counted.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_BOOTTIMELINE_H
+#    define NILAIINI_SERVICES_BOOTTIMELINE_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace BootTimeline
+{
+static constexpr size_t MAX_MARKS = 24;    //!< Marks past that are dropped.
+
+/**
+ * @brief Starts the cycle counter (Profiler::Init) and the timeline.
+ */
+void Start();
+
+/**
+ * @brief Ends the current phase, named @p phase. The name must outlive the timeline.
+ */
+void Mark(const char* phase);
+
+/**
+ * @brief Microseconds from Start() to the last mark.
+ */
+[[nodiscard]] uint32_t GetElapsedUs();
+
+/**
+ * @brief Logs the timeline, only the first call does.
+ */
+void Report();
+}    // namespace BootTimeline
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_BOOTTIMELINE_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
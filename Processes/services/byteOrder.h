@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    byteOrder.h
+ * @brief   Little-endian integers in byte buffers, at any alignment.
+ *
+ * The WAV files and the frames to and from the PC are little-endian. The bytes are read and
+ * written one at a time, the buffers don't have to be aligned.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_BYTEORDER_H
+#    define NILAIINI_SERVICES_BYTEORDER_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported functions */
+namespace ByteOrder
+{
+inline uint16_t GetLe16(const uint8_t* in)
+{
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t GetLe32(const uint8_t* in)
+{
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+inline void PutLe32(uint8_t* out, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(uint32_t); i++)
+    {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+}    // namespace ByteOrder
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_BYTEORDER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
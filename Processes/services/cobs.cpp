@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    cobs.cpp
+ * @brief   Source for the COBS encoder and decoder.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "cobs.h"
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Cobs
+{
+size_t EncodedSize(const uint8_t* data, size_t len)
+{
+    size_t size = 0;
+    Encode(data, len, [&size](const uint8_t*, size_t n) { size += n; });
+    return size;
+}
+
+size_t DecodeInPlace(uint8_t* data, size_t len)
+{
+    // The output never gets ahead of the input, decoding in place is safe.
+    size_t in  = 0;
+    size_t out = 0;
+    while (in < len)
+    {
+        uint8_t code = data[in++];
+        if (code == DELIMITER || in + code - 1 > len)
+        {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++)
+        {
+            data[out++] = data[in++];
+        }
+        if (code != 0xFF && in != len)
+        {
+            data[out++] = 0;
+        }
+    }
+    return out;
+}
+}    // namespace Cobs
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,87 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    cobs.h
+ * @brief   Consistent Overhead Byte Stuffing.
+ *
+ * COBS removes every 0x00 from a packet for at most one byte of overhead per 254 bytes, so that
+ * 0x00 can delimit the packets on a byte stream. A receiver that loses track of the stream
+ * resynchronizes on the next delimiter.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_COBS_H
+#    define NILAIINI_SERVICES_COBS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace Cobs
+{
+constexpr uint8_t DELIMITER = 0x00;
+
+constexpr size_t MaxEncodedSize(size_t len)
+{
+    return len + len / 254 + 1;
+}
+
+/**
+ * @brief Exact size of @p len bytes once encoded, delimiter excluded.
+ */
+size_t EncodedSize(const uint8_t* data, size_t len);
+
+/**
+ * @brief Encodes @p len bytes, without the delimiter.
+ * @param out Called with each piece of the encoded data, as `out(const uint8_t*, size_t)`.
+ * Nothing is buffered, the pieces point either in @p data or to the code bytes.
+ */
+template<typename Out>
+void Encode(const uint8_t* data, size_t len, Out&& out)
+{
+    size_t pos = 0;
+    while (true)
+    {
+        // A block is a run of up to 254 non-zero bytes, preceded by its length + 1.
+        size_t run = 0;
+        while (pos + run < len && run < 254 && data[pos + run] != 0)
+        {
+            run++;
+        }
+        uint8_t code = static_cast<uint8_t>(run + 1);
+        out(&code, 1);
+        out(&data[pos], run);
+        pos += run;
+
+        if (pos == len)
+        {
+            break;
+        }
+        // The zero ending a block is implied by its code, full blocks (0xFF) don't end with one.
+        if (run < 254)
+        {
+            pos++;
+        }
+    }
+}
+
+/**
+ * @brief Decodes a packet in place, the decoded packet is never longer than the encoded one.
+ * @param len Size of the packet, without its delimiter.
+ * @returns The size of the decoded packet, or 0 if it is malformed.
+ */
+size_t DecodeInPlace(uint8_t* data, size_t len);
+}    // namespace Cobs
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_COBS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    crc32.cpp
+ * @brief   Source for the CRC-32.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "crc32.h"
+
+#include <array>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t POLYNOMIAL = 0xEDB88320;
+
+constexpr std::array<uint32_t, 256> MakeTable()
+{
+    std::array<uint32_t, 256> table = {};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) != 0 ? (crc >> 1) ^ POLYNOMIAL : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+// Generated at compile time, lives in flash.
+constexpr std::array<uint32_t, 256> TABLE = MakeTable();
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Crc32
+{
+uint32_t Update(uint32_t crc, const void* data, size_t len)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    crc               = ~crc;
+    while (len-- != 0)
+    {
+        crc = TABLE[(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+}    // namespace Crc32
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    crc32.h
+ * @brief   CRC-32 as used by zlib, Ethernet and PNG (reflected, polynomial 0xEDB88320).
+ *
+ * Matches Python's zlib.crc32, which the host tools use. The STM32's CRC unit uses the same
+ * polynomial but neither reflects nor inverts, and only works on whole words.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_CRC32_H
+#    define NILAIINI_SERVICES_CRC32_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported functions */
+namespace Crc32
+{
+/**
+ * @brief Continues a CRC with more data. Start with a @p crc of 0.
+ */
+uint32_t Update(uint32_t crc, const void* data, size_t len);
+
+inline uint32_t Compute(const void* data, size_t len)
+{
+    return Update(0, data, len);
+}
+}    // namespace Crc32
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_CRC32_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
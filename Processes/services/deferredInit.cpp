@@ -0,0 +1,64 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    deferredInit.cpp
+ * @brief   Source for the DeferredInit.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "deferredInit.h"
+
+#include "Processes/services/bootTimeline.h"
+
+DeferredInit::Entry DeferredInit::s_tasks[MAX_TASKS] = {};
+size_t              DeferredInit::s_count            = 0;
+bool                DeferredInit::s_hasRun           = false;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+DeferredInit::DeferredInit(const std::string& label) : m_label(label)
+{
+}
+
+void DeferredInit::Run()
+{
+    if (s_hasRun)
+    {
+        return;
+    }
+    if (m_firstPass)
+    {
+        // The other modules run between this call and the next.
+        m_firstPass = false;
+        return;
+    }
+
+    BootTimeline::Mark("Live");
+    s_hasRun = true;
+    for (size_t i = 0; i < s_count; i++)
+    {
+        s_tasks[i].task();
+        BootTimeline::Mark(s_tasks[i].name);
+    }
+    s_count = 0;
+    BootTimeline::Report();
+}
+
+void DeferredInit::Defer(const char* name, Task task)
+{
+    if (s_hasRun || s_count == MAX_TASKS)
+    {
+        task();
+        return;
+    }
+    s_tasks[s_count++] = {name, task};
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
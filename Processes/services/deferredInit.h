@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    deferredInit.h
+ * @brief   Runs the parts of the boot that can wait until the application is live.
+ *
+ * Tasks queued with Defer() run from this module's second Run(): by then, every other module
+ * has run at least once, the audio path included. Each task is a phase of the BootTimeline,
+ * which is then reported.
+ *
+ * The benchmarks of the boot (RamFuncBench, the FLAC decoder's) always run here, the POST only
+ * holds checks. With APP_FAST_BOOT, the diagnostics that used to hold the boot (the
+ * configuration's dump, the SD card benchmark of the POST) are deferred here too.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_DEFERREDINIT_H
+#    define NILAIINI_SERVICES_DEFERREDINIT_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include <cstddef>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class DeferredInit : public cep::Module
+{
+public:
+    static constexpr size_t MAX_TASKS = 8;
+
+    using Task = void (*)();
+
+    DeferredInit(const std::string& label);
+    ~DeferredInit() override = default;
+
+    bool                             DoPost() override { return true; }
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    /**
+     * @brief Queues @p task, named @p name in the timeline. Runs it right away if the deferred
+     *        tasks already ran, or if there is no room left.
+     */
+    static void Defer(const char* name, Task task);
+
+    [[nodiscard]] static bool HasRun() { return s_hasRun; }
+
+private:
+    struct Entry
+    {
+        const char* name;
+        Task        task;
+    };
+
+    std::string m_label;
+    bool        m_firstPass = true;
+
+private:
+    static Entry  s_tasks[MAX_TASKS];
+    static size_t s_count;
+    static bool   s_hasRun;
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_DEFERREDINIT_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,117 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    diskStats.cpp
+ * @brief   Source for the DiskStats.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "diskStats.h"
+
+#include "Processes/services/log.h"
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t SECTOR_SIZE = 512;
+
+constexpr const char* OP_NAMES[USER_OP_COUNT] = {"read", "write", "ioctl"};
+
+/**
+ * @brief Largest latency counted in a bucket of the histogram.
+ */
+uint32_t UpperBoundOf(uint32_t bucket)
+{
+    return bucket == 0 ? 0 : static_cast<uint32_t>((1ULL << bucket) - 1);
+}
+
+uint32_t Percentile(const USER_OpStats& op, uint32_t perThousand)
+{
+    uint32_t target = static_cast<uint32_t>(
+      (static_cast<uint64_t>(op.calls) * perThousand + 999) / 1000);
+    uint32_t seen   = 0;
+    for (uint32_t bucket = 0; bucket < USER_LATENCY_BUCKETS; bucket++)
+    {
+        seen += op.histogram[bucket];
+        if (seen >= target && seen != 0)
+        {
+            uint32_t bound = UpperBoundOf(bucket);
+            return bound < op.maxUs ? bound : op.maxUs;
+        }
+    }
+    return op.maxUs;
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace DiskStats
+{
+Summary Summarize(const USER_OpStats& op)
+{
+    Summary summary;
+    summary.calls       = op.calls;
+    summary.errors      = op.errors;
+    summary.sectors     = op.sectors;
+    summary.multiSector = op.multiSector;
+    if (op.calls != 0)
+    {
+        summary.avgUs = static_cast<uint32_t>(op.totalUs / op.calls);
+        summary.maxUs = op.maxUs;
+        summary.p50Us = Percentile(op, 500);
+        summary.p99Us = Percentile(op, 990);
+    }
+    if (op.totalUs != 0)
+    {
+        summary.bytesPerSec = static_cast<uint32_t>(static_cast<uint64_t>(op.sectors) *
+                                                    SECTOR_SIZE * 1000000 / op.totalUs);
+    }
+    return summary;
+}
+
+void Log()
+{
+    USER_Stats stats;
+    USER_GetStats(&stats);
+
+    for (uint32_t op = 0; op < USER_OP_COUNT; op++)
+    {
+        Summary summary = Summarize(stats.ops[op]);
+        LOG_INFO("[disk] {}: {} calls, {} errors, {} sectors ({} multi), {} B/s, "
+                 "avg {} us, p50 {} us, p99 {} us, max {} us.",
+                 OP_NAMES[op],
+                 summary.calls,
+                 summary.errors,
+                 summary.sectors,
+                 summary.multiSector,
+                 summary.bytesPerSec,
+                 summary.avgUs,
+                 summary.p50Us,
+                 summary.p99Us,
+                 summary.maxUs);
+    }
+
+    const USER_SPI_Counters& spi = stats.spi;
+    LOG_INFO("[disk] busy: {} waits, {} timeouts, {} ms, max {} us. Data token: {} timeouts, "
+             "{} ms. {} commands failed, {} init retries, {} blocks rejected.",
+             spi.busyWaits,
+             spi.busyTimeouts,
+             static_cast<uint32_t>(spi.busyUs / 1000),
+             spi.busyMaxUs,
+             spi.tokenTimeouts,
+             static_cast<uint32_t>(spi.tokenWaitUs / 1000),
+             spi.cmdFailures,
+             spi.initRetries,
+             spi.rejectedBlocks);
+}
+}    // namespace DiskStats
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
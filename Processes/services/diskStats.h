@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    diskStats.h
+ * @brief   Summaries of the SD card driver's counters (see USER_GetStats() in user_diskio.h).
+ *
+ * The driver times every read, write and ioctl FatFs makes, and counts what happens on the SPI
+ * link underneath: time spent waiting for the card to be ready, timeouts, commands left
+ * unanswered. A slow card or a regression shows up as a shift of the percentiles, or as busy
+ * time growing faster than the number of sectors moved.
+ *
+ * The summaries are logged with Log(), or read with tools/umo.py disk (GET_DISK_STATS).
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_DISKSTATS_H
+#    define NILAIINI_SERVICES_DISKSTATS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "FATFS/Target/user_diskio.h"
+
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace DiskStats
+{
+struct Summary
+{
+    uint32_t calls       = 0;
+    uint32_t errors      = 0;
+    uint32_t sectors     = 0;
+    uint32_t multiSector = 0;
+    uint32_t avgUs       = 0;
+    uint32_t maxUs       = 0;
+    uint32_t p50Us       = 0;    //!< Upper bound of the histogram's bucket, within 2x.
+    uint32_t p99Us       = 0;
+    uint32_t bytesPerSec = 0;    //!< While the operations ran, 0 for ioctl.
+};
+
+Summary Summarize(const USER_OpStats& op);
+
+/**
+ * @brief Logs one line per kind of operation, and one for the SPI link.
+ */
+void Log();
+}    // namespace DiskStats
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_DISKSTATS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
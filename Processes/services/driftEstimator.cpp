@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    driftEstimator.cpp
+ * @brief   Source for the DriftEstimator.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "driftEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr float DAMPING = 0.707f;
+constexpr float TWO_PI  = 6.2831853f;
+constexpr float Q32     = 4294967296.0f;
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+void DriftEstimator::Start(uint32_t sampleRate, uint32_t tickRate, int32_t expectedPpm)
+{
+    m_sampleRate = sampleRate;
+    m_tickRate   = tickRate;
+    m_isLocked   = false;
+    m_drift      = std::clamp(static_cast<float>(expectedPpm) * 1e-6f,
+                         -MAX_CORRECTION,
+                         MAX_CORRECTION);
+    m_correction = m_drift;
+    m_phase      = 0.0f;
+    m_relocks    = 0;
+}
+
+void DriftEstimator::Update(uint64_t position, uint64_t ticks)
+{
+    // More than a second since the last, or back in time: the reference jumped.
+    uint64_t dticks = ticks - m_lastTicks;
+    if (!m_isLocked || dticks > m_tickRate)
+    {
+        Lock(position, ticks);
+        return;
+    }
+    if (dticks == 0)
+    {
+        return;
+    }
+    m_lastTicks = ticks;
+
+    while (ticks - m_startTicks >= m_tickRate)
+    {
+        m_startTicks += m_tickRate;
+        m_startPosition += uint64_t(m_sampleRate) << 32;
+    }
+    // Under a second of frames, in Q32: the remainder keeps the fraction.
+    uint64_t elapsed  = (ticks - m_startTicks) * m_sampleRate;
+    uint64_t expected = m_startPosition + ((elapsed / m_tickRate) << 32) +
+                        ((elapsed % m_tickRate) << 32) / m_tickRate;
+    float phase = static_cast<float>(static_cast<int64_t>(position - expected)) / Q32;
+    if (std::fabs(phase) > MAX_PHASE * static_cast<float>(m_sampleRate))
+    {
+        Lock(position, ticks);
+        return;
+    }
+
+    float omega = TWO_PI * m_bandwidth;
+    float rate  = static_cast<float>(m_sampleRate);
+    float dt    = static_cast<float>(dticks) / static_cast<float>(m_tickRate);
+    m_phase     = phase;
+    m_drift     = std::clamp(m_drift + omega * omega * dt / rate * phase,
+                         -MAX_CORRECTION,
+                         MAX_CORRECTION);
+    m_correction =
+      std::clamp(m_drift + 2.0f * DAMPING * omega / rate * phase, -MAX_CORRECTION, MAX_CORRECTION);
+}
+
+uint64_t DriftEstimator::GetStep() const
+{
+    return static_cast<uint64_t>(static_cast<int64_t>(uint64_t(1) << 32) -
+                                 static_cast<int64_t>(m_correction * Q32));
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Takes @p position at @p ticks as the start, the phase is 0 from there. The drift is kept.
+ */
+void DriftEstimator::Lock(uint64_t position, uint64_t ticks)
+{
+    if (m_isLocked)
+    {
+        m_relocks++;
+    }
+    m_isLocked      = true;
+    m_startTicks    = ticks;
+    m_startPosition = position;
+    m_lastTicks     = ticks;
+    m_phase         = 0.0f;
+    m_correction    = m_drift;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    driftEstimator.h
+ * @brief   Locks the position in a stream to a reference clock, by steering a Resampler.
+ *
+ * The I2S doesn't play at the rate of the content: 47991.07 Hz for 48 kHz (see I2sClock), and
+ * the crystal it comes from drifts with the temperature. Against the reference, the CPU's cycle
+ * counter or the clock of an external timeline, that's 16 ms lost per 90 s.
+ *
+ * Each time the DMA starts a period, the AudioEngine gives the position in the content that the
+ * DAC is at, and the time of the reference. The estimator compares it to where it should be:
+ *      phase = position - sampleRate * (time - start)
+ * and corrects the step of the resampler, with a proportional and an integral part:
+ *      drift += w^2 * dt / sampleRate * phase        (the rate error of the I2S)
+ *      step   = 1 - drift - 2 * zeta * w / sampleRate * phase
+ * a second-order loop, of natural frequency w = 2 pi bandwidth and damping zeta = 0.707. The
+ * drift ends up as the rate error of the I2S against the reference, and the phase at 0: the
+ * content plays at its rate, by the reference's clock, without accumulating an offset.
+ *
+ * The bandwidth filters the noise of the timestamps: the interrupt's latency for the cycle
+ * counter, but an external clock may tick by the millisecond: 0.01 Hz keeps it within half a
+ * millisecond. At the default 0.05 Hz, the lock settles within a minute from 800 ppm off.
+ * The correction is limited to MAX_CORRECTION: 0.1%, a pitch change of 1.7 cents. A phase of
+ * more than MAX_PHASE, or a reference that jumped, starts the lock over from there.
+ *
+ * It doesn't depend on the target, bench/driftBench.cpp simulates it against drifting clocks.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_DRIFTESTIMATOR_H
+#    define NILAIINI_SERVICES_DRIFTESTIMATOR_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+class DriftEstimator
+{
+public:
+    static constexpr float DEFAULT_BANDWIDTH = 0.05f;    //!< In Hz.
+    static constexpr float MAX_CORRECTION    = 0.001f;
+    static constexpr float MAX_PHASE         = 0.02f;    //!< In seconds.
+
+    /**
+     * @brief Starts over, locked on the next Update().
+     * @param tickRate    Of the reference clock, in Hz.
+     * @param expectedPpm Of the I2S against the reference, if known, for the lock to start
+     *                    there.
+     */
+    void Start(uint32_t sampleRate, uint32_t tickRate, int32_t expectedPpm = 0);
+
+    void SetBandwidth(float bandwidth) { m_bandwidth = bandwidth; }
+
+    /**
+     * @param position In Q32, of the content frame the DAC starts playing, as from
+     *                 Resampler::GetPosition().
+     * @param ticks    Of the reference, when it starts.
+     */
+    void Update(uint64_t position, uint64_t ticks);
+
+    //! Input frames per output frame, for Resampler::SetStep().
+    [[nodiscard]] uint64_t GetStep() const;
+    //! Of the I2S against the reference, as estimated.
+    [[nodiscard]] float GetDriftPpm() const { return m_drift * 1e6f; }
+    //! In frames, positive when ahead of the reference, at the last Update().
+    [[nodiscard]] float    GetPhase() const { return m_phase; }
+    [[nodiscard]] uint32_t GetRelocks() const { return m_relocks; }
+
+private:
+    uint32_t m_sampleRate = 0;
+    uint32_t m_tickRate   = 0;
+    float    m_bandwidth  = DEFAULT_BANDWIDTH;
+
+    bool     m_isLocked      = false;
+    uint64_t m_startTicks    = 0;    //!< Moved by whole seconds, not to overflow.
+    uint64_t m_startPosition = 0;
+    uint64_t m_lastTicks     = 0;
+    float    m_drift         = 0.0f;
+    float    m_correction    = 0.0f;    //!< Of the step.
+    float    m_phase         = 0.0f;
+    uint32_t m_relocks       = 0;
+
+private:
+    void Lock(uint64_t position, uint64_t ticks);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_DRIFTESTIMATOR_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,303 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    fileLogSink.cpp
+ * @brief   Source for the FileLogSink.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "fileLogSink.h"
+
+#include "Core/Inc/main.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+#include "NilaiTFO/services/filesystem.h"
+
+#include "Processes/services/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr const char* FILE_NAMES[FileLogSink::FILE_COUNT] = {
+  "LOG.TXT",
+  "LOG1.TXT",
+  "LOG2.TXT",
+  "LOG3.TXT",
+};
+
+constexpr bool IsPowerOfTwo(size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+static_assert(IsPowerOfTwo(FileLogSink::MIN_BUFFER_SIZE) &&
+                IsPowerOfTwo(FileLogSink::MAX_BUFFER_SIZE),
+              "The buffers must hold whole clusters or split one evenly, like the clusters");
+static_assert(FileLogSink::MIN_BUFFER_SIZE % FileLogSink::SECTOR_SIZE == 0,
+              "The buffers must hold whole sectors");
+static_assert(FileLogSink::MAX_BUFFER_SIZE >= FileLogSink::MIN_BUFFER_SIZE,
+              "APP_FILE_LOG_BUFFER_SECTORS must be at least 8");
+static_assert(FileLogSink::MAX_FILE_SIZE % FileLogSink::MAX_BUFFER_SIZE == 0,
+              "The files must hold whole buffers");
+
+//! Where the buffers are, in the main RAM: the FileLogSink itself is on the heap.
+alignas(4) uint8_t s_pool[2][FileLogSink::MAX_BUFFER_SIZE];
+}    // namespace
+
+FileLogSink* FileLogSink::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+FileLogSink::FileLogSink(const std::string& label) : m_label(label)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of FileLogSink!");
+    s_instance = this;
+
+    m_buffers[0].data = s_pool[0];
+    m_buffers[1].data = s_pool[1];
+}
+
+bool FileLogSink::DoPost()
+{
+    // The SD card is optional, the filesystem's POST already reports when it's missing.
+    return true;
+}
+
+void FileLogSink::Run()
+{
+    if (!m_isOpen)
+    {
+        if (m_failed || !cep::Filesystem::IsMounted())
+        {
+            return;
+        }
+        if (!Start())
+        {
+            m_failed = true;
+            LOG_ERROR("[{}]: Unable to create the log file, file logging disabled.", m_label);
+            return;
+        }
+    }
+
+    bool ok = true;
+    if (m_buffers[m_writeIdx].full)
+    {
+        ok = WriteFullBuffer();
+    }
+    else if (HAL_GetTick() - m_lastSync >= SYNC_PERIOD)
+    {
+        ok = SyncPartialBuffer();
+    }
+
+    if (!ok)
+    {
+        f_close(&m_file);
+        m_isOpen = false;
+        m_failed = true;
+        LOG_ERROR("[{}]: Unable to write the log file, file logging disabled.", m_label);
+    }
+}
+
+void FileLogSink::Tap(const char* first, size_t firstLen, const char* second, size_t secondLen)
+{
+    if (s_instance == nullptr || s_instance->m_failed)
+    {
+        return;
+    }
+
+    // Both parts go in together, so that lines from different contexts never interleave.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    s_instance->Append(first, firstLen);
+    s_instance->Append(second, secondLen);
+    __set_PRIMASK(primask);
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Copies data in the buffers, switching to the next one when the current is full.
+ * @note Must be called with interrupts disabled.
+ */
+void FileLogSink::Append(const char* data, size_t len)
+{
+    while (len != 0)
+    {
+        Buffer& buffer = m_buffers[m_fillIdx];
+        if (buffer.full)
+        {
+            // The card can't keep up.
+            m_droppedBytes = m_droppedBytes + len;
+            return;
+        }
+
+        size_t chunk = std::min(len, m_bufferSize - buffer.used);
+        std::memcpy(&buffer.data[buffer.used], data, chunk);
+        buffer.used = buffer.used + chunk;
+        data += chunk;
+        len -= chunk;
+
+        if (buffer.used == m_bufferSize)
+        {
+            buffer.full = true;
+            m_fillIdx   = m_fillIdx ^ 1;
+        }
+    }
+}
+
+/**
+ * @brief Grows the buffers to @p size, filling the oldest one up from the other.
+ * @note Only before the first write to the card, the buffers then hold what was logged since
+ *       the boot, in order.
+ */
+void FileLogSink::Resize(size_t size)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    Buffer& oldest = m_buffers[m_writeIdx];
+    Buffer& newest = m_buffers[m_writeIdx ^ 1];
+    if (oldest.full)
+    {
+        size_t newestUsed = newest.used;
+        size_t moved      = std::min(newestUsed, size - oldest.used);
+        std::memcpy(&oldest.data[oldest.used], newest.data, moved);
+        std::memmove(newest.data, &newest.data[moved], newestUsed - moved);
+        oldest.used = oldest.used + moved;
+        newest.used = newestUsed - moved;
+    }
+    // The newest one held at most the previous size, less than the new one.
+    oldest.full  = oldest.used == size;
+    newest.full  = false;
+    m_fillIdx    = oldest.full ? m_writeIdx ^ 1 : m_writeIdx;
+    m_bufferSize = size;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Writes the oldest buffer as a single aligned multi-sector write, then syncs.
+ */
+bool FileLogSink::WriteFullBuffer()
+{
+    Buffer& buffer  = m_buffers[m_writeIdx];
+    size_t  size    = m_bufferSize;
+    UINT    written = 0;
+    if (f_lseek(&m_file, m_base) != FR_OK ||
+        f_write(&m_file, buffer.data, size, &written) != FR_OK || written != size ||
+        f_sync(&m_file) != FR_OK)
+    {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    buffer.used = 0;
+    buffer.full = false;
+    __set_PRIMASK(primask);
+
+    m_writeIdx ^= 1;
+    m_base += size;
+    m_syncedUsed = 0;
+    m_lastSync   = HAL_GetTick();
+
+    if (m_base >= MAX_FILE_SIZE)
+    {
+        return Rotate();
+    }
+    return true;
+}
+
+/**
+ * @brief Persists the partially filled buffer, leaving the file position at its start.
+ */
+bool FileLogSink::SyncPartialBuffer()
+{
+    m_lastSync = HAL_GetTick();
+
+    // The buffer can only grow behind our back, the first `used` bytes are stable.
+    size_t used = m_buffers[m_writeIdx].used;
+    if (used == m_syncedUsed)
+    {
+        return true;
+    }
+
+    UINT written = 0;
+    if (f_lseek(&m_file, m_base) != FR_OK ||
+        f_write(&m_file, m_buffers[m_writeIdx].data, used, &written) != FR_OK ||
+        written != used || f_sync(&m_file) != FR_OK)
+    {
+        return false;
+    }
+    m_syncedUsed = used;
+    return true;
+}
+
+/**
+ * @brief Starts the first file since the boot, and sizes the buffers for the card.
+ */
+bool FileLogSink::Start()
+{
+    if (!Rotate())
+    {
+        return false;
+    }
+
+    // FatFs only mounts volumes whose clusters are a power of two sectors.
+    size_t cluster = static_cast<size_t>(m_file.obj.fs->csize) * SECTOR_SIZE;
+    size_t size    = std::clamp(cluster, MIN_BUFFER_SIZE, MAX_BUFFER_SIZE);
+    if (size != m_bufferSize)
+    {
+        Resize(size);
+    }
+    LOG_INFO("[{}]: Clusters of {} B, buffers of {} B.", m_label, cluster, size);
+    return true;
+}
+
+/**
+ * @brief Closes the current file, shifts the older ones and opens a new, empty LOG.TXT.
+ */
+bool FileLogSink::Rotate()
+{
+    if (m_isOpen)
+    {
+        f_close(&m_file);
+        m_isOpen = false;
+    }
+
+    // Errors are expected here, the older files don't necessarily exist.
+    f_unlink(FILE_NAMES[FILE_COUNT - 1]);
+    for (size_t i = FILE_COUNT - 1; i > 0; i--)
+    {
+        f_rename(FILE_NAMES[i - 1], FILE_NAMES[i]);
+    }
+
+    if (f_open(&m_file, FILE_NAMES[0], FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    {
+        return false;
+    }
+    m_isOpen     = true;
+    m_base       = 0;
+    m_syncedUsed = 0;
+    m_lastSync   = HAL_GetTick();
+
+    // Only points FatFs' next allocation at a contiguous free area: the file takes its clusters
+    // one after the other as it grows, each found at the first try. Without such an area
+    // (fragmented card), they are searched for as usual.
+    f_expand(&m_file, MAX_FILE_SIZE, 0);
+    return true;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
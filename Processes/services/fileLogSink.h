@@ -0,0 +1,124 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    fileLogSink.h
+ * @brief   Keeps a copy of everything sent on the log UART in files on the SD card.
+ *
+ * The log lines are gathered in two buffers of one cluster each. A full buffer is written with a
+ * single f_write at an offset that is a multiple of its size, which FatFs hands to the disk as
+ * one multi-block write of the whole cluster instead of going through its sector window. While
+ * one buffer is being written, the other one keeps filling up; if both are full, the incoming
+ * bytes are dropped and counted.
+ *
+ * The cluster size is only known once the card is mounted, until then the buffers hold
+ * MIN_BUFFER_SIZE bytes, and they grow when the first file is opened. They are kept between
+ * MIN_BUFFER_SIZE and MAX_BUFFER_SIZE, APP_FILE_LOG_BUFFER_SECTORS, 4 KiB by default for the
+ * RAM: beyond, e.g. with the 32 KiB clusters of most SDHC cards, a buffer is a part of a
+ * cluster, still written as one multi-block write. The sizes are all powers of two, so the
+ * buffers either hold whole clusters or split one evenly, a write never straddles two.
+ *
+ * The file is synced after every full buffer, and every SYNC_PERIOD ms when only part of a
+ * buffer is filled. In that case, the partial buffer is written and synced, but the file
+ * position goes back to the start of the buffer so that the full buffer is written in place,
+ * aligned, once complete.
+ *
+ * Files are rotated at boot and when they reach MAX_FILE_SIZE: LOG.TXT is the current file,
+ * LOG1.TXT the previous one, up to LOG3.TXT. For each new file, f_expand finds a contiguous free
+ * area of MAX_FILE_SIZE, where FatFs then allocates the clusters as the file grows, so that the
+ * writes don't search the FAT. Nothing is allocated ahead of the writes: a power cut leaves a
+ * file of what was synced, and no cluster outside of it.
+ *
+ * @note Appending is safe from any context, interrupts included. Writing to the card only
+ *       happens in Run().
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_FILELOGSINK_H
+#    define NILAIINI_SERVICES_FILELOGSINK_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include "Core/Inc/main.h"
+#    include "FATFS/App/fatfs.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class FileLogSink : public cep::Module
+{
+public:
+    static constexpr size_t   SECTOR_SIZE     = _MAX_SS;
+    static constexpr size_t   MIN_BUFFER_SIZE = 8 * SECTOR_SIZE;     //!< Also before the mount.
+    static constexpr size_t   MAX_BUFFER_SIZE = APP_FILE_LOG_BUFFER_SECTORS * SECTOR_SIZE;
+    static constexpr FSIZE_t  MAX_FILE_SIZE   = 1024 * 1024;
+    static constexpr size_t   FILE_COUNT      = 4;     //!< LOG.TXT, LOG1.TXT, ... LOG3.TXT.
+    static constexpr uint32_t SYNC_PERIOD     = 2000;  //!< In ms.
+
+    FileLogSink(const std::string& label);
+    //! Leaves the file as it was last synced, as a reset would.
+    ~FileLogSink() override { s_instance = nullptr; }
+
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    /**
+     * @brief Appends data to the current buffer. Matches UartTxDma::TapFunc.
+     * @note The data is given in two parts, for when it wraps around a ring buffer.
+     */
+    static void Tap(const char* first, size_t firstLen, const char* second, size_t secondLen);
+
+    uint32_t GetDroppedBytes() const { return m_droppedBytes; }
+    size_t   GetBufferSize() const { return m_bufferSize; }
+
+    static FileLogSink* Get() { return s_instance; }
+
+private:
+    struct Buffer
+    {
+        uint8_t*        data;
+        volatile size_t used;
+        volatile bool   full;
+    };
+
+    std::string m_label;
+
+    Buffer            m_buffers[2]   = {};
+    volatile size_t   m_bufferSize   = MIN_BUFFER_SIZE;
+    volatile uint8_t  m_fillIdx      = 0;    //!< Buffer receiving the data.
+    uint8_t           m_writeIdx     = 0;    //!< Oldest buffer not written to the file yet.
+    volatile uint32_t m_droppedBytes = 0;
+
+    FIL      m_file       = {};
+    bool     m_isOpen     = false;
+    bool     m_failed     = false;    //!< Gave up on the card until the next boot.
+    FSIZE_t  m_base       = 0;        //!< Offset of m_writeIdx in the file.
+    size_t   m_syncedUsed = 0;        //!< Bytes of m_writeIdx already synced.
+    uint32_t m_lastSync   = 0;
+
+private:
+    static FileLogSink* s_instance;
+
+private:
+    void Append(const char* data, size_t len);
+    void Resize(size_t size);
+    bool WriteFullBuffer();
+    bool SyncPartialBuffer();
+    bool Start();
+    bool Rotate();
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_FILELOGSINK_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
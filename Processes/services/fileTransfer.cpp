@@ -0,0 +1,420 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    fileTransfer.cpp
+ * @brief   Source for the FileTransfer.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "fileTransfer.h"
+
+#include "Core/Inc/main.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+#include "NilaiTFO/services/filesystem.h"
+
+#include "Processes/drivers/criticalSection.h"
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/crc32.h"
+#include "Processes/services/frameLink.h"
+#include "Processes/services/log.h"
+
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr const char* TEMP_NAME = "UPLOAD.TMP";
+
+static_assert(FileTransfer::BUFFER_SIZE % FileTransfer::BLOCK_SIZE == 0,
+              "The buffers must hold whole blocks");
+static_assert(FileTransfer::BLOCK_SIZE + sizeof(uint16_t) <= FrameLink::MAX_RX_BODY,
+              "A block must fit in a frame");
+}    // namespace
+
+FileTransfer* FileTransfer::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+FileTransfer::FileTransfer(const std::string& label) : m_label(label)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of FileTransfer!");
+    s_instance = this;
+}
+
+bool FileTransfer::DoPost()
+{
+    return true;
+}
+
+void FileTransfer::Run()
+{
+    switch (m_state)
+    {
+        case State::Opening:
+            if (!cep::Filesystem::IsMounted())
+            {
+                Finish(Status::NoCard);
+            }
+            else if (!OpenFile())
+            {
+                Finish(Status::OpenFailed);
+            }
+            else
+            {
+                LOG_INFO("[{}]: Receiving {} ({} bytes).", m_label, m_name, m_size);
+                m_state = State::Receiving;
+                SendAck();
+            }
+            break;
+
+        case State::Receiving:
+        case State::Closing:
+            if (m_buffers[m_writeIdx].full)
+            {
+                if (!WriteBuffer())
+                {
+                    CloseFile(false);
+                    Finish(Status::WriteFailed);
+                    break;
+                }
+                // Room was made, let the host know right away.
+                SendAck();
+            }
+
+            if (m_state == State::Closing && m_written == m_size)
+            {
+                if (m_crc != m_expectedCrc)
+                {
+                    CloseFile(false);
+                    Finish(Status::CrcMismatch);
+                }
+                else
+                {
+                    Finish(CloseFile(true) ? Status::Ok : Status::WriteFailed);
+                }
+            }
+            else if (HAL_GetTick() - m_lastActivity > IDLE_TIMEOUT)
+            {
+                m_abortStatus = Status::TimedOut;
+                m_state       = State::Aborting;
+            }
+            break;
+
+        case State::Aborting:
+            CloseFile(false);
+            Finish(m_abortStatus);
+            break;
+
+        case State::Idle:
+        default: break;
+    }
+}
+
+void FileTransfer::OnFrame(uint8_t id, const uint8_t* body, size_t len)
+{
+    FileTransfer* self = s_instance;
+    if (self == nullptr)
+    {
+        return;
+    }
+    self->m_lastActivity = HAL_GetTick();
+
+    switch (id)
+    {
+        case FrameId::Open: self->HandleOpen(body, len); break;
+        case FrameId::Data: self->HandleData(body, len); break;
+        case FrameId::Close: self->HandleClose(body, len); break;
+        case FrameId::Abort:
+            if (self->m_state == State::Receiving || self->m_state == State::Closing)
+            {
+                self->m_abortStatus = Status::Aborted;
+                self->m_state       = State::Aborting;
+            }
+            break;
+        default: break;
+    }
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @note Called from an interrupt.
+ */
+void FileTransfer::HandleOpen(const uint8_t* body, size_t len)
+{
+    if (len <= sizeof(uint32_t) || len - sizeof(uint32_t) > MAX_NAME)
+    {
+        SendDone(Status::InvalidFrame);
+        return;
+    }
+    uint32_t    size    = ByteOrder::GetLe32(body);
+    const char* name    = reinterpret_cast<const char*>(&body[sizeof(uint32_t)]);
+    size_t      nameLen = len - sizeof(uint32_t);
+
+    switch (m_state)
+    {
+        case State::Idle:
+            std::memcpy(m_name, name, nameLen);
+            m_name[nameLen] = '\0';
+            m_size          = size;
+            m_state         = State::Opening;
+            break;
+
+        case State::Receiving:
+            if (m_nextSeq == 0 && size == m_size && std::strlen(m_name) == nameLen &&
+                std::memcmp(m_name, name, nameLen) == 0)
+            {
+                // Our ACK got lost.
+                SendAck();
+            }
+            else
+            {
+                // The host started over, it retries the OPEN until the old upload is gone.
+                m_abortStatus = Status::Aborted;
+                m_state       = State::Aborting;
+            }
+            break;
+
+        case State::Opening:
+        case State::Closing:
+        case State::Aborting:
+        default:
+            // Busy, the host retries.
+            break;
+    }
+}
+
+/**
+ * @note Called from an interrupt.
+ */
+void FileTransfer::HandleData(const uint8_t* body, size_t len)
+{
+    if (m_state != State::Receiving || len <= sizeof(uint16_t))
+    {
+        return;
+    }
+    uint16_t seq = ByteOrder::GetLe16(body);
+    body += sizeof(uint16_t);
+    len -= sizeof(uint16_t);
+
+    uint16_t expected = static_cast<uint16_t>(m_nextSeq);
+    if (seq != expected)
+    {
+        if (static_cast<uint16_t>(expected - seq) <= 0x8000)
+        {
+            // Already have it, our ACK got lost.
+            SendAck();
+        }
+        else if (!m_nakSent)
+        {
+            // One got lost on the way, everything after it is sent again anyway.
+            m_nakSent = true;
+            SendNak();
+        }
+        return;
+    }
+
+    if ((len != BLOCK_SIZE && m_received + len != m_size) || m_received + len > m_size)
+    {
+        m_abortStatus = Status::InvalidFrame;
+        m_state       = State::Aborting;
+        return;
+    }
+
+    Buffer& buffer = m_buffers[m_fillIdx];
+    if (buffer.full)
+    {
+        // Past the credit we gave, the host will send it again.
+        return;
+    }
+    std::memcpy(&buffer.data[buffer.used], body, len);
+    buffer.used = buffer.used + len;
+    m_received += len;
+    m_nextSeq++;
+    m_nakSent = false;
+
+    if (buffer.used == BUFFER_SIZE || m_received == m_size)
+    {
+        buffer.full = true;
+        m_fillIdx ^= 1;
+    }
+    SendAck();
+}
+
+/**
+ * @note Called from an interrupt.
+ */
+void FileTransfer::HandleClose(const uint8_t* body, size_t len)
+{
+    if (len != sizeof(uint32_t))
+    {
+        return;
+    }
+
+    if (m_state == State::Receiving && m_received == m_size)
+    {
+        m_expectedCrc = ByteOrder::GetLe32(body);
+        m_state       = State::Closing;
+    }
+    else if (m_state == State::Idle)
+    {
+        // Our DONE got lost.
+        SendDone(m_lastStatus);
+    }
+}
+
+bool FileTransfer::OpenFile()
+{
+    if (f_open(&m_file, TEMP_NAME, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    {
+        return false;
+    }
+    m_isOpen = true;
+
+    // Only points the allocator at a contiguous area, the file stays empty until written.
+    f_expand(&m_file, m_size, 0);
+
+    {
+        CriticalSection cs;
+        for (Buffer& buffer : m_buffers)
+        {
+            buffer.used = 0;
+            buffer.full = false;
+        }
+        m_fillIdx  = 0;
+        m_writeIdx = 0;
+        m_nextSeq  = 0;
+        m_received = 0;
+        m_nakSent  = false;
+    }
+    m_written      = 0;
+    m_crc          = 0;
+    m_startTime    = HAL_GetTick();
+    m_lastActivity = m_startTime;
+    return true;
+}
+
+/**
+ * @brief Writes the oldest full buffer. Whole buffers land on sector boundaries and go to the
+ * card as one multi-block write.
+ */
+bool FileTransfer::WriteBuffer()
+{
+    Buffer& buffer  = m_buffers[m_writeIdx];
+    size_t  used    = buffer.used;
+    UINT    written = 0;
+    if (used != 0 && (f_write(&m_file, buffer.data, used, &written) != FR_OK || written != used))
+    {
+        return false;
+    }
+    m_crc = Crc32::Update(m_crc, buffer.data, used);
+    m_written += used;
+
+    {
+        CriticalSection cs;
+        buffer.used = 0;
+        buffer.full = false;
+    }
+    m_writeIdx ^= 1;
+    return true;
+}
+
+/**
+ * @brief Closes the temporary file, moving it over the destination if @p keep is set.
+ */
+bool FileTransfer::CloseFile(bool keep)
+{
+    if (!m_isOpen)
+    {
+        return false;
+    }
+    FRESULT res = f_close(&m_file);
+    m_isOpen    = false;
+
+    if (keep && res == FR_OK)
+    {
+        // The destination doesn't necessarily exist.
+        f_unlink(m_name);
+        res = f_rename(TEMP_NAME, m_name);
+    }
+    if (!keep || res != FR_OK)
+    {
+        f_unlink(TEMP_NAME);
+    }
+    return keep && res == FR_OK;
+}
+
+void FileTransfer::Finish(Status status)
+{
+    if (status == Status::Ok)
+    {
+        uint32_t elapsed = HAL_GetTick() - m_startTime;
+        LOG_INFO("[{}]: Received {} in {} ms ({} B/s).",
+                 m_label,
+                 m_name,
+                 elapsed,
+                 elapsed != 0 ? static_cast<uint32_t>(uint64_t(m_size) * 1000 / elapsed) : 0);
+    }
+    else
+    {
+        LOG_ERROR("[{}]: Upload of {} failed: {}.", m_label, m_name, static_cast<int>(status));
+    }
+
+    m_lastStatus = status;
+    m_state      = State::Idle;
+    SendDone(status);
+}
+
+/**
+ * @brief Blocks the host may send past the next one, which is the room left in the buffers.
+ */
+uint16_t FileTransfer::Credit() const
+{
+    size_t blocks = 0;
+    for (const Buffer& buffer : m_buffers)
+    {
+        if (!buffer.full)
+        {
+            blocks += (BUFFER_SIZE - buffer.used) / BLOCK_SIZE;
+        }
+    }
+    return static_cast<uint16_t>(blocks);
+}
+
+void FileTransfer::SendAck() const
+{
+    // The sequence and the credit must come from the same instant, or the window could overshoot.
+    CriticalSection cs;
+    uint16_t        seq    = static_cast<uint16_t>(m_nextSeq);
+    uint16_t        credit = Credit();
+    uint8_t body[] = {static_cast<uint8_t>(seq),
+                      static_cast<uint8_t>(seq >> 8),
+                      static_cast<uint8_t>(credit),
+                      static_cast<uint8_t>(credit >> 8)};
+    FrameLink::Send(FrameId::Ack, body, sizeof(body));
+}
+
+void FileTransfer::SendNak() const
+{
+    uint16_t seq    = static_cast<uint16_t>(m_nextSeq);
+    uint8_t  body[] = {static_cast<uint8_t>(seq), static_cast<uint8_t>(seq >> 8)};
+    FrameLink::Send(FrameId::Nak, body, sizeof(body));
+}
+
+void FileTransfer::SendDone(Status status) const
+{
+    uint8_t body = static_cast<uint8_t>(status);
+    FrameLink::Send(FrameId::Done, &body, sizeof(body));
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,154 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    fileTransfer.h
+ * @brief   Receives files on the SD card through FrameLink, see tools/upload.py for the sender.
+ *
+ * Frames from the host, registered on the UmoDispatcher:
+ *  - OPEN  (0x10): size (u32) | name. Starts a new upload, aborting the current one.
+ *  - DATA  (0x11): seq (u16) | up to BLOCK_SIZE bytes. Every block is full but the last.
+ *  - CLOSE (0x12): crc32 of the whole file (u32). Once all blocks were acknowledged.
+ *  - ABORT (0x13).
+ * Frames to the host:
+ *  - ACK   (0x18): next seq (u16) | credit (u16). Every block before `next seq` is stored; the
+ *                  host may send up to `credit` blocks from there.
+ *  - NAK   (0x19): next seq (u16). A block was lost, everything from there must be sent again.
+ *  - DONE  (0x1A): status (u8), see FileTransfer::Status.
+ *
+ * The window is the room left in two buffers of BUFFER_SIZE bytes. The blocks are decoded into
+ * one of them straight from the UART's interrupt, while Run() writes the other one to the card
+ * as a single sector-aligned write. Reception and writing overlap, and the host is only slowed
+ * down when the card falls behind by a whole buffer.
+ *
+ * The data goes to a temporary file, renamed over the destination once the CRC matched; a
+ * failed upload never leaves a truncated file in place.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_FILETRANSFER_H
+#    define NILAIINI_SERVICES_FILETRANSFER_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include "FATFS/App/fatfs.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class FileTransfer : public cep::Module
+{
+public:
+    static constexpr size_t   BLOCK_SIZE   = 1024;
+    static constexpr size_t   BUFFER_SIZE  = 8 * _MAX_SS;
+    static constexpr size_t   MAX_NAME     = 64;
+    static constexpr uint32_t IDLE_TIMEOUT = 10000;    //!< In ms, before giving up on the host.
+
+    enum FrameId : uint8_t
+    {
+        Open  = 0x10,
+        Data  = 0x11,
+        Close = 0x12,
+        Abort = 0x13,
+        Ack   = 0x18,
+        Nak   = 0x19,
+        Done  = 0x1A,
+    };
+
+    enum class Status : uint8_t
+    {
+        Ok           = 0,
+        NoCard       = 1,
+        OpenFailed   = 2,
+        WriteFailed  = 3,
+        CrcMismatch  = 4,
+        Aborted      = 5,
+        TimedOut     = 6,
+        InvalidFrame = 7,
+    };
+
+    FileTransfer(const std::string& label);
+    ~FileTransfer() override = default;
+
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    /**
+     * @brief Handles the frames of the protocol. Matches UmoDispatcher::Handler.
+     */
+    static void OnFrame(uint8_t id, const uint8_t* body, size_t len);
+
+    static FileTransfer* Get() { return s_instance; }
+
+private:
+    enum class State : uint8_t
+    {
+        Idle,
+        Opening,      //!< OPEN received, Run() creates the file.
+        Receiving,    //!< Blocks are being received and written.
+        Closing,      //!< All blocks received, Run() writes the rest and checks the CRC.
+        Aborting,     //!< Run() deletes the temporary file.
+    };
+
+    struct Buffer
+    {
+        alignas(4) uint8_t data[BUFFER_SIZE];
+        volatile size_t used;
+        volatile bool   full;
+    };
+
+    std::string m_label;
+
+    volatile State    m_state              = State::Idle;
+    Status            m_abortStatus        = Status::Aborted;
+    Status            m_lastStatus         = Status::Ok;
+    char              m_name[MAX_NAME + 1] = {};
+    uint32_t          m_size               = 0;
+    uint32_t          m_expectedCrc        = 0;
+    uint32_t          m_nextSeq            = 0;    //!< Next block expected.
+    uint32_t          m_received           = 0;    //!< Bytes accepted in the buffers.
+    bool              m_nakSent            = false;
+    volatile uint32_t m_lastActivity       = 0;
+
+    Buffer   m_buffers[2] = {};
+    uint8_t  m_fillIdx    = 0;    //!< Buffer receiving the blocks.
+    uint8_t  m_writeIdx   = 0;    //!< Oldest buffer not written to the file yet.
+    FIL      m_file       = {};
+    bool     m_isOpen     = false;
+    uint32_t m_written    = 0;
+    uint32_t m_crc        = 0;
+    uint32_t m_startTime  = 0;
+
+private:
+    static FileTransfer* s_instance;
+
+private:
+    void HandleOpen(const uint8_t* body, size_t len);
+    void HandleData(const uint8_t* body, size_t len);
+    void HandleClose(const uint8_t* body, size_t len);
+
+    bool OpenFile();
+    bool WriteBuffer();
+    void Finish(Status status);
+    bool CloseFile(bool keep);
+
+    uint16_t Credit() const;
+    void     SendAck() const;
+    void     SendNak() const;
+    void     SendDone(Status status) const;
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_FILETRANSFER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
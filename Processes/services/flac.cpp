@@ -0,0 +1,838 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    flac.cpp
+ * @brief   Source for the Flac decoder.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "flac.h"
+
+#include "Processes/services/profiler.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t MARKER          = 0x664C6143;    // "fLaC"
+constexpr uint8_t  STREAMINFO      = 0;
+constexpr size_t   STREAMINFO_SIZE = 34;
+constexpr uint32_t SYNC            = 0x7FFC;    //!< The 15 first bits of a frame.
+constexpr size_t   CRC16_SIZE      = 2;
+constexpr size_t   OUT_CHANNELS    = 2;
+
+enum ChannelCode : uint32_t
+{
+    LeftSide  = 8,
+    SideRight = 9,
+    MidSide   = 10,
+};
+
+/**
+ * @brief CRC-8 of the frame headers (x^8 + x^2 + x + 1).
+ */
+struct Crc8Table
+{
+    uint8_t values[256] = {};
+
+    constexpr Crc8Table()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (size_t bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1;
+            }
+            values[i] = static_cast<uint8_t>(crc);
+        }
+    }
+};
+constexpr Crc8Table CRC8;
+
+/**
+ * @brief CRC-16 of the frames (x^16 + x^15 + x^2 + 1).
+ */
+struct Crc16Table
+{
+    uint16_t values[256] = {};
+
+    constexpr Crc16Table()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i << 8;
+            for (size_t bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x8000) != 0 ? (crc << 1) ^ 0x8005 : crc << 1;
+            }
+            values[i] = static_cast<uint16_t>(crc);
+        }
+    }
+};
+constexpr Crc16Table CRC16;
+
+uint8_t ComputeCrc8(const uint8_t* data, size_t size)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = CRC8.values[crc ^ data[i]];
+    }
+    return crc;
+}
+
+uint16_t ComputeCrc16(const uint8_t* data, size_t size)
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = static_cast<uint16_t>(crc << 8) ^ CRC16.values[(crc >> 8) ^ data[i]];
+    }
+    return crc;
+}
+
+uint32_t GetBe24(const uint8_t* in)
+{
+    return (in[0] << 16) | (in[1] << 8) | in[2];
+}
+
+uint32_t GetBe32(const uint8_t* in)
+{
+    return (static_cast<uint32_t>(in[0]) << 24) | GetBe24(&in[1]);
+}
+
+/**
+ * @brief Reads the bits of a frame from the most significant, through a 64-bit cache. Past the
+ *        end, it reads zeros: the caller checks IsPastEnd() once it's done.
+ */
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    /**
+     * @param bits Up to 32.
+     */
+    uint32_t Read(uint32_t bits)
+    {
+        if (bits == 0)
+        {
+            return 0;
+        }
+        if (m_bits < bits)
+        {
+            Refill();
+        }
+        uint32_t value = static_cast<uint32_t>(m_cache >> (64 - bits));
+        m_cache <<= bits;
+        m_bits -= bits;
+        return value;
+    }
+
+    int32_t ReadSigned(uint32_t bits)
+    {
+        if (bits == 0)
+        {
+            return 0;
+        }
+        // Sign-extends from the top of a 32-bit word.
+        return static_cast<int32_t>(Read(bits) << (32 - bits)) >> (32 - bits);
+    }
+
+    /**
+     * @returns The number of zeros before the next one.
+     */
+    uint32_t ReadUnary()
+    {
+        uint32_t count = 0;
+        while (true)
+        {
+            if (m_bits <= 56)
+            {
+                Refill();
+            }
+            if (m_cache != 0)
+            {
+                // The cache is 0 past its bits, the first one is in them.
+                uint32_t zeros = __builtin_clzll(m_cache);
+                m_cache        = (m_cache << zeros) << 1;
+                m_bits -= zeros + 1;
+                return count + zeros;
+            }
+            count += m_bits;
+            m_bits = 0;
+            if (m_next > m_size)
+            {
+                return count;
+            }
+        }
+    }
+
+    int32_t ReadRice(uint32_t parameter)
+    {
+        uint32_t folded = (ReadUnary() << parameter) | Read(parameter);
+        return static_cast<int32_t>(folded >> 1) ^ -static_cast<int32_t>(folded & 1);
+    }
+
+    void AlignToByte() { Read(m_bits % 8); }
+
+    [[nodiscard]] size_t GetPosition() const { return m_next - m_bits / 8; }
+    [[nodiscard]] bool   IsPastEnd() const { return m_next * 8 - m_bits > m_size * 8; }
+
+private:
+    const uint8_t* m_data;
+    size_t         m_size;
+    size_t         m_next  = 0;    //!< Byte to load in the cache.
+    uint64_t       m_cache = 0;    //!< Its bits from the top.
+    uint32_t       m_bits  = 0;
+
+private:
+    void Refill()
+    {
+        while (m_bits <= 56)
+        {
+            uint64_t byte = m_next < m_size ? m_data[m_next] : 0;
+            m_cache |= byte << (56 - m_bits);
+            m_bits += 8;
+            m_next++;
+        }
+    }
+};
+
+/**
+ * @brief Writes bits from the most significant, the counterpart of the BitReader. Past the end
+ *        of the buffer, it only counts them.
+ */
+class BitWriter
+{
+public:
+    BitWriter(uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    /**
+     * @param bits Up to 32.
+     */
+    void Write(uint32_t value, uint32_t bits)
+    {
+        for (uint32_t bit = bits; bit > 0; bit--)
+        {
+            size_t byte = m_bits / 8;
+            if (byte < m_size)
+            {
+                uint8_t mask = static_cast<uint8_t>(0x80 >> (m_bits % 8));
+                m_data[byte] = ((value >> (bit - 1)) & 1) != 0 ? m_data[byte] | mask
+                                                                : m_data[byte] & ~mask;
+            }
+            m_bits++;
+        }
+    }
+
+    void WriteSigned(int32_t value, uint32_t bits) { Write(static_cast<uint32_t>(value), bits); }
+
+    void WriteRice(int32_t value, uint32_t parameter)
+    {
+        uint32_t folded = value >= 0 ? static_cast<uint32_t>(value) << 1
+                                     : (static_cast<uint32_t>(-(value + 1)) << 1) | 1;
+        Write(0, folded >> parameter);
+        Write(1, 1);
+        Write(folded, parameter);
+    }
+
+    void AlignToByte() { Write(0, (8 - m_bits % 8) % 8); }
+
+    [[nodiscard]] size_t GetPosition() const { return m_bits / 8; }
+    [[nodiscard]] bool   IsPastEnd() const { return m_bits > m_size * 8; }
+
+private:
+    uint8_t* m_data;
+    size_t   m_size;
+    size_t   m_bits = 0;
+};
+
+/**
+ * @brief Decodes the residuals of the samples after the first @p order, in place.
+ */
+bool DecodeResidual(BitReader& in, int32_t* out, size_t count, size_t order)
+{
+    uint32_t method = in.Read(2);
+    if (method > 1)
+    {
+        return false;
+    }
+    uint32_t parameterBits  = method == 0 ? 4 : 5;
+    uint32_t escape         = (1U << parameterBits) - 1;
+    uint32_t partitionOrder = in.Read(4);
+    size_t   partitionSize  = count >> partitionOrder;
+    if ((partitionSize << partitionOrder) != count || partitionSize < order)
+    {
+        return false;
+    }
+
+    size_t i = order;
+    for (size_t partition = 0; partition < (size_t(1) << partitionOrder); partition++)
+    {
+        size_t   end       = (partition + 1) * partitionSize;
+        uint32_t parameter = in.Read(parameterBits);
+        if (parameter == escape)
+        {
+            uint32_t bits = in.Read(5);
+            for (; i < end; i++)
+            {
+                out[i] = in.ReadSigned(bits);
+            }
+        }
+        else
+        {
+            for (; i < end; i++)
+            {
+                out[i] = in.ReadRice(parameter);
+            }
+        }
+    }
+    return true;
+}
+
+bool DecodeFixed(BitReader& in, int32_t* out, size_t count, uint32_t bits, size_t order)
+{
+    if (order > count)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < order; i++)
+    {
+        out[i] = in.ReadSigned(bits);
+    }
+    if (!DecodeResidual(in, out, count, order))
+    {
+        return false;
+    }
+
+    switch (order)
+    {
+        case 1:
+            for (size_t i = 1; i < count; i++)
+            {
+                out[i] += out[i - 1];
+            }
+            break;
+        case 2:
+            for (size_t i = 2; i < count; i++)
+            {
+                out[i] += 2 * out[i - 1] - out[i - 2];
+            }
+            break;
+        case 3:
+            for (size_t i = 3; i < count; i++)
+            {
+                out[i] += 3 * (out[i - 1] - out[i - 2]) + out[i - 3];
+            }
+            break;
+        case 4:
+            for (size_t i = 4; i < count; i++)
+            {
+                out[i] += 4 * (out[i - 1] + out[i - 3]) - 6 * out[i - 2] - out[i - 4];
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool DecodeLpc(BitReader& in, int32_t* out, size_t count, uint32_t bits, size_t order)
+{
+    if (order > count)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < order; i++)
+    {
+        out[i] = in.ReadSigned(bits);
+    }
+    uint32_t precision = in.Read(4) + 1;
+    int32_t  shift     = in.ReadSigned(5);
+    if (precision == 16 || shift < 0)
+    {
+        return false;
+    }
+    // Reversed, the coefficient of the oldest sample first, in the order they're summed.
+    int32_t coefficients[Flac::MAX_LPC_ORDER];
+    for (size_t i = 0; i < order; i++)
+    {
+        coefficients[order - 1 - i] = in.ReadSigned(precision);
+    }
+    if (!DecodeResidual(in, out, count, order))
+    {
+        return false;
+    }
+
+    for (size_t i = order; i < count; i++)
+    {
+        const int32_t* history = &out[i - order];
+        int64_t        sum     = 0;
+        for (size_t tap = 0; tap < order; tap++)
+        {
+            sum += static_cast<int64_t>(coefficients[tap]) * history[tap];
+        }
+        out[i] += static_cast<int32_t>(sum >> shift);
+    }
+    return true;
+}
+
+bool DecodeSubframe(BitReader& in, int32_t* out, size_t count, uint32_t bits)
+{
+    if (in.Read(1) != 0)
+    {
+        return false;
+    }
+    uint32_t type   = in.Read(6);
+    uint32_t wasted = 0;
+    if (in.Read(1) != 0)
+    {
+        wasted = in.ReadUnary() + 1;
+        if (wasted >= bits)
+        {
+            return false;
+        }
+        bits -= wasted;
+    }
+
+    bool decoded = true;
+    if (type == 0)
+    {
+        std::fill(out, out + count, in.ReadSigned(bits));
+    }
+    else if (type == 1)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = in.ReadSigned(bits);
+        }
+    }
+    else if (type >= 8 && type <= 12)
+    {
+        decoded = DecodeFixed(in, out, count, bits, type - 8);
+    }
+    else if (type >= 32)
+    {
+        decoded = DecodeLpc(in, out, count, bits, type - 31);
+    }
+    else
+    {
+        return false;
+    }
+
+    if (decoded && wasted != 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = static_cast<int32_t>(static_cast<uint32_t>(out[i]) << wasted);
+        }
+    }
+    return decoded;
+}
+
+uint32_t GetBlockSize(BitReader& in, uint32_t code)
+{
+    if (code == 1)
+    {
+        return 192;
+    }
+    if (code >= 2 && code <= 5)
+    {
+        return 576U << (code - 2);
+    }
+    if (code == 6)
+    {
+        return in.Read(8) + 1;
+    }
+    if (code == 7)
+    {
+        return in.Read(16) + 1;
+    }
+    if (code >= 8)
+    {
+        return 256U << (code - 8);
+    }
+    return 0;
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Flac
+{
+bool ParseStreamInfo(const uint8_t* file, size_t size, StreamInfo& info)
+{
+    bool isLast = false;
+    if (file == nullptr || size < STREAMINFO_END || GetBe32(file) != MARKER ||
+        (file[MARKER_SIZE] & 0x7F) != STREAMINFO ||
+        GetMetadataSize(&file[MARKER_SIZE], isLast) != HEADER_SIZE + STREAMINFO_SIZE)
+    {
+        return false;
+    }
+
+    // | min block u16 | max block u16 | min frame u24 | max frame u24 | rate u20 | channels u3
+    // | bits per sample u5 | samples u36 | MD5 |
+    const uint8_t* body = &file[MARKER_SIZE + HEADER_SIZE];
+    uint64_t packed     = (static_cast<uint64_t>(GetBe32(&body[10])) << 32) | GetBe32(&body[14]);
+    info.maxBlockSize   = (body[2] << 8) | body[3];
+    info.maxFrameSize   = GetBe24(&body[7]);
+    info.sampleRate     = static_cast<uint32_t>(packed >> 44);
+    info.channels       = static_cast<uint8_t>(((packed >> 41) & 0x07) + 1);
+    info.bitsPerSample  = static_cast<uint8_t>(((packed >> 36) & 0x1F) + 1);
+    info.totalSamples   = packed & 0xFFFFFFFFFULL;
+    return info.channels <= MAX_CHANNELS && info.maxBlockSize <= MAX_BLOCK_SIZE &&
+           info.bitsPerSample >= 8 && info.bitsPerSample <= 24;
+}
+
+size_t GetMetadataSize(const uint8_t* header, bool& isLast)
+{
+    isLast = (header[0] & 0x80) != 0;
+    return HEADER_SIZE + GetBe24(&header[1]);
+}
+
+size_t WriteStreamInfo(uint8_t* out, size_t size, const StreamInfo& info)
+{
+    if (out == nullptr || size < STREAMINFO_END)
+    {
+        return 0;
+    }
+
+    BitWriter writer(out, size);
+    writer.Write(MARKER, 32);
+    writer.Write(0x80 | STREAMINFO, 8);    // The last metadata block.
+    writer.Write(STREAMINFO_SIZE, 24);
+    writer.Write(info.maxBlockSize, 16);
+    writer.Write(info.maxBlockSize, 16);
+    writer.Write(0, 24);    // The smallest frame, unknown.
+    writer.Write(info.maxFrameSize, 24);
+    writer.Write(info.sampleRate, 20);
+    writer.Write(info.channels - 1U, 3);
+    writer.Write(info.bitsPerSample - 1U, 5);
+    writer.Write(static_cast<uint32_t>(info.totalSamples >> 32), 4);
+    writer.Write(static_cast<uint32_t>(info.totalSamples), 32);
+    // The MD5 of the samples, 0 when unknown.
+    for (size_t i = 0; i < 4; i++)
+    {
+        writer.Write(0, 32);
+    }
+    return writer.GetPosition();
+}
+
+size_t WriteBenchFrame(uint8_t* out, size_t size, StreamInfo& info)
+{
+    constexpr uint32_t BITS      = 16;
+    constexpr uint32_t PRECISION = 15;
+    constexpr int32_t  SHIFT     = 15;
+    //! Sums to 0.94, the filter stays stable.
+    constexpr int32_t  COEFFICIENT    = 960;
+    constexpr uint32_t PARTITIONS     = 4;    //!< Their order, of 256 samples each.
+    constexpr uint32_t RICE_PARAMETER = 13;
+
+    BitWriter writer(out, size);
+    // | sync 0xFFF8 | 4096 samples, 48 kHz | mid-side, 16 bits | frame 0 | CRC-8 |
+    writer.Write(SYNC << 1, 16);
+    writer.Write(12, 4);
+    writer.Write(10, 4);
+    writer.Write(MidSide, 4);
+    writer.Write(4, 3);
+    writer.Write(0, 1);
+    writer.Write(0, 8);
+    if (writer.IsPastEnd())
+    {
+        return 0;
+    }
+    writer.Write(ComputeCrc8(out, writer.GetPosition()), 8);
+
+    // Noise over the whole range of the Rice parameter, as a xorshift makes it.
+    uint32_t state = 0x2545F491;
+    auto     noise = [&state](uint32_t bits) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<int32_t>(state >> (32 - bits)) - (1 << (bits - 1));
+    };
+    for (size_t channel = 0; channel < MAX_CHANNELS; channel++)
+    {
+        uint32_t bits = BITS + (channel == 1 ? 1 : 0);
+        writer.Write(0, 1);
+        writer.Write(31 + MAX_LPC_ORDER, 6);
+        writer.Write(0, 1);
+        for (size_t i = 0; i < MAX_LPC_ORDER; i++)
+        {
+            writer.WriteSigned(noise(bits - 2), bits);
+        }
+        writer.Write(PRECISION - 1, 4);
+        writer.WriteSigned(SHIFT, 5);
+        for (size_t i = 0; i < MAX_LPC_ORDER; i++)
+        {
+            writer.WriteSigned(COEFFICIENT, PRECISION);
+        }
+        writer.Write(1, 2);
+        writer.Write(PARTITIONS, 4);
+        for (size_t partition = 0; partition < (size_t(1) << PARTITIONS); partition++)
+        {
+            writer.Write(RICE_PARAMETER, 5);
+            size_t count = (MAX_BLOCK_SIZE >> PARTITIONS) - (partition == 0 ? MAX_LPC_ORDER : 0);
+            for (size_t i = 0; i < count; i++)
+            {
+                writer.WriteRice(noise(RICE_PARAMETER + 1), RICE_PARAMETER);
+            }
+        }
+    }
+    writer.AlignToByte();
+    if (writer.IsPastEnd())
+    {
+        return 0;
+    }
+    writer.Write(ComputeCrc16(out, writer.GetPosition()), 16);
+    if (writer.IsPastEnd())
+    {
+        return 0;
+    }
+
+    info               = StreamInfo {};
+    info.maxBlockSize  = MAX_BLOCK_SIZE;
+    info.maxFrameSize  = static_cast<uint32_t>(writer.GetPosition());
+    info.sampleRate    = 48000;
+    info.channels      = MAX_CHANNELS;
+    info.bitsPerSample = BITS;
+    info.totalSamples  = MAX_BLOCK_SIZE;
+    return writer.GetPosition();
+}
+
+bool Decoder::Open(const uint8_t* file, size_t size)
+{
+    m_frames = nullptr;
+    StreamInfo info;
+    if (!ParseStreamInfo(file, size, info))
+    {
+        return false;
+    }
+
+    size_t offset = MARKER_SIZE;
+    bool   isLast = false;
+    while (!isLast)
+    {
+        if (size - offset < HEADER_SIZE)
+        {
+            return false;
+        }
+        offset += GetMetadataSize(&file[offset], isLast);
+        if (offset > size)
+        {
+            return false;
+        }
+    }
+    return OpenFrames(&file[offset], size - offset, info);
+}
+
+bool Decoder::OpenFrames(const uint8_t* frames, size_t size, const StreamInfo& info)
+{
+    m_frames = nullptr;
+    if (frames == nullptr || info.channels == 0 || info.channels > MAX_CHANNELS)
+    {
+        return false;
+    }
+    m_frames = frames;
+    m_size   = size;
+    m_info   = info;
+    return Rewind();
+}
+
+size_t Decoder::Read(int16_t* out, size_t frames)
+{
+    size_t done = 0;
+    while (done < frames)
+    {
+        if (m_sample == m_blockSize)
+        {
+            Status status = DecodeFrame();
+            if (status == Status::Cut)
+            {
+                break;
+            }
+            if (status == Status::Corrupted)
+            {
+                Resynchronize();
+                continue;
+            }
+        }
+
+        size_t count = std::min(frames - done, m_blockSize - m_sample);
+        for (size_t channel = 0; channel < OUT_CHANNELS; channel++)
+        {
+            const int32_t* in      = &m_samples[channel % m_info.channels][m_sample];
+            int16_t*       samples = &out[done * OUT_CHANNELS + channel];
+            for (size_t i = 0; i < count; i++)
+            {
+                int32_t sample = m_shift >= 0 ? in[i] * (1 << m_shift) : in[i] >> -m_shift;
+                samples[i * OUT_CHANNELS] = static_cast<int16_t>(sample);
+            }
+        }
+        m_sample += count;
+        done += count;
+    }
+    return done;
+}
+
+bool Decoder::Rewind()
+{
+    m_offset    = 0;
+    m_blockSize = 0;
+    m_sample    = 0;
+    return m_frames != nullptr;
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Decodes the frame at m_offset into m_samples.
+ */
+Decoder::Status Decoder::DecodeFrame()
+{
+    PROFILE_ZONE("flac frame");
+
+    if (m_offset >= m_size)
+    {
+        return Status::Cut;
+    }
+    const uint8_t* frame = &m_frames[m_offset];
+    BitReader      in(frame, m_size - m_offset);
+
+    // | sync u15 | blocking u1 | block size u4 | rate u4 | channels u4 | bits u3 | 0 u1 |
+    // | number, UTF-8 | block size u8/u16 | rate u8/u16 | CRC-8 |
+    bool isValid = in.Read(15) == SYNC;
+    in.Read(1);    // Fixed or variable block size, only the number's meaning changes.
+    uint32_t blockCode   = in.Read(4);
+    uint32_t rateCode    = in.Read(4);
+    uint32_t channelCode = in.Read(4);
+    uint32_t bitsCode    = in.Read(3);
+    isValid = isValid && in.Read(1) == 0 && rateCode != 15 && channelCode <= MidSide;
+
+    // Only the length of the frame or sample number matters: its leading ones, less one.
+    uint32_t first = in.Read(8);
+    uint32_t ones  = 0;
+    while (ones < 8 && (first & (0x80 >> ones)) != 0)
+    {
+        ones++;
+    }
+    isValid = isValid && ones != 1 && ones != 8;
+    for (uint32_t i = 1; i < ones; i++)
+    {
+        isValid = isValid && (in.Read(8) & 0xC0) == 0x80;
+    }
+
+    uint32_t blockSize = GetBlockSize(in, blockCode);
+    if (rateCode == 12)
+    {
+        in.Read(8);
+    }
+    else if (rateCode == 13 || rateCode == 14)
+    {
+        in.Read(16);
+    }
+    constexpr uint8_t BITS[8]    = {0, 8, 12, 0, 16, 20, 24, 0};
+    uint32_t          bits       = bitsCode == 0 ? m_info.bitsPerSample : BITS[bitsCode];
+    size_t            channels   = channelCode < LeftSide ? channelCode + 1 : 2;
+    size_t            headerSize = in.GetPosition();
+    isValid = isValid && in.Read(8) == ComputeCrc8(frame, headerSize) && bits != 0 &&
+              blockSize != 0 && blockSize <= MAX_BLOCK_SIZE && channels == m_info.channels;
+    if (in.IsPastEnd())
+    {
+        return Status::Cut;
+    }
+    if (!isValid)
+    {
+        return Status::Corrupted;
+    }
+
+    // The side channel has a bit more than the others.
+    for (size_t channel = 0; channel < channels && isValid; channel++)
+    {
+        bool isSide = (channelCode == LeftSide && channel == 1) ||
+                      (channelCode == SideRight && channel == 0) ||
+                      (channelCode == MidSide && channel == 1);
+        isValid = DecodeSubframe(in, m_samples[channel], blockSize, bits + (isSide ? 1 : 0));
+    }
+    in.AlignToByte();
+    size_t size = in.GetPosition();
+    isValid     = isValid && in.Read(16) == ComputeCrc16(frame, size);
+    if (in.IsPastEnd())
+    {
+        return Status::Cut;
+    }
+    if (!isValid)
+    {
+        return Status::Corrupted;
+    }
+
+    int32_t* left  = m_samples[0];
+    int32_t* right = m_samples[1];
+    switch (channelCode)
+    {
+        case LeftSide:
+            for (size_t i = 0; i < blockSize; i++)
+            {
+                right[i] = left[i] - right[i];
+            }
+            break;
+        case SideRight:
+            for (size_t i = 0; i < blockSize; i++)
+            {
+                left[i] += right[i];
+            }
+            break;
+        case MidSide:
+            for (size_t i = 0; i < blockSize; i++)
+            {
+                // The mid channel lost its lowest bit, the side's.
+                int32_t side = right[i];
+                int32_t mid  = static_cast<int32_t>(static_cast<uint32_t>(left[i]) << 1) |
+                              (side & 1);
+                left[i]  = (mid + side) >> 1;
+                right[i] = (mid - side) >> 1;
+            }
+            break;
+        default:
+            break;
+    }
+
+    m_blockSize = blockSize;
+    m_sample    = 0;
+    m_shift     = 16 - static_cast<int32_t>(bits);
+    m_offset += size + CRC16_SIZE;
+    return Status::Ok;
+}
+
+/**
+ * @brief Skips up to the next sync code, 0xFFF8 or 0xFFF9.
+ */
+void Decoder::Resynchronize()
+{
+    m_skipped++;
+    for (size_t i = m_offset + 1; i + 1 < m_size; i++)
+    {
+        if (m_frames[i] == 0xFF && (m_frames[i + 1] & 0xFE) == 0xF8)
+        {
+            m_offset = i;
+            return;
+        }
+    }
+    // The last byte may be the start of a frame that was cut.
+    m_offset = m_frames[m_size - 1] == 0xFF ? m_size - 1 : m_size;
+}
+}    // namespace Flac
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,148 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    flac.h
+ * @brief   Decoder of FLAC, the Free Lossless Audio Codec (RFC 9639).
+ *
+ * A file is "fLaC", metadata blocks, STREAMINFO first, then frames of up to MAX_BLOCK_SIZE
+ * samples per channel. Each frame has a subframe per channel: constant, verbatim, or predicted
+ * by a fixed polynomial or an LPC filter of up to 32 taps, plus Rice-coded residuals. Stereo
+ * frames may code the side channel with the left, the right, or the mid one.
+ *
+ * Everything is fixed-point: the LPC sums 64-bit products of the coefficients and the 32-bit
+ * samples, which is one SMLAL per tap on the Cortex-M4. A frame is decoded whole into the
+ * decoder's working buffer, MAX_BLOCK_SIZE samples per channel, then read from there: nothing
+ * is allocated. At 48 kHz, a frame of 4096 samples lasts 85.3 ms, 14.3 M cycles at 168 MHz:
+ * the "flac frame" zone of the profiler holds the cycles per frame, its max the worst case.
+ * bench/flacBench.cpp measures the same on the host, for each kind of frame. On the target, the
+ * AudioEngine streams a file of WriteBenchFrame()'s frames at boot, the slowest this decoder can
+ * be given, and times it (see AudioEngine::TimeFlacFrame()).
+ *
+ * Supported: 1 or 2 channels of 8 to 24 bits, played as 16 bits. The header and frame CRCs are
+ * checked, a corrupted frame is skipped up to the next one.
+ *
+ * @note The decoder is 33 KiB, make it a static: not on a stack, not in the heap.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_FLAC_H
+#    define NILAIINI_SERVICES_FLAC_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace Flac
+{
+static constexpr size_t MAX_CHANNELS   = 2;
+static constexpr size_t MAX_BLOCK_SIZE = 4096;    //!< Samples per channel and frame.
+static constexpr size_t MAX_LPC_ORDER  = 32;
+static constexpr size_t MARKER_SIZE    = 4;    //!< "fLaC".
+static constexpr size_t HEADER_SIZE    = 4;    //!< Of a metadata block.
+static constexpr size_t STREAMINFO_END = MARKER_SIZE + HEADER_SIZE + 34;
+
+struct StreamInfo
+{
+    uint32_t maxBlockSize  = 0;
+    uint32_t maxFrameSize  = 0;    //!< 0 if unknown.
+    uint32_t sampleRate    = 0;
+    uint8_t  channels      = 0;
+    uint8_t  bitsPerSample = 0;
+    uint64_t totalSamples  = 0;    //!< Per channel, 0 if unknown.
+};
+
+/**
+ * @brief Parses "fLaC" and the STREAMINFO, the first STREAMINFO_END bytes of a file.
+ * @returns False if it isn't a FLAC file, or its format isn't supported.
+ */
+bool ParseStreamInfo(const uint8_t* file, size_t size, StreamInfo& info);
+
+/**
+ * @param header The HEADER_SIZE bytes of a metadata block.
+ * @returns The size of the block, header included.
+ */
+size_t GetMetadataSize(const uint8_t* header, bool& isLast);
+
+/**
+ * @brief Writes "fLaC" and a STREAMINFO that is the last metadata block, STREAMINFO_END bytes.
+ * @returns STREAMINFO_END, 0 if it doesn't fit in @p size.
+ */
+size_t WriteStreamInfo(uint8_t* out, size_t size, const StreamInfo& info);
+
+/**
+ * @brief Writes a frame as slow to decode as they get within 16 KiB: 4096 samples of 16-bit
+ *        stereo at 48 kHz, mid-side, both channels predicted by LPC of order 32 with residuals
+ *        of 14 bits. The samples are noise.
+ * @param info The stream's, to give to Decoder::OpenFrames() with the frame.
+ * @returns The size of the frame, 0 if it doesn't fit in @p size.
+ */
+size_t WriteBenchFrame(uint8_t* out, size_t size, StreamInfo& info);
+
+class Decoder
+{
+public:
+    /**
+     * @param file The whole file, which must stay valid while it's decoded.
+     * @returns False if it isn't a FLAC file, or its format isn't supported.
+     */
+    bool Open(const uint8_t* file, size_t size);
+
+    /**
+     * @brief Decodes frames without the file's metadata, such as those just read of a file
+     *        streamed from the SD card. The last one may be cut, GetConsumed() tells where it
+     *        starts.
+     */
+    bool OpenFrames(const uint8_t* frames, size_t size, const StreamInfo& info);
+
+    /**
+     * @brief Decodes the next frames into @p out, as 16-bit stereo. Mono is played on both
+     *        channels. A frame of audio is a sample of every channel, not a FLAC frame.
+     * @returns The frames decoded, 0 at the end or at a cut frame.
+     */
+    size_t Read(int16_t* out, size_t frames);
+
+    bool Rewind();
+
+    [[nodiscard]] const StreamInfo& GetInfo() const { return m_info; }
+    [[nodiscard]] size_t            GetFrameCount() const { return m_info.totalSamples; }
+    //! Of the data given to Open() or OpenFrames(), up to the first frame not decoded yet.
+    [[nodiscard]] size_t GetConsumed() const { return m_offset; }
+    [[nodiscard]] size_t GetSkippedFrames() const { return m_skipped; }
+
+private:
+    enum class Status : uint8_t
+    {
+        Ok,
+        Cut,          //!< The frame goes past the end of the data.
+        Corrupted,    //!< Skipped up to the next frame.
+    };
+
+    const uint8_t* m_frames  = nullptr;
+    size_t         m_size    = 0;
+    size_t         m_offset  = 0;    //!< Of the next frame.
+    size_t         m_skipped = 0;
+    StreamInfo     m_info;
+
+    size_t  m_blockSize = 0;    //!< Of the frame in m_samples.
+    size_t  m_sample    = 0;    //!< Next to read from m_samples.
+    int32_t m_shift     = 0;    //!< From the frame's bits per sample to 16.
+    int32_t m_samples[MAX_CHANNELS][MAX_BLOCK_SIZE];
+
+private:
+    Status DecodeFrame();
+    void   Resynchronize();
+};
+}    // namespace Flac
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_FLAC_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,331 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    format.cpp
+ * @brief   Source for the format engine.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "format.h"
+
+#include <cstring>
+
+namespace Fmt
+{
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr uint32_t POWERS_OF_TEN[MAX_PRECISION + 1] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+constexpr uint8_t DEFAULT_PRECISION = 6;
+
+/**
+ * @brief Digits of @p value in @p base, written backward from the end of @p end.
+ * @returns The first digit.
+ */
+char* ToDigits(uint64_t value, unsigned base, bool upper, char* end)
+{
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    do
+    {
+        *--end = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return end;
+}
+
+void WritePadding(Sink& sink, char fill, size_t count)
+{
+    char chunk[16];
+    std::memset(chunk, fill, sizeof(chunk));
+    while (count != 0)
+    {
+        size_t len = count < sizeof(chunk) ? count : sizeof(chunk);
+        sink.Write(chunk, len);
+        count -= len;
+    }
+}
+
+/**
+ * @brief Writes @p prefix (sign, "0x") and @p body, padded according to @p spec.
+ */
+void WritePadded(Sink&       sink,
+                 const Spec& spec,
+                 char        defaultAlign,
+                 const char* prefix,
+                 size_t      prefixLen,
+                 const char* body,
+                 size_t      bodyLen)
+{
+    size_t len     = prefixLen + bodyLen;
+    size_t padding = spec.width > len ? spec.width - len : 0;
+    char   align   = spec.align != 0 ? spec.align : defaultAlign;
+
+    if (spec.zeroPad && defaultAlign == '>')
+    {
+        // Zeros go between the sign and the digits.
+        sink.Write(prefix, prefixLen);
+        WritePadding(sink, '0', padding);
+        sink.Write(body, bodyLen);
+        return;
+    }
+
+    if (align == '>')
+    {
+        WritePadding(sink, ' ', padding);
+    }
+    sink.Write(prefix, prefixLen);
+    sink.Write(body, bodyLen);
+    if (align != '>')
+    {
+        WritePadding(sink, ' ', padding);
+    }
+}
+
+void FormatInteger(Sink& sink, const Spec& spec, uint64_t magnitude, bool negative)
+{
+    if (spec.type == 'c')
+    {
+        char c = static_cast<char>(magnitude);
+        WritePadded(sink, spec, '<', "", 0, &c, 1);
+        return;
+    }
+
+    unsigned base = 10;
+    switch (spec.type)
+    {
+        case 'x':
+        case 'X': base = 16; break;
+        case 'b': base = 2; break;
+        default: break;
+    }
+
+    char  buf[64];
+    char* end   = buf + sizeof(buf);
+    char* first = ToDigits(magnitude, base, spec.type == 'X', end);
+    WritePadded(sink, spec, '>', "-", negative ? 1 : 0, first, static_cast<size_t>(end - first));
+}
+
+/**
+ * @brief Fixed point formatting from the IEEE-754 fields, without any floating point operation.
+ */
+void FormatFloat(Sink& sink, const Spec& spec, float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bool     negative = (bits >> 31) != 0;
+    int32_t  exponent = static_cast<int32_t>((bits >> 23) & 0xFFU);
+    uint32_t mantissa = bits & 0x7FFFFFU;
+
+    if (exponent == 0xFF)
+    {
+        const char* text = mantissa != 0 ? "nan" : "inf";
+        WritePadded(sink, spec, '>', "-", (negative && mantissa == 0) ? 1 : 0, text, 3);
+        return;
+    }
+    if (exponent == 0)
+    {
+        exponent = -126;    // Subnormal, no implicit bit.
+    }
+    else
+    {
+        mantissa |= 0x800000U;
+        exponent -= 127;
+    }
+
+    // value = mantissa * 2^-fractionBits
+    int32_t  fractionBits = 23 - exponent;
+    uint64_t integer      = 0;
+    uint64_t fraction     = 0;
+    if (fractionBits <= 0)
+    {
+        if (-fractionBits > 40)
+        {
+            WritePadded(sink, spec, '>', "-", negative ? 1 : 0, "ovf", 3);
+            return;
+        }
+        integer      = static_cast<uint64_t>(mantissa) << -fractionBits;
+        fractionBits = 0;
+    }
+    else if (fractionBits < 64)
+    {
+        integer  = static_cast<uint64_t>(mantissa) >> fractionBits;
+        fraction = mantissa & ((1ULL << fractionBits) - 1);
+    }
+    else
+    {
+        fraction = mantissa;
+    }
+
+    // Keep 32 fraction bits at most, so that the scaling by 10^precision fits in 64 bits.
+    if (fractionBits > 32)
+    {
+        uint32_t drop = static_cast<uint32_t>(fractionBits - 32);
+        fraction      = drop < 64 ? fraction >> drop : 0;
+        fractionBits  = 32;
+    }
+
+    uint8_t precision =
+      spec.precision < 0 ? DEFAULT_PRECISION : static_cast<uint8_t>(spec.precision);
+    uint32_t scale    = POWERS_OF_TEN[precision];
+    uint64_t decimals = 0;
+    if (fractionBits != 0)
+    {
+        decimals = (fraction * scale + (1ULL << (fractionBits - 1))) >> fractionBits;
+        if (decimals >= scale)
+        {
+            integer++;
+            decimals -= scale;
+        }
+    }
+
+    char  buf[32];
+    char* end   = buf + sizeof(buf);
+    char* first = end;
+    if (precision != 0)
+    {
+        first = ToDigits(decimals, 10, false, end);
+        while (end - first < precision)
+        {
+            *--first = '0';
+        }
+        *--first = '.';
+    }
+    first = ToDigits(integer, 10, false, first);
+
+    WritePadded(sink, spec, '>', "-", negative ? 1 : 0, first, static_cast<size_t>(end - first));
+}
+
+void FormatArg(Sink& sink, const Spec& spec, const Arg& arg)
+{
+    switch (arg.type)
+    {
+        case Arg::Type::Int:
+            FormatInteger(sink,
+                          spec,
+                          arg.i < 0 ? 0ULL - static_cast<uint64_t>(static_cast<int64_t>(arg.i))
+                                    : static_cast<uint64_t>(arg.i),
+                          arg.i < 0);
+            break;
+        case Arg::Type::Uint: FormatInteger(sink, spec, arg.u, false); break;
+        case Arg::Type::Int64:
+            FormatInteger(sink,
+                          spec,
+                          arg.i64 < 0 ? 0ULL - static_cast<uint64_t>(arg.i64)
+                                      : static_cast<uint64_t>(arg.i64),
+                          arg.i64 < 0);
+            break;
+        case Arg::Type::Uint64: FormatInteger(sink, spec, arg.u64, false); break;
+        case Arg::Type::Float: FormatFloat(sink, spec, arg.f); break;
+        case Arg::Type::Bool:
+            if (spec.type == 'd')
+            {
+                FormatInteger(sink, spec, arg.b ? 1 : 0, false);
+            }
+            else
+            {
+                WritePadded(sink, spec, '<', "", 0, arg.b ? "true" : "false", arg.b ? 4 : 5);
+            }
+            break;
+        case Arg::Type::Char:
+            if (spec.type == 0 || spec.type == 'c')
+            {
+                WritePadded(sink, spec, '<', "", 0, &arg.c, 1);
+            }
+            else
+            {
+                FormatInteger(sink, spec, static_cast<uint8_t>(arg.c), false);
+            }
+            break;
+        case Arg::Type::String:
+        {
+            size_t len = arg.s.len;
+            if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < len)
+            {
+                len = static_cast<size_t>(spec.precision);
+            }
+            WritePadded(sink, spec, '<', "", 0, arg.s.data, len);
+            break;
+        }
+        case Arg::Type::Pointer:
+        {
+            char  buf[2 * sizeof(uintptr_t)];
+            char* end   = buf + sizeof(buf);
+            char* first = ToDigits(reinterpret_cast<uintptr_t>(arg.p), 16, false, end);
+            while (first != buf)
+            {
+                *--first = '0';
+            }
+            WritePadded(sink, spec, '>', "0x", 2, first, sizeof(buf));
+            break;
+        }
+    }
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+void BufferSink::Write(const char* data, size_t len)
+{
+    if (m_capacity == 0)
+    {
+        return;
+    }
+    size_t room = m_capacity - 1 - m_size;
+    len         = len < room ? len : room;
+    std::memcpy(&m_buf[m_size], data, len);
+    m_size += len;
+    m_buf[m_size] = '\0';
+}
+
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+void VFormatTo(Sink& sink, std::string_view fmt, const Arg* args, size_t count)
+{
+    size_t literal = 0;
+    size_t argIdx  = 0;
+    for (size_t i = 0; i < fmt.size(); i++)
+    {
+        char c = fmt[i];
+        if (c != '{' && c != '}')
+        {
+            continue;
+        }
+
+        // Literal text up to here, plus one of the braces if it's escaped.
+        bool escaped = i + 1 < fmt.size() && fmt[i + 1] == c;
+        sink.Write(fmt.data() + literal, i - literal + (escaped ? 1 : 0));
+        if (escaped || c == '}')
+        {
+            i += escaped ? 1 : 0;
+            literal = i + 1;
+            continue;
+        }
+
+        Spec spec;
+        i++;
+        if (fmt[i] == ':')
+        {
+            i = Detail::ParseSpec(fmt, i + 1, spec);
+        }
+        if (argIdx < count)
+        {
+            FormatArg(sink, spec, args[argIdx++]);
+        }
+        literal = i + 1;
+    }
+    sink.Write(fmt.data() + literal, fmt.size() - literal);
+}
+}    // namespace Fmt
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,450 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    format.h
+ * @brief   Type-safe text formatting, checked at compile time and without heap or printf.
+ *
+ * The syntax is a subset of {fmt}'s: "{}" is replaced by the next argument, "{{" and "}}" are
+ * literal braces. A replacement field can hold a spec: {:[align][0][width][.precision][type]}
+ *  - align:     '<' (default for text) or '>' (default for numbers).
+ *  - 0:         pad numbers with zeros instead of spaces.
+ *  - width:     minimum number of characters.
+ *  - precision: number of decimals of a floating point value (6 by default, 9 at most), or the
+ *               maximum number of characters of a string.
+ *  - type:      'd', 'x', 'X', 'b', 'c' for integers, 'f' for floating points, 's' for text
+ *               and booleans, 'p' for pointers.
+ *
+ * The format string must be wrapped in FMT_STRING so that it's parsed at compile time: a
+ * malformed string, a wrong number of arguments or a spec that doesn't fit the type of its
+ * argument doesn't compile.
+ *
+ * Floating point values are printed in fixed point with integer arithmetic only, straight from
+ * their IEEE-754 representation. Doubles are narrowed to float first.
+ *
+ * The output goes to a Sink, which receives chunks of characters. The core is not a template,
+ * so each call site only costs the packing of its arguments.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_FORMAT_H
+#    define NILAIINI_SERVICES_FORMAT_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <array>
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+#    include <string_view>
+#    include <type_traits>
+
+/*****************************************************************************/
+/* Exported macro */
+/**
+ * Turns a string literal into a type that carries it, so that it can be parsed in a constant
+ * expression.
+ */
+#    define FMT_STRING(s)                                                                      \
+        [] {                                                                                   \
+            struct FmtString : Fmt::CompileString                                              \
+            {                                                                                  \
+                static constexpr std::string_view Get() { return s; }                         \
+            };                                                                                 \
+            return FmtString {};                                                               \
+        }()
+
+/*****************************************************************************/
+/* Exported types */
+namespace Fmt
+{
+constexpr size_t  MAX_ARGS      = 16;
+constexpr uint8_t MAX_PRECISION = 9;
+
+struct CompileString
+{
+};
+
+class Sink
+{
+public:
+    virtual void Write(const char* data, size_t len) = 0;
+
+protected:
+    ~Sink() = default;
+};
+
+/**
+ * @brief Only counts the characters, to know how much room a message needs.
+ */
+class CountingSink : public Sink
+{
+public:
+    void   Write(const char*, size_t len) override { m_size += len; }
+    size_t Size() const { return m_size; }
+
+private:
+    size_t m_size = 0;
+};
+
+/**
+ * @brief Writes into a fixed buffer, truncating what doesn't fit. The result is null-terminated.
+ */
+class BufferSink : public Sink
+{
+public:
+    BufferSink(char* buf, size_t capacity) : m_buf(buf), m_capacity(capacity)
+    {
+        if (m_capacity != 0)
+        {
+            m_buf[0] = '\0';
+        }
+    }
+
+    void   Write(const char* data, size_t len) override;
+    size_t Size() const { return m_size; }
+
+private:
+    char*  m_buf;
+    size_t m_capacity;
+    size_t m_size = 0;
+};
+
+struct Spec
+{
+    char    align     = 0;    //!< '<', '>' or 0 for the default of the argument's type.
+    char    type      = 0;
+    bool    zeroPad   = false;
+    uint8_t width     = 0;
+    int8_t  precision = -1;
+};
+
+/**
+ * @brief Type-erased argument.
+ */
+struct Arg
+{
+    enum class Type : uint8_t
+    {
+        Int,
+        Uint,
+        Int64,
+        Uint64,
+        Float,
+        Bool,
+        Char,
+        String,
+        Pointer,
+    };
+
+    Type type;
+    union
+    {
+        int32_t     i;
+        uint32_t    u;
+        int64_t     i64;
+        uint64_t    u64;
+        float       f;
+        bool        b;
+        char        c;
+        const void* p;
+        struct
+        {
+            const char* data;
+            size_t      len;
+        } s;
+    };
+};
+
+/*****************************************************************************/
+/* Compile-time parsing */
+namespace Detail
+{
+struct Parsed
+{
+    size_t                     count = 0;
+    bool                       valid = true;
+    std::array<Spec, MAX_ARGS> specs = {};
+};
+
+constexpr bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Parses the spec that starts after ':' and ends before '}'.
+ * @returns The position of the closing brace, or npos if the spec is invalid.
+ */
+constexpr size_t ParseSpec(std::string_view fmt, size_t pos, Spec& spec)
+{
+    if (pos < fmt.size() && (fmt[pos] == '<' || fmt[pos] == '>'))
+    {
+        spec.align = fmt[pos++];
+    }
+    if (pos < fmt.size() && fmt[pos] == '0')
+    {
+        spec.zeroPad = true;
+        pos++;
+    }
+    unsigned width = 0;
+    while (pos < fmt.size() && IsDigit(fmt[pos]))
+    {
+        width = width * 10 + static_cast<unsigned>(fmt[pos++] - '0');
+        if (width > UINT8_MAX)
+        {
+            return std::string_view::npos;
+        }
+    }
+    spec.width = static_cast<uint8_t>(width);
+    if (pos < fmt.size() && fmt[pos] == '.')
+    {
+        pos++;
+        if (pos >= fmt.size() || !IsDigit(fmt[pos]))
+        {
+            return std::string_view::npos;
+        }
+        unsigned precision = 0;
+        while (pos < fmt.size() && IsDigit(fmt[pos]))
+        {
+            precision = precision * 10 + static_cast<unsigned>(fmt[pos++] - '0');
+            if (precision > INT8_MAX)
+            {
+                return std::string_view::npos;
+            }
+        }
+        spec.precision = static_cast<int8_t>(precision);
+    }
+    if (pos < fmt.size() && fmt[pos] != '}')
+    {
+        spec.type = fmt[pos++];
+    }
+    if (pos >= fmt.size() || fmt[pos] != '}')
+    {
+        return std::string_view::npos;
+    }
+    return pos;
+}
+
+constexpr Parsed Parse(std::string_view fmt)
+{
+    Parsed parsed;
+    for (size_t i = 0; i < fmt.size(); i++)
+    {
+        if (fmt[i] == '}')
+        {
+            if (i + 1 >= fmt.size() || fmt[i + 1] != '}')
+            {
+                parsed.valid = false;
+                return parsed;
+            }
+            i++;
+            continue;
+        }
+        if (fmt[i] != '{')
+        {
+            continue;
+        }
+        if (i + 1 < fmt.size() && fmt[i + 1] == '{')
+        {
+            i++;
+            continue;
+        }
+        if (parsed.count >= MAX_ARGS)
+        {
+            parsed.valid = false;
+            return parsed;
+        }
+
+        Spec spec;
+        i++;
+        if (i < fmt.size() && fmt[i] == ':')
+        {
+            i = ParseSpec(fmt, i + 1, spec);
+        }
+        if (i >= fmt.size() || fmt[i] != '}')
+        {
+            parsed.valid = false;
+            return parsed;
+        }
+        parsed.specs[parsed.count++] = spec;
+    }
+    return parsed;
+}
+
+template<typename T>
+constexpr bool IsString = std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+                          std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>;
+
+template<typename T>
+constexpr bool IsCompatible(const Spec& spec)
+{
+    using U = std::remove_cv_t<std::remove_reference_t<std::decay_t<T>>>;
+
+    char type = spec.type;
+    if constexpr (std::is_same_v<U, bool>)
+    {
+        return (type == 0 || type == 's' || type == 'd') && spec.precision < 0;
+    }
+    else if constexpr (std::is_same_v<U, char>)
+    {
+        return (type == 0 || type == 'c' || type == 'd' || type == 'x' || type == 'X') &&
+               spec.precision < 0;
+    }
+    else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+    {
+        return (type == 0 || type == 'd' || type == 'x' || type == 'X' || type == 'b' ||
+                type == 'c') &&
+               spec.precision < 0;
+    }
+    else if constexpr (std::is_floating_point_v<U>)
+    {
+        return (type == 0 || type == 'f') && spec.precision <= MAX_PRECISION;
+    }
+    else if constexpr (IsString<U>)
+    {
+        return type == 0 || type == 's';
+    }
+    else if constexpr (std::is_pointer_v<U>)
+    {
+        return (type == 0 || type == 'p' || type == 'x') && spec.precision < 0;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template<typename... Args, size_t... I>
+constexpr bool AllCompatible(const Parsed& parsed, std::index_sequence<I...>)
+{
+    return (IsCompatible<Args>(parsed.specs[I]) && ...);
+}
+
+template<typename S, typename... Args>
+constexpr void Check()
+{
+    static_assert(std::is_base_of_v<CompileString, S>,
+                  "The format string must be wrapped in FMT_STRING");
+    constexpr Parsed parsed = Parse(S::Get());
+    static_assert(parsed.valid, "Malformed format string");
+    static_assert(parsed.count == sizeof...(Args),
+                  "The number of arguments doesn't match the format string");
+    if constexpr (parsed.count == sizeof...(Args))
+    {
+        static_assert(AllCompatible<Args...>(parsed, std::index_sequence_for<Args...> {}),
+                      "A format spec doesn't fit the type of its argument");
+    }
+}
+
+template<typename T>
+Arg MakeArg(const T& value)
+{
+    using U = std::remove_cv_t<std::decay_t<T>>;
+
+    Arg arg {};
+    if constexpr (std::is_same_v<U, bool>)
+    {
+        arg.type = Arg::Type::Bool;
+        arg.b    = value;
+    }
+    else if constexpr (std::is_same_v<U, char>)
+    {
+        arg.type = Arg::Type::Char;
+        arg.c    = value;
+    }
+    else if constexpr (std::is_enum_v<U>)
+    {
+        return MakeArg(static_cast<std::underlying_type_t<U>>(value));
+    }
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U> && sizeof(U) <= 4)
+    {
+        arg.type = Arg::Type::Int;
+        arg.i    = value;
+    }
+    else if constexpr (std::is_integral_v<U> && sizeof(U) <= 4)
+    {
+        arg.type = Arg::Type::Uint;
+        arg.u    = value;
+    }
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+    {
+        arg.type = Arg::Type::Int64;
+        arg.i64  = value;
+    }
+    else if constexpr (std::is_integral_v<U>)
+    {
+        arg.type = Arg::Type::Uint64;
+        arg.u64  = value;
+    }
+    else if constexpr (std::is_floating_point_v<U>)
+    {
+        arg.type = Arg::Type::Float;
+        arg.f    = static_cast<float>(value);
+    }
+    else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>)
+    {
+        const char* str = value;
+        arg.type        = Arg::Type::String;
+        arg.s.data      = str != nullptr ? str : "(null)";
+        arg.s.len  = std::char_traits<char>::length(arg.s.data);
+    }
+    else if constexpr (std::is_same_v<U, std::string_view> || std::is_same_v<U, std::string>)
+    {
+        arg.type   = Arg::Type::String;
+        arg.s.data = value.data();
+        arg.s.len  = value.size();
+    }
+    else
+    {
+        arg.type = Arg::Type::Pointer;
+        arg.p    = static_cast<const void*>(value);
+    }
+    return arg;
+}
+}    // namespace Detail
+
+/*****************************************************************************/
+/* Exported functions */
+/**
+ * @brief Formats already packed arguments. The format string is assumed to be valid.
+ */
+void VFormatTo(Sink& sink, std::string_view fmt, const Arg* args, size_t count);
+
+template<typename S, typename... Args>
+void FormatTo(Sink& sink, S, const Args&... args)
+{
+    Detail::Check<S, Args...>();
+    const std::array<Arg, sizeof...(Args)> packed = {Detail::MakeArg(args)...};
+    VFormatTo(sink, S::Get(), packed.data(), packed.size());
+}
+
+/**
+ * @brief Formats into @p buf, truncating to @p capacity - 1 characters.
+ * @returns The number of characters written, without the null terminator.
+ */
+template<typename S, typename... Args>
+size_t FormatTo(char* buf, size_t capacity, S fmt, const Args&... args)
+{
+    BufferSink sink(buf, capacity);
+    FormatTo(sink, fmt, args...);
+    return sink.Size();
+}
+
+template<typename S, typename... Args>
+size_t FormattedSize(S fmt, const Args&... args)
+{
+    CountingSink sink;
+    FormatTo(sink, fmt, args...);
+    return sink.Size();
+}
+}    // namespace Fmt
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_FORMAT_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,216 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    frameLink.cpp
+ * @brief   Source for the FrameLink.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "frameLink.h"
+
+#include "Processes/drivers/ccmRam.h"
+#include "Processes/drivers/uartRxDma.h"
+#include "Processes/drivers/uartTxDma.h"
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/cobs.h"
+#include "Processes/services/crc32.h"
+
+#include <algorithm>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t MAX_RX_FRAME   = 1 + FrameLink::MAX_RX_BODY + FrameLink::CRC_SIZE;
+constexpr size_t MAX_RX_ENCODED = Cobs::MaxEncodedSize(MAX_RX_FRAME);
+constexpr size_t MAX_TX_FRAME   = 1 + FrameLink::MAX_TX_BODY + FrameLink::CRC_SIZE;
+
+static_assert(MAX_RX_ENCODED < UartRxDma::RX_SIZE, "A frame must fit in the RX ring");
+
+//! Only used for the frames that wrap around the end of the RX ring, never seen by the DMA.
+CCM_BSS uint8_t    s_scratch[MAX_RX_ENCODED] = {};
+FrameLink::Handler s_handler                 = nullptr;
+size_t             s_scanned                 = 0;    //!< Bytes known not to hold a delimiter.
+uint32_t           s_overruns                = 0;
+uint32_t           s_frames                  = 0;
+uint32_t           s_crcErrors               = 0;
+uint32_t           s_framingErrors           = 0;
+
+void OnFrame(const uint8_t* frame, size_t len)
+{
+    if (len < 1 + FrameLink::CRC_SIZE)
+    {
+        s_framingErrors++;
+        return;
+    }
+    size_t dataLen = len - FrameLink::CRC_SIZE;
+    if (Crc32::Compute(frame, dataLen) != ByteOrder::GetLe32(&frame[dataLen]))
+    {
+        s_crcErrors++;
+        return;
+    }
+    s_frames++;
+    if (s_handler != nullptr)
+    {
+        s_handler(frame[0], &frame[1], dataLen - 1);
+    }
+}
+
+/**
+ * @brief Finds the first delimiter at or after @p from.
+ * @returns Its position, or the size of the data if there is none.
+ */
+size_t FindDelimiter(const UartRxDma::Spans& spans, size_t from)
+{
+    for (size_t i = from; i < spans.first.len; i++)
+    {
+        if (spans.first.data[i] == Cobs::DELIMITER)
+        {
+            return i;
+        }
+    }
+    for (size_t i = std::max(from, spans.first.len) - spans.first.len; i < spans.second.len; i++)
+    {
+        if (spans.second.data[i] == Cobs::DELIMITER)
+        {
+            return spans.first.len + i;
+        }
+    }
+    return spans.Size();
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace FrameLink
+{
+void Init(Handler handler)
+{
+    s_handler = handler;
+    UartRxDma::Get()->SetRxCallback(&Poll);
+}
+
+void Poll()
+{
+    UartRxDma* rx = UartRxDma::Get();
+    if (rx == nullptr)
+    {
+        return;
+    }
+
+    while (true)
+    {
+        UartRxDma::Spans spans = rx->Peek();
+        if (rx->GetOverruns() != s_overruns)
+        {
+            // The ring was overwritten under a partial frame, the CRC will reject it.
+            s_overruns = rx->GetOverruns();
+            s_scanned  = 0;
+        }
+
+        size_t end = FindDelimiter(spans, s_scanned);
+        if (end == spans.Size())
+        {
+            // Incomplete, wait for the rest unless it can't be a frame.
+            s_scanned = end;
+            if (end > MAX_RX_ENCODED)
+            {
+                s_framingErrors++;
+                rx->Consume(end);
+                s_scanned = 0;
+            }
+            return;
+        }
+
+        if (end > MAX_RX_ENCODED)
+        {
+            s_framingErrors++;
+        }
+        else if (end != 0)
+        {
+            // Decoded right where the DMA put it, unless it wraps around the end of the ring.
+            uint8_t* frame = spans.first.data;
+            if (end > spans.first.len)
+            {
+                std::memcpy(s_scratch, spans.first.data, spans.first.len);
+                std::memcpy(&s_scratch[spans.first.len], spans.second.data, end - spans.first.len);
+                frame = s_scratch;
+            }
+            size_t len = Cobs::DecodeInPlace(frame, end);
+            if (len == 0)
+            {
+                s_framingErrors++;
+            }
+            else
+            {
+                OnFrame(frame, len);
+            }
+        }
+
+        rx->Consume(end + 1);
+        s_scanned = 0;
+    }
+}
+
+bool Send(uint8_t id, const void* body, size_t len)
+{
+    if (len > MAX_TX_BODY || UartTxDma::Get() == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t frame[MAX_TX_FRAME];
+    frame[0] = id;
+    if (len != 0)
+    {
+        std::memcpy(&frame[1], body, len);
+    }
+    uint32_t crc = Crc32::Compute(frame, 1 + len);
+    for (size_t i = 0; i < CRC_SIZE; i++)
+    {
+        frame[1 + len + i] = static_cast<uint8_t>(crc >> (8 * i));
+    }
+    size_t frameLen = 1 + len + CRC_SIZE;
+
+    // Encoded straight into the TX ring.
+    size_t encodedLen = Cobs::EncodedSize(frame, frameLen);
+    return UartTxDma::Get()->WriteInPlace(
+      encodedLen + 2,
+      [&](UartTxDma::RingWriter& writer)
+      {
+          static constexpr char delimiter = static_cast<char>(Cobs::DELIMITER);
+          writer.Write(&delimiter, 1);
+          Cobs::Encode(frame,
+                       frameLen,
+                       [&writer](const uint8_t* data, size_t n)
+                       { writer.Write(reinterpret_cast<const char*>(data), n); });
+          writer.Write(&delimiter, 1);
+      },
+      false);
+}
+
+uint32_t GetFrameCount()
+{
+    return s_frames;
+}
+
+uint32_t GetCrcErrors()
+{
+    return s_crcErrors;
+}
+
+uint32_t GetFramingErrors()
+{
+    return s_framingErrors;
+}
+}    // namespace FrameLink
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    frameLink.h
+ * @brief   Binary frames over USART2, checked by a CRC-32 and delimited by COBS.
+ *
+ * On the wire, a frame is:
+ * | 0x00 | COBS( id | body... | crc32 ) | 0x00 |
+ * where the CRC-32 (little-endian) covers the ID and the body. The leading delimiter closes
+ * whatever text came before on the shared log UART, so the host always resynchronizes.
+ *
+ * Reception runs in the interrupts of UartRxDma: each frame is decoded in place, in the RX ring
+ * itself, as soon as its delimiter arrives, and handed to the handler, which must be quick. Only
+ * the frames that wrap around the end of the ring are copied first. Frames that don't pass the CRC
+ * are dropped and counted, recovering from losses is up to the protocol on top.
+ *
+ * Frames are sent through UartTxDma, between the log lines, without going to the log's tap.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_FRAMELINK_H
+#    define NILAIINI_SERVICES_FRAMELINK_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace FrameLink
+{
+constexpr size_t CRC_SIZE    = sizeof(uint32_t);
+constexpr size_t MAX_RX_BODY = 1040;
+constexpr size_t MAX_TX_BODY = 250;    //!< Built on the sender's stack.
+
+/**
+ * @brief Receives a valid frame.
+ * @note Called from an interrupt. @p body points in the RX ring, it is only valid for the
+ * duration of the call.
+ */
+using Handler = void (*)(uint8_t id, const uint8_t* body, size_t len);
+
+/**
+ * @brief Starts receiving the frames on UartRxDma, which must already exist.
+ */
+void Init(Handler handler);
+
+/**
+ * @brief Decodes what was received so far. Called from UartRxDma's interrupts.
+ */
+void Poll();
+
+/**
+ * @brief Queues a frame for transmission.
+ * @note Never blocks, can be called from an interrupt.
+ * @returns False if the body is too big or the frame was dropped.
+ */
+bool Send(uint8_t id, const void* body, size_t len);
+
+uint32_t GetFrameCount();
+uint32_t GetCrcErrors();
+uint32_t GetFramingErrors();
+}    // namespace FrameLink
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_FRAMELINK_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
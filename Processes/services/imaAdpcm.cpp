@@ -0,0 +1,210 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    imaAdpcm.cpp
+ * @brief   Source for the ImaAdpcm decoder.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "imaAdpcm.h"
+
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/profiler.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t  OUT_CHANNELS = 2;
+constexpr size_t  GROUP_BYTES  = 4;    //!< Of one channel, between the others'.
+constexpr size_t  GROUP_FRAMES = GROUP_BYTES * 2;
+constexpr int32_t MAX_INDEX    = 88;
+
+constexpr int16_t STEPS[MAX_INDEX + 1] = {
+  7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,
+  25,    28,    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,
+  88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,
+  307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,
+  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,
+  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487,
+  12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+constexpr int8_t INDEX_STEPS[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+/**
+ * @brief Applies @p nibble to a channel's sample and step.
+ */
+template<typename Channel>
+inline int16_t Step(Channel& channel, uint8_t nibble)
+{
+    int32_t step = STEPS[channel.index];
+    int32_t diff = step >> 3;
+    if ((nibble & 4) != 0)
+    {
+        diff += step;
+    }
+    if ((nibble & 2) != 0)
+    {
+        diff += step >> 1;
+    }
+    if ((nibble & 1) != 0)
+    {
+        diff += step >> 2;
+    }
+
+    int32_t sample = (nibble & 8) != 0 ? channel.sample - diff : channel.sample + diff;
+    channel.sample = std::clamp<int32_t>(sample, INT16_MIN, INT16_MAX);
+    channel.index  = std::clamp<int32_t>(channel.index + INDEX_STEPS[nibble & 7], 0, MAX_INDEX);
+    return static_cast<int16_t>(channel.sample);
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace ImaAdpcm
+{
+size_t FramesPerBlock(size_t blockAlign, size_t channels)
+{
+    if (channels == 0 || blockAlign < HEADER_SIZE * channels)
+    {
+        return 0;
+    }
+    // The first frame is in the headers.
+    return 1 + (blockAlign - HEADER_SIZE * channels) / (GROUP_BYTES * channels) * GROUP_FRAMES;
+}
+
+bool Decoder::Open(const uint8_t* data, size_t size, size_t channels, size_t blockAlign)
+{
+    m_data = nullptr;
+    if (data == nullptr || channels == 0 || channels > MAX_CHANNELS ||
+        FramesPerBlock(blockAlign, channels) == 0)
+    {
+        return false;
+    }
+    m_data       = data;
+    m_size       = size;
+    m_channels   = channels;
+    m_blockAlign = blockAlign;
+    m_frameCount = (size / blockAlign) * FramesPerBlock(blockAlign, channels) +
+                   FramesPerBlock(size % blockAlign, channels);
+    return Rewind();
+}
+
+size_t Decoder::Read(int16_t* out, size_t frames)
+{
+    PROFILE_ZONE("ima decode");
+
+    size_t done = 0;
+    while (done < frames)
+    {
+        if (m_frame == m_blockFrames && !NextBlock())
+        {
+            break;
+        }
+
+        size_t count = 0;
+        if (m_frame == 0)
+        {
+            count = DecodeHeaders(&out[done * OUT_CHANNELS]);
+        }
+        else
+        {
+            // The nibbles of a group of 8 frames are together.
+            size_t first = m_frame - 1;
+            count        = std::min({GROUP_FRAMES - first % GROUP_FRAMES,
+                              frames - done,
+                              m_blockFrames - m_frame});
+            DecodeGroup(&out[done * OUT_CHANNELS], first, count);
+        }
+        m_frame += count;
+        done += count;
+    }
+    return done;
+}
+
+bool Decoder::Rewind()
+{
+    m_block       = nullptr;
+    m_blockFrames = 0;
+    m_frame       = 0;
+    m_offset      = 0;
+    return m_data != nullptr;
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+bool Decoder::NextBlock()
+{
+    if (m_offset >= m_size)
+    {
+        return false;
+    }
+    size_t size   = std::min(m_blockAlign, m_size - m_offset);
+    m_block       = &m_data[m_offset];
+    m_blockFrames = FramesPerBlock(size, m_channels);
+    m_frame       = 0;
+    m_offset += size;
+    return m_blockFrames != 0;
+}
+
+/**
+ * @brief The first frame of a block is in its headers, as is the step of the next.
+ */
+size_t Decoder::DecodeHeaders(int16_t* out)
+{
+    for (size_t channel = 0; channel < m_channels; channel++)
+    {
+        const uint8_t* header   = &m_block[channel * HEADER_SIZE];
+        m_state[channel].sample = static_cast<int16_t>(ByteOrder::GetLe16(header));
+        m_state[channel].index  = std::min<int32_t>(header[2], MAX_INDEX);
+        out[channel]            = static_cast<int16_t>(m_state[channel].sample);
+    }
+    if (m_channels == 1)
+    {
+        out[1] = out[0];
+    }
+    return 1;
+}
+
+/**
+ * @param first The first frame after the headers to decode.
+ * @param count Up to the end of the group of 8 of @p first.
+ */
+void Decoder::DecodeGroup(int16_t* out, size_t first, size_t count)
+{
+    const uint8_t* groups =
+      &m_block[m_channels * (HEADER_SIZE + (first / GROUP_FRAMES) * GROUP_BYTES)];
+    size_t start = first % GROUP_FRAMES;
+    for (size_t channel = 0; channel < m_channels; channel++)
+    {
+        const uint8_t* bytes = &groups[channel * GROUP_BYTES];
+        Channel&       state = m_state[channel];
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t  nibble                  = start + i;
+            uint8_t code                    = (bytes[nibble / 2] >> ((nibble & 1) * 4)) & 0xF;
+            out[i * OUT_CHANNELS + channel] = Step(state, code);
+        }
+    }
+    if (m_channels == 1)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i * OUT_CHANNELS + 1] = out[i * OUT_CHANNELS];
+        }
+    }
+}
+}    // namespace ImaAdpcm
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,95 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    imaAdpcm.h
+ * @brief   Decoder of the IMA-ADPCM of WAV files (WAVE_FORMAT_IMA_ADPCM), 4 bits per sample.
+ *
+ * The samples come in blocks of blockAlign bytes. Each block starts with a header per channel,
+ * the first sample and the index of its step, and is followed by the nibbles of the others: 4
+ * bytes of one channel, the 8 next samples low nibble first, then 4 of the next channel:
+ *      | sample | index | 0 | ... per channel | 4 bytes of ch 0 | 4 bytes of ch 1 | ...
+ * Every nibble moves the sample by a multiple of the step, and the step by its index: only
+ * shifts and adds, as in the reference IMA decoder, which this one matches bit for bit.
+ *
+ * The decoder is incremental: it carries its state from one Read() to the next, and decodes
+ * straight into the caller's buffer, without a buffer of its own. It doesn't depend on the
+ * target, bench/codecBench.cpp checks it against tools/audioref.py.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_IMAADPCM_H
+#    define NILAIINI_SERVICES_IMAADPCM_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace ImaAdpcm
+{
+static constexpr size_t MAX_CHANNELS = 2;
+static constexpr size_t HEADER_SIZE  = 4;    //!< Per channel, at the start of a block.
+
+/**
+ * @returns The frames in a block of @p blockAlign bytes, 0 if it can't hold its headers.
+ */
+size_t FramesPerBlock(size_t blockAlign, size_t channels);
+
+class Decoder
+{
+public:
+    /**
+     * @param data       The "data" chunk, its blocks back to back. The last one may be shorter.
+     * @param blockAlign Of the "fmt " chunk.
+     * @returns False if the format isn't supported.
+     */
+    bool Open(const uint8_t* data, size_t size, size_t channels, size_t blockAlign);
+
+    /**
+     * @brief Decodes the next frames into @p out, as 16-bit stereo. Mono is played on both
+     *        channels.
+     * @returns The frames decoded, 0 at the end.
+     */
+    size_t Read(int16_t* out, size_t frames);
+
+    bool Rewind();
+
+    [[nodiscard]] size_t GetFrameCount() const { return m_frameCount; }
+
+private:
+    struct Channel
+    {
+        int32_t sample = 0;
+        int32_t index  = 0;    //!< In the table of steps.
+    };
+
+    const uint8_t* m_data       = nullptr;
+    size_t         m_size       = 0;
+    size_t         m_channels   = 0;
+    size_t         m_blockAlign = 0;
+    size_t         m_frameCount = 0;
+
+    const uint8_t* m_block       = nullptr;    //!< Being decoded.
+    size_t         m_blockFrames = 0;
+    size_t         m_frame       = 0;    //!< In the block.
+    size_t         m_offset      = 0;    //!< Of the next block in m_data.
+    Channel        m_state[MAX_CHANNELS];
+
+private:
+    bool   NextBlock();
+    size_t DecodeHeaders(int16_t* out);
+    void   DecodeGroup(int16_t* out, size_t first, size_t count);
+};
+}    // namespace ImaAdpcm
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_IMAADPCM_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,575 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    kvStore.cpp
+ * @brief   Source for the KvStore.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "kvStore.h"
+
+#include "Processes/services/crc32.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t BLANK_WORD    = 0xFFFFFFFF;
+constexpr size_t   RETIRE_LENGTH = sizeof(uint32_t);
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+bool KvStore::Mount()
+{
+    m_index.clear();
+    m_active      = NO_SECTOR;
+    m_writeOffset = 0;
+    m_liveBytes   = 0;
+    m_rotations   = 0;
+
+    m_sectorCount = m_flash.GetSectorCount();
+    m_sectorSize  = m_flash.GetSectorSize();
+    if (m_sectorCount < 2 || m_sectorCount > MAX_SECTORS || m_sectorSize % sizeof(uint32_t) != 0 ||
+        m_sectorSize < sizeof(SectorHeader) + 2 * RECORD_MAX)
+    {
+        return false;
+    }
+
+    // The sectors in use, from the oldest to the newest.
+    size_t   order[MAX_SECTORS] = {};
+    size_t   used               = 0;
+    uint32_t mostErased         = 0;
+    for (size_t sector = 0; sector < m_sectorCount; sector++)
+    {
+        SectorHeader header;
+        m_sectors[sector] = {};
+        if (!ReadHeader(sector, header))
+        {
+            continue;
+        }
+        m_sectors[sector] = {SectorState::Used, header.sequence, header.erases};
+        mostErased        = std::max(mostErased, header.erases);
+
+        size_t at = used++;
+        for (; at > 0 && m_sectors[order[at - 1]].sequence > header.sequence; at--)
+        {
+            order[at] = order[at - 1];
+        }
+        order[at] = sector;
+    }
+    // What a sector without header went through is lost, assume the worst.
+    for (size_t sector = 0; sector < m_sectorCount; sector++)
+    {
+        if (m_sectors[sector].state == SectorState::Unused)
+        {
+            m_sectors[sector].erases = mostErased;
+        }
+    }
+
+    if (used == 0)
+    {
+        return Start(0, 1);
+    }
+    for (size_t i = 0; i < used; i++)
+    {
+        // A sector retired by a newer one was dropped from the index when the retiring record
+        // was read.
+        if (m_sectors[order[i]].state == SectorState::Used)
+        {
+            m_active      = order[i];
+            m_writeOffset = Scan(order[i]);
+        }
+    }
+    for (const Entry& entry : m_index)
+    {
+        m_liveBytes += RecordSize(HeaderOf(entry.location));
+    }
+
+    // The power was cut while reclaiming the oldest sector.
+    size_t oldest = (m_active + 1) % m_sectorCount;
+    if (m_sectors[oldest].state == SectorState::Used)
+    {
+        if (m_writeOffset < m_sectorSize)
+        {
+            return Reclaim(oldest);
+        }
+        // Cut in the middle of a copy. The active sector only holds copies, start it over.
+        return m_flash.Erase(m_active) && Mount();
+    }
+    return true;
+}
+
+bool KvStore::Get(std::string_view key, std::string_view& value) const
+{
+    const Entry* entry = Find(key);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+    value = ValueOf(entry->location);
+    return true;
+}
+
+bool KvStore::Set(std::string_view key, std::string_view value)
+{
+    if (!IsMounted() || key.empty() || key.size() > MAX_KEY || value.size() > MAX_VALUE)
+    {
+        return false;
+    }
+    const Entry* existing = Find(key);
+    if (existing != nullptr && ValueOf(existing->location) == value)
+    {
+        return true;
+    }
+
+    // The previous value is counted too: it is still there if its sector is reclaimed.
+    size_t   size     = RecordSize(key.size(), value.size());
+    uint32_t location = 0;
+    if (m_liveBytes + size > GetCapacity() || !Reserve(size) ||
+        !AppendRecord(RecordType::Value, key, value, location))
+    {
+        return false;
+    }
+
+    // Making room may have moved the previous value.
+    Entry* entry = Find(key);
+    if (entry != nullptr)
+    {
+        m_liveBytes -= RecordSize(HeaderOf(entry->location));
+        entry->location = location;
+    }
+    else
+    {
+        Insert(Hash(key), location);
+    }
+    m_liveBytes += size;
+    return true;
+}
+
+bool KvStore::Erase(std::string_view key)
+{
+    if (!IsMounted())
+    {
+        return false;
+    }
+    Entry* entry = Find(key);
+    if (entry == nullptr)
+    {
+        return true;
+    }
+
+    // Out of the index, the value isn't copied if its sector is reclaimed to make room.
+    m_liveBytes -= RecordSize(HeaderOf(entry->location));
+    m_index.erase(m_index.begin() + (entry - m_index.data()));
+    uint32_t location = 0;
+    return Reserve(RecordSize(key.size(), 0)) &&
+           AppendRecord(RecordType::Erased, key, {}, location);
+}
+
+bool KvStore::Compact()
+{
+    return IsMounted() && Advance();
+}
+
+bool KvStore::PrepareNext()
+{
+    if (!IsMounted())
+    {
+        return false;
+    }
+    size_t  next = (m_active + 1) % m_sectorCount;
+    Sector& info = m_sectors[next];
+    if (info.state == SectorState::Used || IsBlank(next))
+    {
+        return true;
+    }
+    if (!m_flash.Erase(next))
+    {
+        return false;
+    }
+    // Start() writes it in the header.
+    info.erases++;
+    return true;
+}
+
+KvStore::Stats KvStore::GetStats() const
+{
+    Stats stats;
+    if (!IsMounted())
+    {
+        return stats;
+    }
+    stats.keys      = m_index.size();
+    stats.liveBytes = m_liveBytes;
+    stats.capacity  = GetCapacity();
+    stats.freeBytes = m_sectorSize - m_writeOffset;
+    stats.rotations = m_rotations;
+    stats.minErases = m_sectors[0].erases;
+    for (size_t sector = 0; sector < m_sectorCount; sector++)
+    {
+        stats.minErases = std::min(stats.minErases, m_sectors[sector].erases);
+        stats.maxErases = std::max(stats.maxErases, m_sectors[sector].erases);
+    }
+    return stats;
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+size_t KvStore::GetCapacity() const
+{
+    // A reclaimed sector's values must fit in a new one, with the record that retires it.
+    return m_sectorSize - sizeof(SectorHeader) - RecordSize(0, RETIRE_LENGTH);
+}
+
+bool KvStore::ReadHeader(size_t sector, SectorHeader& header) const
+{
+    std::memcpy(&header, m_flash.GetSector(sector), sizeof(header));
+    return header.magic == MAGIC &&
+           header.crc == Crc32::Compute(&header, offsetof(SectorHeader, crc));
+}
+
+/**
+ * @brief Indexes the records of @p sector.
+ * @returns Where the next record goes, the end of the sector if a record is corrupted.
+ */
+size_t KvStore::Scan(size_t sector)
+{
+    const uint8_t* base   = m_flash.GetSector(sector);
+    size_t         offset = sizeof(SectorHeader);
+    while (offset + sizeof(RecordHeader) <= m_sectorSize)
+    {
+        RecordHeader header;
+        uint32_t     words[2];
+        std::memcpy(&header, &base[offset], sizeof(header));
+        std::memcpy(words, &base[offset], sizeof(words));
+        if (words[0] == BLANK_WORD && words[1] == BLANK_WORD)
+        {
+            return offset;
+        }
+
+        // A record cut short by the power, nothing can be written after it.
+        size_t size = RecordSize(header);
+        if (!IsValid(header) || size > m_sectorSize - offset ||
+            RecordCrc(header, &base[offset + sizeof(header)]) != header.crc)
+        {
+            return m_sectorSize;
+        }
+        Apply(header, static_cast<uint32_t>(sector * m_sectorSize + offset));
+        offset += size;
+    }
+    return offset;
+}
+
+void KvStore::Apply(const RecordHeader& header, uint32_t location)
+{
+    if (header.type == RecordType::Retire)
+    {
+        uint32_t sequence = 0;
+        std::memcpy(&sequence, &At(location)[sizeof(header)], sizeof(sequence));
+        for (size_t sector = 0; sector < m_sectorCount; sector++)
+        {
+            if (m_sectors[sector].state == SectorState::Used &&
+                m_sectors[sector].sequence == sequence && sector != location / m_sectorSize)
+            {
+                RemoveSector(sector);
+                m_sectors[sector].state = SectorState::Unused;
+            }
+        }
+        return;
+    }
+
+    std::string_view key   = KeyOf(location);
+    Entry*           entry = Find(key);
+    if (header.type == RecordType::Erased)
+    {
+        if (entry != nullptr)
+        {
+            m_index.erase(m_index.begin() + (entry - m_index.data()));
+        }
+    }
+    else if (entry != nullptr)
+    {
+        entry->location = location;
+    }
+    else
+    {
+        Insert(Hash(key), location);
+    }
+}
+
+/**
+ * @brief Erases @p sector if needed and makes it the active one.
+ */
+bool KvStore::Start(size_t sector, uint32_t sequence)
+{
+    Sector& info = m_sectors[sector];
+    if (!IsBlank(sector))
+    {
+        if (!m_flash.Erase(sector))
+        {
+            return false;
+        }
+        info.erases++;
+    }
+
+    SectorHeader header;
+    header.sequence = sequence;
+    header.erases   = info.erases;
+    header.crc      = Crc32::Compute(&header, offsetof(SectorHeader, crc));
+    if (!m_flash.Program(sector, 0, &header, sizeof(header)))
+    {
+        return false;
+    }
+    info.state    = SectorState::Used;
+    info.sequence = sequence;
+    m_active      = sector;
+    m_writeOffset = sizeof(header);
+    return true;
+}
+
+/**
+ * @brief Moves on to the next sector of the ring, and reclaims the oldest one after it.
+ */
+bool KvStore::Advance()
+{
+    size_t next = (m_active + 1) % m_sectorCount;
+    // Only if reclaiming it failed.
+    if (m_sectors[next].state == SectorState::Used)
+    {
+        return false;
+    }
+    if (!Start(next, m_sectors[m_active].sequence + 1))
+    {
+        return false;
+    }
+    m_rotations++;
+
+    size_t oldest = (m_active + 1) % m_sectorCount;
+    if (m_sectors[oldest].state == SectorState::Used)
+    {
+        return Reclaim(oldest);
+    }
+    return true;
+}
+
+/**
+ * @brief Copies the values that are still current out of @p sector, then retires it.
+ */
+bool KvStore::Reclaim(size_t sector)
+{
+    for (Entry& entry : m_index)
+    {
+        if (entry.location / m_sectorSize != sector)
+        {
+            continue;
+        }
+        uint32_t location = 0;
+        if (!Append(At(entry.location), RecordSize(HeaderOf(entry.location)), location))
+        {
+            return false;
+        }
+        entry.location = location;
+    }
+
+    uint32_t sequence = m_sectors[sector].sequence;
+    uint32_t location = 0;
+    if (!AppendRecord(RecordType::Retire,
+                      {},
+                      {reinterpret_cast<const char*>(&sequence), sizeof(sequence)},
+                      location))
+    {
+        return false;
+    }
+    m_sectors[sector].state = SectorState::Unused;
+    return true;
+}
+
+/**
+ * @brief Makes sure @p size bytes can be appended to the active sector.
+ */
+bool KvStore::Reserve(size_t size)
+{
+    // Nothing can follow the copies of a reclaim that failed, but the end of that reclaim.
+    size_t oldest = (m_active + 1) % m_sectorCount;
+    if (m_sectors[oldest].state == SectorState::Used && !Reclaim(oldest))
+    {
+        return false;
+    }
+    if (m_sectorSize - m_writeOffset >= size)
+    {
+        return true;
+    }
+    return Advance() && m_sectorSize - m_writeOffset >= size;
+}
+
+bool KvStore::Append(const void* record, size_t size, uint32_t& location)
+{
+    if (size > m_sectorSize - m_writeOffset)
+    {
+        return false;
+    }
+    if (!m_flash.Program(m_active, m_writeOffset, record, size))
+    {
+        // What was half written can't be written over, the sector is done.
+        m_writeOffset = m_sectorSize;
+        return false;
+    }
+    location = static_cast<uint32_t>(m_active * m_sectorSize + m_writeOffset);
+    m_writeOffset += size;
+    return true;
+}
+
+bool KvStore::AppendRecord(RecordType       type,
+                           std::string_view key,
+                           std::string_view value,
+                           uint32_t&        location)
+{
+    RecordHeader header;
+    header.type        = type;
+    header.keyLength   = static_cast<uint8_t>(key.size());
+    header.valueLength = static_cast<uint16_t>(value.size());
+
+    size_t   size   = RecordSize(header);
+    uint8_t* record = reinterpret_cast<uint8_t*>(m_record);
+    uint8_t* body   = &record[sizeof(header)];
+    std::memset(record, 0xFF, size);
+    std::memcpy(body, key.data(), key.size());
+    std::memcpy(&body[key.size()], value.data(), value.size());
+    header.crc = RecordCrc(header, body);
+    std::memcpy(record, &header, sizeof(header));
+
+    return Append(record, size, location);
+}
+
+bool KvStore::IsBlank(size_t sector) const
+{
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(m_flash.GetSector(sector));
+    return std::all_of(words,
+                       &words[m_sectorSize / sizeof(uint32_t)],
+                       [](uint32_t word) { return word == BLANK_WORD; });
+}
+
+KvStore::Entry* KvStore::Find(std::string_view key)
+{
+    return const_cast<Entry*>(static_cast<const KvStore*>(this)->Find(key));
+}
+
+const KvStore::Entry* KvStore::Find(std::string_view key) const
+{
+    uint32_t hash = Hash(key);
+    auto     it   = std::lower_bound(m_index.begin(),
+                               m_index.end(),
+                               hash,
+                               [](const Entry& entry, uint32_t value)
+                               { return entry.hash < value; });
+    for (; it != m_index.end() && it->hash == hash; ++it)
+    {
+        if (KeyOf(it->location) == key)
+        {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+void KvStore::Insert(uint32_t hash, uint32_t location)
+{
+    auto it = std::upper_bound(m_index.begin(),
+                               m_index.end(),
+                               hash,
+                               [](uint32_t value, const Entry& entry)
+                               { return value < entry.hash; });
+    m_index.insert(it, {hash, location});
+}
+
+void KvStore::RemoveSector(size_t sector)
+{
+    m_index.erase(std::remove_if(m_index.begin(),
+                                 m_index.end(),
+                                 [this, sector](const Entry& entry)
+                                 { return entry.location / m_sectorSize == sector; }),
+                  m_index.end());
+}
+
+const uint8_t* KvStore::At(uint32_t location) const
+{
+    return &m_flash.GetSector(location / m_sectorSize)[location % m_sectorSize];
+}
+
+KvStore::RecordHeader KvStore::HeaderOf(uint32_t location) const
+{
+    RecordHeader header;
+    std::memcpy(&header, At(location), sizeof(header));
+    return header;
+}
+
+std::string_view KvStore::KeyOf(uint32_t location) const
+{
+    const char* body = reinterpret_cast<const char*>(&At(location)[sizeof(RecordHeader)]);
+    return {body, HeaderOf(location).keyLength};
+}
+
+std::string_view KvStore::ValueOf(uint32_t location) const
+{
+    RecordHeader header = HeaderOf(location);
+    const char*  body   = reinterpret_cast<const char*>(&At(location)[sizeof(RecordHeader)]);
+    return {&body[header.keyLength], header.valueLength};
+}
+
+bool KvStore::IsValid(const RecordHeader& header)
+{
+    switch (header.type)
+    {
+        case RecordType::Value:
+            return header.keyLength != 0 && header.keyLength <= MAX_KEY &&
+                   header.valueLength <= MAX_VALUE;
+        case RecordType::Erased:
+            return header.keyLength != 0 && header.keyLength <= MAX_KEY &&
+                   header.valueLength == 0;
+        case RecordType::Retire:
+            return header.keyLength == 0 && header.valueLength == RETIRE_LENGTH;
+        default: return false;
+    }
+}
+
+size_t KvStore::RecordSize(size_t keyLength, size_t valueLength)
+{
+    return sizeof(RecordHeader) + ((keyLength + valueLength + 3) & ~size_t(3));
+}
+
+size_t KvStore::RecordSize(const RecordHeader& header)
+{
+    return RecordSize(header.keyLength, header.valueLength);
+}
+
+uint32_t KvStore::Hash(std::string_view key)
+{
+    // FNV-1a.
+    uint32_t hash = 2166136261U;
+    for (char c : key)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619U;
+    }
+    return hash;
+}
+
+uint32_t KvStore::RecordCrc(const RecordHeader& header, const uint8_t* body)
+{
+    uint32_t crc = Crc32::Compute(&header, offsetof(RecordHeader, crc));
+    return Crc32::Update(crc, body, header.keyLength + header.valueLength);
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    kvStore.h
+ * @brief   Log-structured key-value store over sectors of flash, wear-leveled.
+ *
+ * Nothing is ever rewritten in place: setting or erasing a key appends a record to the active
+ * sector, and the last record of a key is its value. The sectors are used in a ring, each one
+ * starting with a header that numbers it in the order they were started:
+ *      | header | record | record | ...  free ... |
+ *      | type | key length | value length | CRC | key | value | padding to 4 |
+ * Mount() reads the records of every sector from the oldest to the newest, and keeps in RAM an
+ * index of where each key's last record is. Get() then returns the value where it is, in the
+ * flash.
+ *
+ * When the active sector is full, the next one in the ring is erased and becomes the active
+ * sector. The one after it, the oldest, is then reclaimed: its records that are still the last
+ * of their key are copied to the active sector, followed by a record that retires it. It is
+ * only erased when its turn to be the active sector comes. Every sector is erased in turn, as
+ * often as the others.
+ *
+ * Power can be cut at any point:
+ *  - A record that wasn't fully written doesn't match its CRC, it and what follows are ignored.
+ *  - A sector whose header wasn't written, or was half erased, is not used.
+ *  - Until the retiring record is written, the oldest sector is still read and the copies of
+ *    its records only repeat them. Mount() finishes a reclaim that was cut short, or erases the
+ *    copies and starts over when one of them was cut.
+ *
+ * The store doesn't depend on the target, a Flash gives it its sectors: InternalFlash on the
+ * target, bench/simFlash.h on the host, which cuts the power on demand.
+ *
+ * @note All the values must fit in one sector, Set() fails beyond.
+ * @note Not thread-safe, the caller locks.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_KVSTORE_H
+#    define NILAIINI_SERVICES_KVSTORE_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+#    include <string_view>
+#    include <vector>
+
+/*****************************************************************************/
+/* Exported types */
+class KvStore
+{
+public:
+    static constexpr uint32_t MAGIC       = 0x31564B4E;    //!< "NKV1".
+    static constexpr size_t   MAX_KEY     = 64;
+    static constexpr size_t   MAX_VALUE   = 256;
+    static constexpr size_t   MAX_SECTORS = 8;
+
+    /**
+     * @brief Sectors of NOR flash, of the same size and mapped in memory.
+     *
+     * Erasing sets a sector's bytes to 0xFF, programming can only clear bits.
+     */
+    class Flash
+    {
+    public:
+        virtual ~Flash() = default;
+
+        [[nodiscard]] virtual size_t GetSectorCount() const = 0;
+        [[nodiscard]] virtual size_t GetSectorSize() const  = 0;
+        /**
+         * @returns Where @p sector is read from.
+         */
+        [[nodiscard]] virtual const uint8_t* GetSector(size_t sector) const = 0;
+
+        virtual bool Erase(size_t sector) = 0;
+        /**
+         * @param offset In @p sector, a multiple of 4.
+         * @param size   A multiple of 4.
+         */
+        virtual bool Program(size_t sector, size_t offset, const void* data, size_t size) = 0;
+    };
+
+    struct Stats
+    {
+        size_t   keys      = 0;
+        size_t   liveBytes = 0;    //!< Taken by the last record of every key.
+        size_t   capacity  = 0;    //!< What liveBytes can grow to.
+        size_t   freeBytes = 0;    //!< Left in the active sector.
+        uint32_t rotations = 0;    //!< Since Mount().
+        uint32_t minErases = 0;    //!< Of the sectors.
+        uint32_t maxErases = 0;
+    };
+
+    explicit KvStore(Flash& flash) : m_flash(flash) {}
+
+    /**
+     * @brief Reads the sectors and indexes the keys. Formats the flash if no sector is in use.
+     * @returns False if the flash has less than 2 or more than MAX_SECTORS sectors, or can't be
+     *          written.
+     */
+    bool Mount();
+
+    [[nodiscard]] bool IsMounted() const { return m_active != NO_SECTOR; }
+
+    /**
+     * @param value Set to the value, in the flash. Valid until the next Set(), Erase() or
+     *              Compact().
+     * @returns False if there is no such key.
+     */
+    bool Get(std::string_view key, std::string_view& value) const;
+
+    /**
+     * @brief Doesn't write anything if @p key already has that value.
+     * @returns False if the key or the value is too long, or the values wouldn't fit in a sector.
+     */
+    bool Set(std::string_view key, std::string_view value);
+
+    /**
+     * @returns False only if the flash couldn't be written.
+     */
+    bool Erase(std::string_view key);
+
+    /**
+     * @brief Moves on to the next sector right away, reclaiming the oldest one.
+     */
+    bool Compact();
+
+    /**
+     * @brief Erases the sector that comes after the active one, if it's retired and not blank.
+     *
+     * Set() and Erase() then only program the flash until the active sector is full: call it
+     * when stalling on an erase does no harm.
+     * @returns False only if the flash couldn't be erased.
+     */
+    bool PrepareNext();
+
+    /**
+     * @brief Calls @p fn(key, value) for every key, in no particular order.
+     */
+    template<typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (const Entry& entry : m_index)
+        {
+            fn(KeyOf(entry.location), ValueOf(entry.location));
+        }
+    }
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    static constexpr size_t NO_SECTOR = SIZE_MAX;
+
+    enum RecordType : uint8_t
+    {
+        Value  = 0x56,    //!< 'V'.
+        Erased = 0x58,    //!< 'X', has no value.
+        Retire = 0x52,    //!< 'R', no key, the value is the sequence of the retired sector.
+    };
+
+    struct SectorHeader
+    {
+        uint32_t magic    = MAGIC;
+        uint32_t sequence = 0;    //!< Order in which the sectors were started.
+        uint32_t erases   = 0;
+        uint32_t crc      = 0;    //!< Of the fields above.
+    };
+
+    struct RecordHeader
+    {
+        uint8_t  type        = 0;
+        uint8_t  keyLength   = 0;
+        uint16_t valueLength = 0;
+        uint32_t crc         = 0;    //!< Of the fields above, the key and the value.
+    };
+
+    enum class SectorState : uint8_t
+    {
+        Unused,    //!< Blank, half erased, or retired.
+        Used,
+    };
+
+    struct Sector
+    {
+        SectorState state    = SectorState::Unused;
+        uint32_t    sequence = 0;
+        uint32_t    erases   = 0;
+    };
+
+    struct Entry
+    {
+        uint32_t hash     = 0;
+        uint32_t location = 0;    //!< Of the record, sector * sector size + offset.
+    };
+
+    static constexpr size_t RECORD_MAX =
+      sizeof(RecordHeader) + ((MAX_KEY + MAX_VALUE + 3) & ~size_t(3));
+
+    Flash&             m_flash;
+    size_t             m_sectorCount = 0;
+    size_t             m_sectorSize  = 0;
+    Sector             m_sectors[MAX_SECTORS];
+    size_t             m_active      = NO_SECTOR;
+    size_t             m_writeOffset = 0;    //!< In the active sector.
+    size_t             m_liveBytes   = 0;
+    uint32_t           m_rotations   = 0;
+    std::vector<Entry> m_index;    //!< Sorted by hash.
+
+    //! Where records are put together before being programmed.
+    uint32_t m_record[RECORD_MAX / sizeof(uint32_t)] = {};
+
+private:
+    [[nodiscard]] size_t GetCapacity() const;
+
+    bool   ReadHeader(size_t sector, SectorHeader& header) const;
+    size_t Scan(size_t sector);
+    void   Apply(const RecordHeader& header, uint32_t location);
+    bool   Start(size_t sector, uint32_t sequence);
+    bool   Advance();
+    bool   Reclaim(size_t sector);
+    bool   Reserve(size_t size);
+    bool   Append(const void* record, size_t size, uint32_t& location);
+    bool   AppendRecord(RecordType       type,
+                        std::string_view key,
+                        std::string_view value,
+                        uint32_t&        location);
+
+    [[nodiscard]] bool IsBlank(size_t sector) const;
+
+    [[nodiscard]] Entry*           Find(std::string_view key);
+    [[nodiscard]] const Entry*     Find(std::string_view key) const;
+    void                           Insert(uint32_t hash, uint32_t location);
+    void                           RemoveSector(size_t sector);
+    [[nodiscard]] const uint8_t*   At(uint32_t location) const;
+    [[nodiscard]] RecordHeader     HeaderOf(uint32_t location) const;
+    [[nodiscard]] std::string_view KeyOf(uint32_t location) const;
+    [[nodiscard]] std::string_view ValueOf(uint32_t location) const;
+
+    static bool     IsValid(const RecordHeader& header);
+    static size_t   RecordSize(size_t keyLength, size_t valueLength);
+    static size_t   RecordSize(const RecordHeader& header);
+    static uint32_t Hash(std::string_view key);
+    static uint32_t RecordCrc(const RecordHeader& header, const uint8_t* body);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_KVSTORE_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
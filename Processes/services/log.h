@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    log.h
+ * @brief   LOG_* macros of the application.
+ *
+ * Replaces the printf-style macros of NilaiTFO's logger.hpp with ones that use the format
+ * engine (see format.h), for example:
+ *      LOG_INFO("POST OK! {:.3} seconds.", seconds);
+ *
+ * The line is formatted directly into the UART's DMA ring, without intermediate buffer: its
+ * length is measured first, then the exact room is reserved and filled in place. When
+ * APP_LOG_BINARY is set, the line is sent as a binary frame instead (see binaryLog.h).
+ *
+ * NilaiTFO's own modules keep logging through its Logger.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_LOG_H
+#    define NILAIINI_SERVICES_LOG_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Core/Inc/main.h"
+
+#    include "NilaiTFO/services/logger.hpp"
+
+#    include "Processes/drivers/uartTxDma.h"
+#    include "Processes/services/binaryLog.h"
+#    include "Processes/services/format.h"
+
+/*****************************************************************************/
+/* Exported types */
+namespace AppLog
+{
+class RingSink : public Fmt::Sink
+{
+public:
+    explicit RingSink(UartTxDma::RingWriter& writer) : m_writer(writer) {}
+
+    void Write(const char* data, size_t len) override { m_writer.Write(data, len); }
+
+private:
+    UartTxDma::RingWriter& m_writer;
+};
+
+template<typename S, typename... Args>
+void Log(S fmt, const Args&... args)
+{
+    UartTxDma* uart = UartTxDma::Get();
+    if (uart == nullptr)
+    {
+        return;
+    }
+
+    size_t len = Fmt::FormattedSize(fmt, args...);
+    uart->WriteInPlace(len, [&](UartTxDma::RingWriter& writer) {
+        RingSink sink(writer);
+        Fmt::FormatTo(sink, fmt, args...);
+    });
+}
+}    // namespace AppLog
+
+/*****************************************************************************/
+/* Exported macro */
+#    if APP_LOG_BINARY
+#        define APP_LOG_STR_(x) #x
+#        define APP_LOG_STR(x)  APP_LOG_STR_(x)
+
+/**
+ * Fields of the table entry are separated by the ASCII unit separator (0x1F). Each piece is its
+ * own string literal so that the escape sequence can't absorb the first characters of the next.
+ */
+#        define APP_LOG_HELPER(level, msg, ...)                                                \
+            do                                                                                 \
+            {                                                                                  \
+                static const char s_binaryLogFmt[]                                             \
+                  __attribute__((section(".nilai_log_fmt"), used)) =                           \
+                    level "\x1F" __FILE__ ":" APP_LOG_STR(__LINE__) "\x1F" msg;                \
+                BinaryLog::Log(FMT_STRING(msg), s_binaryLogFmt, ##__VA_ARGS__);                \
+            } while (0)
+#    else
+#        define APP_LOG_HELPER(level, msg, ...)                                                \
+            AppLog::Log(                                                                       \
+              FMT_STRING("[{}] [" level "]: " msg "\n\r"), HAL_GetTick(), ##__VA_ARGS__)
+#    endif
+
+#    undef LOG_DEBUG
+#    undef LOG_INFO
+#    undef LOG_WARNING
+#    undef LOG_ERROR
+#    undef LOG_CRITICAL
+
+#    if defined(NILAI_LOG_ENABLE_DEBUG)
+#        define LOG_DEBUG(msg, ...) APP_LOG_HELPER("DEBUG", msg, ##__VA_ARGS__)
+#    else
+#        define LOG_DEBUG(msg, ...)
+#    endif
+#    if defined(NILAI_LOG_ENABLE_INFO)
+#        define LOG_INFO(msg, ...) APP_LOG_HELPER("INFO", msg, ##__VA_ARGS__)
+#    else
+#        define LOG_INFO(msg, ...)
+#    endif
+#    if defined(NILAI_LOG_ENABLE_WARNING)
+#        define LOG_WARNING(msg, ...) APP_LOG_HELPER("WARNING", msg, ##__VA_ARGS__)
+#    else
+#        define LOG_WARNING(msg, ...)
+#    endif
+#    if defined(NILAI_LOG_ENABLE_ERROR)
+#        define LOG_ERROR(msg, ...) APP_LOG_HELPER("ERROR", msg, ##__VA_ARGS__)
+#    else
+#        define LOG_ERROR(msg, ...)
+#    endif
+#    if defined(NILAI_LOG_ENABLE_CRITICAL)
+#        define LOG_CRITICAL(msg, ...) APP_LOG_HELPER("CRITICAL", msg, ##__VA_ARGS__)
+#    else
+#        define LOG_CRITICAL(msg, ...)
+#    endif
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_LOG_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
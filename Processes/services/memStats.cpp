@@ -0,0 +1,510 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    memStats.cpp
+ * @brief   Source for the MemStats, and the wrappers of newlib's malloc.
+ *
+ * With APP_USE_TLSF, the wrappers don't call newlib's malloc anymore but serve every request from
+ * a Tlsf over the RAM the linker script reserves past the end of .bss (_Tlsf_Heap_Size).
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "memStats.h"
+
+#include "Core/Inc/main.h"
+
+#include "Processes/drivers/ccmRam.h"
+#include "Processes/drivers/criticalSection.h"
+#include "Processes/services/log.h"
+#include "Processes/services/tlsf.h"
+
+#if APP_USE_RTOS
+#    include "Processes/os/threadedApplication.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+struct _reent;
+
+extern "C"
+{
+// From the linker script.
+extern uint8_t  _end;
+extern uint8_t  _estack;
+extern uint32_t _Min_Stack_Size;
+extern uint32_t _Tlsf_Heap_Size;
+
+void* _sbrk(ptrdiff_t incr);
+
+// From newlib's malloc. __malloc_av_[2] points to the top chunk, the free end of the arena.
+extern void* __malloc_av_[];
+void         __malloc_lock(_reent* r);
+void         __malloc_unlock(_reent* r);
+
+// Resolved by -Wl,--wrap to the functions of newlib.
+void* __real__malloc_r(_reent* r, size_t size);
+void  __real__free_r(_reent* r, void* ptr);
+void* __real__realloc_r(_reent* r, void* ptr, size_t size);
+void* __real__calloc_r(_reent* r, size_t count, size_t size);
+void* __real__memalign_r(_reent* r, size_t alignment, size_t size);
+size_t __real__malloc_usable_size_r(_reent* r, void* ptr);
+}
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uintptr_t PAINT_MARGIN = 64;    //!< Left unpainted below the stack pointer.
+
+#if APP_USE_TLSF
+Tlsf s_heap;    // Constant-initialized, usable from the static constructors.
+#endif
+
+// A chunk of dlmalloc starts with the size of the previous one, then its own size. The low bits
+// of the size are flags, PREV_INUSE is clear when the previous chunk is free.
+constexpr uint32_t CHUNK_ALIGN     = 8;
+constexpr uint32_t CHUNK_SIZE_MASK = ~(CHUNK_ALIGN - 1);
+constexpr uint32_t PREV_INUSE      = 0x1;
+constexpr uint32_t MIN_CHUNK_SIZE  = 16;
+
+MemStats::Owner s_owners[MemStats::MAX_OWNERS] = {{"other"}};
+size_t          s_ownerCount                   = 1;
+uint8_t         s_owner                        = 0;
+
+uint32_t s_current     = 0;
+uint32_t s_peak        = 0;
+uint32_t s_blocks      = 0;
+uint32_t s_allocations = 0;
+uint32_t s_failures    = 0;
+
+#if APP_USE_TLSF
+/**
+ * @brief Holds off the interrupts over a wrapper, the Tlsf is quick enough for it.
+ */
+class Accounting
+{
+public:
+    explicit Accounting(_reent* /*r*/)
+    {
+        if (!s_heap.IsInitialized())
+        {
+            s_heap.Init(&_end, reinterpret_cast<uintptr_t>(&_Tlsf_Heap_Size));
+        }
+    }
+
+    [[nodiscard]] bool IsOuter() const { return true; }
+
+private:
+    CriticalSection m_cs;
+};
+
+void* Malloc(_reent* /*r*/, size_t size)
+{
+    return s_heap.Allocate(size);
+}
+void Free(_reent* /*r*/, void* ptr)
+{
+    s_heap.Free(ptr);
+}
+void* Realloc(_reent* /*r*/, void* ptr, size_t size)
+{
+    return s_heap.Reallocate(ptr, size);
+}
+void* Calloc(_reent* /*r*/, size_t count, size_t size)
+{
+    size_t bytes = count * size;
+    if (size != 0 && bytes / size != count)
+    {
+        return nullptr;
+    }
+    void* ptr = s_heap.Allocate(bytes);
+    if (ptr != nullptr)
+    {
+        std::memset(ptr, 0, bytes);
+    }
+    return ptr;
+}
+void* Memalign(_reent* /*r*/, size_t alignment, size_t size)
+{
+    return s_heap.AllocateAligned(alignment, size);
+}
+size_t UsableSize(_reent* /*r*/, void* ptr)
+{
+    return Tlsf::UsableSize(ptr);
+}
+#else
+/**
+ * @brief Holds malloc's lock over a wrapper. calloc, realloc and memalign call malloc and free,
+ *        through the wrappers too: only the outermost call is accounted for.
+ */
+class Accounting
+{
+public:
+    explicit Accounting(_reent* r) : m_reent(r)
+    {
+        __malloc_lock(r);
+        m_outer  = !s_nested;
+        s_nested = true;
+    }
+    ~Accounting()
+    {
+        if (m_outer)
+        {
+            s_nested = false;
+        }
+        __malloc_unlock(m_reent);
+    }
+
+    [[nodiscard]] bool IsOuter() const { return m_outer; }
+
+private:
+    static inline bool s_nested = false;    //!< In a call the outer wrapper accounts for.
+
+    _reent* m_reent;
+    bool    m_outer;
+};
+
+void* Malloc(_reent* r, size_t size)
+{
+    return __real__malloc_r(r, size);
+}
+void Free(_reent* r, void* ptr)
+{
+    __real__free_r(r, ptr);
+}
+void* Realloc(_reent* r, void* ptr, size_t size)
+{
+    return __real__realloc_r(r, ptr, size);
+}
+void* Calloc(_reent* r, size_t count, size_t size)
+{
+    return __real__calloc_r(r, count, size);
+}
+void* Memalign(_reent* r, size_t alignment, size_t size)
+{
+    return __real__memalign_r(r, alignment, size);
+}
+size_t UsableSize(_reent* r, void* ptr)
+{
+    return __real__malloc_usable_size_r(r, ptr);
+}
+#endif
+
+void Allocated(_reent* r, void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        s_failures++;
+        return;
+    }
+    auto size = static_cast<uint32_t>(UsableSize(r, ptr));
+    s_current += size;
+    s_peak = std::max(s_peak, s_current);
+    s_blocks++;
+    s_allocations++;
+    s_owners[s_owner].allocations++;
+    s_owners[s_owner].allocatedBytes += size;
+}
+
+void Freed(uint32_t size)
+{
+    s_current -= size;
+    s_blocks--;
+    s_owners[s_owner].frees++;
+    s_owners[s_owner].freedBytes += size;
+}
+
+/**
+ * @brief The end of the heap as it is, the stack is above.
+ */
+uintptr_t HeapEnd()
+{
+#if APP_USE_TLSF
+    return reinterpret_cast<uintptr_t>(&_end) + reinterpret_cast<uintptr_t>(&_Tlsf_Heap_Size);
+#else
+    return reinterpret_cast<uintptr_t>(_sbrk(0));
+#endif
+}
+
+/**
+ * @brief The deepest the stack went: the first word above the heap that lost its paint.
+ */
+uintptr_t StackLowWater()
+{
+    const auto* word = reinterpret_cast<const uint32_t*>((HeapEnd() + 3) & ~uintptr_t(3));
+    const auto* top  = reinterpret_cast<const uint32_t*>(&_estack);
+    while (word < top && *word == MemStats::STACK_PAINT)
+    {
+        word++;
+    }
+    return reinterpret_cast<uintptr_t>(word);
+}
+
+#if !APP_USE_TLSF
+/**
+ * @brief Where _sbrk stops growing the heap.
+ */
+uintptr_t HeapLimit()
+{
+    return reinterpret_cast<uintptr_t>(&_estack) - reinterpret_cast<uintptr_t>(&_Min_Stack_Size);
+}
+
+/**
+ * @brief Walks the chunks from the start of the arena to the top chunk, adding up the free ones.
+ *        The first chunk is at the first 8-byte boundary of the heap, dlmalloc aligns it there.
+ */
+void WalkChunks(uint32_t& free, uint32_t& largest)
+{
+    auto      chunk = (reinterpret_cast<uintptr_t>(&_end) + CHUNK_ALIGN - 1) & CHUNK_SIZE_MASK;
+    uintptr_t top   = reinterpret_cast<uintptr_t>(__malloc_av_[2]);
+    uintptr_t end   = HeapEnd();
+    if (top < chunk || top >= end)
+    {
+        return;    // Nothing was ever allocated.
+    }
+
+    while (chunk < top)
+    {
+        uint32_t  size = reinterpret_cast<const uint32_t*>(chunk)[1] & CHUNK_SIZE_MASK;
+        uintptr_t next = chunk + size;
+        if (size < MIN_CHUNK_SIZE || next > top)
+        {
+            break;    // Not a chunk, the heap isn't contiguous.
+        }
+        if ((reinterpret_cast<const uint32_t*>(next)[1] & PREV_INUSE) == 0)
+        {
+            free += size;
+            largest = std::max(largest, size);
+        }
+        chunk = next;
+    }
+
+    uint32_t topSize = reinterpret_cast<const uint32_t*>(top)[1] & CHUNK_SIZE_MASK;
+    free += topSize;
+    // The top chunk grows as far as _sbrk lets it.
+    largest = std::max<uint32_t>(largest, topSize + std::max<uintptr_t>(HeapLimit(), end) - end);
+}
+#endif
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace MemStats
+{
+void PaintStack()
+{
+    auto* word = reinterpret_cast<uint32_t*>((HeapEnd() + 3) & ~uintptr_t(3));
+    auto* end  = reinterpret_cast<uint32_t*>(__get_MSP() - PAINT_MARGIN);
+    while (word < end)
+    {
+        *word++ = STACK_PAINT;
+    }
+}
+
+Heap GetHeap()
+{
+    CriticalSection cs;
+    Heap            heap;
+    heap.current     = s_current;
+    heap.peak        = s_peak;
+    heap.blocks      = s_blocks;
+    heap.allocations = s_allocations;
+    heap.failures    = s_failures;
+#if APP_USE_TLSF
+    Tlsf::Stats stats = s_heap.GetStats();
+    heap.arena        = stats.size;
+    heap.free         = stats.free;
+    heap.largestFree  = stats.largestFree;
+#else
+    heap.arena = static_cast<uint32_t>(HeapEnd() - reinterpret_cast<uintptr_t>(&_end));
+    WalkChunks(heap.free, heap.largestFree);
+#endif
+    return heap;
+}
+
+Stack GetStack()
+{
+    uintptr_t lowWater = StackLowWater();
+    Stack     stack;
+    stack.reserved = reinterpret_cast<uintptr_t>(&_Min_Stack_Size);
+    stack.used     = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&_estack) - lowWater);
+    stack.headroom = static_cast<uint32_t>(lowWater - HeapEnd());
+    return stack;
+}
+
+uint8_t RegisterOwner(const char* name)
+{
+    CriticalSection cs;
+    if (s_ownerCount == MAX_OWNERS)
+    {
+        return 0;
+    }
+    s_owners[s_ownerCount].name = name;
+    return static_cast<uint8_t>(s_ownerCount++);
+}
+
+uint8_t SetOwner(uint8_t owner)
+{
+    uint8_t previous = s_owner;
+    s_owner          = owner < s_ownerCount ? owner : 0;
+    return previous;
+}
+
+size_t GetOwnerCount()
+{
+    return s_ownerCount;
+}
+
+Owner GetOwner(size_t index)
+{
+    CriticalSection cs;
+    return index < s_ownerCount ? s_owners[index] : Owner {};
+}
+
+void Log()
+{
+    Heap  heap  = GetHeap();
+    Stack stack = GetStack();
+
+    LOG_INFO("----- Memory:");
+    LOG_INFO("Heap: {} B in {} blocks, peak {} B, {} allocations, {} failed.",
+             heap.current,
+             heap.blocks,
+             heap.peak,
+             heap.allocations,
+             heap.failures);
+    // 0% when the free memory is in one block.
+    uint32_t fragmentation =
+      heap.free != 0 ? 100 - static_cast<uint32_t>(100ull * heap.largestFree / heap.free) : 0;
+    LOG_INFO("Arena: {} B, {} B free, largest free block {} B ({}% fragmented).",
+             heap.arena,
+             heap.free,
+             heap.largestFree,
+             fragmentation);
+    LOG_INFO("Main stack: {} B used, {} B reserved, {} B above the heap.",
+             stack.used,
+             stack.reserved,
+             stack.headroom);
+#if APP_USE_RTOS
+    ThreadedApplication::LogStackUsage();
+#endif
+    LOG_INFO("CCM: {} B used of {} B.", CcmRam::GetUsed(), CcmRam::SIZE);
+
+    LOG_INFO("{:<20} {:>8} {:>8} {:>10} {:>10}", "owner", "allocs", "frees", "alloc B", "live B");
+    for (size_t i = 0; i < GetOwnerCount(); i++)
+    {
+        Owner owner = GetOwner(i);
+        LOG_INFO("{:<20} {:>8} {:>8} {:>10} {:>10}",
+                 owner.name,
+                 owner.allocations,
+                 owner.frees,
+                 owner.allocatedBytes,
+                 static_cast<int32_t>(owner.allocatedBytes - owner.freedBytes));
+    }
+}
+
+bool DoPost()
+{
+    Log();
+
+    Stack stack = GetStack();
+    if (stack.used > stack.reserved)
+    {
+        LOG_WARNING("The main stack went {} B past _Min_Stack_Size.", stack.used - stack.reserved);
+    }
+    if (stack.headroom < MIN_HEADROOM)
+    {
+        LOG_ERROR("The main stack came within {} B of the heap!", stack.headroom);
+        return false;
+    }
+    return true;
+}
+}    // namespace MemStats
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+extern "C" void* __wrap__malloc_r(_reent* r, size_t size)
+{
+    Accounting accounting(r);
+    void*      ptr = Malloc(r, size);
+    if (accounting.IsOuter())
+    {
+        Allocated(r, ptr);
+    }
+    return ptr;
+}
+
+extern "C" void __wrap__free_r(_reent* r, void* ptr)
+{
+    Accounting accounting(r);
+    if (accounting.IsOuter() && ptr != nullptr)
+    {
+        Freed(static_cast<uint32_t>(UsableSize(r, ptr)));
+    }
+    Free(r, ptr);
+}
+
+extern "C" void* __wrap__realloc_r(_reent* r, void* ptr, size_t size)
+{
+    Accounting accounting(r);
+    auto  oldSize = ptr != nullptr ? static_cast<uint32_t>(UsableSize(r, ptr)) : 0;
+    void* result  = Realloc(r, ptr, size);
+    if (!accounting.IsOuter())
+    {
+        return result;
+    }
+
+    if (result == nullptr && size != 0)
+    {
+        s_failures++;    // The old block is left as it was.
+        return result;
+    }
+    // Counted as a free and an allocation, even when the block grew in place.
+    if (ptr != nullptr)
+    {
+        Freed(oldSize);
+    }
+    if (result != nullptr)
+    {
+        Allocated(r, result);
+    }
+    return result;
+}
+
+extern "C" void* __wrap__calloc_r(_reent* r, size_t count, size_t size)
+{
+    Accounting accounting(r);
+    void*      ptr = Calloc(r, count, size);
+    if (accounting.IsOuter())
+    {
+        Allocated(r, ptr);
+    }
+    return ptr;
+}
+
+extern "C" size_t __wrap__malloc_usable_size_r(_reent* r, void* ptr)
+{
+    return UsableSize(r, ptr);
+}
+
+extern "C" void* __wrap__memalign_r(_reent* r, size_t alignment, size_t size)
+{
+    Accounting accounting(r);
+    void*      ptr = Memalign(r, alignment, size);
+    if (accounting.IsOuter())
+    {
+        Allocated(r, ptr);
+    }
+    return ptr;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    memStats.h
+ * @brief   Usage of the heap and of the main stack, and who allocates what.
+ *
+ * The heap starts at the end of .bss and the main stack grows down from the end of the RAM. The
+ * heap is either a Tlsf of _Tlsf_Heap_Size bytes (APP_USE_TLSF, see tlsf.h), or newlib's malloc
+ * (dlmalloc) fed by _sbrk, which grows until the _Min_Stack_Size reserve. This tells how close
+ * the two get:
+ *  - Heap:  _malloc_r, _free_r, _realloc_r, _calloc_r, _memalign_r and _malloc_usable_size_r
+ *           are wrapped at link time (-Wl,--wrap, see CMakeLists.txt), operator new and
+ *           std::string land there too. The wrappers count the bytes in use, their peak and the
+ *           failed allocations. The largest free block is found by walking the heap's blocks,
+ *           fragmentation shows as a largest block much smaller than the free total.
+ *  - Stack: PaintStack() fills the RAM between the heap and the stack with STACK_PAINT, the
+ *           first word not holding it anymore is as deep as the stack ever went.
+ *
+ * Allocations are attributed to the owner set when they happen. MasterApplication sets the one
+ * of each module around its Run(), what happens outside of them goes to owner 0, "other":
+ *      static const uint8_t s_owner = MemStats::RegisterOwner("CheckParser");
+ *      MemStats::OwnerScope scope(s_owner);
+ * A block freed by another owner than the one that allocated it is counted as freed by the
+ * former. With APP_USE_RTOS, the owner is global: a module that blocks in its Run() lends its
+ * owner to the threads that run in the meantime.
+ *
+ * Reported by Log(), in the POST (which fails below MIN_HEADROOM) and with tools/umo.py mem
+ * (GET_MEMORY).
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_MEMSTATS_H
+#    define NILAIINI_SERVICES_MEMSTATS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace MemStats
+{
+static constexpr uint32_t STACK_PAINT  = 0xA5A5A5A5;    //!< Same as the threads' stacks.
+static constexpr size_t   MIN_HEADROOM = 2048;    //!< Between the heap and the deepest stack.
+static constexpr size_t   MAX_OWNERS   = 24;      //!< Owners past that are counted as "other".
+
+struct Heap
+{
+    uint32_t current     = 0;    //!< Bytes in use, as given by malloc (rounded up).
+    uint32_t peak        = 0;
+    uint32_t blocks      = 0;    //!< Blocks in use.
+    uint32_t allocations = 0;    //!< Since the boot.
+    uint32_t failures    = 0;    //!< Allocations that returned null.
+    uint32_t arena       = 0;    //!< Bytes taken from _sbrk, or the Tlsf's region.
+    uint32_t free        = 0;    //!< Free bytes in the arena.
+    uint32_t largestFree = 0;    //!< Largest block malloc could return, with what _sbrk can add.
+};
+
+struct Stack
+{
+    uint32_t reserved = 0;    //!< _Min_Stack_Size.
+    uint32_t used     = 0;    //!< Deepest the main stack went, since PaintStack().
+    uint32_t headroom = 0;    //!< Between the end of the heap and the deepest the stack went.
+};
+
+struct Owner
+{
+    const char* name           = nullptr;
+    uint32_t    allocations    = 0;
+    uint32_t    frees          = 0;
+    uint32_t    allocatedBytes = 0;
+    uint32_t    freedBytes     = 0;
+};
+
+/**
+ * @brief Paints the free RAM below the current stack pointer. First thing in main(), before
+ *        anything goes deep into the stack.
+ */
+void PaintStack();
+
+[[nodiscard]] Heap  GetHeap();
+[[nodiscard]] Stack GetStack();
+
+/**
+ * @param name Must outlive the application.
+ * @returns The ID of the new owner, or 0 ("other") when the table is full.
+ */
+uint8_t RegisterOwner(const char* name);
+
+/**
+ * @brief Attributes the following allocations to @p owner.
+ * @returns The previous owner.
+ */
+uint8_t SetOwner(uint8_t owner);
+
+[[nodiscard]] size_t GetOwnerCount();
+
+/**
+ * @returns The counters of the owner at @p index, a null name past the last one.
+ */
+[[nodiscard]] Owner GetOwner(size_t index);
+
+/**
+ * @brief Sets an owner for its scope, then restores the previous one.
+ */
+class OwnerScope
+{
+public:
+    explicit OwnerScope(uint8_t owner) : m_previous(SetOwner(owner)) {}
+    ~OwnerScope() { SetOwner(m_previous); }
+
+    OwnerScope(const OwnerScope&)            = delete;
+    OwnerScope& operator=(const OwnerScope&) = delete;
+
+private:
+    uint8_t m_previous;
+};
+
+/**
+ * @brief Logs the heap, the stacks and one line per owner.
+ */
+void Log();
+
+/**
+ * @brief Logs the usage.
+ * @returns False when the stack came within MIN_HEADROOM of the heap.
+ */
+bool DoPost();
+}    // namespace MemStats
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_MEMSTATS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,242 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    pcSampler.cpp
+ * @brief   Source for the PcSampler.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "pcSampler.h"
+
+#include "Core/Inc/main.h"
+
+#include "Processes/drivers/criticalSection.h"
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/frameLink.h"
+#include "Processes/services/umoDispatcher.h"
+
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t TIMER_CLOCK = 1000000;    //!< TIM7 counts microseconds.
+constexpr size_t   MAX_PROBES  = 16;
+constexpr uint32_t SLOT_BITS   = 9;
+constexpr size_t   HEADER_SIZE = sizeof(uint16_t) + 2 * sizeof(uint32_t);
+
+static_assert(HEADER_SIZE + PcSampler::MAX_PER_REPLY * 2 * sizeof(uint32_t) <=
+                FrameLink::MAX_TX_BODY,
+              "A reply of PcSampler must fit in a frame");
+static_assert(PcSampler::SLOT_COUNT == 1u << SLOT_BITS, "SLOT_BITS must match SLOT_COUNT");
+
+struct Slot
+{
+    uint32_t pc;
+    uint32_t count;
+};
+
+Slot              s_slots[PcSampler::SLOT_COUNT] = {};
+volatile uint32_t s_samples                      = 0;
+volatile uint32_t s_dropped                      = 0;
+volatile bool     s_running                      = false;
+uint32_t          s_period                       = 0;    //!< In timer ticks.
+uint32_t          s_lfsr                         = 0xACE1u;
+
+/**
+ * @brief TIM7 sits on APB1, its clock is twice PCLK1 when APB1 is divided.
+ */
+uint32_t TimerInputClock()
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return (RCC->CFGR & RCC_CFGR_PPRE1_2) != 0 ? 2 * pclk1 : pclk1;
+}
+
+void Count(uint32_t pc)
+{
+    s_samples = s_samples + 1;
+
+    // Fibonacci hashing, the PCs of Thumb code are always even.
+    size_t slot = ((pc >> 1) * 2654435761u) >> (32 - SLOT_BITS);
+    for (size_t probe = 0; probe < MAX_PROBES; probe++)
+    {
+        Slot& entry = s_slots[(slot + probe) & (PcSampler::SLOT_COUNT - 1)];
+        if (entry.pc == pc)
+        {
+            entry.count++;
+            return;
+        }
+        if (entry.count == 0)
+        {
+            entry.pc    = pc;
+            entry.count = 1;
+            return;
+        }
+    }
+    s_dropped = s_dropped + 1;
+}
+
+void ReplySamples(uint8_t id, size_t first)
+{
+    uint8_t reply[FrameLink::MAX_TX_BODY];
+    size_t  pos   = HEADER_SIZE;
+    size_t  slot  = first;
+    size_t  added = 0;
+    for (; slot < PcSampler::SLOT_COUNT && added < PcSampler::MAX_PER_REPLY; slot++)
+    {
+        if (s_slots[slot].count == 0)
+        {
+            continue;
+        }
+        ByteOrder::PutLe32(&reply[pos], s_slots[slot].pc);
+        ByteOrder::PutLe32(&reply[pos + sizeof(uint32_t)], s_slots[slot].count);
+        pos += 2 * sizeof(uint32_t);
+        added++;
+    }
+
+    reply[0] = static_cast<uint8_t>(slot);
+    reply[1] = static_cast<uint8_t>(slot >> 8);
+    ByteOrder::PutLe32(&reply[2], s_samples);
+    ByteOrder::PutLe32(&reply[6], s_dropped);
+    UmoDispatcher::Reply(id, reply, pos);
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace PcSampler
+{
+void Start(uint32_t rate)
+{
+    if (rate == 0)
+    {
+        rate = DEFAULT_RATE;
+    }
+    else if (rate > MAX_RATE)
+    {
+        rate = MAX_RATE;
+    }
+
+    Stop();
+    {
+        CriticalSection cs;
+        std::memset(s_slots, 0, sizeof(s_slots));
+        s_samples = 0;
+        s_dropped = 0;
+    }
+
+    __HAL_RCC_TIM7_CLK_ENABLE();
+    s_period   = TIMER_CLOCK / rate;
+    TIM7->CR1  = TIM_CR1_ARPE;
+    TIM7->PSC  = TimerInputClock() / TIMER_CLOCK - 1;
+    TIM7->ARR  = s_period - 1;
+    TIM7->EGR  = TIM_EGR_UG;    // Loads the prescaler.
+    TIM7->SR   = 0;
+    TIM7->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(TIM7_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM7_IRQn);
+    s_running = true;
+    TIM7->CR1 |= TIM_CR1_CEN;
+}
+
+void Stop()
+{
+    if (!s_running)
+    {
+        return;
+    }
+    TIM7->CR1 &= ~TIM_CR1_CEN;
+    TIM7->DIER = 0;
+    HAL_NVIC_DisableIRQ(TIM7_IRQn);
+    s_running = false;
+}
+
+bool IsRunning()
+{
+    return s_running;
+}
+
+uint32_t GetSampleCount()
+{
+    return s_samples;
+}
+
+uint32_t GetDroppedCount()
+{
+    return s_dropped;
+}
+
+void OnFrame(uint8_t id, const uint8_t* body, size_t len)
+{
+    switch (id)
+    {
+        case StartSampling:
+            if (len != sizeof(uint16_t))
+            {
+                UmoDispatcher::ReplyError(id, UmoDispatcher::ErrorCode::InvalidRequest);
+                return;
+            }
+            PcSampler::Start(body[0] | (body[1] << 8));
+            UmoDispatcher::Reply(id, nullptr, 0);
+            break;
+        case StopSampling:
+            PcSampler::Stop();
+            UmoDispatcher::Reply(id, nullptr, 0);
+            break;
+        case GetSamples:
+            if (len != sizeof(uint16_t))
+            {
+                UmoDispatcher::ReplyError(id, UmoDispatcher::ErrorCode::InvalidRequest);
+                return;
+            }
+            ReplySamples(id, body[0] | (body[1] << 8));
+            break;
+        default:
+            UmoDispatcher::ReplyError(id, UmoDispatcher::ErrorCode::UnknownCommand);
+            break;
+    }
+}
+}    // namespace PcSampler
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Counts the PC stacked by the entry of TIM7_IRQHandler, and dithers the next period.
+ * @param frame The exception frame: r0, r1, r2, r3, r12, lr, pc, xpsr.
+ */
+extern "C" __attribute__((used)) void PcSampler_OnTick(const uint32_t* frame)
+{
+    TIM7->SR = 0;    // UIF is the only flag of TIM7.
+
+    Count(frame[6]);
+
+    // Galois LFSR, the next period lands within [7/8, 9/8] of the nominal one.
+    s_lfsr         = (s_lfsr >> 1) ^ (-(s_lfsr & 1u) & 0xB400u);
+    uint32_t range = s_period / 4;
+    uint32_t next  = s_period - range / 2 + (range != 0 ? s_lfsr % range : 0);
+    TIM7->ARR      = next - 1;
+}
+
+/**
+ * @brief Hands the exception frame, on whichever stack it was pushed, to PcSampler_OnTick.
+ */
+extern "C" __attribute__((naked)) void TIM7_IRQHandler()
+{
+    __asm volatile("tst   lr, #4          \n"
+                   "ite   eq              \n"
+                   "mrseq r0, msp         \n"
+                   "mrsne r0, psp         \n"
+                   "b     PcSampler_OnTick\n");
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
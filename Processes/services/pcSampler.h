@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    pcSampler.h
+ * @brief   Statistical profiler: samples the interrupted PC from TIM7, see tools/pcsample.py.
+ *
+ * While sampling, TIM7's interrupt reads the PC stacked by the exception entry and counts it in
+ * a hash table. Nothing has to be instrumented, and the cost is one short interrupt per sample.
+ * The period is dithered by up to 1/8 so a loop running in step with the timer isn't always
+ * caught at the same place.
+ *
+ * Frames from the host, registered on the UmoDispatcher:
+ *  - START   (0x20): rate (u16, Hz, 0 for DEFAULT_RATE). Clears the samples and starts.
+ *  - STOP    (0x21).
+ *  - SAMPLES (0x22): first slot (u16). Answers with: next slot (u16) | samples (u32) |
+ *                    dropped (u32) | up to MAX_PER_REPLY pairs of pc (u32) | count (u32). The
+ *                    host asks again from `next slot` until it equals SLOT_COUNT.
+ *
+ * @note All the interrupts share the same priority, so the time spent in the other interrupts
+ *       is attributed to where they returned to.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_PCSAMPLER_H
+#    define NILAIINI_SERVICES_PCSAMPLER_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace PcSampler
+{
+static constexpr size_t   SLOT_COUNT    = 512;      //!< Distinct PCs that can be counted.
+static constexpr uint32_t DEFAULT_RATE  = 10000;    //!< In Hz.
+static constexpr uint32_t MAX_RATE      = 50000;    //!< In Hz.
+static constexpr size_t   MAX_PER_REPLY = 30;
+
+enum FrameId : uint8_t
+{
+    StartSampling = 0x20,
+    StopSampling  = 0x21,
+    GetSamples    = 0x22,
+};
+
+/**
+ * @brief Clears the samples and starts TIM7 at @p rate Hz.
+ */
+void Start(uint32_t rate = DEFAULT_RATE);
+void Stop();
+
+[[nodiscard]] bool     IsRunning();
+[[nodiscard]] uint32_t GetSampleCount();
+/**
+ * @brief Samples that didn't fit in the table, because too many distinct PCs were hit.
+ */
+[[nodiscard]] uint32_t GetDroppedCount();
+
+/**
+ * @brief Handles the frames of the protocol. Matches UmoDispatcher::Handler.
+ */
+void OnFrame(uint8_t id, const uint8_t* body, size_t len);
+}    // namespace PcSampler
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_PCSAMPLER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
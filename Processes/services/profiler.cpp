@@ -0,0 +1,203 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    profiler.cpp
+ * @brief   Source for the Profiler.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "profiler.h"
+
+#include "Processes/drivers/criticalSection.h"
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+Profiler::Zone* s_first = nullptr;
+
+/**
+ * @brief Values below 4 have their own bucket, then each power of two is split in 4.
+ */
+size_t BucketOf(Profiler::Ticks ticks)
+{
+    if (ticks < 4)
+    {
+        return ticks;
+    }
+    uint32_t msb = 31 - __builtin_clz(ticks);
+    uint32_t sub = (ticks >> (msb - 2)) & 3;
+    return (msb - 1) * 4 + sub;
+}
+
+/**
+ * @brief Largest value that falls in a bucket.
+ */
+Profiler::Ticks UpperBoundOf(size_t bucket)
+{
+    if (bucket < 4)
+    {
+        return static_cast<Profiler::Ticks>(bucket);
+    }
+    uint32_t msb   = static_cast<uint32_t>(bucket / 4 + 1);
+    uint64_t lower = static_cast<uint64_t>(4 + bucket % 4) << (msb - 2);
+    return static_cast<Profiler::Ticks>(lower + (1ULL << (msb - 2)) - 1);
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Profiler
+{
+void Init()
+{
+#if defined(__ARM_ARCH_7EM__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t TicksPerSecond()
+{
+#if defined(__ARM_ARCH_7EM__)
+    return SystemCoreClock;
+#else
+    return 1000000000;
+#endif
+}
+
+float ToMicroseconds(Ticks ticks)
+{
+    return static_cast<float>(ticks) * 1e6f / static_cast<float>(TicksPerSecond());
+}
+
+Zone::Zone(const char* name) : m_name(name)
+{
+    CriticalSection cs;
+    m_next  = s_first;
+    s_first = this;
+}
+
+void Zone::Record(Ticks ticks)
+{
+    size_t          bucket = BucketOf(ticks);
+    CriticalSection cs;
+
+    m_count++;
+    m_total += ticks;
+    m_min = ticks < m_min ? ticks : m_min;
+    m_max = ticks > m_max ? ticks : m_max;
+
+    if (m_buckets[bucket] == UINT16_MAX)
+    {
+        for (uint16_t& count : m_buckets)
+        {
+            count /= 2;
+        }
+    }
+    m_buckets[bucket]++;
+}
+
+Stats Zone::GetStats() const
+{
+    CriticalSection cs;
+
+    Stats stats;
+    stats.count = m_count;
+    if (m_count != 0)
+    {
+        stats.min = m_min;
+        stats.max = m_max;
+        stats.avg = static_cast<Ticks>(m_total / m_count);
+        stats.p50 = Percentile(500);
+        stats.p99 = Percentile(990);
+    }
+    return stats;
+}
+
+void Zone::Reset()
+{
+    CriticalSection cs;
+
+    m_count = 0;
+    m_min   = UINT32_MAX;
+    m_max   = 0;
+    m_total = 0;
+    for (uint16_t& count : m_buckets)
+    {
+        count = 0;
+    }
+}
+
+Zone* GetFirstZone()
+{
+    return s_first;
+}
+
+Zone* GetZone(size_t index)
+{
+    Zone* zone = s_first;
+    while (zone != nullptr && index-- != 0)
+    {
+        zone = zone->GetNext();
+    }
+    return zone;
+}
+
+size_t GetZoneCount()
+{
+    size_t count = 0;
+    for (Zone* zone = s_first; zone != nullptr; zone = zone->GetNext())
+    {
+        count++;
+    }
+    return count;
+}
+
+void ResetAll()
+{
+    for (Zone* zone = s_first; zone != nullptr; zone = zone->GetNext())
+    {
+        zone->Reset();
+    }
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Estimates a percentile from the histogram, never above the largest value seen.
+ */
+Ticks Zone::Percentile(uint32_t perThousand) const
+{
+    uint32_t total = 0;
+    for (uint16_t count : m_buckets)
+    {
+        total += count;
+    }
+
+    uint32_t target = static_cast<uint32_t>((static_cast<uint64_t>(total) * perThousand + 999) /
+                                            1000);
+    uint32_t seen   = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        seen += m_buckets[bucket];
+        if (seen >= target && seen != 0)
+        {
+            Ticks bound = UpperBoundOf(bucket);
+            return bound < m_max ? bound : m_max;
+        }
+    }
+    return m_max;
+}
+}    // namespace Profiler
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,167 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    profiler.h
+ * @brief   Cycle-accurate timing of named zones of code.
+ *
+ * On target, the time is read from the DWT cycle counter of the Cortex-M4: one tick is one CPU
+ * cycle, reading it costs a single load. On the host, the same API is backed by std::chrono and
+ * one tick is one nanosecond, so the zones can be benchmarked off-target (see bench/).
+ *
+ * Each zone accumulates the count, min, max and total of its measurements, as well as a
+ * histogram with 4 buckets per power of two, from which the percentiles are estimated within
+ * 25%. The zones register themselves in a list on creation, tools/umo.py lists them over UART.
+ *
+ * Usage:
+ * @code
+ * void Mixer::Run()
+ * {
+ *     PROFILE_ZONE("mixer");    // Times everything up to the end of the scope.
+ *     ...
+ * }
+ * @endcode
+ *
+ * @note Recording is safe from any context, interrupts included.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_PROFILER_H
+#    define NILAIINI_SERVICES_PROFILER_H
+
+/*****************************************************************************/
+/* Includes */
+#    if defined(__ARM_ARCH_7EM__)
+#        include "Core/Inc/main.h"
+#    else
+#        include <chrono>
+#    endif
+
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported macro */
+#    define PROFILE_CONCAT_(a, b) a##b
+#    define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+
+/**
+ * @brief Times the rest of the enclosing scope in a zone named @p name (a string literal).
+ */
+#    define PROFILE_ZONE(name)                                                                     \
+        static Profiler::Zone PROFILE_CONCAT(s_profileZone, __LINE__)(name);                       \
+        Profiler::ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(                              \
+          PROFILE_CONCAT(s_profileZone, __LINE__))
+
+/*****************************************************************************/
+/* Exported types */
+namespace Profiler
+{
+using Ticks = uint32_t;
+
+/**
+ * @brief Starts the cycle counter. Must be called once before anything is timed.
+ */
+void Init();
+
+inline Ticks Now()
+{
+#    if defined(__ARM_ARCH_7EM__)
+    return DWT->CYCCNT;
+#    else
+    return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+#    endif
+}
+
+/**
+ * @brief Ticks in one second: the CPU's frequency on target, 1e9 on the host.
+ */
+uint32_t TicksPerSecond();
+
+/**
+ * @brief Converts ticks to microseconds.
+ */
+float ToMicroseconds(Ticks ticks);
+
+struct Stats
+{
+    uint32_t count = 0;
+    Ticks    min   = 0;
+    Ticks    avg   = 0;
+    Ticks    max   = 0;
+    Ticks    p50   = 0;
+    Ticks    p99   = 0;
+};
+
+class Zone
+{
+public:
+    static constexpr size_t BUCKET_COUNT = 124;    //!< 4 per power of two, up to 2^32.
+
+    /**
+     * @param name Must outlive the zone, a string literal usually.
+     */
+    explicit Zone(const char* name);
+
+    Zone(const Zone&)            = delete;
+    Zone& operator=(const Zone&) = delete;
+
+    void Record(Ticks ticks);
+
+    [[nodiscard]] Stats       GetStats() const;
+    [[nodiscard]] const char* GetName() const { return m_name; }
+    [[nodiscard]] Zone*       GetNext() const { return m_next; }
+
+    void Reset();
+
+private:
+    const char* m_name  = nullptr;
+    Zone*       m_next  = nullptr;
+    uint32_t    m_count = 0;
+    Ticks       m_min   = UINT32_MAX;
+    Ticks       m_max   = 0;
+    uint64_t    m_total = 0;
+    //! Halved when one saturates, the shape of the distribution is what matters.
+    uint16_t m_buckets[BUCKET_COUNT] = {};
+
+private:
+    Ticks Percentile(uint32_t perThousand) const;
+};
+
+/**
+ * @brief Records the time from its construction to its destruction in a zone.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Zone& zone) : m_zone(zone), m_start(Now()) {}
+    ~ScopedTimer() { m_zone.Record(Now() - m_start); }
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Zone& m_zone;
+    Ticks m_start;
+};
+
+/**
+ * @brief First of the zones, in reverse order of creation. Follow with Zone::GetNext().
+ */
+Zone* GetFirstZone();
+
+Zone*  GetZone(size_t index);
+size_t GetZoneCount();
+void   ResetAll();
+}    // namespace Profiler
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_PROFILER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,251 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    qoa.cpp
+ * @brief   Source for the Qoa decoder.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "qoa.h"
+
+#include "Processes/services/profiler.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t MAGIC        = 0x716F6166;    // "qoaf"
+constexpr size_t   LMS_SIZE     = 16;    //!< Per channel, the history then the weights.
+constexpr size_t   SLICE_SIZE   = 8;
+constexpr size_t   OUT_CHANNELS = 2;
+
+/**
+ * @brief The residuals of each scale factor, rounded away from 0 as in the reference.
+ */
+struct DequantTable
+{
+    int32_t values[16][8] = {};
+
+    constexpr DequantTable()
+    {
+        constexpr int32_t scales[16] = {
+          1, 7, 21, 45, 84, 138, 211, 304, 421, 562, 731, 928, 1157, 1419, 1715, 2048};
+        // 0.75, 2.5, 4.5 and 7, in quarters.
+        constexpr int32_t quarters[4] = {3, 10, 18, 28};
+        for (size_t scale = 0; scale < 16; scale++)
+        {
+            for (size_t q = 0; q < 4; q++)
+            {
+                int32_t value            = (scales[scale] * quarters[q] + 2) / 4;
+                values[scale][q * 2]     = value;
+                values[scale][q * 2 + 1] = -value;
+            }
+        }
+    }
+};
+constexpr DequantTable DEQUANT;
+
+uint64_t GetBe64(const uint8_t* in)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+/**
+ * @brief The 4 signed 16-bit values of @p in, from the top.
+ */
+void Unpack(const uint8_t* in, int32_t (&out)[Qoa::LMS_LEN])
+{
+    uint64_t packed = GetBe64(in);
+    for (int32_t& value : out)
+    {
+        value = static_cast<int16_t>(packed >> 48);
+        packed <<= 16;
+    }
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Qoa
+{
+size_t GetFrameSize(const uint8_t* header)
+{
+    return GetBe64(header) & 0xFFFF;
+}
+
+bool Decoder::Open(const uint8_t* file, size_t size)
+{
+    m_frames = nullptr;
+    if (file == nullptr || size < FILE_HEADER + FRAME_HEADER || GetBe64(file) >> 32 != MAGIC)
+    {
+        return false;
+    }
+
+    uint64_t header     = GetBe64(&file[FILE_HEADER]);
+    size_t   frameCount = GetBe64(file) & UINT32_MAX;
+    size_t   channels   = header >> 56;
+    // 0 samples is a stream, of which the length isn't known: not supported.
+    if (frameCount == 0 ||
+        !OpenFrames(&file[FILE_HEADER], size - FILE_HEADER, channels, (header >> 32) & 0xFFFFFF))
+    {
+        return false;
+    }
+    m_frameCount = frameCount;
+    return true;
+}
+
+bool Decoder::OpenFrames(const uint8_t* frames, size_t size, size_t channels, uint32_t sampleRate)
+{
+    m_frames = nullptr;
+    if (frames == nullptr || channels == 0 || channels > MAX_CHANNELS)
+    {
+        return false;
+    }
+    m_frames     = frames;
+    m_size       = size;
+    m_channels   = channels;
+    m_sampleRate = sampleRate;
+    m_frameCount = 0;
+    return Rewind();
+}
+
+size_t Decoder::Read(int16_t* out, size_t frames)
+{
+    PROFILE_ZONE("qoa decode");
+
+    size_t done = 0;
+    while (done < frames)
+    {
+        if (m_sample == m_frameSamples && !NextFrame())
+        {
+            break;
+        }
+        if (m_sample % SLICE_LEN == 0)
+        {
+            LoadSlices();
+        }
+
+        size_t count =
+          std::min({SLICE_LEN - m_sample % SLICE_LEN, frames - done, m_frameSamples - m_sample});
+        for (size_t channel = 0; channel < m_channels; channel++)
+        {
+            Channel& state   = m_state[channel];
+            int16_t* samples = &out[done * OUT_CHANNELS + channel];
+            for (size_t i = 0; i < count; i++)
+            {
+                int32_t predicted = 0;
+                for (size_t tap = 0; tap < LMS_LEN; tap++)
+                {
+                    predicted += state.weights[tap] * state.history[tap];
+                }
+                predicted >>= 13;
+
+                int32_t residual = state.dequant[state.slice >> 61];
+                int32_t sample   = std::clamp<int32_t>(predicted + residual, INT16_MIN, INT16_MAX);
+                state.slice <<= 3;
+                samples[i * OUT_CHANNELS] = static_cast<int16_t>(sample);
+
+                int32_t delta = residual >> 4;
+                for (size_t tap = 0; tap < LMS_LEN; tap++)
+                {
+                    state.weights[tap] += state.history[tap] < 0 ? -delta : delta;
+                }
+                for (size_t tap = 0; tap < LMS_LEN - 1; tap++)
+                {
+                    state.history[tap] = state.history[tap + 1];
+                }
+                state.history[LMS_LEN - 1] = sample;
+            }
+        }
+        if (m_channels == 1)
+        {
+            for (size_t i = done; i < done + count; i++)
+            {
+                out[i * OUT_CHANNELS + 1] = out[i * OUT_CHANNELS];
+            }
+        }
+        m_sample += count;
+        done += count;
+    }
+    return done;
+}
+
+bool Decoder::Rewind()
+{
+    m_slices       = nullptr;
+    m_frameSamples = 0;
+    m_sample       = 0;
+    m_offset       = 0;
+    return m_frames != nullptr;
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Checks the header of the next frame and loads its LMS state.
+ * @returns False at the end of the file, or if the frame is corrupted.
+ */
+bool Decoder::NextFrame()
+{
+    size_t lmsSize = LMS_SIZE * m_channels;
+    if (m_size - m_offset < FRAME_HEADER + lmsSize)
+    {
+        return false;
+    }
+
+    const uint8_t* frame     = &m_frames[m_offset];
+    uint64_t       header    = GetBe64(frame);
+    size_t         samples   = (header >> 16) & 0xFFFF;
+    size_t         frameSize = header & 0xFFFF;
+    size_t         slices    = (samples + SLICE_LEN - 1) / SLICE_LEN * m_channels;
+    if ((header >> 56) != m_channels || ((header >> 32) & 0xFFFFFF) != m_sampleRate ||
+        samples == 0 || samples > FRAME_SAMPLES || frameSize > m_size - m_offset ||
+        frameSize < FRAME_HEADER + lmsSize + slices * SLICE_SIZE)
+    {
+        return false;
+    }
+
+    for (size_t channel = 0; channel < m_channels; channel++)
+    {
+        const uint8_t* lms = &frame[FRAME_HEADER + channel * LMS_SIZE];
+        Unpack(&lms[0], m_state[channel].history);
+        Unpack(&lms[LMS_SIZE / 2], m_state[channel].weights);
+    }
+    m_slices       = &frame[FRAME_HEADER + lmsSize];
+    m_frameSamples = samples;
+    m_sample       = 0;
+    m_offset += frameSize;
+    return true;
+}
+
+/**
+ * @brief Loads the slice of each channel that m_sample starts.
+ */
+void Decoder::LoadSlices()
+{
+    const uint8_t* slices = &m_slices[(m_sample / SLICE_LEN) * m_channels * SLICE_SIZE];
+    for (size_t channel = 0; channel < m_channels; channel++)
+    {
+        uint64_t slice           = GetBe64(&slices[channel * SLICE_SIZE]);
+        m_state[channel].dequant = DEQUANT.values[slice >> 60];
+        m_state[channel].slice   = slice << 4;
+    }
+}
+}    // namespace Qoa
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
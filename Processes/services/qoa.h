@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    qoa.h
+ * @brief   Decoder of the Quite OK Audio format (qoaformat.org), 3.2 bits per sample.
+ *
+ * A file is a header, "qoaf" and the samples per channel (u32), then frames of up to 5120
+ * samples per channel, all big endian:
+ *      | channels u8 | rate u24 | samples u16 | size u16 | history, weights per channel | slices |
+ * Each channel is predicted by a 4-tap LMS filter, whose state starts the frame. The slices hold
+ * 20 residuals of one channel, quantized to 3 bits with a scale factor of 4, and alternate
+ * between channels. Decoding is only multiplies, adds and shifts, as in the reference decoder
+ * (qoa.h), which this one matches bit for bit.
+ *
+ * The decoder is incremental: it carries its state from one Read() to the next, down to the
+ * slice it's in, and decodes straight into the caller's buffer. It doesn't depend on the target,
+ * bench/codecBench.cpp checks it against tools/audioref.py.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_QOA_H
+#    define NILAIINI_SERVICES_QOA_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace Qoa
+{
+static constexpr size_t MAX_CHANNELS  = 2;
+static constexpr size_t SLICE_LEN     = 20;    //!< Samples per slice.
+static constexpr size_t FRAME_SAMPLES = 256 * SLICE_LEN;
+static constexpr size_t LMS_LEN       = 4;
+static constexpr size_t FILE_HEADER   = 8;
+static constexpr size_t FRAME_HEADER  = 8;
+
+/**
+ * @returns The largest frame of @p channels, header included.
+ */
+constexpr size_t MaxFrameSize(size_t channels)
+{
+    return FRAME_HEADER + channels * (16 + FRAME_SAMPLES / SLICE_LEN * 8);
+}
+
+/**
+ * @returns The size of the frame of @p header, header included.
+ */
+size_t GetFrameSize(const uint8_t* header);
+
+class Decoder
+{
+public:
+    /**
+     * @param file The whole file, which must stay valid while it's decoded.
+     * @returns False if it isn't a QOA file, or its format isn't supported.
+     */
+    bool Open(const uint8_t* file, size_t size);
+
+    /**
+     * @brief Decodes frames without the file's header, such as the frame just read of a file
+     *        streamed from the SD card.
+     * @param channels, sampleRate Of the file's first frame, which every frame must have.
+     */
+    bool OpenFrames(const uint8_t* frames, size_t size, size_t channels, uint32_t sampleRate);
+
+    /**
+     * @brief Decodes the next frames into @p out, as 16-bit stereo. Mono is played on both
+     *        channels. A frame of audio is a sample of every channel, not a QOA frame.
+     * @returns The frames decoded, 0 at the end or on a corrupted frame.
+     */
+    size_t Read(int16_t* out, size_t frames);
+
+    bool Rewind();
+
+    [[nodiscard]] size_t   GetChannels() const { return m_channels; }
+    [[nodiscard]] uint32_t GetSampleRate() const { return m_sampleRate; }
+    //! Of the file, 0 if opened with OpenFrames().
+    [[nodiscard]] size_t   GetFrameCount() const { return m_frameCount; }
+
+private:
+    struct Channel
+    {
+        int32_t        history[LMS_LEN] = {};
+        int32_t        weights[LMS_LEN] = {};
+        uint64_t       slice            = 0;    //!< Residuals left, from the top bit.
+        const int32_t* dequant          = nullptr;    //!< Of the slice's scale factor.
+    };
+
+    const uint8_t* m_frames     = nullptr;
+    size_t         m_size       = 0;
+    size_t         m_channels   = 0;
+    uint32_t       m_sampleRate = 0;
+    size_t         m_frameCount = 0;
+
+    const uint8_t* m_slices       = nullptr;    //!< Of the frame being decoded.
+    size_t         m_frameSamples = 0;
+    size_t         m_sample       = 0;    //!< In the frame, per channel.
+    size_t         m_offset       = 0;    //!< Of the next frame in m_frames.
+    Channel        m_state[MAX_CHANNELS];
+
+private:
+    bool NextFrame();
+    void LoadSlices();
+};
+}    // namespace Qoa
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_QOA_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
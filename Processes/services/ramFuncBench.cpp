@@ -0,0 +1,138 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    ramFuncBench.cpp
+ * @brief   Source for the RamFuncBench.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "ramFuncBench.h"
+
+#include "Core/Inc/main.h"
+
+#include "Processes/services/log.h"
+#include "Processes/services/profiler.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t  TAPS = 8;
+constexpr int16_t GAIN = 0x5A82;    //!< -3 dB in Q15.
+
+using Kernel = void (*)(int16_t* out, const int16_t* in);
+
+// In SRAM for both variants, only where the instructions come from differs.
+int16_t s_in[RamFuncBench::SAMPLES + TAPS];
+int16_t s_out[RamFuncBench::SAMPLES];
+int16_t s_taps[TAPS] = {-1205, 2410, 6836, 8960, 8960, 6836, 2410, -1205};
+
+[[gnu::always_inline]] inline void MixBody(int16_t* out, const int16_t* in)
+{
+    for (size_t i = 0; i < RamFuncBench::SAMPLES; i++)
+    {
+        int32_t mixed = ((in[i] * GAIN) >> 15) + out[i];
+        out[i]        = static_cast<int16_t>(__SSAT(mixed, 16));
+    }
+}
+
+[[gnu::always_inline]] inline void FirBody(int16_t* out, const int16_t* in)
+{
+    for (size_t i = 0; i < RamFuncBench::SAMPLES; i++)
+    {
+        int32_t acc = 0;
+        for (size_t tap = 0; tap < TAPS; tap++)
+        {
+            acc += in[i + tap] * s_taps[tap];
+        }
+        out[i] = static_cast<int16_t>(__SSAT(acc >> 15, 16));
+    }
+}
+
+[[gnu::noinline]] void MixFlash(int16_t* out, const int16_t* in)
+{
+    MixBody(out, in);
+}
+
+RAMFUNC void MixRam(int16_t* out, const int16_t* in)
+{
+    MixBody(out, in);
+}
+
+[[gnu::noinline]] void FirFlash(int16_t* out, const int16_t* in)
+{
+    FirBody(out, in);
+}
+
+RAMFUNC void FirRam(int16_t* out, const int16_t* in)
+{
+    FirBody(out, in);
+}
+
+struct Case
+{
+    const char* name;
+    Kernel      flash;
+    Kernel      ram;
+};
+
+constexpr Case s_cases[] = {
+  {"mix", &MixFlash, &MixRam},
+  {"fir", &FirFlash, &FirRam},
+};
+
+/**
+ * @returns The cycles of the fastest of RUNS runs, the others were interrupted or cold.
+ */
+uint32_t Time(Kernel kernel)
+{
+    // Called through a volatile, so that neither variant is inlined nor specialized.
+    volatile Kernel call = kernel;
+    uint32_t        best = UINT32_MAX;
+    for (size_t run = 0; run < RamFuncBench::RUNS; run++)
+    {
+        Profiler::Ticks start = Profiler::Now();
+        call(s_out, s_in);
+        best = std::min<uint32_t>(best, Profiler::Now() - start);
+    }
+    return best;
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace RamFuncBench
+{
+void Run()
+{
+    for (size_t i = 0; i < SAMPLES + TAPS; i++)
+    {
+        s_in[i] = static_cast<int16_t>(i * 997);
+    }
+
+    LOG_INFO("----- RAMFUNC: {} samples, best of {} runs.", SAMPLES, RUNS);
+    for (const Case& kase : s_cases)
+    {
+        uint32_t flash = Time(kase.flash);
+        uint32_t ram   = Time(kase.ram);
+        // Negative when SRAM is slower, the flash being fast enough for a tight loop.
+        int32_t gain = static_cast<int32_t>(100 - static_cast<int64_t>(100) * ram / flash);
+        LOG_INFO("{:<4} flash: {} cycles, SRAM: {} cycles, {}% faster.",
+                 kase.name,
+                 flash,
+                 ram,
+                 gain);
+    }
+}
+}    // namespace RamFuncBench
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,44 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    ramFuncBench.h
+ * @brief   Cycles of the same kernels run from the flash and from SRAM (RAMFUNC, see main.h).
+ *
+ * Two kernels, each compiled twice from the same body, timed with the DWT cycle counter:
+ *  - mix: 256 Q15 samples scaled and added to another buffer, with saturation.
+ *  - fir: 8-tap Q15 FIR over 256 samples.
+ * The best of RUNS runs of each variant is logged, with the gain of SRAM over the flash. Deferred
+ * until the application is live (see DeferredInit), it isn't part of the POST.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_RAMFUNCBENCH_H
+#    define NILAIINI_SERVICES_RAMFUNCBENCH_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported functions */
+namespace RamFuncBench
+{
+static constexpr size_t SAMPLES = 256;
+static constexpr size_t RUNS    = 16;
+
+/**
+ * @brief Times the kernels and logs their results.
+ */
+void Run();
+}    // namespace RamFuncBench
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_RAMFUNCBENCH_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    resampler.cpp
+ * @brief   Source for the Resampler.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "resampler.h"
+
+#include "Processes/services/profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t FRACTION_BITS = 15;    //!< Of the position, in the polynomial.
+
+/**
+ * @brief The Catmull-Rom spline through @p in[0] to @p in[3 * CHANNELS], of one channel, at
+ *        @p t (Q15) between @p in[CHANNELS] and @p in[2 * CHANNELS].
+ */
+inline int16_t Interpolate(const int16_t* in, int32_t t)
+{
+    constexpr size_t CH = Resampler::CHANNELS;
+    int32_t          ym1 = in[0];
+    int32_t          y0  = in[CH];
+    int32_t          y1  = in[2 * CH];
+    int32_t          y2  = in[3 * CH];
+
+    // Twice the coefficients, to stay in integers.
+    int32_t c1 = y1 - ym1;
+    int32_t c2 = 2 * ym1 - 5 * y0 + 4 * y1 - y2;
+    int32_t c3 = (y2 - ym1) + 3 * (y0 - y1);
+
+    // Up to 20 bits times 15: the products need 64 bits, one SMULL each.
+    int32_t sum = static_cast<int32_t>((int64_t(c3) * t) >> FRACTION_BITS) + c2;
+    sum         = static_cast<int32_t>((int64_t(sum) * t) >> FRACTION_BITS) + c1;
+    sum         = static_cast<int32_t>((int64_t(sum) * t) >> FRACTION_BITS);
+    int32_t out = y0 + ((sum + 1) >> 1);
+    return static_cast<int16_t>(std::clamp<int32_t>(out, INT16_MIN, INT16_MAX));
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+void Resampler::Reset()
+{
+    // A frame of silence before the first, for it to have one on each side.
+    std::fill(std::begin(m_buffer), std::end(m_buffer), int16_t(0));
+    m_fill     = 1;
+    m_position = 0;
+    m_dropped  = 0;
+}
+
+void Resampler::SetStep(uint64_t step)
+{
+    m_step = std::clamp<uint64_t>(step, ONE / 2, 2 * ONE);
+}
+
+int16_t* Resampler::GetInput(size_t& frames)
+{
+    // Drops what's before the first tap of the next output frame.
+    size_t first = std::min(static_cast<size_t>(m_position >> 32), m_fill);
+    if (first != 0)
+    {
+        std::memmove(m_buffer, &m_buffer[first * CHANNELS], (m_fill - first) * CHANNELS * 2);
+        m_fill -= first;
+        m_position -= uint64_t(first) << 32;
+        m_dropped += first;
+    }
+    frames = BUFFER_FRAMES - m_fill;
+    return &m_buffer[m_fill * CHANNELS];
+}
+
+void Resampler::Commit(size_t frames)
+{
+    m_fill = std::min(m_fill + frames, BUFFER_FRAMES);
+}
+
+size_t Resampler::Read(int16_t* out, size_t frames)
+{
+    PROFILE_ZONE("resample");
+    size_t done = 0;
+    for (; done < frames; done++)
+    {
+        size_t first = static_cast<size_t>(m_position >> 32);
+        if (first + TAPS > m_fill)
+        {
+            break;
+        }
+        const int16_t* in = &m_buffer[first * CHANNELS];
+        auto t = static_cast<int32_t>(static_cast<uint32_t>(m_position) >> (32 - FRACTION_BITS));
+        out[done * CHANNELS]     = Interpolate(in, t);
+        out[done * CHANNELS + 1] = Interpolate(in + 1, t);
+        m_position += m_step;
+    }
+    return done;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    resampler.h
+ * @brief   Fractional resampler of 16-bit stereo, for ratios close to 1.
+ *
+ * Each output frame is interpolated between the input frames around its position, with the
+ * 4-point cubic Hermite (Catmull-Rom) polynomial. The position moves by the step, input frames
+ * per output frame in Q32, which can change at any time: set to 1 + 186 ppm, the resampler
+ * makes up for a DAC that runs 186 ppm slow. That's 3 SMULL and a dozen additions per sample,
+ * about 40 cycles per stereo frame on the Cortex-M4: around 1% of the CPU at 48 kHz. The
+ * "resample" zone of the profiler measures it, bench/driftBench.cpp on the host.
+ *
+ * The resampler has its own input buffer, which the caller fills:
+ *      size_t   space = 0;
+ *      int16_t* in    = resampler.GetInput(space);
+ *      resampler.Commit(source.Read(in, space));
+ *      size_t   done  = resampler.Read(out, frames);    // Less than frames: it needs input.
+ * The two frames of input that follow an output frame are needed to compute it: those at the
+ * end of a sound are never played.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_RESAMPLER_H
+#    define NILAIINI_SERVICES_RESAMPLER_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+class Resampler
+{
+public:
+    static constexpr size_t   CHANNELS      = 2;
+    static constexpr size_t   TAPS          = 4;
+    static constexpr size_t   BUFFER_FRAMES = 128;    //!< Of input, history included.
+    static constexpr uint64_t ONE           = uint64_t(1) << 32;    //!< Step of 1, in Q32.
+
+    /**
+     * @brief Empties the buffer and starts over, the step is kept.
+     */
+    void Reset();
+
+    /**
+     * @param step Input frames per output frame, in Q32. 0.5 to 2.
+     */
+    void SetStep(uint64_t step);
+
+    /**
+     * @returns Where to write the next input frames, and how many fit in @p frames.
+     */
+    int16_t* GetInput(size_t& frames);
+
+    /**
+     * @brief Adds the @p frames written where GetInput() told.
+     */
+    void Commit(size_t frames);
+
+    /**
+     * @brief Interpolates up to @p frames output frames into @p out.
+     * @returns The frames written, less than @p frames when the input is used up.
+     */
+    size_t Read(int16_t* out, size_t frames);
+
+    [[nodiscard]] uint64_t GetStep() const { return m_step; }
+
+    /**
+     * @returns In Q32, the input frames consumed since Reset(), up to the next output frame.
+     *          Wraps around after 2^32 frames, differences of positions stay right.
+     */
+    [[nodiscard]] uint64_t GetPosition() const { return (m_dropped << 32) + m_position; }
+
+private:
+    int16_t  m_buffer[BUFFER_FRAMES * CHANNELS] = {};
+    size_t   m_fill     = 1;    //!< Frames in m_buffer, see Reset().
+    uint64_t m_position = 0;    //!< Of the next output frame in m_buffer, Q32.
+    uint64_t m_step     = ONE;
+    uint64_t m_dropped  = 0;    //!< Frames moved out of m_buffer.
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_RESAMPLER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
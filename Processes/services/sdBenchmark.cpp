@@ -0,0 +1,464 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    sdBenchmark.cpp
+ * @brief   Source for the SdBenchmark.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "sdBenchmark.h"
+
+#include "Core/Inc/main.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+#include "NilaiTFO/services/filesystem.h"
+
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/deferredInit.h"
+#include "Processes/services/format.h"
+#include "Processes/services/log.h"
+#include "Processes/services/umoDispatcher.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t SEQ_WRITE_64  = 2;    //!< Indices in s_tests of the tests that are graded.
+constexpr size_t SEQ_READ_64   = 6;
+constexpr size_t RANDOM_WRITE  = 8;
+constexpr size_t RANDOM_READ   = 9;
+constexpr size_t MAX_LINE_SIZE = 160;
+
+//! The content of the writes doesn't matter, it's taken from the firmware itself.
+const BYTE* const WRITE_SOURCE = reinterpret_cast<const BYTE*>(FLASH_BASE);
+
+uint32_t ToUs(Profiler::Ticks ticks)
+{
+    return static_cast<uint32_t>(Profiler::ToMicroseconds(ticks));
+}
+
+/**
+ * @brief Logs a line of the report and appends it to the report file, if it's open.
+ */
+template<typename S, typename... Args>
+void Emit(FIL* file, const std::string& label, S fmt, const Args&... args)
+{
+    char   line[MAX_LINE_SIZE];
+    size_t len = Fmt::FormatTo(line, sizeof(line), fmt, args...);
+    LOG_INFO("[{}]: {}", label, static_cast<const char*>(line));
+
+    if (file != nullptr)
+    {
+        UINT written = 0;
+        f_write(file, line, len, &written);
+        f_write(file, "\r\n", 2, &written);
+    }
+}
+}    // namespace
+
+const SdBenchmark::Test SdBenchmark::s_tests[SdBenchmark::TEST_COUNT] = {
+  {"seq write", Kind::SequentialWrite, 1, 512},
+  {"seq write", Kind::SequentialWrite, 8, 128},
+  {"seq write", Kind::SequentialWrite, 64, 32},
+  {"seq write", Kind::SequentialWrite, 128, 16},
+  {"seq read", Kind::SequentialRead, 1, 512},
+  {"seq read", Kind::SequentialRead, 8, 128},
+  {"seq read", Kind::SequentialRead, 64, 32},
+  {"seq read", Kind::SequentialRead, 128, 16},
+  {"rand write", Kind::RandomWrite, 8, 256},
+  {"rand read", Kind::RandomRead, 8, 256},
+};
+
+static_assert(SdBenchmark::AREA_SECTORS % 128 == 0, "The transfers must fit the area evenly");
+static_assert(128 * SdBenchmark::SECTOR_SIZE <= FLASH_END - FLASH_BASE + 1,
+              "The writes are sourced from the flash");
+
+SdBenchmark* SdBenchmark::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+SdBenchmark::SdBenchmark(const std::string& label) : m_label(label), m_zone("sdBenchmark")
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of SdBenchmark!");
+    s_instance = this;
+}
+
+bool SdBenchmark::DoPost()
+{
+#if APP_SD_BENCHMARK_ON_POST
+    if (!cep::Filesystem::IsMounted())
+    {
+        // The SD card is optional, the filesystem's POST already reports when it's missing.
+        return true;
+    }
+#    if APP_FAST_BOOT
+    // Runs in the background once the application is live, a slow card is only logged.
+    DeferredInit::Defer("sdBenchmark", [] { s_instance->Start(); });
+    return true;
+#    else
+    Start();
+    while (m_state == State::Running)
+    {
+        Step();
+    }
+    return m_state == State::Passed;
+#    endif
+#else
+    return true;
+#endif
+}
+
+void SdBenchmark::Run()
+{
+    if (m_state == State::Running)
+    {
+        Step();
+    }
+}
+
+bool SdBenchmark::Start()
+{
+    if (m_state == State::Running)
+    {
+        return false;
+    }
+    m_prepared = false;
+    m_state    = State::Running;
+    return true;
+}
+
+void SdBenchmark::OnFrame(uint8_t id, const uint8_t* /*body*/, size_t /*len*/)
+{
+    SdBenchmark* self = s_instance;
+    if (self == nullptr)
+    {
+        UmoDispatcher::ReplyError(id, UmoDispatcher::ErrorCode::NotFound);
+        return;
+    }
+
+    if (id == StartBenchmark)
+    {
+        if (!self->Start())
+        {
+            UmoDispatcher::ReplyError(id, UmoDispatcher::ErrorCode::Busy);
+            return;
+        }
+        UmoDispatcher::Reply(id, nullptr, 0);
+        return;
+    }
+
+    uint8_t reply[3 + 5 * sizeof(uint32_t)];
+    reply[0] = static_cast<uint8_t>(self->m_state);
+    reply[1] = self->m_test;
+    reply[2] = TEST_COUNT;
+    ByteOrder::PutLe32(&reply[3], self->m_results[SEQ_WRITE_64].bytesPerSec);
+    ByteOrder::PutLe32(&reply[7], self->m_results[SEQ_READ_64].bytesPerSec);
+    ByteOrder::PutLe32(&reply[11], self->m_results[RANDOM_WRITE].p99Us);
+    ByteOrder::PutLe32(&reply[15], self->m_results[RANDOM_READ].p99Us);
+    ByteOrder::PutLe32(&reply[19], self->m_busy.busyMaxUs);
+    UmoDispatcher::Reply(id, reply, sizeof(reply));
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Makes one transfer, or the setup before the first one.
+ */
+void SdBenchmark::Step()
+{
+    if (!m_prepared)
+    {
+        m_prepared = true;
+        if (!Prepare())
+        {
+            Finish(false);
+        }
+        return;
+    }
+
+    if (!Transfer())
+    {
+        Finish(false);
+        return;
+    }
+
+    const Test& test = s_tests[m_test];
+    if (++m_transfer < test.transfers)
+    {
+        return;
+    }
+
+    Profiler::Stats stats  = m_zone.GetStats();
+    Result&         result = m_results[m_test];
+    result.bytesPerSec     = static_cast<uint32_t>(static_cast<uint64_t>(test.sectors) *
+                                               test.transfers * SECTOR_SIZE *
+                                               Profiler::TicksPerSecond() /
+                                               std::max<uint64_t>(m_testTicks, 1));
+    result.minUs           = ToUs(stats.min);
+    result.avgUs           = ToUs(stats.avg);
+    result.p50Us           = ToUs(stats.p50);
+    result.p99Us           = ToUs(stats.p99);
+    result.maxUs           = ToUs(stats.max);
+
+    m_zone.Reset();
+    m_testTicks = 0;
+    m_transfer  = 0;
+    if (++m_test == TEST_COUNT)
+    {
+        Finish(true);
+    }
+}
+
+/**
+ * @brief Reserves the test area and reads the card's geometry.
+ */
+bool SdBenchmark::Prepare()
+{
+    m_test      = 0;
+    m_transfer  = 0;
+    m_testTicks = 0;
+    m_random    = HAL_GetTick() | 1;
+    m_zone.Reset();
+    for (Result& result : m_results)
+    {
+        result = {};
+    }
+    m_busy = {};
+
+    if (!cep::Filesystem::IsMounted())
+    {
+        LOG_ERROR("[{}]: No SD card.", m_label);
+        return false;
+    }
+
+    DWORD sectors    = 0;
+    DWORD eraseBlock = 0;
+    if (USER_SPI_ioctl(0, GET_SECTOR_COUNT, &sectors) != RES_OK)
+    {
+        LOG_ERROR("[{}]: Unable to read the size of the card.", m_label);
+        return false;
+    }
+    if (USER_SPI_ioctl(0, GET_BLOCK_SIZE, &eraseBlock) != RES_OK)
+    {
+        eraseBlock = 0;    // Unknown, some cards don't report it.
+    }
+    m_cardSectors = sectors;
+    m_eraseBlock  = eraseBlock;
+
+    if (f_open(&m_file, AREA_FILE, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    {
+        LOG_ERROR("[{}]: Unable to create {}.", m_label, AREA_FILE);
+        return false;
+    }
+    m_isOpen = true;
+    if (f_expand(&m_file, static_cast<FSIZE_t>(AREA_SECTORS) * SECTOR_SIZE, 1) != FR_OK ||
+        f_sync(&m_file) != FR_OK)
+    {
+        LOG_ERROR("[{}]: Not enough contiguous room on the card for the test area.", m_label);
+        return false;
+    }
+
+    // The area is contiguous: its sectors follow the first one of its first cluster.
+    const FATFS* fs = m_file.obj.fs;
+    m_firstSector   = fs->database + (m_file.obj.sclust - 2) * fs->csize;
+    if (m_firstSector + AREA_SECTORS > m_cardSectors)
+    {
+        LOG_ERROR("[{}]: The test area is outside of the card.", m_label);
+        return false;
+    }
+
+    USER_Stats stats;
+    USER_GetStats(&stats);
+    m_busy = stats.spi;    // Subtracted in Finish().
+    return true;
+}
+
+bool SdBenchmark::Transfer()
+{
+    const Test& test = s_tests[m_test];
+
+    uint32_t offset = 0;
+    if (test.kind == Kind::SequentialWrite || test.kind == Kind::SequentialRead)
+    {
+        offset = (static_cast<uint32_t>(m_transfer) * test.sectors) % AREA_SECTORS;
+    }
+    else
+    {
+        m_random = m_random * 1664525 + 1013904223;
+        offset   = ((m_random >> 8) % (AREA_SECTORS / test.sectors)) * test.sectors;
+    }
+
+    DRESULT         res;
+    Profiler::Ticks start = Profiler::Now();
+    if (test.kind == Kind::SequentialWrite || test.kind == Kind::RandomWrite)
+    {
+        res = USER_SPI_write(0, WRITE_SOURCE, m_firstSector + offset, test.sectors);
+    }
+    else
+    {
+        res = USER_SPI_read(0, nullptr, m_firstSector + offset, test.sectors);
+    }
+    Profiler::Ticks elapsed = Profiler::Now() - start;
+
+    if (res != RES_OK)
+    {
+        LOG_ERROR("[{}]: {} of {} sectors at {} failed: {}.",
+                  m_label,
+                  test.name,
+                  test.sectors,
+                  m_firstSector + offset,
+                  static_cast<int>(res));
+        return false;
+    }
+    m_zone.Record(elapsed);
+    m_testTicks += elapsed;
+    return true;
+}
+
+void SdBenchmark::Finish(bool ok)
+{
+    if (ok)
+    {
+        USER_Stats stats;
+        USER_GetStats(&stats);
+        const USER_SPI_Counters& after = stats.spi;
+        m_busy.busyWaits    = after.busyWaits - m_busy.busyWaits;
+        m_busy.busyTimeouts = after.busyTimeouts - m_busy.busyTimeouts;
+        m_busy.busyUs       = after.busyUs - m_busy.busyUs;
+        for (size_t i = 0; i < USER_SPI_BUSY_BUCKETS; i++)
+        {
+            m_busy.busyHistogram[i] = after.busyHistogram[i] - m_busy.busyHistogram[i];
+        }
+        // The driver's maximum may predate the benchmark, the histogram bounds it.
+        m_busy.busyMaxUs = std::min(BusyPercentile(1000), after.busyMaxUs);
+
+        bool passed = Passes();
+        Report(passed);
+        m_state = passed ? State::Passed : State::Failed;
+    }
+    else
+    {
+        m_state = State::Error;
+    }
+    Cleanup();
+}
+
+void SdBenchmark::Report(bool passed)
+{
+    FIL  report;
+    bool haveReport = f_open(&report, REPORT_FILE, FA_CREATE_ALWAYS | FA_WRITE) == FR_OK;
+    FIL* file       = haveReport ? &report : nullptr;
+
+    Emit(file,
+         m_label,
+         FMT_STRING("Card: {} sectors ({} MiB), erase block of {} sectors, test area at {}."),
+         m_cardSectors,
+         m_cardSectors / (1024 * 1024 / SECTOR_SIZE),
+         m_eraseBlock,
+         m_firstSector);
+    Emit(file,
+         m_label,
+         FMT_STRING("{:<10} {:>7} {:>9} {:>8} {:>8} {:>8} {:>8} {:>8}"),
+         "test",
+         "sectors",
+         "B/s",
+         "min us",
+         "avg us",
+         "p50 us",
+         "p99 us",
+         "max us");
+    for (size_t i = 0; i < TEST_COUNT; i++)
+    {
+        const Result& result = m_results[i];
+        Emit(file,
+             m_label,
+             FMT_STRING("{:<10} {:>7} {:>9} {:>8} {:>8} {:>8} {:>8} {:>8}"),
+             s_tests[i].name,
+             s_tests[i].sectors,
+             result.bytesPerSec,
+             result.minUs,
+             result.avgUs,
+             result.p50Us,
+             result.p99Us,
+             result.maxUs);
+    }
+
+    Emit(file,
+         m_label,
+         FMT_STRING("Busy: {} waits, {} timeouts, {} ms, p50 {} us, p99 {} us, max {} us."),
+         m_busy.busyWaits,
+         m_busy.busyTimeouts,
+         static_cast<uint32_t>(m_busy.busyUs / 1000),
+         BusyPercentile(500),
+         BusyPercentile(990),
+         m_busy.busyMaxUs);
+    for (size_t i = 0; i < USER_SPI_BUSY_BUCKETS; i++)
+    {
+        if (m_busy.busyHistogram[i] != 0)
+        {
+            Emit(file,
+                 m_label,
+                 FMT_STRING("  busy < {:>7} us: {}"),
+                 static_cast<uint32_t>(1) << i,
+                 m_busy.busyHistogram[i]);
+        }
+    }
+
+    Emit(file, m_label, FMT_STRING("Card {}."), passed ? "PASSED" : "FAILED");
+    if (haveReport)
+    {
+        f_close(&report);
+    }
+}
+
+bool SdBenchmark::Passes() const
+{
+    return m_results[SEQ_WRITE_64].bytesPerSec >= MIN_WRITE_RATE &&
+           m_results[SEQ_READ_64].bytesPerSec >= MIN_READ_RATE &&
+           m_results[RANDOM_WRITE].p99Us <= MAX_RANDOM_WRITE_P99 &&
+           m_busy.busyMaxUs <= MAX_BUSY && m_busy.busyTimeouts == 0;
+}
+
+/**
+ * @brief Closes and deletes the test area.
+ */
+void SdBenchmark::Cleanup()
+{
+    if (m_isOpen)
+    {
+        f_close(&m_file);
+        f_unlink(AREA_FILE);
+        m_isOpen = false;
+    }
+}
+
+/**
+ * @brief Upper bound of the bucket of the busy waits' histogram holding a percentile.
+ */
+uint32_t SdBenchmark::BusyPercentile(uint32_t perThousand) const
+{
+    uint32_t target = static_cast<uint32_t>(
+      (static_cast<uint64_t>(m_busy.busyWaits) * perThousand + 999) / 1000);
+    uint32_t seen   = 0;
+    for (size_t i = 0; i < USER_SPI_BUSY_BUCKETS; i++)
+    {
+        seen += m_busy.busyHistogram[i];
+        if (seen >= target && seen != 0)
+        {
+            return i == 0 ? 0 : (static_cast<uint32_t>(1) << i) - 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
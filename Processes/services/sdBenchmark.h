@@ -0,0 +1,176 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    sdBenchmark.h
+ * @brief   Characterizes the SD card: sequential and random throughput, latency and busy time.
+ *
+ * The transfers go straight to the driver (USER_SPI_read/USER_SPI_write), bypassing FatFs, but
+ * only ever touch the sectors of a contiguous file reserved for the benchmark with f_expand and
+ * deleted afterwards: the filesystem is never at risk.
+ *
+ * Measured:
+ *  - Sequential writes, then reads, of 1, 8, 64 and 128 sectors per transfer.
+ *  - Random 4 KiB writes and reads, aligned, spread over the whole test area.
+ *  - The distribution of the time spent waiting for the card to be ready (wait_ready), the
+ *    programming time of the card, taken from the driver's counters.
+ *
+ * A full-size transfer needs 64 KiB of memory, more than can be spared: writes are sourced from
+ * the flash (the content doesn't matter) and reads are clocked out of the card and discarded.
+ *
+ * The results go to the log and to REPORT_FILE. The card passes when it meets the MIN_* / MAX_*
+ * thresholds, which can be made part of the POST with APP_SD_BENCHMARK_ON_POST, to reject slow
+ * cards at install time (with APP_FAST_BOOT, it only starts once the application is live, and a
+ * slow card is only logged). Otherwise, it runs on demand, see tools/umo.py sdbench:
+ *  - START_BENCHMARK (0x28): starts the benchmark, answered right away.
+ *  - GET_STATUS      (0x29): answers with state (u8, see State) | test (u8) | test count (u8) |
+ *                            sequential write (B/s) | sequential read (B/s) | random write
+ *                            p99 (us) | random read p99 (us) | longest busy wait (us), all u32,
+ *                            from the 64-sector and 4 KiB tests.
+ *
+ * On demand, one transfer is made per Run(), the other modules keep running in between.
+ *
+ * @note Must run in the same group as the other users of the card when APP_USE_RTOS is set, the
+ *       transfers bypass FatFs' lock.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_SDBENCHMARK_H
+#    define NILAIINI_SERVICES_SDBENCHMARK_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include "FATFS/App/fatfs.h"
+#    include "FATFS/Target/user_diskio.h"
+
+#    include "Processes/services/profiler.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class SdBenchmark : public cep::Module
+{
+public:
+    static constexpr const char* AREA_FILE    = "SDBENCH.BIN";
+    static constexpr const char* REPORT_FILE  = "SDBENCH.TXT";
+    static constexpr uint32_t    SECTOR_SIZE  = _MAX_SS;
+    static constexpr uint32_t    AREA_SECTORS = 8192;    //!< 4 MiB.
+
+    // Pass/fail thresholds.
+    static constexpr uint32_t MIN_WRITE_RATE       = 250000;    //!< B/s, 64-sector writes.
+    static constexpr uint32_t MIN_READ_RATE        = 400000;    //!< B/s, 64-sector reads.
+    static constexpr uint32_t MAX_RANDOM_WRITE_P99 = 50000;     //!< us, 4 KiB writes.
+    static constexpr uint32_t MAX_BUSY             = 250000;    //!< us, the SD spec's timeout.
+
+    enum FrameId : uint8_t
+    {
+        StartBenchmark = 0x28,
+        GetStatus      = 0x29,
+    };
+
+    enum class State : uint8_t
+    {
+        Idle    = 0,    //!< Never ran.
+        Running = 1,
+        Passed  = 2,
+        Failed  = 3,    //!< Ran, but the card is below the thresholds.
+        Error   = 4,    //!< No card, not enough room, or a transfer failed.
+    };
+
+    SdBenchmark(const std::string& label);
+    ~SdBenchmark() override = default;
+
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    /**
+     * @brief Starts the benchmark, ran from Run().
+     * @returns False if it was already running.
+     */
+    bool Start();
+
+    [[nodiscard]] State GetState() const { return m_state; }
+
+    /**
+     * @brief Handles the frames of the protocol. Matches UmoDispatcher::Handler.
+     */
+    static void OnFrame(uint8_t id, const uint8_t* body, size_t len);
+
+    static SdBenchmark* Get() { return s_instance; }
+
+private:
+    enum class Kind : uint8_t
+    {
+        SequentialWrite,
+        SequentialRead,
+        RandomWrite,
+        RandomRead,
+    };
+
+    struct Test
+    {
+        const char* name;
+        Kind        kind;
+        uint16_t    sectors;    //!< Per transfer.
+        uint16_t    transfers;
+    };
+
+    struct Result
+    {
+        uint32_t bytesPerSec = 0;
+        uint32_t minUs       = 0;
+        uint32_t avgUs       = 0;
+        uint32_t p50Us       = 0;
+        uint32_t p99Us       = 0;
+        uint32_t maxUs       = 0;
+    };
+
+    static constexpr size_t TEST_COUNT = 10;
+    static const Test       s_tests[TEST_COUNT];
+
+    std::string m_label;
+
+    volatile State    m_state               = State::Idle;
+    bool              m_prepared            = false;
+    uint8_t           m_test                = 0;
+    uint16_t          m_transfer            = 0;
+    uint32_t          m_random              = 1;
+    uint64_t          m_testTicks           = 0;    //!< Spent in the transfers of the test.
+    FIL               m_file                = {};
+    bool              m_isOpen              = false;
+    uint32_t          m_firstSector         = 0;
+    uint32_t          m_cardSectors         = 0;
+    uint32_t          m_eraseBlock          = 0;    //!< In sectors.
+    Profiler::Zone    m_zone;                       //!< Transfers of the current test.
+    Result            m_results[TEST_COUNT] = {};
+    USER_SPI_Counters m_busy                = {};    //!< Busy waits during the benchmark.
+
+private:
+    static SdBenchmark* s_instance;
+
+private:
+    void Step();
+    bool Prepare();
+    bool Transfer();
+    void Finish(bool ok);
+    void Report(bool passed);
+    bool Passes() const;
+    void Cleanup();
+
+    uint32_t BusyPercentile(uint32_t perThousand) const;
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_SDBENCHMARK_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,188 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    settings.cpp
+ * @brief   Source for the Settings.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "settings.h"
+
+#include "Processes/drivers/internalFlash.h"
+#include "Processes/services/log.h"
+
+#include "NilaiTFO/services/IniParser.h"
+
+#include <cctype>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr char SEPARATOR = '=';
+
+KvStore*            s_store      = nullptr;    //!< Null until mounted.
+InternalFlash*      s_flash      = nullptr;
+Settings::BusyCheck s_isBusy     = nullptr;
+uint32_t            s_busyErases = 0;    //!< Done while s_isBusy() said so.
+
+bool IsBusy()
+{
+    return s_isBusy != nullptr && s_isBusy();
+}
+
+void AppendLower(std::string& out, std::string_view text)
+{
+    for (char c : text)
+    {
+        out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Settings
+{
+bool Init()
+{
+    static InternalFlash s_internalFlash(FLASH_SECTOR_8, SECTORS);
+    static KvStore       s_kvStore(s_internalFlash);
+
+    s_flash = &s_internalFlash;
+    s_store = s_kvStore.Mount() ? &s_kvStore : nullptr;
+    if (s_store == nullptr)
+    {
+        LOG_ERROR("Unable to mount the settings!");
+        return false;
+    }
+    // At boot, before anything plays from the flash.
+    if (!s_store->PrepareNext())
+    {
+        LOG_WARNING("Unable to erase the next sector of the settings.");
+    }
+    LogStats();
+    return true;
+}
+
+void SetBusyCheck(BusyCheck isBusy)
+{
+    s_isBusy = isBusy;
+}
+
+KvStore* Get()
+{
+    return s_store;
+}
+
+std::string MakeKey(std::string_view section, std::string_view name)
+{
+    std::string key;
+    key.reserve(section.size() + 1 + name.size());
+    AppendLower(key, section);
+    key += SEPARATOR;
+    AppendLower(key, name);
+    return key;
+}
+
+Values Snapshot(cep::IniParser& ini)
+{
+    Values values;
+    for (auto& [key, value] : ini)
+    {
+        values.emplace(key, value);
+    }
+    return values;
+}
+
+size_t Import(cep::IniParser& ini)
+{
+    size_t count = 0;
+    if (s_store == nullptr)
+    {
+        return count;
+    }
+    s_store->ForEach(
+      [&](std::string_view key, std::string_view value)
+      {
+          size_t separator = key.find(SEPARATOR);
+          if (separator == std::string_view::npos)
+          {
+              return;
+          }
+          ini.SetStr(std::string(key.substr(0, separator)),
+                     std::string(key.substr(separator + 1)),
+                     std::string(value));
+          count++;
+      });
+    return count;
+}
+
+bool Export(cep::IniParser& ini, const Values& file)
+{
+    if (s_store == nullptr)
+    {
+        return false;
+    }
+    // IniParser keeps its values by MakeKey(section, name), as inih's INIReader does.
+    bool     stored = true;
+    bool     busy   = IsBusy();
+    uint32_t erases = s_flash->GetErases();
+    for (auto& [key, value] : ini)
+    {
+        auto             it = file.find(key);
+        std::string_view previous;
+        if (it != file.end() && it->second == value)
+        {
+            // Back to the file's value, the file gives it again.
+            if (s_store->Get(key, previous) && !s_store->Erase(key))
+            {
+                LOG_WARNING("Unable to erase the setting '{}'.", key.c_str());
+                stored = false;
+            }
+        }
+        else if (!s_store->Set(key, value))
+        {
+            LOG_WARNING("Unable to store the setting '{}'.", key.c_str());
+            stored = false;
+        }
+    }
+
+    if (busy && s_flash->GetErases() != erases)
+    {
+        erases = s_flash->GetErases() - erases;
+        s_busyErases += erases;
+        LOG_WARNING("The settings erased the flash {} times while busy.", erases);
+    }
+    else if (!busy && !s_store->PrepareNext())
+    {
+        LOG_WARNING("Unable to erase the next sector of the settings.");
+    }
+    return stored;
+}
+
+void LogStats()
+{
+    if (s_store == nullptr)
+    {
+        return;
+    }
+    KvStore::Stats stats = s_store->GetStats();
+    LOG_INFO("Settings: {} keys, {} B of {} B, sectors erased {} to {} times, {} while busy.",
+             stats.keys,
+             stats.liveBytes,
+             stats.capacity,
+             stats.minErases,
+             stats.maxErases,
+             s_busyErases);
+}
+}    // namespace Settings
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    settings.h
+ * @brief   The settings, kept in a KvStore over sectors 8 to 11 of the flash (0x08080000).
+ *
+ * Changing a setting appends a record to the flash instead of writing cfg.ini back to the SD
+ * card. cfg.ini still gives the defaults: Import() lays the stored values over those read from
+ * the file, Export() stores only those that were changed since, against a Snapshot() of the file.
+ * A value set back to the file's erases its record: editing cfg.ini changes every setting that
+ * wasn't changed at runtime. The keys are IniParser's, "section=name", and the values its strings.
+ *
+ * Erasing a sector stalls the first bank for 1 to 2 s, the code's: nothing runs, the interrupts
+ * that would refill the audio or the UART's DMA included. The asset bundle, in the second bank,
+ * stays readable. The sector the store moves on to next is erased ahead of time, by
+ * Init() and by the Export() done while nothing is busy. An export then only erases if it fills
+ * a whole sector; if that happens while busy, it's logged and counted in LogStats().
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_SETTINGS_H
+#    define NILAIINI_SERVICES_SETTINGS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Processes/services/kvStore.h"
+
+#    include <cstddef>
+#    include <string>
+#    include <string_view>
+#    include <unordered_map>
+
+namespace cep
+{
+class IniParser;
+}
+
+/*****************************************************************************/
+/* Exported functions */
+namespace Settings
+{
+static constexpr size_t SECTORS = 4;    //!< Reserved in DATA_FLASH by the linker script.
+
+//! The values of an IniParser, by key.
+using Values = std::unordered_map<std::string, std::string>;
+//! True while stalling the flash would be noticed.
+using BusyCheck = bool (*)();
+
+/**
+ * @brief Mounts the store, formatting the sectors the first time, and erases the next sector.
+ */
+bool Init();
+
+/**
+ * @brief Sets what tells Export() not to erase the flash, nothing by default.
+ */
+void SetBusyCheck(BusyCheck isBusy);
+
+/**
+ * @returns The store, null if it couldn't be mounted.
+ */
+KvStore* Get();
+
+/**
+ * @returns The key of @p name in @p section, lowercased like IniParser's.
+ */
+std::string MakeKey(std::string_view section, std::string_view name);
+
+/**
+ * @returns The values of @p ini, taken right after parsing it, before Import().
+ */
+Values Snapshot(cep::IniParser& ini);
+
+/**
+ * @brief Sets every stored value in @p ini, replacing what the file had.
+ * @returns The values set.
+ */
+size_t Import(cep::IniParser& ini);
+
+/**
+ * @brief Stores the values of @p ini that differ from @p file, and erases those that are back to
+ *        the file's. Only what changed is written to the flash.
+ * @param file Snapshot() of the file @p ini was parsed from.
+ * @returns False if one couldn't be stored.
+ */
+bool Export(cep::IniParser& ini, const Values& file);
+
+void LogStats();
+}    // namespace Settings
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_SETTINGS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,456 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    tlsf.cpp
+ * @brief   Source for the Tlsf allocator.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "tlsf.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+/**
+ * @brief Index of the highest bit set, @p value isn't 0.
+ */
+size_t Fls(size_t value)
+{
+    return sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(value);
+}
+
+/**
+ * @brief Index of the lowest bit set, @p value isn't 0.
+ */
+size_t Ffs(uint32_t value)
+{
+    return __builtin_ctz(value);
+}
+
+uintptr_t AlignUp(uintptr_t value, size_t align)
+{
+    return (value + align - 1) & ~(uintptr_t(align) - 1);
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+bool Tlsf::Init(void* memory, size_t size)
+{
+    *this = Tlsf();
+
+    auto      begin = reinterpret_cast<uintptr_t>(memory);
+    uintptr_t start = AlignUp(begin, ALIGN);
+    uintptr_t end   = (begin + size) & ~(uintptr_t(ALIGN) - 1);
+    if (end < start + 2 * HEADER + MIN_PAYLOAD)
+    {
+        return false;
+    }
+
+    auto* first     = reinterpret_cast<Block*>(start);
+    first->prevPhys = nullptr;
+    first->size     = std::min<size_t>(end - start - 2 * HEADER, MAX_PAYLOAD) | FREE;
+
+    Block* last    = Next(first);
+    last->prevPhys = first;
+    last->size     = 0;    // Used and empty, nothing ever merges with it.
+
+    m_first = first;
+    Insert(first);
+    return true;
+}
+
+void* Tlsf::Allocate(size_t size)
+{
+    size_t adjusted = Adjust(size);
+    if (adjusted == 0 || m_first == nullptr)
+    {
+        return nullptr;
+    }
+    Block* block = FindFree(adjusted);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    block->size &= ~FREE;
+    Split(block, adjusted);
+    return Payload(block);
+}
+
+void* Tlsf::AllocateAligned(size_t alignment, size_t size)
+{
+    if (alignment <= ALIGN)
+    {
+        return Allocate(size);
+    }
+    size_t adjusted = Adjust(size);
+    if (adjusted == 0 || alignment > MAX_PAYLOAD || m_first == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Big enough for the payload wherever the alignment falls, after a free block in front.
+    Block* block = FindFree(adjusted + alignment + HEADER + MIN_PAYLOAD);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto      payload = reinterpret_cast<uintptr_t>(Payload(block));
+    uintptr_t aligned = AlignUp(payload, alignment);
+    if (aligned != payload && aligned - payload < HEADER + MIN_PAYLOAD)
+    {
+        aligned = AlignUp(payload + HEADER + MIN_PAYLOAD, alignment);
+    }
+    if (aligned != payload)
+    {
+        // The gap goes back to the lists. The block before it can't be free, it's not merged.
+        Block* front    = block;
+        block           = reinterpret_cast<Block*>(aligned - HEADER);
+        block->prevPhys = front;
+        block->size     = SizeOf(front) - (aligned - payload);
+        front->size     = (aligned - HEADER - payload) | FREE;
+        Next(block)->prevPhys = block;
+        Insert(front);
+    }
+
+    block->size &= ~FREE;
+    Split(block, adjusted);
+    return Payload(block);
+}
+
+void* Tlsf::Reallocate(void* ptr, size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return Allocate(size);
+    }
+    if (size == 0)
+    {
+        Free(ptr);
+        return nullptr;
+    }
+    size_t adjusted = Adjust(size);
+    if (adjusted == 0)
+    {
+        return nullptr;
+    }
+
+    Block* block   = FromPayload(ptr);
+    size_t current = SizeOf(block);
+    if (adjusted > current)
+    {
+        Block* next = Next(block);
+        if (IsFree(next) && current + HEADER + SizeOf(next) >= adjusted)
+        {
+            MergeNext(block);
+        }
+        else
+        {
+            void* moved = Allocate(size);
+            if (moved != nullptr)
+            {
+                std::memcpy(moved, ptr, current);
+                Free(ptr);
+            }
+            return moved;
+        }
+    }
+
+    Split(block, adjusted);
+    return ptr;
+}
+
+void Tlsf::Free(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    Block* block = FromPayload(ptr);
+    block->size |= FREE;
+    block = MergePrev(block);
+    MergeNext(block);
+    Insert(block);
+}
+
+size_t Tlsf::UsableSize(const void* ptr)
+{
+    return ptr != nullptr ? SizeOf(FromPayload(ptr)) : 0;
+}
+
+Tlsf::Stats Tlsf::GetStats() const
+{
+    Stats stats;
+    if (m_first == nullptr)
+    {
+        return stats;
+    }
+
+    const Block* block = m_first;
+    for (; SizeOf(block) != 0; block = Next(block))
+    {
+        if (IsFree(block))
+        {
+            stats.free += SizeOf(block);
+            stats.largestFree = std::max(stats.largestFree, SizeOf(block));
+            stats.freeBlocks++;
+        }
+        else
+        {
+            stats.used += SizeOf(block);
+            stats.usedBlocks++;
+        }
+    }
+    stats.size = reinterpret_cast<uintptr_t>(block) - reinterpret_cast<uintptr_t>(m_first) - HEADER;
+    return stats;
+}
+
+bool Tlsf::Check() const
+{
+    if (m_first == nullptr)
+    {
+        return true;
+    }
+
+    // Every block links back to the one before it, no two free blocks are neighbours.
+    size_t       freeBlocks = 0;
+    const Block* prev       = nullptr;
+    const Block* block      = m_first;
+    for (;; block = Next(block))
+    {
+        if (block->prevPhys != prev || (reinterpret_cast<uintptr_t>(block) + HEADER) % ALIGN != 0)
+        {
+            return false;
+        }
+        if (SizeOf(block) == 0)
+        {
+            break;
+        }
+        if (IsFree(block))
+        {
+            if (prev != nullptr && IsFree(prev))
+            {
+                return false;
+            }
+            freeBlocks++;
+        }
+        prev = block;
+    }
+    if (IsFree(block))
+    {
+        return false;
+    }
+
+    // Every listed block is free, in the list of its size, and the bitmaps match the lists.
+    size_t listed = 0;
+    for (size_t fl = 0; fl < FL_COUNT; fl++)
+    {
+        if (((m_flBitmap >> fl) & 1) != (m_slBitmaps[fl] != 0 ? 1u : 0u))
+        {
+            return false;
+        }
+        for (size_t sl = 0; sl < SL_COUNT; sl++)
+        {
+            if (((m_slBitmaps[fl] >> sl) & 1) != (m_lists[fl][sl] != nullptr ? 1u : 0u))
+            {
+                return false;
+            }
+            for (const Block* free = m_lists[fl][sl]; free != nullptr; free = free->nextFree)
+            {
+                size_t freeFl = 0;
+                size_t freeSl = 0;
+                Mapping(SizeOf(free), freeFl, freeSl);
+                if (!IsFree(free) || freeFl != fl || freeSl != sl || ++listed > freeBlocks ||
+                    (free->nextFree != nullptr && free->nextFree->prevFree != free))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return listed == freeBlocks;
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @returns The payload to allocate for @p size bytes, 0 if it's too big.
+ */
+size_t Tlsf::Adjust(size_t size)
+{
+    if (size > MAX_PAYLOAD)
+    {
+        return 0;
+    }
+    return std::max<size_t>(AlignUp(size, ALIGN), MIN_PAYLOAD);
+}
+
+/**
+ * @brief The list of the blocks of @p size bytes: linear below SMALL_BLOCK, then SL_COUNT lists
+ *        per power of two.
+ */
+void Tlsf::Mapping(size_t size, size_t& fl, size_t& sl)
+{
+    if (size < SMALL_BLOCK)
+    {
+        fl = 0;
+        sl = size / (SMALL_BLOCK / SL_COUNT);
+    }
+    else
+    {
+        size_t bit = Fls(size);
+        sl         = (size >> (bit - SL_LOG2)) - SL_COUNT;
+        fl         = bit - FL_SHIFT + 1;
+    }
+}
+
+void Tlsf::Insert(Block* block)
+{
+    size_t fl = 0;
+    size_t sl = 0;
+    Mapping(SizeOf(block), fl, sl);
+
+    Block*& head    = m_lists[fl][sl];
+    block->prevFree = nullptr;
+    block->nextFree = head;
+    if (head != nullptr)
+    {
+        head->prevFree = block;
+    }
+    head = block;
+    m_flBitmap |= 1u << fl;
+    m_slBitmaps[fl] |= 1u << sl;
+}
+
+void Tlsf::Remove(Block* block)
+{
+    if (block->nextFree != nullptr)
+    {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    if (block->prevFree != nullptr)
+    {
+        block->prevFree->nextFree = block->nextFree;
+        return;
+    }
+
+    // The head of its list.
+    size_t fl = 0;
+    size_t sl = 0;
+    Mapping(SizeOf(block), fl, sl);
+    m_lists[fl][sl] = block->nextFree;
+    if (block->nextFree == nullptr)
+    {
+        m_slBitmaps[fl] &= ~(1u << sl);
+        if (m_slBitmaps[fl] == 0)
+        {
+            m_flBitmap &= ~(1u << fl);
+        }
+    }
+}
+
+/**
+ * @brief Takes a block of at least @p size bytes off the lists, null if there is none.
+ */
+Tlsf::Block* Tlsf::FindFree(size_t size)
+{
+    // Rounded up to the next list, so that any block of the list found is big enough.
+    if (size >= SMALL_BLOCK)
+    {
+        size += (size_t(1) << (Fls(size) - SL_LOG2)) - 1;
+    }
+    size_t fl = 0;
+    size_t sl = 0;
+    Mapping(size, fl, sl);
+    if (fl >= FL_COUNT)
+    {
+        return nullptr;
+    }
+
+    uint32_t slMap = m_slBitmaps[fl] & (~0u << sl);
+    if (slMap == 0)
+    {
+        // None at this power of two, the smallest list of the next ones.
+        uint32_t flMap = m_flBitmap & (~0u << (fl + 1));
+        if (flMap == 0)
+        {
+            return nullptr;
+        }
+        fl    = Ffs(flMap);
+        slMap = m_slBitmaps[fl];
+    }
+    sl = Ffs(slMap);
+
+    Block* block = m_lists[fl][sl];
+    Remove(block);
+    return block;
+}
+
+/**
+ * @returns The block @p block is now part of.
+ */
+Tlsf::Block* Tlsf::MergePrev(Block* block)
+{
+    Block* prev = block->prevPhys;
+    if (prev == nullptr || !IsFree(prev))
+    {
+        return block;
+    }
+    Remove(prev);
+    prev->size += HEADER + SizeOf(block);
+    Next(prev)->prevPhys = prev;
+    return prev;
+}
+
+/**
+ * @brief Absorbs the next block if it's free. @p block isn't in a list.
+ */
+void Tlsf::MergeNext(Block* block)
+{
+    Block* next = Next(block);
+    if (!IsFree(next))
+    {
+        return;
+    }
+    Remove(next);
+    block->size += HEADER + SizeOf(next);
+    Next(block)->prevPhys = block;
+}
+
+/**
+ * @brief Gives the end of @p block past @p size bytes back to the lists, if it's big enough to
+ *        be a block.
+ */
+void Tlsf::Split(Block* block, size_t size)
+{
+    size_t current = SizeOf(block);
+    if (current < size + HEADER + MIN_PAYLOAD)
+    {
+        return;
+    }
+
+    auto* rest     = reinterpret_cast<Block*>(static_cast<uint8_t*>(Payload(block)) + size);
+    rest->prevPhys = block;
+    rest->size     = (current - size - HEADER) | FREE;
+    block->size    = size | (block->size & FREE);
+    Next(rest)->prevPhys = rest;
+    MergeNext(rest);
+    Insert(rest);
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,153 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    tlsf.h
+ * @brief   Two-Level Segregated Fit allocator: malloc and free in constant time, over one region.
+ *
+ * The free blocks are sorted in lists by size: a first level per power of two, split into
+ * SL_COUNT second-level lists. A bitmap per level tells which lists hold blocks, finding a block
+ * big enough is two bit scans and freeing one merges it with its free neighbours, neither
+ * depends on how many blocks there are. The block returned is the head of the first list whose
+ * sizes are all big enough (good fit): the waste is bounded to 1/SL_COUNT of the request.
+ *
+ * Every block starts with a header, the address of the previous block and its own size:
+ *      | prev | size | payload ...              | prev | size | payload ...
+ * Free blocks keep the links of their list in their payload. The region ends with an empty
+ * block that is never free, so the last real block always has a neighbour.
+ *
+ * With APP_USE_TLSF, malloc and operator new get their memory from one instance over the RAM
+ * the linker script reserves (see MemStats). The class itself depends on nothing of the target,
+ * bench/tlsfBench.cpp churns it with random requests and checks it on the host.
+ *
+ * @note Not thread-safe, the caller locks.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_TLSF_H
+#    define NILAIINI_SERVICES_TLSF_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+class Tlsf
+{
+public:
+    static constexpr size_t ALIGN    = 8;     //!< Of every payload.
+    static constexpr size_t SL_LOG2  = 4;     //!< log2 of the second-level lists per power of 2.
+    static constexpr size_t FL_MAX   = 20;    //!< log2 of the largest block, 1 MiB.
+    static constexpr size_t SL_COUNT = size_t(1) << SL_LOG2;
+
+    struct Stats
+    {
+        size_t size        = 0;    //!< Of the region, less the headers of its ends.
+        size_t used        = 0;    //!< Payloads of the used blocks.
+        size_t free        = 0;    //!< Payloads of the free blocks.
+        size_t largestFree = 0;    //!< Largest payload that can be allocated.
+        size_t usedBlocks  = 0;
+        size_t freeBlocks  = 0;
+    };
+
+    constexpr Tlsf() = default;
+
+    /**
+     * @brief Takes over @p size bytes at @p memory, up to 1 MiB are used.
+     * @returns False if the region is too small to hold a block.
+     */
+    bool Init(void* memory, size_t size);
+
+    [[nodiscard]] bool IsInitialized() const { return m_first != nullptr; }
+
+    /**
+     * @returns The memory, aligned to ALIGN, or null if no free block is big enough.
+     */
+    void* Allocate(size_t size);
+    /**
+     * @param alignment A power of two.
+     */
+    void* AllocateAligned(size_t alignment, size_t size);
+    /**
+     * @brief Grows or shrinks in place when it can, moves the block otherwise.
+     * @returns Null if it can't, @p ptr is then left as it was.
+     */
+    void* Reallocate(void* ptr, size_t size);
+    void  Free(void* ptr);
+
+    /**
+     * @returns The bytes usable at @p ptr, at least what was asked for.
+     */
+    [[nodiscard]] static size_t UsableSize(const void* ptr);
+
+    /**
+     * @note Walks every block.
+     */
+    [[nodiscard]] Stats GetStats() const;
+
+    /**
+     * @brief Walks the blocks and the lists, checking that they agree with each other.
+     * @returns False if the heap is corrupted.
+     */
+    [[nodiscard]] bool Check() const;
+
+private:
+    static constexpr size_t FL_SHIFT    = SL_LOG2 + 3;    //!< log2 of SL_COUNT * ALIGN.
+    static constexpr size_t FL_COUNT    = FL_MAX - FL_SHIFT + 1;
+    static constexpr size_t SMALL_BLOCK = size_t(1) << FL_SHIFT;    //!< Linear lists below.
+    static constexpr size_t FREE        = 0x1;
+
+    struct Block
+    {
+        Block* prevPhys = nullptr;    //!< Null for the first block.
+        size_t size     = 0;          //!< Of the payload, FREE in the lowest bit.
+        // The payload of a used block starts here.
+        Block* nextFree = nullptr;
+        Block* prevFree = nullptr;
+    };
+
+    Block*   m_first                     = nullptr;
+    uint32_t m_flBitmap                  = 0;
+    uint32_t m_slBitmaps[FL_COUNT]       = {};
+    Block*   m_lists[FL_COUNT][SL_COUNT] = {};
+
+private:
+    static constexpr size_t HEADER      = 2 * sizeof(Block*);    //!< prevPhys and size.
+    static constexpr size_t MIN_PAYLOAD = sizeof(Block) - HEADER;
+    static constexpr size_t MAX_PAYLOAD = (size_t(1) << FL_MAX) - ALIGN;
+
+    static size_t SizeOf(const Block* block) { return block->size & ~FREE; }
+    static bool   IsFree(const Block* block) { return (block->size & FREE) != 0; }
+    static void*  Payload(Block* block) { return reinterpret_cast<uint8_t*>(block) + HEADER; }
+    static Block* FromPayload(const void* ptr)
+    {
+        return reinterpret_cast<Block*>(const_cast<uint8_t*>(static_cast<const uint8_t*>(ptr)) -
+                                        HEADER);
+    }
+    static Block* Next(const Block* block)
+    {
+        return reinterpret_cast<Block*>(reinterpret_cast<uintptr_t>(block) + HEADER +
+                                         SizeOf(block));
+    }
+
+    static size_t Adjust(size_t size);
+    static void   Mapping(size_t size, size_t& fl, size_t& sl);
+
+    void   Insert(Block* block);
+    void   Remove(Block* block);
+    Block* FindFree(size_t size);
+    Block* MergePrev(Block* block);
+    void   MergeNext(Block* block);
+    void   Split(Block* block, size_t size);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_TLSF_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,394 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    umoDispatcher.cpp
+ * @brief   Source for the UmoDispatcher.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "umoDispatcher.h"
+
+#include "Core/Inc/main.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+#include "NilaiTFO/services/IniParser.h"
+#include "NilaiTFO/services/filesystem.h"
+
+#include "Processes/drivers/uartRxDma.h"
+#include "Processes/drivers/uartTxDma.h"
+#include "Processes/services/byteOrder.h"
+#include "Processes/services/diskStats.h"
+#include "Processes/services/memStats.h"
+#include "Processes/services/profiler.h"
+#include "Processes/services/settings.h"
+
+#include <algorithm>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr const char* CONFIG_FILE = "cfg.ini";
+
+constexpr uint8_t DISK_STATS_LOG   = 0x01;    //!< Also log the stats.
+constexpr uint8_t DISK_STATS_RESET = 0x02;    //!< Clear the stats once read.
+
+constexpr uint8_t MEMORY_LOG      = 0x01;    //!< Also log the usage.
+constexpr size_t  MEMORY_NAME_LEN = 32;      //!< Longer names are cut, a page always fits one.
+}    // namespace
+
+UmoDispatcher* UmoDispatcher::s_instance = nullptr;
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+UmoDispatcher::UmoDispatcher(const std::string& label) : m_label(label)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of UmoDispatcher!");
+    s_instance = this;
+
+    Register(Command::Ping, &HandlePing);
+    Register(Command::GetStats, &HandleGetStats);
+    Register(Command::GetConfig, &HandleGetConfig, Context::Module);
+    Register(Command::GetProfile, &HandleGetProfile);
+    Register(Command::ResetProfile, &HandleResetProfile);
+    Register(Command::GetDiskStats, &HandleGetDiskStats, Context::Module);
+    Register(Command::GetMemory, &HandleGetMemory, Context::Module);
+
+    FrameLink::Init(&Dispatch);
+}
+
+bool UmoDispatcher::DoPost()
+{
+    return true;
+}
+
+void UmoDispatcher::Run()
+{
+    if (!m_pending)
+    {
+        return;
+    }
+    m_handlers[m_pendingId](m_pendingId, m_pendingBody, m_pendingLen);
+    m_pending = false;
+}
+
+void UmoDispatcher::Register(uint8_t id, Handler handler, Context context)
+{
+    CEP_ASSERT(id != ERROR_ID && (id & RESPONSE) == 0, "IDs with the response bit are reserved!");
+    CEP_ASSERT(m_handlers[id] == nullptr, "Command ID already registered!");
+
+    m_handlers[id] = handler;
+    if (context == Context::Module)
+    {
+        m_deferred[id / 32] |= 1UL << (id % 32);
+    }
+}
+
+bool UmoDispatcher::Reply(uint8_t command, const void* body, size_t len)
+{
+    return FrameLink::Send(command | RESPONSE, body, len);
+}
+
+bool UmoDispatcher::ReplyError(uint8_t command, ErrorCode code)
+{
+    uint8_t body[] = {command, static_cast<uint8_t>(code)};
+    return FrameLink::Send(ERROR_ID, body, sizeof(body));
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @brief Routes a frame to its handler. Matches FrameLink::Handler.
+ * @note Called from an interrupt.
+ */
+void UmoDispatcher::Dispatch(uint8_t id, const uint8_t* body, size_t len)
+{
+    UmoDispatcher* self = s_instance;
+    if (self == nullptr)
+    {
+        return;
+    }
+
+    Handler handler = self->m_handlers[id];
+    if (handler == nullptr)
+    {
+        self->m_unknownCommands++;
+        ReplyError(id, ErrorCode::UnknownCommand);
+        return;
+    }
+
+    if ((self->m_deferred[id / 32] & (1UL << (id % 32))) == 0)
+    {
+        handler(id, body, len);
+        return;
+    }
+
+    if (self->m_pending)
+    {
+        ReplyError(id, ErrorCode::Busy);
+    }
+    else if (len > MAX_DEFERRED_BODY)
+    {
+        ReplyError(id, ErrorCode::InvalidRequest);
+    }
+    else
+    {
+        std::memcpy(self->m_pendingBody, body, len);
+        self->m_pendingId  = id;
+        self->m_pendingLen = len;
+        self->m_pending    = true;
+    }
+}
+
+void UmoDispatcher::HandlePing(uint8_t id, const uint8_t* body, size_t len)
+{
+    Reply(id, body, len);
+}
+
+/**
+ * @brief Answers with, in order (all u32): uptime (ms), frames received, CRC errors, framing
+ * errors, RX overruns, log messages dropped, unknown commands.
+ */
+void UmoDispatcher::HandleGetStats(uint8_t id, const uint8_t* /*body*/, size_t /*len*/)
+{
+    const uint32_t stats[] = {
+      HAL_GetTick(),
+      FrameLink::GetFrameCount(),
+      FrameLink::GetCrcErrors(),
+      FrameLink::GetFramingErrors(),
+      UartRxDma::Get() != nullptr ? UartRxDma::Get()->GetOverruns() : 0,
+      UartTxDma::Get() != nullptr ? UartTxDma::Get()->GetDroppedMessages() : 0,
+      s_instance->m_unknownCommands,
+    };
+
+    uint8_t reply[sizeof(stats)];
+    for (size_t i = 0; i < sizeof(stats) / sizeof(stats[0]); i++)
+    {
+        ByteOrder::PutLe32(&reply[i * sizeof(uint32_t)], stats[i]);
+    }
+    Reply(id, reply, sizeof(reply));
+}
+
+/**
+ * @note Called from Run(), it reads the SD card.
+ */
+void UmoDispatcher::HandleGetConfig(uint8_t id, const uint8_t* body, size_t len)
+{
+    const auto* text       = reinterpret_cast<const char*>(body);
+    size_t      sectionLen = strnlen(text, len);
+    if (sectionLen == len)
+    {
+        ReplyError(id, ErrorCode::InvalidRequest);
+        return;
+    }
+    std::string section(text, sectionLen);
+    std::string key(&text[sectionLen + 1], strnlen(&text[sectionLen + 1], len - sectionLen - 1));
+
+#if APP_USE_SETTINGS
+    // What was changed since is in the flash, not in the file.
+    std::string_view stored;
+    if (Settings::Get() != nullptr && Settings::Get()->Get(Settings::MakeKey(section, key), stored))
+    {
+        Reply(id, stored.data(), std::min(stored.size(), FrameLink::MAX_TX_BODY));
+        return;
+    }
+#endif
+    if (!cep::Filesystem::IsMounted())
+    {
+        ReplyError(id, ErrorCode::NotFound);
+        return;
+    }
+    cep::IniParser ini(CONFIG_FILE);
+    if (ini.GetError() != 0 || !ini.HasValue(section, key))
+    {
+        ReplyError(id, ErrorCode::NotFound);
+        return;
+    }
+
+    std::string value = ini.Get<std::string>(section, key);
+    Reply(id, value.data(), std::min(value.size(), FrameLink::MAX_TX_BODY));
+}
+
+/**
+ * @brief Answers with: index (u8) | zone count (u8) | ticks per second | count | min | avg | max |
+ * p50 | p99 (all u32, in ticks) | name.
+ */
+void UmoDispatcher::HandleGetProfile(uint8_t id, const uint8_t* body, size_t len)
+{
+    if (len != 1)
+    {
+        ReplyError(id, ErrorCode::InvalidRequest);
+        return;
+    }
+    const Profiler::Zone* zone = Profiler::GetZone(body[0]);
+    if (zone == nullptr)
+    {
+        ReplyError(id, ErrorCode::NotFound);
+        return;
+    }
+
+    Profiler::Stats stats    = zone->GetStats();
+    const uint32_t  values[] = {
+      Profiler::TicksPerSecond(),
+      stats.count,
+      stats.min,
+      stats.avg,
+      stats.max,
+      stats.p50,
+      stats.p99,
+    };
+
+    uint8_t reply[FrameLink::MAX_TX_BODY];
+    size_t  pos  = 0;
+    reply[pos++] = body[0];
+    reply[pos++] = static_cast<uint8_t>(std::min<size_t>(Profiler::GetZoneCount(), UINT8_MAX));
+    for (uint32_t value : values)
+    {
+        ByteOrder::PutLe32(&reply[pos], value);
+        pos += sizeof(uint32_t);
+    }
+    size_t nameLen = strnlen(zone->GetName(), sizeof(reply) - pos);
+    std::memcpy(&reply[pos], zone->GetName(), nameLen);
+    Reply(id, reply, pos + nameLen);
+}
+
+void UmoDispatcher::HandleResetProfile(uint8_t id, const uint8_t* /*body*/, size_t /*len*/)
+{
+    Profiler::ResetAll();
+    Reply(id, nullptr, 0);
+}
+
+/**
+ * @brief Answers with, for read, write and ioctl: calls | errors | sectors | multi-sector calls |
+ * B/s | avg | p50 | p99 | max (us). Then: busy waits | busy timeouts | busy time (ms) | longest
+ * busy wait (us) | data token timeouts | data token wait (ms) | failed commands | init retries |
+ * rejected blocks. All u32.
+ * @note Called from Run(), logging the stats takes a while.
+ */
+void UmoDispatcher::HandleGetDiskStats(uint8_t id, const uint8_t* body, size_t len)
+{
+    uint8_t flags = len != 0 ? body[0] : 0;
+    if ((flags & DISK_STATS_LOG) != 0)
+    {
+        DiskStats::Log();
+    }
+
+    USER_Stats stats;
+    USER_GetStats(&stats);
+    if ((flags & DISK_STATS_RESET) != 0)
+    {
+        USER_ResetStats();
+    }
+
+    uint8_t reply[FrameLink::MAX_TX_BODY];
+    size_t  pos = 0;
+    auto    put = [&](uint32_t value)
+    {
+        ByteOrder::PutLe32(&reply[pos], value);
+        pos += sizeof(uint32_t);
+    };
+    for (const USER_OpStats& op : stats.ops)
+    {
+        DiskStats::Summary summary = DiskStats::Summarize(op);
+        for (uint32_t value : {summary.calls,
+                               summary.errors,
+                               summary.sectors,
+                               summary.multiSector,
+                               summary.bytesPerSec,
+                               summary.avgUs,
+                               summary.p50Us,
+                               summary.p99Us,
+                               summary.maxUs})
+        {
+            put(value);
+        }
+    }
+    const USER_SPI_Counters& spi = stats.spi;
+    for (uint32_t value : {spi.busyWaits,
+                           spi.busyTimeouts,
+                           static_cast<uint32_t>(spi.busyUs / 1000),
+                           spi.busyMaxUs,
+                           spi.tokenTimeouts,
+                           static_cast<uint32_t>(spi.tokenWaitUs / 1000),
+                           spi.cmdFailures,
+                           spi.initRetries,
+                           spi.rejectedBlocks})
+    {
+        put(value);
+    }
+    Reply(id, reply, pos);
+}
+
+/**
+ * @brief Answers with, all u32: heap in use | peak | blocks | allocations | failures | arena | free
+ * | largest free block | stack reserved | stack used | headroom. Then owner count (u8) | first
+ * owner (u8) and, from the first owner on for as many as fit: allocations | frees | allocated
+ * bytes | freed bytes (u32) | name length (u8) | name.
+ * @note Called from Run(), the heap is walked.
+ */
+void UmoDispatcher::HandleGetMemory(uint8_t id, const uint8_t* body, size_t len)
+{
+    uint8_t first = len > 0 ? body[0] : 0;
+    uint8_t flags = len > 1 ? body[1] : 0;
+    if ((flags & MEMORY_LOG) != 0)
+    {
+        MemStats::Log();
+    }
+
+    MemStats::Heap  heap  = MemStats::GetHeap();
+    MemStats::Stack stack = MemStats::GetStack();
+
+    uint8_t reply[FrameLink::MAX_TX_BODY];
+    size_t  pos = 0;
+    auto    put = [&](uint32_t value)
+    {
+        ByteOrder::PutLe32(&reply[pos], value);
+        pos += sizeof(uint32_t);
+    };
+    for (uint32_t value : {heap.current,
+                           heap.peak,
+                           heap.blocks,
+                           heap.allocations,
+                           heap.failures,
+                           heap.arena,
+                           heap.free,
+                           heap.largestFree,
+                           stack.reserved,
+                           stack.used,
+                           stack.headroom})
+    {
+        put(value);
+    }
+    reply[pos++] = static_cast<uint8_t>(MemStats::GetOwnerCount());
+    reply[pos++] = first;
+
+    for (size_t i = first; i < MemStats::GetOwnerCount(); i++)
+    {
+        MemStats::Owner owner   = MemStats::GetOwner(i);
+        size_t          nameLen = std::min(strlen(owner.name), MEMORY_NAME_LEN);
+        if (pos + 4 * sizeof(uint32_t) + 1 + nameLen > sizeof(reply))
+        {
+            break;    // The next request starts from there.
+        }
+        for (uint32_t value :
+             {owner.allocations, owner.frees, owner.allocatedBytes, owner.freedBytes})
+        {
+            put(value);
+        }
+        reply[pos++] = static_cast<uint8_t>(nameLen);
+        std::memcpy(&reply[pos], owner.name, nameLen);
+        pos += nameLen;
+    }
+    Reply(id, reply, pos);
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,137 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    umoDispatcher.h
+ * @brief   Binary command protocol on FrameLink, dispatched by command ID.
+ *
+ * The first byte of each frame is the ID of the command and directly indexes a table of handlers,
+ * nothing is parsed as text. A handler gets the body of the frame in place, still in the RX ring
+ * of the UART, from either of two contexts:
+ *  - Interrupt: called from the RX interrupt, as soon as the frame is complete. For the requests
+ *    that only read a few variables, answered within microseconds.
+ *  - Module: the frame is copied to a mailbox and the handler is called from Run(), for the
+ *    requests that need the SD card or anything else that can't run in an interrupt. The mailbox
+ *    holds one request, the next one is answered with ErrorCode::Busy until it's free.
+ *
+ * The answer to a command has the ID of the command with the RESPONSE bit set. Errors are
+ * answered with ERROR_ID: | command ID | ErrorCode |.
+ *
+ * Built-in commands:
+ *  - PING       (0x01): echoes its body.
+ *  - GET_STATS  (0x02): uptime and the counters of the link, see HandleGetStats.
+ *  - GET_CONFIG (0x03): section | 0x00 | key, answers with the value from cfg.ini.
+ *  - GET_PROFILE (0x04): index (u8), answers with the stats of that Profiler zone.
+ *  - RESET_PROFILE (0x05): clears the stats of every zone.
+ *  - GET_DISK_STATS (0x06): flags (u8, optional), answers with the SD card driver's counters,
+ *    see HandleGetDiskStats.
+ *  - GET_MEMORY (0x07): first owner (u8, optional) | flags (u8, optional), answers with the usage
+ *    of the heap and the stack, and the allocations of as many owners as fit, see HandleGetMemory.
+ *
+ * @note Stands in for NilaiTFO's UmoModule, which parses its requests as text on a UartModule.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_UMODISPATCHER_H
+#    define NILAIINI_SERVICES_UMODISPATCHER_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "NilaiTFO/defines/module.hpp"
+
+#    include "Processes/services/frameLink.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+class UmoDispatcher : public cep::Module
+{
+public:
+    static constexpr uint8_t RESPONSE          = 0x80;
+    static constexpr uint8_t ERROR_ID          = 0xFF;
+    static constexpr size_t  MAX_DEFERRED_BODY = 128;
+
+    enum Command : uint8_t
+    {
+        Ping         = 0x01,
+        GetStats     = 0x02,
+        GetConfig    = 0x03,
+        GetProfile   = 0x04,
+        ResetProfile = 0x05,
+        GetDiskStats = 0x06,
+        GetMemory    = 0x07,
+    };
+
+    enum class ErrorCode : uint8_t
+    {
+        UnknownCommand = 1,
+        Busy           = 2,
+        InvalidRequest = 3,
+        NotFound       = 4,
+    };
+
+    enum class Context : uint8_t
+    {
+        Interrupt,
+        Module,
+    };
+
+    using Handler = FrameLink::Handler;
+
+    /**
+     * @brief Starts receiving the commands, UartRxDma must already exist.
+     */
+    UmoDispatcher(const std::string& label);
+    ~UmoDispatcher() override = default;
+
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const override { return m_label; }
+
+    void Register(uint8_t id, Handler handler, Context context = Context::Interrupt);
+
+    static bool Reply(uint8_t command, const void* body, size_t len);
+    static bool ReplyError(uint8_t command, ErrorCode code);
+
+    uint32_t GetUnknownCommands() const { return m_unknownCommands; }
+
+    static UmoDispatcher* Get() { return s_instance; }
+
+private:
+    std::string m_label;
+
+    Handler  m_handlers[256]   = {};
+    uint32_t m_deferred[8]     = {};    //!< One bit per ID, set for Context::Module.
+    uint32_t m_unknownCommands = 0;
+
+    volatile bool m_pending                        = false;
+    uint8_t       m_pendingId                      = 0;
+    uint8_t       m_pendingBody[MAX_DEFERRED_BODY] = {};
+    size_t        m_pendingLen                     = 0;
+
+private:
+    static UmoDispatcher* s_instance;
+
+private:
+    static void Dispatch(uint8_t id, const uint8_t* body, size_t len);
+
+    static void HandlePing(uint8_t id, const uint8_t* body, size_t len);
+    static void HandleGetStats(uint8_t id, const uint8_t* body, size_t len);
+    static void HandleGetConfig(uint8_t id, const uint8_t* body, size_t len);
+    static void HandleGetProfile(uint8_t id, const uint8_t* body, size_t len);
+    static void HandleResetProfile(uint8_t id, const uint8_t* body, size_t len);
+    static void HandleGetDiskStats(uint8_t id, const uint8_t* body, size_t len);
+    static void HandleGetMemory(uint8_t id, const uint8_t* body, size_t len);
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_UMODISPATCHER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    wav.cpp
+ * @brief   Source for the Wav parser.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "wav.h"
+
+#include "Processes/services/byteOrder.h"
+
+#include <algorithm>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t   CHUNK_HEADER           = 8;
+constexpr size_t   BASIC_FMT_SIZE         = 16;
+constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Wav
+{
+bool Parse(const uint8_t* file, size_t size, Format& format)
+{
+    format = {};
+    if (file == nullptr || size < 12 || std::memcmp(file, "RIFF", 4) != 0 ||
+        std::memcmp(&file[8], "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    bool   haveFmt = false;
+    size_t pos     = 12;
+    while (pos + CHUNK_HEADER <= size)
+    {
+        const uint8_t* chunk     = &file[pos];
+        size_t         chunkSize = ByteOrder::GetLe32(&chunk[4]);
+        const uint8_t* body      = &chunk[CHUNK_HEADER];
+        size_t         available = size - pos - CHUNK_HEADER;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0)
+        {
+            if (chunkSize < BASIC_FMT_SIZE || chunkSize > available)
+            {
+                return false;
+            }
+            format.encoding      = ByteOrder::GetLe16(&body[0]);
+            format.channels      = ByteOrder::GetLe16(&body[2]);
+            format.sampleRate    = ByteOrder::GetLe32(&body[4]);
+            format.blockAlign    = ByteOrder::GetLe16(&body[12]);
+            format.bitsPerSample = ByteOrder::GetLe16(&body[14]);
+            format.extra         = &body[BASIC_FMT_SIZE];
+            format.extraSize     = chunkSize - BASIC_FMT_SIZE;
+            // cbSize, valid bits and channel mask come before the sub-format's GUID.
+            if (format.encoding == WAVE_FORMAT_EXTENSIBLE && format.extraSize >= 10)
+            {
+                format.encoding = ByteOrder::GetLe16(&format.extra[8]);
+            }
+            haveFmt = true;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0)
+        {
+            format.data = body;
+            format.size = std::min(chunkSize, available);
+            return haveFmt && format.channels != 0 && format.blockAlign != 0;
+        }
+
+        if (chunkSize >= available)
+        {
+            break;
+        }
+        // Chunks are padded to an even size.
+        pos += CHUNK_HEADER + chunkSize + (chunkSize & 1);
+    }
+    return false;
+}
+}    // namespace Wav
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @addtogroup services
+ * @{
+ * @file    wav.h
+ * @brief   Parsing of the RIFF/WAVE files played by the AudioEngine.
+ *
+ * Only finds the "fmt " and "data" chunks, the others are skipped. The samples are left where
+ * they are: the AudioEngine plays them in place when their format is the I2S's.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_SERVICES_WAV_H
+#    define NILAIINI_SERVICES_WAV_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace Wav
+{
+enum Encoding : uint16_t
+{
+    Pcm      = 0x0001,
+    ImaAdpcm = 0x0011,    //!< 4 bits per sample, see ImaAdpcm.
+};
+
+struct Format
+{
+    uint16_t       encoding      = 0;    //!< Encoding, the sub-format of WAVE_FORMAT_EXTENSIBLE.
+    uint16_t       channels      = 0;
+    uint32_t       sampleRate    = 0;
+    uint16_t       bitsPerSample = 0;
+    uint16_t       blockAlign    = 0;    //!< Bytes per frame, or per block when compressed.
+    const uint8_t* extra         = nullptr;    //!< What follows the basic "fmt " fields.
+    size_t         extraSize     = 0;
+    const uint8_t* data          = nullptr;    //!< Content of the "data" chunk.
+    size_t         size          = 0;
+};
+
+/**
+ * @returns False if @p file isn't a WAVE file, or has no "fmt " or "data" chunk. A truncated
+ *          "data" chunk is cut to what's there.
+ */
+bool Parse(const uint8_t* file, size_t size, Format& format);
+}    // namespace Wav
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_SERVICES_WAV_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
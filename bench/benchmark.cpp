@@ -0,0 +1,419 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    benchmark.cpp
+ * @brief   Source of the harness of hostBench.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr double DEFAULT_TOLERANCE = 15.0;    //!< In percent.
+constexpr size_t MAX_ITERATIONS    = size_t(1) << 32;
+
+struct Case
+{
+    std::string     name;
+    uint64_t        bytesPerOp;
+    Bench::Body     body;
+    Bench::IoCounter io;
+};
+
+struct Result
+{
+    std::string name;
+    double      nsPerOp     = 0.0;
+    double      heapPerOp   = 0.0;
+    double      allocsPerOp = 0.0;
+    double      ioPerOp     = 0.0;
+    uint64_t    bytesPerOp  = 0;
+};
+
+struct Options
+{
+    std::string filter;
+    double      minTimeMs = Bench::DEFAULT_MIN_TIME;
+    std::string save;
+    std::string compare;
+    double      tolerance = DEFAULT_TOLERANCE;
+};
+
+// Counted by the replacements of operator new below.
+size_t s_allocatedBytes = 0;
+size_t s_allocations    = 0;
+
+std::vector<Case>& Cases()
+{
+    static std::vector<Case> s_cases;
+    return s_cases;
+}
+
+double RunNs(const Case& c, size_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    c.body(iterations);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+Result Measure(const Case& c, double minTimeMs)
+{
+    const double minNs = minTimeMs * 1e6;
+
+    // Warms up the caches, and runs the checks a case does once, before its first operation.
+    c.body(1);
+
+    // Grows the count until a run is long enough.
+    size_t iterations = 1;
+    double ns         = RunNs(c, iterations);
+    while (ns < minNs && iterations < MAX_ITERATIONS)
+    {
+        double scale = ns > 0.0 ? 1.2 * minNs / ns : 100.0;
+        iterations   = static_cast<size_t>(iterations * std::min(std::max(scale, 2.0), 100.0));
+        ns           = RunNs(c, iterations);
+    }
+
+    Result result;
+    result.name       = c.name;
+    result.bytesPerOp = c.bytesPerOp;
+
+    std::vector<double> samples;
+    samples.reserve(Bench::REPETITIONS);    // Not to count it against the case.
+
+    size_t   bytesBefore  = s_allocatedBytes;
+    size_t   allocsBefore = s_allocations;
+    uint64_t ioBefore     = c.io != nullptr ? c.io() : 0;
+    for (size_t i = 0; i < Bench::REPETITIONS; i++)
+    {
+        samples.push_back(RunNs(c, iterations) / static_cast<double>(iterations));
+    }
+
+    double ops         = static_cast<double>(iterations * Bench::REPETITIONS);
+    result.nsPerOp     = *std::min_element(samples.begin(), samples.end());
+    result.heapPerOp   = static_cast<double>(s_allocatedBytes - bytesBefore) / ops;
+    result.allocsPerOp = static_cast<double>(s_allocations - allocsBefore) / ops;
+    result.ioPerOp     = c.io != nullptr ? static_cast<double>(c.io() - ioBefore) / ops : 0.0;
+    return result;
+}
+
+std::string HostDescription()
+{
+    std::ostringstream out;
+#if defined(__clang__)
+    out << "clang " << __clang_major__ << "." << __clang_minor__;
+#elif defined(__GNUC__)
+    out << "gcc " << __GNUC__ << "." << __GNUC_MINOR__;
+#endif
+#if defined(NDEBUG)
+    out << ", optimized";
+#else
+    out << ", debug";
+#endif
+    return out.str();
+}
+
+bool Save(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    file << "{\n  \"host\": \"" << HostDescription() << "\",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        char          line[256];
+        std::snprintf(line,
+                      sizeof(line),
+                      "    {\"name\": \"%s\", \"ns_per_op\": %.2f, \"bytes_per_op\": %.2f, "
+                      "\"allocs_per_op\": %.3f, \"io_bytes_per_op\": %.2f, "
+                      "\"processed_bytes\": %llu}%s\n",
+                      r.name.c_str(),
+                      r.nsPerOp,
+                      r.heapPerOp,
+                      r.allocsPerOp,
+                      r.ioPerOp,
+                      static_cast<unsigned long long>(r.bytesPerOp),
+                      i + 1 < results.size() ? "," : "");
+        file << line;
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Reads the number following "key": in @p object, 0 if it's not there.
+ */
+double FindNumber(const std::string& object, const char* key)
+{
+    std::string quoted = std::string("\"") + key + "\":";
+    size_t      pos    = object.find(quoted);
+    return pos == std::string::npos ? 0.0 : std::strtod(&object[pos + quoted.size()], nullptr);
+}
+
+/**
+ * @brief Loads a file written by Save. Not a general JSON parser: one object per case, names
+ *        without escaped characters.
+ */
+bool Load(const std::string& path, std::vector<Result>& results)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    size_t pos = text.find("\"benchmarks\"");
+    while (pos != std::string::npos && (pos = text.find('{', pos)) != std::string::npos)
+    {
+        size_t end = text.find('}', pos);
+        if (end == std::string::npos)
+        {
+            return false;
+        }
+        std::string object = text.substr(pos, end - pos);
+        size_t      name   = object.find("\"name\": \"");
+        if (name != std::string::npos)
+        {
+            name += std::strlen("\"name\": \"");
+            Result r;
+            r.name        = object.substr(name, object.find('"', name) - name);
+            r.nsPerOp     = FindNumber(object, "ns_per_op");
+            r.heapPerOp   = FindNumber(object, "bytes_per_op");
+            r.allocsPerOp = FindNumber(object, "allocs_per_op");
+            r.ioPerOp     = FindNumber(object, "io_bytes_per_op");
+            results.push_back(r);
+        }
+        pos = end;
+    }
+    return true;
+}
+
+/**
+ * @returns True if @p now regressed from @p base, and describes the difference in @p note.
+ */
+bool Regressed(const Result& now, const Result& base, double tolerance, std::string& note)
+{
+    char   text[64];
+    double change = base.nsPerOp > 0.0 ? 100.0 * (now.nsPerOp / base.nsPerOp - 1.0) : 0.0;
+    std::snprintf(text, sizeof(text), "%+6.1f%%", change);
+    note = text;
+
+    // The allocations and the I/O don't depend on the machine, the margin is for what a run
+    // spreads over its count of operations (opening the file, where the laps end, ...).
+    auto grew      = [](double value, double was) { return value > 1.1 * was + 1.0; };
+    bool regressed = false;
+    if (change > tolerance)
+    {
+        note += " SLOWER";
+        regressed = true;
+    }
+    if (grew(now.heapPerOp, base.heapPerOp) || now.allocsPerOp > 1.1 * base.allocsPerOp + 0.01)
+    {
+        note += " MORE HEAP";
+        regressed = true;
+    }
+    if (grew(now.ioPerOp, base.ioPerOp))
+    {
+        note += " MORE I/O";
+        regressed = true;
+    }
+    return regressed;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string arg   = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg != "--filter" && arg != "--min-time" && arg != "--save" && arg != "--compare" &&
+            arg != "--tolerance")
+        {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return false;
+        }
+        if (value == nullptr)
+        {
+            std::fprintf(stderr, "Missing the value of %s\n", arg.c_str());
+            return false;
+        }
+
+        if (arg == "--filter")
+        {
+            options.filter = value;
+        }
+        else if (arg == "--min-time")
+        {
+            options.minTimeMs = std::atof(value);
+        }
+        else if (arg == "--save")
+        {
+            options.save = value;
+        }
+        else if (arg == "--compare")
+        {
+            options.compare = value;
+        }
+        else
+        {
+            options.tolerance = std::atof(value);
+        }
+    }
+    return true;
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace Bench
+{
+bool Register(const char* name, uint64_t bytesPerOp, Body body, IoCounter io)
+{
+    Cases().push_back({name, bytesPerOp, std::move(body), io});
+    return true;
+}
+
+int Main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [--filter TEXT] [--min-time MS] [--save FILE] [--compare FILE] "
+                     "[--tolerance PERCENT]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::vector<Result> baseline;
+    if (!options.compare.empty() && !Load(options.compare, baseline))
+    {
+        std::fprintf(stderr, "Can't read the baseline %s\n", options.compare.c_str());
+        return 2;
+    }
+
+    std::printf("%-28s %12s %9s %9s %10s %9s %s\n",
+                "benchmark",
+                "ns/op",
+                "B/op",
+                "allocs/op",
+                "io B/op",
+                "MB/s",
+                baseline.empty() ? "" : "  vs baseline");
+
+    std::vector<Result> results;
+    size_t              regressions = 0;
+    for (const Case& c : Cases())
+    {
+        if (c.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        Result r = Measure(c, options.minTimeMs);
+        results.push_back(r);
+
+        char rate[16] = "-";
+        if (r.bytesPerOp != 0)
+        {
+            std::snprintf(rate, sizeof(rate), "%.1f", 1e3 * r.bytesPerOp / r.nsPerOp);
+        }
+        std::string note;
+        auto        base = std::find_if(baseline.begin(),
+                                 baseline.end(),
+                                 [&](const Result& b) { return b.name == r.name; });
+        if (base != baseline.end())
+        {
+            regressions += Regressed(r, *base, options.tolerance, note);
+        }
+        else if (!baseline.empty())
+        {
+            note = "new";
+        }
+
+        std::printf("%-28s %12.1f %9.1f %9.3f %10.1f %9s   %s\n",
+                    r.name.c_str(),
+                    r.nsPerOp,
+                    r.heapPerOp,
+                    r.allocsPerOp,
+                    r.ioPerOp,
+                    rate,
+                    note.c_str());
+    }
+
+    if (!options.save.empty() && !Save(options.save, results))
+    {
+        std::fprintf(stderr, "Can't write %s\n", options.save.c_str());
+        return 2;
+    }
+    if (regressions != 0)
+    {
+        std::printf("\n%zu regression(s) against %s, tolerance %.0f%%.\n",
+                    regressions,
+                    options.compare.c_str(),
+                    options.tolerance);
+        return 1;
+    }
+    return 0;
+}
+}    // namespace Bench
+
+int main(int argc, char** argv)
+{
+    return Bench::Main(argc, argv);
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+// Counts the allocations of the C++ heap, operator new[] and the nothrow forms land here too.
+void* operator new(size_t size)
+{
+    s_allocatedBytes += size;
+    s_allocations++;
+    if (void* p = std::malloc(size != 0 ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
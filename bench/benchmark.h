@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    benchmark.h
+ * @brief   Micro-benchmark harness of hostBench, with JSON baselines.
+ *
+ * Each case is a body that runs its operation a given number of times. The harness grows the
+ * count until a run lasts long enough to be timed, then keeps the fastest of REPETITIONS runs,
+ * the least disturbed by the rest of the machine. For every case it reports:
+ *  - ns/op:     the time per operation.
+ *  - B/op:      bytes allocated on the C++ heap per operation (operator new is counted).
+ *  - allocs/op: allocations per operation.
+ *  - io B/op:   bytes moved by the case's I/O counter, if it has one (e.g. sectors of the disk).
+ *  - MB/s:      from the bytes processed per operation, if given.
+ *
+ * Usage: hostBench [--filter TEXT] [--min-time MS] [--save FILE] [--compare FILE]
+ *                  [--tolerance PERCENT]
+ * --save writes the results as JSON, --compare checks them against a saved baseline and fails
+ * when a case got slower by more than the tolerance, or allocates or moves more bytes than it
+ * used to.
+ *
+ * Cases register themselves from their own file:
+ *      const bool s_registered = Bench::Register("group/name", bytesPerOp, [](size_t n) { ... });
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_BENCHMARK_H
+#    define NILAIINI_BENCH_BENCHMARK_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+#    include <functional>
+
+/*****************************************************************************/
+/* Exported types */
+namespace Bench
+{
+static constexpr size_t REPETITIONS      = 5;
+static constexpr double DEFAULT_MIN_TIME = 50.0;    //!< In ms, per repetition.
+
+/**
+ * @brief Runs the operation @p iterations times.
+ */
+using Body = std::function<void(size_t iterations)>;
+/**
+ * @brief Returns a running total of bytes, read before and after each run.
+ */
+using IoCounter = uint64_t (*)();
+
+/**
+ * @param name       Unique, "group/case" by convention. It is the key of the baseline.
+ * @param bytesPerOp Bytes processed by one operation, 0 if it doesn't apply.
+ * @param io         Optional, counter of the bytes moved by the I/O under test.
+ * @returns True, so it can initialize a static.
+ */
+bool Register(const char* name, uint64_t bytesPerOp, Body body, IoCounter io = nullptr);
+
+/**
+ * @brief Keeps the compiler from optimizing away the computation of @p value.
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Runs the cases matching the command line, see the file's description.
+ * @returns The exit code of the program.
+ */
+int Main(int argc, char** argv);
+}    // namespace Bench
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_BENCHMARK_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,287 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    codecBench.cpp
+ * @brief   The decoders of compressed audio, ImaAdpcm and Qoa.
+ *
+ * An operation decodes a block of a stereo IMA-ADPCM stream at 48 kHz (2048 bytes, 2041 frames)
+ * or a frame of a stereo QOA stream (5120 frames), a period of the AudioEngine at a time, as it
+ * does. The B/op is what's read from the file for it: its share of the SD's bandwidth.
+ *
+ * Before timing anything, the decoders decode the vectors of tools/audioref.py, in reads of
+ * random sizes, and their output must have the same CRC32 as the reference decoders': a
+ * mismatch stops hostBench. "audioref.py vectors" prints the CRCs.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+
+#include "Processes/services/crc32.h"
+#include "Processes/services/imaAdpcm.h"
+#include "Processes/services/qoa.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t PERIOD_FRAMES = 512;    //!< AudioEngine::PERIOD_FRAMES.
+constexpr size_t IMA_BLOCK     = 2048;
+constexpr size_t BENCH_BLOCKS  = 16;
+
+struct ImaVector
+{
+    size_t   channels;
+    size_t   blockAlign;
+    size_t   size;
+    uint32_t seed;
+    size_t   frames;
+    uint32_t crc;
+};
+
+struct QoaVector
+{
+    size_t              channels;
+    std::vector<size_t> frames;
+    uint32_t            seed;
+    uint32_t            crc;
+};
+
+const ImaVector IMA_VECTORS[] = {
+  {1, 256, 256 * 3 + 4 + 4 * 5 + 3, 1, 1556, 0xACDFE39E},
+  {2, 512, 512 * 2 + 8 + 8 * 7 + 5, 2, 1067, 0x5F906707},
+};
+
+const QoaVector QOA_VECTORS[] = {
+  {1, {5120, 5120, 1337}, 3, 0xC9461CEE},
+  {2, {5120, 999}, 4, 0x6196B736},
+};
+
+class XorShift32
+{
+public:
+    explicit XorShift32(uint32_t seed) : m_state(seed) {}
+
+    uint32_t operator()()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+void Fail(const char* what, size_t vector)
+{
+    std::fprintf(stderr, "%s doesn't match the reference on vector %zu\n", what, vector);
+    std::exit(2);
+}
+
+void PutBe(std::vector<uint8_t>& out, uint64_t value, size_t size)
+{
+    for (size_t i = size; i-- > 0;)
+    {
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+/**
+ * @brief Random nibbles, behind headers with valid step indices, as audioref.py's ima_vector().
+ */
+std::vector<uint8_t> MakeIma(size_t channels, size_t blockAlign, size_t size, uint32_t seed)
+{
+    XorShift32           rng(seed);
+    std::vector<uint8_t> data(size);
+    for (uint8_t& byte : data)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    for (size_t start = 0; start < size; start += blockAlign)
+    {
+        for (size_t channel = 0; channel < channels; channel++)
+        {
+            size_t index = start + channel * ImaAdpcm::HEADER_SIZE + 2;
+            if (index + 1 < size)
+            {
+                data[index] %= 89;
+                data[index + 1] = 0;
+            }
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Random residuals of scale factors 0 to 3, as audioref.py's qoa_vector().
+ */
+std::vector<uint8_t> MakeQoa(size_t channels, const std::vector<size_t>& frames, uint32_t seed)
+{
+    XorShift32           rng(seed);
+    std::vector<uint8_t> out = {'q', 'o', 'a', 'f'};
+    size_t               total = 0;
+    for (size_t samples : frames)
+    {
+        total += samples;
+    }
+    PutBe(out, total, 4);
+
+    for (size_t samples : frames)
+    {
+        size_t slices = (samples + Qoa::SLICE_LEN - 1) / Qoa::SLICE_LEN * channels;
+        size_t size   = 8 + 16 * channels + 8 * slices;
+        PutBe(out, (uint64_t(channels) << 56) | (48000ULL << 32) | (samples << 16) | size, 8);
+        for (size_t i = 0; i < channels * 2 * Qoa::LMS_LEN; i++)
+        {
+            PutBe(out, static_cast<uint16_t>(static_cast<int16_t>(rng()) >> 2), 2);
+        }
+        for (size_t i = 0; i < slices; i++)
+        {
+            out.push_back(static_cast<uint8_t>(rng()) & 0x3F);
+            for (size_t byte = 1; byte < 8; byte++)
+            {
+                out.push_back(static_cast<uint8_t>(rng()));
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * @returns The CRC32 of what @p decoder outputs, read in random sizes.
+ */
+template<typename Decoder>
+uint32_t Decode(Decoder& decoder, size_t& frames, uint32_t seed)
+{
+    XorShift32           rng(seed);
+    std::vector<int16_t> out(700 * 2);
+    uint32_t             crc = 0;
+    frames                   = 0;
+    size_t read              = 0;
+    while ((read = decoder.Read(out.data(), 1 + rng() % 700)) != 0)
+    {
+        crc = Crc32::Update(crc, out.data(), read * 2 * sizeof(int16_t));
+        frames += read;
+    }
+    return crc;
+}
+
+void VerifyIma()
+{
+    static bool s_verified = false;
+    for (size_t i = 0; i < std::size(IMA_VECTORS) && !s_verified; i++)
+    {
+        const ImaVector& vector = IMA_VECTORS[i];
+        std::vector<uint8_t> data =
+          MakeIma(vector.channels, vector.blockAlign, vector.size, vector.seed);
+        ImaAdpcm::Decoder decoder;
+        size_t            frames = 0;
+        if (!decoder.Open(data.data(), data.size(), vector.channels, vector.blockAlign) ||
+            Decode(decoder, frames, 42) != vector.crc || frames != vector.frames ||
+            decoder.GetFrameCount() != vector.frames)
+        {
+            Fail("ImaAdpcm", i);
+        }
+        // Once more from the start, in other sizes.
+        if (!decoder.Rewind() || Decode(decoder, frames, 43) != vector.crc)
+        {
+            Fail("ImaAdpcm rewound", i);
+        }
+    }
+    s_verified = true;
+}
+
+void VerifyQoa()
+{
+    static bool s_verified = false;
+    for (size_t i = 0; i < std::size(QOA_VECTORS) && !s_verified; i++)
+    {
+        const QoaVector&     vector = QOA_VECTORS[i];
+        std::vector<uint8_t> file   = MakeQoa(vector.channels, vector.frames, vector.seed);
+        Qoa::Decoder         decoder;
+        size_t               frames = 0;
+        if (!decoder.Open(file.data(), file.size()) || Decode(decoder, frames, 42) != vector.crc ||
+            frames != decoder.GetFrameCount() || decoder.GetChannels() != vector.channels)
+        {
+            Fail("Qoa", i);
+        }
+        if (!decoder.Rewind() || Decode(decoder, frames, 43) != vector.crc)
+        {
+            Fail("Qoa rewound", i);
+        }
+    }
+    s_verified = true;
+}
+
+/**
+ * @brief Decodes @p iterations units of @p unitFrames, looping over the stream.
+ */
+template<typename Decoder>
+void Run(Decoder& decoder, size_t iterations, size_t unitFrames)
+{
+    static int16_t s_period[PERIOD_FRAMES * 2];
+    for (size_t i = 0; i < iterations; i++)
+    {
+        for (size_t frames = 0; frames < unitFrames;)
+        {
+            size_t read = decoder.Read(s_period, std::min(PERIOD_FRAMES, unitFrames - frames));
+            if (read == 0)
+            {
+                decoder.Rewind();
+                continue;
+            }
+            frames += read;
+        }
+        Bench::DoNotOptimize(s_period);
+    }
+}
+
+void ImaBlock(size_t iterations)
+{
+    VerifyIma();
+
+    static const std::vector<uint8_t> s_data = MakeIma(2, IMA_BLOCK, BENCH_BLOCKS * IMA_BLOCK, 5);
+    static ImaAdpcm::Decoder          s_decoder;
+    if (s_decoder.GetFrameCount() == 0 &&
+        !s_decoder.Open(s_data.data(), s_data.size(), 2, IMA_BLOCK))
+    {
+        Fail("ImaAdpcm", 0);
+    }
+    Run(s_decoder, iterations, ImaAdpcm::FramesPerBlock(IMA_BLOCK, 2));
+}
+
+void QoaFrame(size_t iterations)
+{
+    VerifyQoa();
+
+    static const std::vector<uint8_t> s_file =
+      MakeQoa(2, std::vector<size_t>(BENCH_BLOCKS, Qoa::FRAME_SAMPLES), 6);
+    static Qoa::Decoder s_decoder;
+    if (s_decoder.GetFrameCount() == 0 && !s_decoder.Open(s_file.data(), s_file.size()))
+    {
+        Fail("Qoa", 0);
+    }
+    Run(s_decoder, iterations, Qoa::FRAME_SAMPLES);
+}
+
+const bool s_registered = [] {
+    Bench::Register("codec/ima block", IMA_BLOCK, ImaBlock);
+    Bench::Register("codec/qoa frame", Qoa::MaxFrameSize(2), QoaFrame);
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
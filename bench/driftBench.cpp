@@ -0,0 +1,285 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    driftBench.cpp
+ * @brief   The Resampler, and the DriftEstimator steering it against simulated clocks.
+ *
+ * An operation resamples a period of the AudioEngine, 512 frames of 16-bit stereo, at a step
+ * of 1 + 186 ppm: the cost of the drift compensation per 10.7 ms of audio.
+ *
+ * Before timing anything, the loop of the AudioEngine is simulated for 10 minutes of playback
+ * against I2S clocks that drift from the reference: the resampler's position at the start of
+ * each period, the timestamps of the reference with the latency of the interrupt, or ticking by
+ * the millisecond, and the step updated between periods. After a minute, the content must stay
+ * within half a frame of where the reference says it should be (half a millisecond, for the
+ * millisecond ticks), and the drift must be estimated within a ppm (2). A reference that jumps
+ * must relock. The resampler itself must interpolate a tone within 3 LSB, and count its position
+ * exactly. A failure stops hostBench.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+
+#include "Processes/services/driftEstimator.h"
+#include "Processes/services/resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t   PERIOD_FRAMES = 512;    //!< AudioEngine::PERIOD_FRAMES.
+constexpr uint32_t SAMPLE_RATE   = 48000;
+constexpr uint32_t CPU_CLOCK     = 168000000;
+constexpr double   DURATION      = 600.0;    //!< Of the simulations, in seconds.
+constexpr double   SETTLING      = 60.0;
+
+Resampler s_resampler;
+
+class XorShift32
+{
+public:
+    explicit XorShift32(uint32_t seed) : m_state(seed) {}
+
+    double Uniform()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state / 4294967296.0;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+void Fail(const char* scenario, const char* what)
+{
+    std::fprintf(stderr, "Drift: %s: %s\n", scenario, what);
+    std::exit(2);
+}
+
+/**
+ * @brief Fills a period from silence, as AudioEngine::Fill does from its source.
+ */
+void FillPeriod(Resampler& resampler, int16_t* out)
+{
+    size_t done = 0;
+    while ((done += resampler.Read(&out[done * 2], PERIOD_FRAMES - done)) < PERIOD_FRAMES)
+    {
+        size_t   space = 0;
+        int16_t* in    = resampler.GetInput(space);
+        std::fill(in, in + space * 2, int16_t(0));
+        resampler.Commit(space);
+    }
+}
+
+struct Scenario
+{
+    const char* name;
+    double      driftPpm;       //!< Of the I2S, at the start.
+    double      rampPpm;        //!< Change of the drift by the end, as the crystal warms up.
+    int32_t     expectedPpm;    //!< Given to DriftEstimator::Start().
+    uint32_t    tickRate;
+    double      latency;     //!< Of the interrupt, at most, in seconds.
+    float       bandwidth;
+    double      jumpAt;      //!< When the reference jumps, 0 if it doesn't.
+    double      jump;        //!< In seconds.
+    double      maxPhase;    //!< In frames, once settled.
+    double      maxDriftError;    //!< In ppm, at the end.
+    uint32_t    relocks;
+};
+
+const Scenario SCENARIOS[] = {
+  {"48 kHz on the cycle counter", -186.0, 0.0, -186, CPU_CLOCK, 2e-6, 0.05f, 0, 0, 0.5, 1.0, 0},
+  {"+183 ppm, from scratch", 183.0, 0.0, 0, CPU_CLOCK, 2e-6, 0.05f, 0, 0, 0.5, 1.0, 0},
+  {"warming crystal", -186.0, 40.0, -186, CPU_CLOCK, 5e-6, 0.05f, 0, 0, 0.5, 1.0, 0},
+  {"800 ppm, from scratch", 800.0, 0.0, 0, CPU_CLOCK, 2e-6, 0.05f, 0, 0, 0.5, 1.0, 0},
+  {"millisecond ticks", -186.0, 0.0, -186, 1000, 0, 0.01f, 0, 0, 24.0, 2.0, 0},
+  {"jumping reference", -186.0, 0.0, -186, CPU_CLOCK, 2e-6, 0.05f, 300.0, 0.1, 0.5, 1.0, 1},
+};
+
+/**
+ * @brief Plays DURATION seconds of @p scenario, as the AudioEngine would.
+ */
+void Simulate(const Scenario& scenario)
+{
+    static int16_t s_period[PERIOD_FRAMES * 2];
+    XorShift32     rng(1);
+    Resampler      resampler;
+    DriftEstimator estimator;
+    resampler.Reset();
+    estimator.SetBandwidth(scenario.bandwidth);
+    estimator.Start(SAMPLE_RATE, scenario.tickRate, scenario.expectedPpm);
+
+    // Start() fills both periods, the DMA starts the first at 0.
+    uint64_t positions[2];
+    positions[0] = resampler.GetPosition();
+    FillPeriod(resampler, s_period);
+    positions[1] = resampler.GetPosition();
+    FillPeriod(resampler, s_period);
+
+    double   time     = 0.0;
+    double   maxPhase = 0.0;
+    double   drift    = scenario.driftPpm;
+    uint64_t start    = 0;    //!< Where the content was at 0, by the estimator's lock.
+    bool     jumped   = false;
+    for (size_t period = 1; time < DURATION; period++)
+    {
+        drift = scenario.driftPpm + scenario.rampPpm * time / DURATION;
+        time += PERIOD_FRAMES / (SAMPLE_RATE * (1.0 + drift * 1e-6));
+
+        // The interrupt of the period that starts, then Run() refills the one that ended.
+        double reference = time + rng.Uniform() * scenario.latency;
+        if (scenario.jumpAt != 0 && time >= scenario.jumpAt)
+        {
+            reference += scenario.jump;
+        }
+        uint64_t position = positions[period % 2];
+        estimator.Update(position, static_cast<uint64_t>(reference * scenario.tickRate));
+        resampler.SetStep(estimator.GetStep());
+        positions[(period + 1) % 2] = resampler.GetPosition();
+        FillPeriod(resampler, s_period);
+
+        // The estimator locks on the first timestamp, and on the first after the jump.
+        auto expected = static_cast<uint64_t>(SAMPLE_RATE * time * 4294967296.0);
+        if (period == 1 || (scenario.jumpAt != 0 && time >= scenario.jumpAt && !jumped))
+        {
+            start  = position - expected;
+            jumped = period != 1;
+        }
+        double phase = static_cast<int64_t>(position - start - expected) / 4294967296.0;
+        if (time > SETTLING)
+        {
+            maxPhase = std::max(maxPhase, std::fabs(phase));
+        }
+    }
+
+    if (maxPhase > scenario.maxPhase)
+    {
+        std::fprintf(stderr, "Drift: off by %.2f frames\n", maxPhase);
+        Fail(scenario.name, "the content drifted from the reference");
+    }
+    // The I2S running slow by drift is what the estimator must find.
+    if (std::fabs(estimator.GetDriftPpm() - drift) > scenario.maxDriftError)
+    {
+        std::fprintf(stderr, "Drift: %.2f ppm instead of %.2f\n", estimator.GetDriftPpm(), drift);
+        Fail(scenario.name, "wrong drift");
+    }
+    if (estimator.GetRelocks() != scenario.relocks)
+    {
+        Fail(scenario.name, "wrong number of relocks");
+    }
+}
+
+/**
+ * @brief Resamples a tone, compared to the tone at the position of each frame.
+ */
+void VerifyResampler()
+{
+    constexpr double FREQUENCY = 1000.0;
+    constexpr double AMPLITUDE = 16000.0;
+    constexpr size_t FRAMES    = 48000;
+    const uint64_t   step      = Resampler::ONE + Resampler::ONE / 2000;    // +500 ppm
+
+    Resampler resampler;
+    resampler.Reset();
+    resampler.SetStep(step);
+    std::vector<int16_t> out(FRAMES * 2);
+    size_t               done  = 0;
+    size_t               input = 0;
+    while (done < FRAMES)
+    {
+        done += resampler.Read(&out[done * 2], FRAMES - done);
+        size_t   space = 0;
+        int16_t* in    = resampler.GetInput(space);
+        for (size_t i = 0; i < space; i++, input++)
+        {
+            double value = AMPLITUDE * std::sin(2 * M_PI * FREQUENCY * input / SAMPLE_RATE);
+            in[i * 2]     = static_cast<int16_t>(std::lround(value));
+            in[i * 2 + 1] = static_cast<int16_t>(-std::lround(value));
+        }
+        resampler.Commit(space);
+    }
+    if (resampler.GetPosition() != step * FRAMES)
+    {
+        Fail("resampler", "wrong position");
+    }
+
+    // The first frame is between the silence before the tone and its start.
+    double maxError = 0.0;
+    for (size_t i = 1; i < FRAMES; i++)
+    {
+        double position = static_cast<double>(step * i) / 4294967296.0;
+        double expected = AMPLITUDE * std::sin(2 * M_PI * FREQUENCY * position / SAMPLE_RATE);
+        maxError        = std::max({maxError,
+                             std::fabs(out[i * 2] - expected),
+                             std::fabs(out[i * 2 + 1] + expected)});
+    }
+    if (maxError > 3.0)
+    {
+        std::fprintf(stderr, "Drift: off by %.2f LSB\n", maxError);
+        Fail("resampler", "the tone isn't interpolated right");
+    }
+}
+
+void Verify()
+{
+    static bool s_verified = false;
+    if (s_verified)
+    {
+        return;
+    }
+    VerifyResampler();
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        Simulate(scenario);
+    }
+    s_verified = true;
+}
+
+void ResamplePeriod(size_t iterations)
+{
+    static int16_t s_input[PERIOD_FRAMES * 2];
+    static int16_t s_period[PERIOD_FRAMES * 2];
+    Verify();
+    for (size_t i = 0; i < PERIOD_FRAMES * 2; i++)
+    {
+        s_input[i] = static_cast<int16_t>(std::lround(16000 * std::sin(i * 0.0654)));
+    }
+    s_resampler.Reset();
+    s_resampler.SetStep(Resampler::ONE + Resampler::ONE / 5376);    // +186 ppm
+    size_t next = 0;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        size_t done = 0;
+        while ((done += s_resampler.Read(&s_period[done * 2], PERIOD_FRAMES - done)) <
+               PERIOD_FRAMES)
+        {
+            size_t   space = 0;
+            int16_t* in    = s_resampler.GetInput(space);
+            space          = std::min(space, PERIOD_FRAMES - next);
+            std::copy(&s_input[next * 2], &s_input[(next + space) * 2], in);
+            s_resampler.Commit(space);
+            next = (next + space) % PERIOD_FRAMES;
+        }
+        Bench::DoNotOptimize(s_period);
+    }
+}
+
+const bool s_registered =
+  Bench::Register("drift/resample period", PERIOD_FRAMES * 2 * sizeof(int16_t), ResamplePeriod);
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    fatfsBench.cpp
+ * @brief   FatFs, with the firmware's ffconf.h, over the RamDisk.
+ *
+ * The disk being memory, ns/op is the CPU time of FatFs itself. What the card would cost shows
+ * in io B/op: more bytes moved for the same operation means more sectors sent over the SPI.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+#include "ramDisk.h"
+
+#include "ff.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr FSIZE_t FILE_SIZE = 4 << 20;
+constexpr size_t  DIR_FILES = 64;
+
+uint8_t s_data[32768];
+
+void Check(FRESULT res, const char* what)
+{
+    if (res != FR_OK)
+    {
+        std::fprintf(stderr, "%s failed: %d\n", what, res);
+        std::exit(2);
+    }
+}
+
+/**
+ * @brief Opens @p path, filled to FILE_SIZE so reading it never reaches its end.
+ */
+FIL& OpenFilled(const char* path)
+{
+    static FIL s_file;
+    Check(RamDisk::Mount() ? FR_OK : FR_NOT_READY, "Mount");
+    Check(f_open(&s_file, path, FA_READ | FA_WRITE | FA_OPEN_ALWAYS), "f_open");
+    while (f_size(&s_file) < FILE_SIZE)
+    {
+        UINT written = 0;
+        Check(f_write(&s_file, s_data, sizeof(s_data), &written), "f_write");
+    }
+    Check(f_lseek(&s_file, 0), "f_lseek");
+    return s_file;
+}
+
+/**
+ * @brief Appends @p size bytes per operation, like the log sink. The file is truncated back to
+ *        empty every FILE_SIZE, so the clusters keep being allocated.
+ */
+Bench::Body Append(UINT size, bool sync)
+{
+    return [size, sync](size_t iterations) {
+        FIL& file = OpenFilled("append.bin");
+        Check(f_truncate(&file), "f_truncate");
+        for (size_t i = 0; i < iterations; i++)
+        {
+            if (f_tell(&file) >= FILE_SIZE)
+            {
+                Check(f_lseek(&file, 0), "f_lseek");
+                Check(f_truncate(&file), "f_truncate");
+            }
+            UINT written = 0;
+            Check(f_write(&file, s_data, size, &written), "f_write");
+            if (sync)
+            {
+                Check(f_sync(&file), "f_sync");
+            }
+        }
+        Check(f_close(&file), "f_close");
+    };
+}
+
+Bench::Body Read(UINT size)
+{
+    return [size](size_t iterations) {
+        FIL& file = OpenFilled("read.bin");
+        for (size_t i = 0; i < iterations; i++)
+        {
+            if (f_tell(&file) + size > FILE_SIZE)
+            {
+                Check(f_lseek(&file, 0), "f_lseek");
+            }
+            UINT read = 0;
+            Check(f_read(&file, s_data, size, &read), "f_read");
+        }
+        Check(f_close(&file), "f_close");
+    };
+}
+
+/**
+ * @brief Reads a sector at a random offset, through the fast seek table.
+ */
+void RandomRead(size_t iterations)
+{
+    static DWORD s_table[64];
+    FIL&         file = OpenFilled("read.bin");
+    file.cltbl        = s_table;
+    s_table[0]        = sizeof(s_table) / sizeof(s_table[0]);
+    Check(f_lseek(&file, CREATE_LINKMAP), "f_lseek");
+
+    uint32_t random = 1;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        random = random * 1664525u + 1013904223u;
+        UINT read = 0;
+        Check(f_lseek(&file, (random >> 8) % (FILE_SIZE / 512) * 512), "f_lseek");
+        Check(f_read(&file, s_data, 512, &read), "f_read");
+    }
+    Check(f_close(&file), "f_close");
+}
+
+/**
+ * @brief Opens and closes the last of DIR_FILES files, the whole directory is scanned.
+ */
+void OpenClose(size_t iterations)
+{
+    static char s_last[24] = {};
+    FIL         file;
+    if (s_last[0] == '\0')
+    {
+        Check(RamDisk::Mount() ? FR_OK : FR_NOT_READY, "Mount");
+        FRESULT res = f_mkdir("dir");
+        Check(res == FR_EXIST ? FR_OK : res, "f_mkdir");
+        for (size_t i = 0; i < DIR_FILES; i++)
+        {
+            std::snprintf(s_last, sizeof(s_last), "dir/file%03zu.txt", i);
+            Check(f_open(&file, s_last, FA_WRITE | FA_OPEN_ALWAYS), "f_open");
+            Check(f_close(&file), "f_close");
+        }
+    }
+
+    for (size_t i = 0; i < iterations; i++)
+    {
+        Check(f_open(&file, s_last, FA_READ), "f_open");
+        Check(f_close(&file), "f_close");
+    }
+}
+
+void Stat(size_t iterations)
+{
+    Check(RamDisk::Mount() ? FR_OK : FR_NOT_READY, "Mount");
+    FILINFO info;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        Check(f_stat("read.bin", &info), "f_stat");
+    }
+}
+
+const bool s_registered = [] {
+    Bench::IoCounter io = RamDisk::GetTransferredBytes;
+    Bench::Register("fatfs/append 512", 512, Append(512, false), io);
+    Bench::Register("fatfs/append 512 + sync", 512, Append(512, true), io);
+    Bench::Register("fatfs/append 4K", 4096, Append(4096, false), io);
+    Bench::Register("fatfs/append 32K", 32768, Append(32768, false), io);
+    Bench::Register("fatfs/read 512", 512, Read(512), io);
+    Bench::Register("fatfs/read 32K", 32768, Read(32768), io);
+    Bench::Register("fatfs/random read 512", 512, RandomRead, io);
+    Bench::Register("fatfs/open + close", 0, OpenClose, io);
+    Bench::Register("fatfs/stat", 0, Stat, io);
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,252 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    fileLogTest.cpp
+ * @brief   Checks the FileLogSink on a RamDisk, through power cuts.
+ *
+ * The sink is the firmware's, the volume a RamDisk formatted like an SDHC card (32 KiB clusters,
+ * so a buffer is a part of one). Each boot creates a sink, taps lines into it and runs it as the
+ * main loop does. A power cut deletes the sink without closing its file, and mounts the volume
+ * again: what FatFs didn't write yet is lost. Before it, another file is looked up, as another
+ * module would, which writes FatFs' pending FAT sector. The boots:
+ *  - Power cut before the first sync: the new LOG.TXT is empty, or not there.
+ *  - Power cut after a sync and more lines: LOG.TXT holds the lines up to the sync, and the
+ *    previous file was rotated to LOG1.TXT.
+ *  - 2.5 times MAX_FILE_SIZE of lines: the files rotate, LOG2.TXT, LOG1.TXT then LOG.TXT hold
+ *    every line, and LOG3.TXT the previous boot's.
+ * After each cut, the volume must hold no cluster outside of its files, as chkdsk counts them.
+ *
+ * Exits with 1 if a check failed.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "ramDisk.h"
+
+#include "Processes/services/fileLogSink.h"
+
+#include "NilaiTFO/services/filesystem.h"
+
+#include "ff.h"
+
+#include <cstdio>
+#include <string>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr const char* NAMES[FileLogSink::FILE_COUNT] = {
+  "LOG.TXT",
+  "LOG1.TXT",
+  "LOG2.TXT",
+  "LOG3.TXT",
+};
+
+bool     s_passed       = true;
+uint32_t s_tick         = 0;
+DWORD    s_rootClusters = 0;    //!< In use on the blank volume.
+
+void Expect(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FileLog: %s\n", what);
+        s_passed = false;
+    }
+}
+
+std::string Line(size_t boot, size_t index)
+{
+    char line[64];
+    int  len = std::snprintf(line, sizeof(line), "[%zu] line %zu of the log\n", boot, index);
+    return std::string(line, static_cast<size_t>(len));
+}
+
+/**
+ * @returns The whole file, empty if it doesn't exist.
+ */
+std::string ReadFile(const char* name)
+{
+    FIL file;
+    if (f_open(&file, name, FA_READ) != FR_OK)
+    {
+        return {};
+    }
+    std::string content(f_size(&file), '\0');
+    UINT        read = 0;
+    f_read(&file, content.data(), static_cast<UINT>(content.size()), &read);
+    f_close(&file);
+    content.resize(read);
+    return content;
+}
+
+/**
+ * @returns The clusters in use on the volume, counted in the FAT, not its FSINFO.
+ */
+DWORD UsedClusters()
+{
+    FATFS* fs   = nullptr;
+    DWORD  free = 0;
+    f_getfree("", &free, &fs);
+    fs->free_clst = 0xFFFFFFFF;
+    f_getfree("", &free, &fs);
+    return fs->n_fatent - 2 - free;
+}
+
+/**
+ * @returns The clusters in use that no file holds, lost chains.
+ */
+DWORD LostClusters()
+{
+    FATFS* fs   = nullptr;
+    DWORD  free = 0;
+    f_getfree("", &free, &fs);
+    FSIZE_t cluster = static_cast<FSIZE_t>(fs->csize) * FileLogSink::SECTOR_SIZE;
+
+    DWORD   files = 0;
+    DIR     dir;
+    FILINFO info;
+    f_opendir(&dir, "");
+    while (f_readdir(&dir, &info) == FR_OK && info.fname[0] != '\0')
+    {
+        files += static_cast<DWORD>((info.fsize + cluster - 1) / cluster);
+    }
+    f_closedir(&dir);
+    return UsedClusters() - s_rootClusters - files;
+}
+
+void PowerCut(FileLogSink*& sink)
+{
+    FILINFO info;
+    f_stat(NAMES[FileLogSink::FILE_COUNT - 1], &info);
+    delete sink;
+    sink = nullptr;
+    if (!RamDisk::Remount())
+    {
+        std::fprintf(stderr, "FileLog: unable to mount the volume again\n");
+        std::exit(1);
+    }
+}
+
+/**
+ * @brief Taps the lines from @p first to @p last, running the sink after each as the main loop
+ *        would.
+ * @returns The lines.
+ */
+std::string Log(FileLogSink& sink, size_t boot, size_t first, size_t last)
+{
+    std::string lines;
+    for (size_t i = first; i < last; i++)
+    {
+        std::string line = Line(boot, i);
+        FileLogSink::Tap(line.data(), line.size(), "", 0);
+        lines += line;
+        sink.Run();
+    }
+    return lines;
+}
+
+/**
+ * @brief Lets SYNC_PERIOD go by, for the partial buffer to be synced.
+ */
+void Sync(FileLogSink& sink)
+{
+    s_tick += FileLogSink::SYNC_PERIOD;
+    sink.Run();
+}
+
+/*****************************************************************************/
+/* Checks */
+void CheckCutBeforeSync()
+{
+    auto* sink = new FileLogSink("fileLog");
+    // Logged before the card is mounted, then by the first Run().
+    Log(*sink, 1, 0, 20);
+    Log(*sink, 1, 20, 40);
+    PowerCut(sink);
+
+    Expect(ReadFile(NAMES[0]).empty(), "lines that weren't synced are in LOG.TXT");
+    Expect(LostClusters() == 0, "clusters were lost, cut before the first sync");
+    std::printf("Cut before the first sync: %zu B in LOG.TXT\n", ReadFile(NAMES[0]).size());
+}
+
+std::string CheckCutAfterSync()
+{
+    auto*       sink   = new FileLogSink("fileLog");
+    std::string synced = Log(*sink, 2, 0, 1);
+    size_t      next   = 1;
+    // Up to a quarter into a buffer, the lines after the sync don't fill it.
+    while (synced.size() < sink->GetBufferSize() * 13 / 4)
+    {
+        synced += Log(*sink, 2, next, next + 1);
+        next++;
+    }
+    Sync(*sink);
+    Expect(sink->GetDroppedBytes() == 0, "lines were dropped");
+    Log(*sink, 2, next, next + 20);
+    PowerCut(sink);
+
+    std::string file = ReadFile(NAMES[0]);
+    Expect(file == synced, "LOG.TXT doesn't hold the lines up to the sync");
+    Expect(LostClusters() == 0, "clusters were lost, cut after a sync");
+    std::printf("Cut after a sync: %zu B in LOG.TXT\n", file.size());
+    return file;
+}
+
+void CheckRotation(const std::string& previous)
+{
+    auto*       sink  = new FileLogSink("fileLog");
+    std::string lines = Log(*sink, 3, 0, 1);
+    for (size_t i = 1; lines.size() < FileLogSink::MAX_FILE_SIZE * 5 / 2; i += 1000)
+    {
+        lines += Log(*sink, 3, i, i + 1000);
+    }
+    Sync(*sink);
+    Expect(sink->GetDroppedBytes() == 0, "lines were dropped");
+    PowerCut(sink);
+
+    std::string first  = ReadFile(NAMES[2]);
+    std::string second = ReadFile(NAMES[1]);
+    std::string third  = ReadFile(NAMES[0]);
+    Expect(first.size() == FileLogSink::MAX_FILE_SIZE && second.size() == first.size(),
+           "the rotated files aren't of MAX_FILE_SIZE");
+    Expect(first + second + third == lines, "LOG2.TXT, LOG1.TXT and LOG.TXT don't hold the lines");
+    Expect(ReadFile(NAMES[3]) == previous, "LOG3.TXT isn't the previous boot's");
+    Expect(LostClusters() == 0, "clusters were lost, with rotations");
+    std::printf("Rotation: %zu B, %zu B, %zu B\n", first.size(), second.size(), third.size());
+}
+}    // namespace
+
+extern "C" uint32_t HAL_GetTick()
+{
+    return s_tick;
+}
+
+bool cep::Filesystem::IsMounted()
+{
+    return true;
+}
+
+int main()
+{
+    if (!RamDisk::Mount())
+    {
+        return 1;
+    }
+    s_rootClusters = UsedClusters();
+
+    CheckCutBeforeSync();
+    std::string previous = CheckCutAfterSync();
+    CheckRotation(previous);
+
+    std::printf("%s\n", s_passed ? "passed" : "FAILED");
+    return s_passed ? 0 : 1;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,448 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    flacBench.cpp
+ * @brief   The Flac decoder, on frames of the FlacEncoder.
+ *
+ * An operation decodes a frame of 4096 samples of 16-bit stereo at 48 kHz, a period of the
+ * AudioEngine at a time, as it does. The kinds of frames are those of the usual compression
+ * levels: a fixed predictor (-0 to -2), LPC of order 8 (-5), of order 12 (-8, the most the
+ * subset allows at 48 kHz) and of order 32, the worst case. The frame lasts 85.3 ms: the ns/op
+ * must stay well under it, for the decoding to keep up on the target.
+ *
+ * Before timing anything, files covering every frame header, subframe, stereo decorrelation
+ * and residual coding are decoded, from memory, streamed through a buffer as the AudioEngine
+ * does, and with a corrupted frame. The samples must be those that were encoded: a mismatch
+ * stops hostBench.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+#include "flacEncoder.h"
+
+#include "Processes/services/flac.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+using Options = FlacEncoder::Options;
+using Stereo  = FlacEncoder::Stereo;
+using Type    = FlacEncoder::Type;
+
+constexpr size_t   PERIOD_FRAMES = 512;    //!< AudioEngine::PERIOD_FRAMES.
+constexpr size_t   BLOCK_SIZE    = 4096;
+constexpr size_t   BENCH_FRAMES  = 8;
+constexpr uint32_t SAMPLE_RATE   = 48000;
+constexpr size_t   STREAM_BUFFER = 16 * 1024;    //!< As the AudioEngine's.
+
+Flac::Decoder s_decoder;
+
+class XorShift32
+{
+public:
+    explicit XorShift32(uint32_t seed) : m_state(seed) {}
+
+    uint32_t operator()()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+void Fail(const char* what)
+{
+    std::fprintf(stderr, "Flac: %s\n", what);
+    std::exit(2);
+}
+
+/**
+ * @brief Music of sorts: two tones and some noise, at 60% of full scale.
+ */
+std::vector<int32_t> MakeSignal(size_t count, uint32_t bits, uint32_t seed, uint32_t wasted = 0)
+{
+    XorShift32           rng(seed);
+    std::vector<int32_t> out(count);
+    double               amplitude = 0.6 * double(1 << (bits - 1));
+    int32_t              noise     = bits > 8 ? 1 << (bits - 8) : 2;
+    for (size_t i = 0; i < count; i++)
+    {
+        double t     = double(i) / SAMPLE_RATE;
+        double value = 0.7 * std::sin(2 * M_PI * (110.0 + seed) * t + seed) +
+                       0.3 * std::sin(2 * M_PI * 1375.0 * t);
+        int32_t sample = static_cast<int32_t>(amplitude * value) +
+                         static_cast<int32_t>(rng() % noise) - noise / 2;
+        out[i] = static_cast<int32_t>(static_cast<uint32_t>(sample >> wasted) << wasted);
+    }
+    return out;
+}
+
+/**
+ * @brief A file and the 16-bit stereo it must decode to.
+ */
+struct Vector
+{
+    std::vector<uint8_t> file;
+    std::vector<int16_t> pcm;
+    std::vector<size_t>  frameEnds;    //!< In the file.
+    std::vector<size_t>  frameFrames;    //!< Where each starts in pcm, in frames.
+};
+
+class VectorBuilder
+{
+public:
+    VectorBuilder(size_t channels, uint32_t bits) : m_encoder(channels, bits, SAMPLE_RATE)
+    {
+        m_channels = channels;
+        m_bits     = bits;
+        m_encoder.AddMetadata(1, 300);    // PADDING
+        m_encoder.AddMetadata(2, 20);     // APPLICATION
+    }
+
+    void Add(const std::vector<int32_t>* samples, size_t count, const Options& options)
+    {
+        const int32_t* channels[2] = {samples[0].data(), samples[m_channels - 1].data()};
+        m_vector.frameFrames.push_back(m_vector.pcm.size() / 2);
+        m_size += m_encoder.AddFrame(channels, count, options);
+        m_vector.frameEnds.push_back(m_size);
+        for (size_t i = 0; i < count; i++)
+        {
+            for (size_t channel = 0; channel < 2; channel++)
+            {
+                int32_t sample = channels[channel][i];
+                m_vector.pcm.push_back(static_cast<int16_t>(
+                  m_bits >= 16 ? sample >> (m_bits - 16) : sample * (1 << (16 - m_bits))));
+            }
+        }
+    }
+
+    Vector Finish()
+    {
+        m_vector.file     = m_encoder.Finish();
+        size_t metadata   = m_vector.file.size() - m_size;
+        for (size_t& end : m_vector.frameEnds)
+        {
+            end += metadata;
+        }
+        return m_vector;
+    }
+
+private:
+    FlacEncoder m_encoder;
+    Vector      m_vector;
+    size_t      m_channels = 0;
+    uint32_t    m_bits     = 0;
+    size_t      m_size     = 0;
+};
+
+/**
+ * @brief Every stereo decorrelation with every kind of subframe, in blocks of every size code.
+ */
+Vector MakeStereoVector()
+{
+    VectorBuilder builder(2, 16);
+    const size_t  sizes[]  = {4096, 1000, 192, 576, 100, 2304, 1};
+    const Stereo  stereo[] = {Stereo::Independent, Stereo::LeftSide, Stereo::SideRight,
+                              Stereo::MidSide};
+    uint32_t      seed     = 1;
+    size_t        sizeIndex = 0;
+    for (Stereo mode : stereo)
+    {
+        for (Type type : {Type::Constant, Type::Verbatim, Type::Fixed, Type::Lpc})
+        {
+            for (size_t order : {0, 1, 2, 3, 4, 8, 12, 32})
+            {
+                if ((type == Type::Constant || type == Type::Verbatim) && order != 0)
+                {
+                    continue;
+                }
+                size_t  count = sizes[sizeIndex++ % std::size(sizes)];
+                Options options;
+                options.stereo         = mode;
+                options.type           = type;
+                options.order          = order;
+                options.partitionOrder = order % 5;
+                options.escape         = order == 3 || order == 12;
+                std::vector<int32_t> channels[2] = {MakeSignal(count, 16, seed++),
+                                                    MakeSignal(count, 16, seed++)};
+                if (type == Type::Constant)
+                {
+                    channels[0].assign(count, 1234);
+                    channels[1].assign(count, -77);
+                }
+                builder.Add(channels, count, options);
+            }
+        }
+    }
+
+    // Enough frames for their numbers to take more than a byte.
+    for (size_t i = 0; i < 160; i++)
+    {
+        Options              options;
+        std::vector<int32_t> channels[2] = {MakeSignal(192, 16, seed++),
+                                            MakeSignal(192, 16, seed++)};
+        builder.Add(channels, 192, options);
+    }
+    return builder.Finish();
+}
+
+/**
+ * @brief 24 bits with wasted bits, mono, and 8 and 12 bits in stereo, played as 16 bits.
+ */
+std::vector<Vector> MakeOtherVectors()
+{
+    std::vector<Vector> vectors;
+    uint32_t            seed = 100;
+
+    VectorBuilder mono(1, 24);
+    for (size_t order : {1, 4, 12, 32})
+    {
+        for (Type type : {Type::Fixed, Type::Lpc})
+        {
+            Options options;
+            options.type      = type;
+            options.order     = order;
+            options.precision = 15;
+            std::vector<int32_t> channel[1] = {MakeSignal(BLOCK_SIZE, 24, seed++, 3)};
+            mono.Add(channel, BLOCK_SIZE, options);
+        }
+    }
+    vectors.push_back(mono.Finish());
+
+    for (uint32_t bits : {8, 12})
+    {
+        VectorBuilder stereo(2, bits);
+        for (Stereo mode : {Stereo::LeftSide, Stereo::MidSide})
+        {
+            Options options;
+            options.stereo = mode;
+            options.type   = Type::Lpc;
+            options.order  = 6;
+            std::vector<int32_t> channels[2] = {MakeSignal(1152, bits, seed++),
+                                                MakeSignal(1152, bits, seed++)};
+            stereo.Add(channels, 1152, options);
+        }
+        vectors.push_back(stereo.Finish());
+    }
+    return vectors;
+}
+
+/**
+ * @brief Decodes the file from memory, in reads of random sizes.
+ */
+std::vector<int16_t> DecodeInMemory(const std::vector<uint8_t>& file)
+{
+    XorShift32           rng(42);
+    std::vector<int16_t> out;
+    int16_t              buffer[700 * 2];
+    if (!s_decoder.Open(file.data(), file.size()))
+    {
+        Fail("Open");
+    }
+    size_t read = 0;
+    while ((read = s_decoder.Read(buffer, 1 + rng() % 700)) != 0)
+    {
+        out.insert(out.end(), buffer, buffer + read * 2);
+    }
+    return out;
+}
+
+/**
+ * @brief Decodes the file through a buffer, as the AudioEngine streams it from the SD card.
+ */
+std::vector<int16_t> DecodeStreamed(const std::vector<uint8_t>& file)
+{
+    Flac::StreamInfo info;
+    if (!Flac::ParseStreamInfo(file.data(), file.size(), info))
+    {
+        Fail("ParseStreamInfo");
+    }
+    size_t next   = Flac::MARKER_SIZE;
+    bool   isLast = false;
+    while (!isLast)
+    {
+        next += Flac::GetMetadataSize(&file[next], isLast);
+    }
+
+    static uint8_t       s_buffer[STREAM_BUFFER];
+    size_t               filled = 0;
+    std::vector<int16_t> out;
+    int16_t              period[PERIOD_FRAMES * 2];
+    s_decoder.OpenFrames(s_buffer, 0, info);
+    while (true)
+    {
+        size_t read = s_decoder.Read(period, PERIOD_FRAMES);
+        if (read != 0)
+        {
+            out.insert(out.end(), period, period + read * 2);
+            continue;
+        }
+        size_t consumed = s_decoder.GetConsumed();
+        std::memmove(s_buffer, &s_buffer[consumed], filled - consumed);
+        filled -= consumed;
+        size_t size = std::min(sizeof(s_buffer) - filled, file.size() - next);
+        if (size == 0)
+        {
+            return out;
+        }
+        std::memcpy(&s_buffer[filled], &file[next], size);
+        filled += size;
+        next += size;
+        s_decoder.OpenFrames(s_buffer, filled, info);
+    }
+}
+
+void Verify()
+{
+    static bool s_verified = false;
+    if (s_verified)
+    {
+        return;
+    }
+
+    std::vector<Vector> vectors = MakeOtherVectors();
+    vectors.insert(vectors.begin(), MakeStereoVector());
+    for (const Vector& vector : vectors)
+    {
+        if (DecodeInMemory(vector.file) != vector.pcm)
+        {
+            Fail("the samples decoded from memory aren't those encoded");
+        }
+        if (s_decoder.GetFrameCount() != vector.pcm.size() / 2 || s_decoder.GetSkippedFrames() != 0)
+        {
+            Fail("wrong frame count, or frames were skipped");
+        }
+        if (DecodeStreamed(vector.file) != vector.pcm)
+        {
+            Fail("the samples decoded through a buffer aren't those encoded");
+        }
+    }
+
+    // A corrupted frame is skipped, the others are still decoded.
+    const Vector&        vector  = vectors[0];
+    size_t               frame   = vector.frameEnds.size() / 2;
+    std::vector<uint8_t> file    = vector.file;
+    file[vector.frameEnds[frame] - 5] ^= 0x10;
+    std::vector<int16_t> expected = vector.pcm;
+    size_t               end = frame + 1 < vector.frameFrames.size() ? vector.frameFrames[frame + 1]
+                                                                      : vector.pcm.size() / 2;
+    expected.erase(expected.begin() + vector.frameFrames[frame] * 2, expected.begin() + end * 2);
+    if (DecodeInMemory(file) != expected || s_decoder.GetSkippedFrames() == 0)
+    {
+        Fail("a corrupted frame wasn't skipped");
+    }
+
+    // The file the AudioEngine streams on the target to time the decoder, with 3 frames.
+    static uint8_t   s_frame[STREAM_BUFFER];
+    Flac::StreamInfo info;
+    size_t           size = Flac::WriteBenchFrame(s_frame, sizeof(s_frame), info);
+    info.totalSamples     = 3 * BLOCK_SIZE;
+    std::vector<uint8_t> bench(Flac::STREAMINFO_END);
+    if (size == 0 || Flac::WriteStreamInfo(bench.data(), bench.size(), info) == 0)
+    {
+        Fail("the bench file can't be written");
+    }
+    for (size_t i = 0; i < 3; i++)
+    {
+        bench.insert(bench.end(), s_frame, s_frame + size);
+    }
+    std::vector<int16_t> pcm = DecodeInMemory(bench);
+    if (pcm.size() != 3 * BLOCK_SIZE * 2 || s_decoder.GetFrameCount() != 3 * BLOCK_SIZE ||
+        DecodeStreamed(bench) != pcm)
+    {
+        Fail("the bench file doesn't decode");
+    }
+    s_verified = true;
+}
+
+/**
+ * @brief Encodes BENCH_FRAMES frames of 16-bit stereo, coded as told.
+ */
+std::vector<uint8_t> MakeBenchFile(const Options& options)
+{
+    FlacEncoder encoder(2, 16, SAMPLE_RATE);
+    for (size_t frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        std::vector<int32_t> left     = MakeSignal(BLOCK_SIZE, 16, 2 * frame + 7);
+        std::vector<int32_t> right    = MakeSignal(BLOCK_SIZE, 16, 2 * frame + 8);
+        const int32_t*       stereo[] = {left.data(), right.data()};
+        encoder.AddFrame(stereo, BLOCK_SIZE, options);
+    }
+    return encoder.Finish();
+}
+
+void DecodeFrames(const std::vector<uint8_t>& file, size_t iterations)
+{
+    static int16_t s_period[PERIOD_FRAMES * 2];
+    Verify();
+    if (!s_decoder.Open(file.data(), file.size()))
+    {
+        Fail("Open");
+    }
+    for (size_t i = 0; i < iterations; i++)
+    {
+        for (size_t frames = 0; frames < BLOCK_SIZE;)
+        {
+            size_t read = s_decoder.Read(s_period, PERIOD_FRAMES);
+            if (read == 0)
+            {
+                s_decoder.Rewind();
+                continue;
+            }
+            frames += read;
+        }
+        Bench::DoNotOptimize(s_period);
+    }
+}
+
+struct BenchCase
+{
+    const char* name;
+    Type        type;
+    size_t      order;
+};
+
+const BenchCase CASES[] = {
+  {"flac/frame fixed", Type::Fixed, 2},
+  {"flac/frame lpc 8", Type::Lpc, 8},
+  {"flac/frame lpc 12", Type::Lpc, 12},
+  {"flac/frame lpc 32", Type::Lpc, 32},
+};
+
+const bool s_registered = [] {
+    for (const BenchCase& benchCase : CASES)
+    {
+        Options options;
+        options.stereo = Stereo::MidSide;
+        options.type   = benchCase.type;
+        options.order  = benchCase.order;
+        auto file      = std::make_shared<std::vector<uint8_t>>(MakeBenchFile(options));
+        Bench::Register(benchCase.name, file->size() / BENCH_FRAMES, [file](size_t iterations) {
+            DecodeFrames(*file, iterations);
+        });
+    }
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
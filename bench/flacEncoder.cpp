@@ -0,0 +1,568 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    flacEncoder.cpp
+ * @brief   Source of the FlacEncoder.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "flacEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t   MAX_LPC_ORDER   = 32;
+constexpr uint32_t MAX_PRECISION   = 15;
+constexpr uint32_t MAX_SHIFT       = 15;
+constexpr size_t   STREAMINFO_SIZE = 34;
+
+/**
+ * @brief Writes from the most significant bit, one at a time: slow but plain.
+ */
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void Write(uint64_t value, uint32_t bits)
+    {
+        for (uint32_t i = bits; i-- > 0;)
+        {
+            WriteBit((value >> i) & 1);
+        }
+    }
+
+    void WriteSigned(int64_t value, uint32_t bits) { Write(static_cast<uint64_t>(value), bits); }
+
+    void WriteUnary(uint64_t zeros)
+    {
+        for (uint64_t i = 0; i < zeros; i++)
+        {
+            WriteBit(0);
+        }
+        WriteBit(1);
+    }
+
+    void WriteRice(int64_t value, uint32_t parameter)
+    {
+        uint64_t folded = value >= 0 ? uint64_t(value) * 2 : uint64_t(-value) * 2 - 1;
+        WriteUnary(folded >> parameter);
+        Write(folded, parameter);
+    }
+
+    void Align()
+    {
+        while (m_bit != 0)
+        {
+            WriteBit(0);
+        }
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint32_t              m_bit = 0;    //!< In the last byte.
+
+private:
+    void WriteBit(uint64_t bit)
+    {
+        if (m_bit == 0)
+        {
+            m_out.push_back(0);
+        }
+        if (bit != 0)
+        {
+            m_out.back() |= 0x80 >> m_bit;
+        }
+        m_bit = (m_bit + 1) % 8;
+    }
+};
+
+uint8_t Crc8(const uint8_t* data, size_t size)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (size_t bit = 0; bit < 8; bit++)
+        {
+            crc = ((crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1) & 0xFF;
+        }
+    }
+    return static_cast<uint8_t>(crc);
+}
+
+uint16_t Crc16(const uint8_t* data, size_t size)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i] << 8;
+        for (size_t bit = 0; bit < 8; bit++)
+        {
+            crc = ((crc & 0x8000) != 0 ? (crc << 1) ^ 0x8005 : crc << 1) & 0xFFFF;
+        }
+    }
+    return static_cast<uint16_t>(crc);
+}
+
+void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FlacEncoder: %s\n", what);
+        std::exit(2);
+    }
+}
+
+/**
+ * @returns The bits a signed two's complement needs for every value of @p values.
+ */
+uint32_t SignedWidth(const int64_t* values, size_t count)
+{
+    uint32_t width = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        while (values[i] < -(int64_t(1) << width) / 2 || values[i] >= (int64_t(1) << width) / 2)
+        {
+            width++;
+        }
+    }
+    return width;
+}
+
+void WriteResidual(BitWriter&                  out,
+                   const std::vector<int64_t>& residual,
+                   size_t                      order,
+                   const FlacEncoder::Options& options)
+{
+    size_t   count          = residual.size();
+    uint32_t partitionOrder = options.partitionOrder;
+    while (partitionOrder > 0 &&
+           (count % (size_t(1) << partitionOrder) != 0 || (count >> partitionOrder) < order))
+    {
+        partitionOrder--;
+    }
+    size_t partitions = size_t(1) << partitionOrder;
+    size_t size       = count >> partitionOrder;
+
+    // The parameter that suits the mean of each partition.
+    std::vector<uint32_t> parameters(partitions);
+    bool                  needsMethod1 = false;
+    for (size_t partition = 0; partition < partitions; partition++)
+    {
+        size_t   start = partition == 0 ? order : partition * size;
+        uint64_t sum   = 0;
+        for (size_t i = start; i < (partition + 1) * size; i++)
+        {
+            sum += residual[i] >= 0 ? uint64_t(residual[i]) * 2 : uint64_t(-residual[i]) * 2 - 1;
+        }
+        uint64_t mean = (partition + 1) * size > start ? sum / ((partition + 1) * size - start) : 0;
+        uint32_t k    = 0;
+        while (k < 29 && (uint64_t(1) << (k + 1)) <= mean)
+        {
+            k++;
+        }
+        parameters[partition] = k;
+        needsMethod1          = needsMethod1 || k >= 15;
+    }
+
+    uint32_t method        = needsMethod1 ? 1 : 0;
+    uint32_t parameterBits = method == 0 ? 4 : 5;
+    uint32_t escape        = (1U << parameterBits) - 1;
+    out.Write(method, 2);
+    out.Write(partitionOrder, 4);
+    for (size_t partition = 0; partition < partitions; partition++)
+    {
+        size_t start = partition == 0 ? order : partition * size;
+        size_t end   = (partition + 1) * size;
+        if (options.escape && partition == std::min<size_t>(1, partitions - 1))
+        {
+            uint32_t width = SignedWidth(&residual[start], end - start);
+            Check(width < 32, "residual too wide for an escaped partition");
+            out.Write(escape, parameterBits);
+            out.Write(width, 5);
+            for (size_t i = start; i < end; i++)
+            {
+                out.WriteSigned(residual[i], width);
+            }
+            continue;
+        }
+        out.Write(parameters[partition], parameterBits);
+        for (size_t i = start; i < end; i++)
+        {
+            out.WriteRice(residual[i], parameters[partition]);
+        }
+    }
+}
+
+/**
+ * @brief The coefficients that predict x[i] from x[i - 1 - j], by Levinson-Durbin.
+ */
+std::vector<double> ComputeLpc(const std::vector<int64_t>& x, size_t order)
+{
+    std::vector<double> autocorrelation(order + 1, 0.0);
+    for (size_t lag = 0; lag <= order; lag++)
+    {
+        for (size_t i = lag; i < x.size(); i++)
+        {
+            autocorrelation[lag] += double(x[i]) * double(x[i - lag]);
+        }
+    }
+
+    std::vector<double> lpc(order, 0.0);
+    double              error = autocorrelation[0];
+    for (size_t i = 0; i < order && error > 0.0; i++)
+    {
+        double reflection = -autocorrelation[i + 1];
+        for (size_t j = 0; j < i; j++)
+        {
+            reflection -= lpc[j] * autocorrelation[i - j];
+        }
+        reflection /= error;
+
+        std::vector<double> previous = lpc;
+        lpc[i]                       = reflection;
+        for (size_t j = 0; j < i; j++)
+        {
+            lpc[j] = previous[j] + reflection * previous[i - 1 - j];
+        }
+        error *= 1.0 - reflection * reflection;
+    }
+    // The recursion predicts -x[i], FLAC x[i].
+    for (double& coefficient : lpc)
+    {
+        coefficient = -coefficient;
+    }
+    return lpc;
+}
+
+void WriteSubframe(BitWriter&                  out,
+                   const int32_t*              samples,
+                   size_t                      count,
+                   uint32_t                    bits,
+                   const FlacEncoder::Options& options)
+{
+    std::vector<int64_t> x(samples, samples + count);
+
+    uint32_t wasted = 0;
+    if (options.wastedBits)
+    {
+        int64_t any = 0;
+        for (int64_t sample : x)
+        {
+            any |= sample;
+        }
+        while (any != 0 && (any & (int64_t(1) << wasted)) == 0 && wasted + 1 < bits)
+        {
+            wasted++;
+        }
+        for (int64_t& sample : x)
+        {
+            sample >>= wasted;
+        }
+        bits -= wasted;
+    }
+
+    FlacEncoder::Type type = options.type;
+    if (type == FlacEncoder::Type::Constant &&
+        std::any_of(x.begin(), x.end(), [&](int64_t sample) { return sample != x[0]; }))
+    {
+        type = FlacEncoder::Type::Verbatim;
+    }
+    size_t order = 0;
+    if (type == FlacEncoder::Type::Fixed)
+    {
+        order = std::min<size_t>({options.order, 4, count});
+    }
+    else if (type == FlacEncoder::Type::Lpc)
+    {
+        order = std::clamp<size_t>(std::min(options.order, count), 1, MAX_LPC_ORDER);
+        if (order > count)
+        {
+            type  = FlacEncoder::Type::Verbatim;
+            order = 0;
+        }
+    }
+
+    uint32_t code = 0;
+    switch (type)
+    {
+        case FlacEncoder::Type::Constant: code = 0; break;
+        case FlacEncoder::Type::Verbatim: code = 1; break;
+        case FlacEncoder::Type::Fixed: code = 8 + static_cast<uint32_t>(order); break;
+        case FlacEncoder::Type::Lpc: code = 31 + static_cast<uint32_t>(order); break;
+    }
+    out.Write(0, 1);
+    out.Write(code, 6);
+    out.Write(wasted != 0 ? 1 : 0, 1);
+    if (wasted != 0)
+    {
+        out.WriteUnary(wasted - 1);
+    }
+
+    if (type == FlacEncoder::Type::Constant)
+    {
+        out.WriteSigned(x[0], bits);
+        return;
+    }
+    size_t warmup = type == FlacEncoder::Type::Verbatim ? count : order;
+    for (size_t i = 0; i < warmup; i++)
+    {
+        out.WriteSigned(x[i], bits);
+    }
+    if (type == FlacEncoder::Type::Verbatim)
+    {
+        return;
+    }
+
+    std::vector<int64_t> residual(count, 0);
+    if (type == FlacEncoder::Type::Fixed)
+    {
+        for (size_t i = order; i < count; i++)
+        {
+            switch (order)
+            {
+                case 0: residual[i] = x[i]; break;
+                case 1: residual[i] = x[i] - x[i - 1]; break;
+                case 2: residual[i] = x[i] - 2 * x[i - 1] + x[i - 2]; break;
+                case 3: residual[i] = x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3]; break;
+                default:
+                    residual[i] = x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4];
+                    break;
+            }
+        }
+    }
+    else
+    {
+        std::vector<double> lpc       = ComputeLpc(x, order);
+        uint32_t            precision = std::min(options.precision, MAX_PRECISION);
+        double              largest   = 0.0;
+        for (double coefficient : lpc)
+        {
+            largest = std::max(largest, std::fabs(coefficient));
+        }
+        int exponent = 0;
+        std::frexp(largest, &exponent);
+        int32_t shift =
+          largest > 0.0 ? std::clamp<int32_t>(precision - 1 - exponent, 0, MAX_SHIFT) : 0;
+        int64_t limit = (int64_t(1) << (precision - 1)) - 1;
+
+        std::vector<int64_t> quantized(order);
+        for (size_t j = 0; j < order; j++)
+        {
+            int64_t coefficient = std::lround(std::ldexp(lpc[j], shift));
+            quantized[j]        = std::clamp<int64_t>(coefficient, -limit, limit);
+        }
+        out.Write(precision - 1, 4);
+        out.WriteSigned(shift, 5);
+        for (int64_t coefficient : quantized)
+        {
+            out.WriteSigned(coefficient, precision);
+        }
+        for (size_t i = order; i < count; i++)
+        {
+            int64_t sum = 0;
+            for (size_t j = 0; j < order; j++)
+            {
+                sum += quantized[j] * x[i - 1 - j];
+            }
+            residual[i] = x[i] - (sum >> shift);
+        }
+    }
+
+    for (size_t i = order; i < count; i++)
+    {
+        Check(residual[i] >= INT32_MIN && residual[i] <= INT32_MAX, "residual out of 32 bits");
+    }
+    WriteResidual(out, residual, order, options);
+}
+
+uint32_t GetBlockCode(size_t count)
+{
+    if (count == 192)
+    {
+        return 1;
+    }
+    for (uint32_t shift = 0; shift < 4; shift++)
+    {
+        if (count == size_t(576) << shift)
+        {
+            return 2 + shift;
+        }
+    }
+    for (uint32_t shift = 0; shift < 8; shift++)
+    {
+        if (count == size_t(256) << shift)
+        {
+            return 8 + shift;
+        }
+    }
+    return count <= 256 ? 6 : 7;
+}
+
+uint32_t GetBitsCode(uint32_t bits)
+{
+    switch (bits)
+    {
+        case 8: return 1;
+        case 12: return 2;
+        case 16: return 4;
+        case 20: return 5;
+        case 24: return 6;
+        default: return 0;
+    }
+}
+
+void WriteUtf8(BitWriter& out, uint32_t number)
+{
+    if (number < 0x80)
+    {
+        out.Write(number, 8);
+        return;
+    }
+    // The first byte has as many leading ones as bytes, then 6 bits per byte that follows.
+    uint32_t following = 1;
+    while (number >= (1U << (5 * following + 6)))
+    {
+        following++;
+    }
+    out.Write(((0xFF00 >> (following + 1)) & 0xFF) | (number >> (6 * following)), 8);
+    for (uint32_t i = following; i-- > 0;)
+    {
+        out.Write(0x80 | ((number >> (6 * i)) & 0x3F), 8);
+    }
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+FlacEncoder::FlacEncoder(size_t channels, uint32_t bitsPerSample, uint32_t sampleRate)
+: m_channels(channels), m_bitsPerSample(bitsPerSample), m_sampleRate(sampleRate)
+{
+}
+
+void FlacEncoder::AddMetadata(uint8_t type, size_t size)
+{
+    m_lastMetadata = m_metadata.size();
+    BitWriter out(m_metadata);
+    out.Write(type, 8);
+    out.Write(size, 24);
+    // Full of sync codes, for a decoder that would look for frames in there.
+    m_metadata.insert(m_metadata.end(), size, 0xFF);
+}
+
+size_t FlacEncoder::AddFrame(const int32_t* const* samples, size_t count, const Options& options)
+{
+    size_t    start = m_frames.size();
+    BitWriter out(m_frames);
+
+    Stereo   stereo      = m_channels == 2 ? options.stereo : Stereo::Independent;
+    uint32_t channelCode = static_cast<uint32_t>(m_channels - 1);
+    switch (stereo)
+    {
+        case Stereo::LeftSide: channelCode = 8; break;
+        case Stereo::SideRight: channelCode = 9; break;
+        case Stereo::MidSide: channelCode = 10; break;
+        default: break;
+    }
+    uint32_t blockCode = GetBlockCode(count);
+    out.Write(0xFFF8, 16);
+    out.Write(blockCode, 4);
+    out.Write(m_sampleRate == 48000 ? 10 : 0, 4);
+    out.Write(channelCode, 4);
+    out.Write(GetBitsCode(m_bitsPerSample), 3);
+    out.Write(0, 1);
+    WriteUtf8(out, m_frameNumber++);
+    if (blockCode == 6)
+    {
+        out.Write(count - 1, 8);
+    }
+    else if (blockCode == 7)
+    {
+        out.Write(count - 1, 16);
+    }
+    out.Write(Crc8(&m_frames[start], m_frames.size() - start), 8);
+
+    std::vector<int32_t> channels[2];
+    uint32_t             bits[2] = {m_bitsPerSample, m_bitsPerSample};
+    for (size_t channel = 0; channel < m_channels; channel++)
+    {
+        channels[channel].assign(samples[channel], samples[channel] + count);
+    }
+    if (stereo != Stereo::Independent)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            int32_t left  = samples[0][i];
+            int32_t right = samples[1][i];
+            int32_t side  = left - right;
+            switch (stereo)
+            {
+                case Stereo::LeftSide: channels[1][i] = side; break;
+                case Stereo::SideRight: channels[0][i] = side; break;
+                default:
+                    channels[0][i] = (left + right) >> 1;
+                    channels[1][i] = side;
+                    break;
+            }
+        }
+        bits[stereo == Stereo::SideRight ? 0 : 1]++;
+    }
+    for (size_t channel = 0; channel < m_channels; channel++)
+    {
+        WriteSubframe(out, channels[channel].data(), count, bits[channel], options);
+    }
+    out.Align();
+    out.Write(Crc16(&m_frames[start], m_frames.size() - start), 16);
+
+    size_t size = m_frames.size() - start;
+    m_totalSamples += count;
+    m_minBlockSize = std::min<uint32_t>(m_minBlockSize, count);
+    m_maxBlockSize = std::max<uint32_t>(m_maxBlockSize, count);
+    m_minFrameSize = std::min<uint32_t>(m_minFrameSize, size);
+    m_maxFrameSize = std::max<uint32_t>(m_maxFrameSize, size);
+    return size;
+}
+
+std::vector<uint8_t> FlacEncoder::Finish() const
+{
+    std::vector<uint8_t> file = {'f', 'L', 'a', 'C'};
+    BitWriter            out(file);
+    out.Write(m_metadata.empty() ? 1 : 0, 1);
+    out.Write(0, 7);
+    out.Write(STREAMINFO_SIZE, 24);
+    out.Write(m_minBlockSize, 16);
+    out.Write(m_maxBlockSize, 16);
+    out.Write(m_minFrameSize, 24);
+    out.Write(m_maxFrameSize, 24);
+    out.Write(m_sampleRate, 20);
+    out.Write(m_channels - 1, 3);
+    out.Write(m_bitsPerSample - 1, 5);
+    out.Write(m_totalSamples, 36);
+    out.Write(0, 64);    // The MD5, not checked.
+    out.Write(0, 64);
+
+    size_t metadata = file.size();
+    file.insert(file.end(), m_metadata.begin(), m_metadata.end());
+    if (!m_metadata.empty())
+    {
+        file[metadata + m_lastMetadata] |= 0x80;
+    }
+    file.insert(file.end(), m_frames.begin(), m_frames.end());
+    return file;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
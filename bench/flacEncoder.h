@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    flacEncoder.h
+ * @brief   FLAC encoder for the host benchmarks, written from RFC 9639 to test Flac::Decoder.
+ *
+ * Not meant to compress well: every frame is coded the way it's told, so that the tests reach
+ * every kind of subframe, stereo decorrelation, residual coding and frame header the decoder
+ * must handle. The LPC coefficients come from the Levinson-Durbin recursion, as in the
+ * reference encoder, so that its residuals are those of real files.
+ *
+ * FLAC being lossless, the decoder must give back the samples given to the encoder, exactly.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_FLACENCODER_H
+#    define NILAIINI_BENCH_FLACENCODER_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstddef>
+#    include <cstdint>
+#    include <vector>
+
+/*****************************************************************************/
+/* Exported types */
+class FlacEncoder
+{
+public:
+    enum class Stereo : uint8_t
+    {
+        Independent,
+        LeftSide,
+        SideRight,
+        MidSide,
+    };
+
+    enum class Type : uint8_t
+    {
+        Constant,    //!< Verbatim if the samples aren't all the same.
+        Verbatim,
+        Fixed,
+        Lpc,
+    };
+
+    struct Options
+    {
+        Stereo   stereo         = Stereo::Independent;
+        Type     type           = Type::Fixed;
+        size_t   order          = 2;
+        uint32_t precision      = 14;    //!< Of the LPC coefficients.
+        uint32_t partitionOrder = 4;     //!< Lowered until it fits the block.
+        bool     escape         = false;    //!< Writes the second partition unencoded.
+        bool     wastedBits     = true;     //!< Codes the zeros common to every sample.
+    };
+
+    FlacEncoder(size_t channels, uint32_t bitsPerSample, uint32_t sampleRate);
+
+    /**
+     * @brief Adds a metadata block after the STREAMINFO, for the decoder to skip.
+     */
+    void AddMetadata(uint8_t type, size_t size);
+
+    /**
+     * @param samples Of each channel, @p count each.
+     * @returns The size of the frame.
+     */
+    size_t AddFrame(const int32_t* const* samples, size_t count, const Options& options);
+
+    /**
+     * @returns The file: "fLaC", the metadata, then the frames.
+     */
+    std::vector<uint8_t> Finish() const;
+
+private:
+    size_t               m_channels;
+    uint32_t             m_bitsPerSample;
+    uint32_t             m_sampleRate;
+    std::vector<uint8_t> m_metadata;
+    size_t               m_lastMetadata = 0;    //!< Offset of its header in m_metadata.
+    std::vector<uint8_t> m_frames;
+    uint32_t             m_frameNumber  = 0;
+    uint64_t             m_totalSamples = 0;
+    uint32_t             m_minBlockSize = UINT16_MAX;
+    uint32_t             m_maxBlockSize = 0;
+    uint32_t             m_minFrameSize = UINT32_MAX;
+    uint32_t             m_maxFrameSize = 0;
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_FLACENCODER_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
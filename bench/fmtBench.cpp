@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    fmtBench.cpp
+ * @brief   Compares the format engine (Processes/services/format.h) with snprintf.
+ *
+ * Each case formats the same line with both, checks that the outputs match and prints the
+ * time per call. Absolute numbers are the host's, the ratio is what matters.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "Processes/services/format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t ITERATIONS = 1000000;
+
+// Keeps the compiler from optimizing the formatting away.
+volatile size_t g_sink = 0;
+
+template<typename Func>
+double NsPerCall(Func&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ITERATIONS; i++)
+    {
+        g_sink = g_sink + func(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+template<typename Printf, typename Fmt>
+bool Compare(const char* name, Printf&& printfCase, Fmt&& fmtCase)
+{
+    char expected[128];
+    char actual[128];
+    printfCase(expected, sizeof(expected), 0);
+    fmtCase(actual, sizeof(actual), 0);
+    bool same = std::strcmp(expected, actual) == 0;
+
+    double printfNs = NsPerCall([&](size_t i) { return printfCase(expected, sizeof(expected), i); });
+    double fmtNs    = NsPerCall([&](size_t i) { return fmtCase(actual, sizeof(actual), i); });
+
+    std::printf("%-10s snprintf %8.1f ns   Fmt %8.1f ns   x%5.2f   %s\n",
+                name,
+                printfNs,
+                fmtNs,
+                printfNs / fmtNs,
+                same ? "" : "OUTPUT MISMATCH");
+    if (!same)
+    {
+        std::printf("    snprintf: '%s'\n    Fmt:      '%s'\n", expected, actual);
+    }
+    return same;
+}
+}    // namespace
+
+int main()
+{
+    bool ok = true;
+
+    ok &= Compare(
+      "integers",
+      [](char* buf, size_t size, size_t i) {
+          return static_cast<size_t>(
+            std::snprintf(buf, size, "[%lu] [DEBUG]: i1: %d", static_cast<unsigned long>(i), -42));
+      },
+      [](char* buf, size_t size, size_t i) {
+          return Fmt::FormatTo(buf, size, FMT_STRING("[{}] [DEBUG]: i1: {}"), i, -42);
+      });
+
+    ok &= Compare(
+      "float",
+      [](char* buf, size_t size, size_t i) {
+          return static_cast<size_t>(std::snprintf(
+            buf, size, "POST OK! %0.3f seconds.", static_cast<double>(i % 5000) / 1000.0));
+      },
+      [](char* buf, size_t size, size_t i) {
+          return Fmt::FormatTo(
+            buf, size, FMT_STRING("POST OK! {:.3} seconds."), static_cast<float>(i % 5000) / 1000.0f);
+      });
+
+    ok &= Compare(
+      "strings",
+      [](char* buf, size_t size, size_t) {
+          return static_cast<size_t>(
+            std::snprintf(buf, size, "Has %s - %s: %s", "section 1", "s1", "true"));
+      },
+      [](char* buf, size_t size, size_t) {
+          return Fmt::FormatTo(
+            buf, size, FMT_STRING("Has {} - {}: {}"), "section 1", "s1", "true");
+      });
+
+    ok &= Compare(
+      "hex",
+      [](char* buf, size_t size, size_t i) {
+          return static_cast<size_t>(
+            std::snprintf(buf, size, "reg 0x%08x = %5u", static_cast<unsigned>(i), 1234u));
+      },
+      [](char* buf, size_t size, size_t i) {
+          return Fmt::FormatTo(
+            buf, size, FMT_STRING("reg 0x{:08x} = {:5}"), static_cast<uint32_t>(i), 1234u);
+      });
+
+    return ok ? 0 : 1;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
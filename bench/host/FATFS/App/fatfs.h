@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    fatfs.h
+ * @brief   Stands in for CubeMX's fatfs.h in the host builds, without the SD card's driver.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_FATFS_H
+#    define NILAIINI_BENCH_HOST_FATFS_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "ff.h"
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_FATFS_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
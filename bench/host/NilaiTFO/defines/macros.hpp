@@ -0,0 +1,37 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    macros.hpp
+ * @brief   Stands in for NilaiTFO's macros in the host builds.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_MACROS_HPP
+#    define NILAIINI_BENCH_HOST_MACROS_HPP
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstdio>
+#    include <cstdlib>
+
+/*****************************************************************************/
+/* Exported macro */
+#    define CEP_ASSERT(condition, msg)                                                         \
+        do                                                                                     \
+        {                                                                                      \
+            if (!(condition))                                                                  \
+            {                                                                                  \
+                std::fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, msg);                  \
+                std::abort();                                                                  \
+            }                                                                                  \
+        } while (0)
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_MACROS_HPP */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,39 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    module.hpp
+ * @brief   Stands in for NilaiTFO's cep::Module in the host builds.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_MODULE_HPP
+#    define NILAIINI_BENCH_HOST_MODULE_HPP
+
+/*****************************************************************************/
+/* Includes */
+#    include <string>
+
+/*****************************************************************************/
+/* Exported types */
+namespace cep
+{
+class Module
+{
+public:
+    virtual ~Module() = default;
+
+    virtual bool                             DoPost()         = 0;
+    virtual void                             Run()            = 0;
+    [[nodiscard]] virtual const std::string& GetLabel() const = 0;
+};
+}    // namespace cep
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_MODULE_HPP */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,29 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    filesystem.h
+ * @brief   Stands in for NilaiTFO's cep::Filesystem in the host builds.
+ *
+ * The host programs mount their volume themselves, see ramDisk.h, and define IsMounted().
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_FILESYSTEM_H
+#    define NILAIINI_BENCH_HOST_FILESYSTEM_H
+
+/*****************************************************************************/
+/* Exported functions */
+namespace cep::Filesystem
+{
+bool IsMounted();
+}    // namespace cep::Filesystem
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_FILESYSTEM_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,22 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    logger.hpp
+ * @brief   Stands in for NilaiTFO's logger in the host builds.
+ *
+ * Processes/services/log.h replaces its macros anyway, they go through UartTxDma.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_LOGGER_HPP
+#    define NILAIINI_BENCH_HOST_LOGGER_HPP
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_LOGGER_HPP */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,40 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    ffInteger.h
+ * @brief   FatFs' integer types, with their required widths on a 64-bit host.
+ *
+ * FatFs' own integer.h makes DWORD an unsigned long, 64 bits wide on Linux. This one is forced
+ * in front of every source (-include) and takes its include guard, ff.h includes integer.h from
+ * its own directory, where the include path can't override it.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef _FF_INTEGER
+#    define _FF_INTEGER
+
+/*****************************************************************************/
+/* Includes */
+#    include <stdint.h>
+
+/*****************************************************************************/
+/* Exported types */
+typedef int32_t  INT;
+typedef uint32_t UINT;
+typedef uint8_t  BYTE;
+typedef int16_t  SHORT;
+typedef uint16_t WORD;
+typedef uint16_t WCHAR;
+typedef int32_t  LONG;
+typedef uint32_t DWORD;
+typedef uint64_t QWORD;
+
+/* Have a wonderful day :) */
+#endif /* _FF_INTEGER */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    main.h
+ * @brief   Stands in for Core/Inc/main.h in the host builds, FatFs' ffconf.h includes it.
+ *
+ * Only holds the configuration the portable code built on the host depends on.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_MAIN_H
+#    define NILAIINI_BENCH_HOST_MAIN_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <stdint.h>
+
+/*****************************************************************************/
+/* Private defines */
+#    define APP_USE_RTOS 0    // FatFs is used from a single thread.
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_MAIN_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
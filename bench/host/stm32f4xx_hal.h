@@ -0,0 +1,60 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    stm32f4xx_hal.h
+ * @brief   Stand-in for the HAL in the host builds, FatFs' ffconf.h includes it.
+ *
+ * Only declares what the headers of the drivers built on the host need: their handles, the
+ * tick, and the interrupt masking, which does nothing on a single thread.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOST_STM32F4XX_HAL_H
+#    define NILAIINI_BENCH_HOST_STM32F4XX_HAL_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <stdint.h>
+
+/*****************************************************************************/
+/* Exported types */
+typedef struct
+{
+    int unused;
+} UART_HandleTypeDef;
+
+typedef struct
+{
+    int unused;
+} DMA_HandleTypeDef;
+
+/*****************************************************************************/
+/* Exported functions */
+/**
+ * @brief In ms, defined by the host programs that need it.
+ */
+uint32_t HAL_GetTick(void);
+
+static inline uint32_t __get_PRIMASK(void)
+{
+    return 0;
+}
+
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    (void)primask;
+}
+
+static inline void __disable_irq(void)
+{
+}
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOST_STM32F4XX_HAL_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,288 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    hostUart.cpp
+ * @brief   Source for the HostUart.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "hostUart.h"
+
+#include "Processes/drivers/uartRxDma.h"
+#include "Processes/drivers/uartTxDma.h"
+
+#include "NilaiTFO/defines/macros.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr uint32_t RX_MASK  = UartRxDma::RX_SIZE - 1;
+constexpr uint32_t TX_MASK  = UartTxDma::RING_SIZE - 1;
+constexpr uint32_t IDX_MASK = 0x00FFFFFFU;    //!< As UartTxDma's.
+constexpr uint8_t  DELIMITER = 0x00;
+
+/**
+ * @brief Passes the bytes on, losing some of the frames.
+ */
+class LossyLink
+{
+public:
+    void Push(const uint8_t* data, size_t len, std::vector<uint8_t>& out);
+
+    uint32_t GetLost() const { return m_lost; }
+
+private:
+    std::vector<uint8_t> m_frame;    //!< Since the last delimiter.
+    bool                 m_isInFrame = false;    //!< Each frame has a delimiter on each side.
+    uint32_t             m_lost      = 0;
+};
+
+int                  s_fd   = -1;
+double               s_loss = 0.0;
+std::mt19937         s_rng;
+LossyLink            s_rx;
+LossyLink            s_tx;
+std::vector<uint8_t> s_received;    //!< Not in the RX ring yet.
+std::vector<uint8_t> s_toSend;
+uint32_t             s_head = 0;    //!< Where the RX "DMA" writes next, free-running.
+
+void LossyLink::Push(const uint8_t* data, size_t len, std::vector<uint8_t>& out)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (data[i] != DELIMITER)
+        {
+            m_frame.push_back(data[i]);
+            continue;
+        }
+        // The text between frames, log lines, is never lost.
+        if (m_isInFrame && !m_frame.empty() &&
+            std::uniform_real_distribution<double>()(s_rng) < s_loss)
+        {
+            m_lost++;
+            if ((s_rng() & 1) != 0)
+            {
+                m_frame.clear();
+            }
+            else
+            {
+                m_frame[s_rng() % m_frame.size()] ^= 0x10;
+            }
+        }
+        out.insert(out.end(), m_frame.begin(), m_frame.end());
+        out.push_back(DELIMITER);
+        m_frame.clear();
+        m_isInFrame = !m_isInFrame;
+    }
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace HostUart
+{
+void Attach(int fd, double loss, uint32_t seed)
+{
+    CEP_ASSERT(UartRxDma::Get() != nullptr && UartTxDma::Get() != nullptr,
+               "The drivers must exist!");
+    s_fd   = fd;
+    s_loss = loss;
+    s_rng.seed(seed);
+    s_rx = {};
+    s_tx = {};
+    s_received.clear();
+    s_toSend.clear();
+}
+
+void Poll()
+{
+    uint8_t buffer[4096];
+    ssize_t len = 0;
+    while ((len = read(s_fd, buffer, sizeof(buffer))) > 0)
+    {
+        s_rx.Push(buffer, static_cast<size_t>(len), s_received);
+    }
+    UartRxDma::Get()->OnIdleLine();
+
+    while (!s_toSend.empty())
+    {
+        len = write(s_fd, s_toSend.data(), s_toSend.size());
+        if (len <= 0)
+        {
+            // Full, the rest goes on the next poll.
+            CEP_ASSERT(len == 0 || errno == EAGAIN, "Unable to write to the pty!");
+            break;
+        }
+        s_toSend.erase(s_toSend.begin(), s_toSend.begin() + len);
+    }
+}
+
+Stats GetStats()
+{
+    return {s_rx.GetLost(), s_tx.GetLost()};
+}
+}    // namespace HostUart
+
+/*****************************************************************************/
+/* UartRxDma                                                                 */
+/*****************************************************************************/
+UartRxDma* UartRxDma::s_instance = nullptr;
+
+UartRxDma::UartRxDma(UART_HandleTypeDef* uart, DMA_HandleTypeDef* dma, const std::string& label)
+: m_label(label), m_uart(uart), m_dma(dma)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of UartRxDma!");
+    s_instance = this;
+}
+
+bool UartRxDma::DoPost()
+{
+    return true;
+}
+
+void UartRxDma::Run()
+{
+}
+
+UartRxDma::Spans UartRxDma::Peek()
+{
+    uint32_t head = Head();
+    if (head - m_tail > RX_SIZE)
+    {
+        m_overruns++;
+        m_tail = head - RX_SIZE;
+    }
+
+    size_t available = head - m_tail;
+    size_t pos       = m_tail & RX_MASK;
+    size_t first     = std::min(available, RX_SIZE - pos);
+
+    Spans spans;
+    spans.first  = {&m_buffer[pos], first};
+    spans.second = {&m_buffer[0], available - first};
+    return spans;
+}
+
+void UartRxDma::Consume(size_t len)
+{
+    m_tail += static_cast<uint32_t>(std::min<size_t>(len, Head() - m_tail));
+}
+
+/**
+ * @brief Writes what was received in the ring, as the DMA does, calling the callback at every
+ *        half of the ring, as the half and full transfer interrupts do, and at the end, as the
+ *        IDLE line does.
+ */
+void UartRxDma::OnIdleLine()
+{
+    size_t done = 0;
+    while (done < s_received.size())
+    {
+        size_t len = std::min(s_received.size() - done, RX_SIZE / 2);
+        for (size_t i = 0; i < len; i++)
+        {
+            m_buffer[s_head++ & RX_MASK] = s_received[done + i];
+        }
+        done += len;
+        if (m_rxCallback != nullptr)
+        {
+            m_rxCallback();
+        }
+    }
+    s_received.clear();
+}
+
+uint32_t UartRxDma::Head() const
+{
+    return s_head;
+}
+
+/*****************************************************************************/
+/* UartTxDma                                                                 */
+/*****************************************************************************/
+UartTxDma* UartTxDma::s_instance = nullptr;
+
+UartTxDma::UartTxDma(UART_HandleTypeDef* uart, DMA_HandleTypeDef* dma) : m_uart(uart), m_dma(dma)
+{
+    CEP_ASSERT(s_instance == nullptr, "Cannot have multiple instances of UartTxDma!");
+    s_instance = this;
+}
+
+bool UartTxDma::Write(const char* msg, size_t len, bool tap)
+{
+    if (msg == nullptr)
+    {
+        return true;
+    }
+    return WriteInPlace(
+      len, [msg, len](RingWriter& writer) { writer.Write(msg, len); }, tap);
+}
+
+void UartTxDma::Flush()
+{
+    while (!s_toSend.empty())
+    {
+        HostUart::Poll();
+    }
+}
+
+void UartTxDma::RingWriter::Write(const char* data, size_t len)
+{
+    len = std::min(len, m_left);
+    while (len != 0)
+    {
+        uint32_t pos   = m_pos & TX_MASK;
+        size_t   chunk = std::min(len, RING_SIZE - pos);
+        std::memcpy(&m_ring[pos], data, chunk);
+        data += chunk;
+        len -= chunk;
+        m_left -= chunk;
+        m_pos = (m_pos + chunk) & IDX_MASK;
+    }
+}
+
+/**
+ * @brief The ring is sent as soon as committed, it's never full.
+ */
+bool UartTxDma::Reserve(size_t& len, uint32_t& start)
+{
+    if (len > RING_SIZE)
+    {
+        m_dropped++;
+        m_totalDropped++;
+        return false;
+    }
+    start = m_state.load() & IDX_MASK;
+    m_state.store((start + len) & IDX_MASK);
+    return true;
+}
+
+void UartTxDma::Commit()
+{
+    uint32_t end = m_state.load() & IDX_MASK;
+    while (m_published != end)
+    {
+        uint32_t pos = m_published & TX_MASK;
+        size_t   len = std::min<size_t>((end - m_published) & IDX_MASK, RING_SIZE - pos);
+        s_tx.Push(&m_ring[pos], len, s_toSend);
+        m_published = (m_published + len) & IDX_MASK;
+    }
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
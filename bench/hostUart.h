@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    hostUart.h
+ * @brief   UartRxDma and UartTxDma on a file descriptor, a pty, for the host tests.
+ *
+ * Defines the drivers' methods in place of Processes/drivers/uartRxDma.cpp and uartTxDma.cpp,
+ * which program the DMA. Poll() does what their interrupts do: it moves what was received into
+ * the RX ring, half of it at most at a time, and calls the RX callback. Messages are sent as soon
+ * as they're committed.
+ *
+ * The link can lose frames, what's between two COBS delimiters, in both directions: half of them
+ * are dropped, the other half have a byte flipped, for the CRC to reject them.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_HOSTUART_H
+#    define NILAIINI_BENCH_HOSTUART_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported functions */
+namespace HostUart
+{
+struct Stats
+{
+    uint32_t lostRx = 0;    //!< Frames to the target.
+    uint32_t lostTx = 0;    //!< Frames from the target.
+};
+
+/**
+ * @brief Connects the drivers, which must exist, to @p fd, non-blocking.
+ * @param loss Probability of losing each frame.
+ */
+void Attach(int fd, double loss, uint32_t seed);
+
+/**
+ * @brief Receives what's waiting on the descriptor and sends what's left to send.
+ */
+void Poll();
+
+Stats GetStats();
+}    // namespace HostUart
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_HOSTUART_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    iniBench.cpp
+ * @brief   Parsing of the configuration, cfg.ini, read from the RamDisk by inih.
+ *
+ * cep::IniParser itself pulls in NilaiTFO's logger and drivers, which don't build on the host.
+ * What it spends its time on does: inih reading the file line by line through f_gets, and the
+ * values being stored by section and name.
+ *
+ * Only built when the NilaiTFO submodule is checked out, inih comes with it.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+#include "ramDisk.h"
+
+#include "ff.h"
+#include "vendor/NilaiTFO/vendor/inih/ini.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+using Sections = std::map<std::string, std::map<std::string, std::string>>;
+
+const char CONFIG[] = "[section 1]\n"
+                      "s1 = My string\n"
+                      "s2 = My other string\n"
+                      "\n"
+                      "[section 2]\n"
+                      "i1 = 1234\n"
+                      "i2 = -1234\n"
+                      "i3 = 0x4d2 ; 1234 in hex.\n"
+                      "\n"
+                      "[section 3]\n"
+                      "f1 = 0.1234\n"
+                      "f2 = -0.1234\n"
+                      "\n"
+                      "[section 4]\n"
+                      "b1 = true\n"
+                      "b2 = false\n";
+
+void WriteConfig()
+{
+    static bool s_written = false;
+    FIL         file;
+    UINT        written = 0;
+    if (s_written)
+    {
+        return;
+    }
+    if (!RamDisk::Mount() || f_open(&file, "cfg.ini", FA_WRITE | FA_CREATE_ALWAYS) != FR_OK ||
+        f_write(&file, CONFIG, sizeof(CONFIG) - 1, &written) != FR_OK || f_close(&file) != FR_OK)
+    {
+        std::fprintf(stderr, "Can't write cfg.ini\n");
+        std::exit(2);
+    }
+    s_written = true;
+}
+
+int Store(void* user, const char* section, const char* name, const char* value)
+{
+    (*static_cast<Sections*>(user))[section][name] = value;
+    return 1;
+}
+
+char* ReadLine(char* str, int num, void* stream)
+{
+    return f_gets(str, num, static_cast<FIL*>(stream));
+}
+
+int Parse(Sections& sections)
+{
+    FIL file;
+    if (f_open(&file, "cfg.ini", FA_READ) != FR_OK)
+    {
+        return -1;
+    }
+    int error = ini_parse_stream(ReadLine, &file, Store, &sections);
+    f_close(&file);
+    return error;
+}
+
+const bool s_registered = [] {
+    Bench::Register("ini/parse cfg.ini",
+                    sizeof(CONFIG) - 1,
+                    [](size_t iterations) {
+                        WriteConfig();
+                        for (size_t i = 0; i < iterations; i++)
+                        {
+                            Sections sections;
+                            Bench::DoNotOptimize(Parse(sections));
+                        }
+                    },
+                    RamDisk::GetTransferredBytes);
+    Bench::Register("ini/get", 0, [](size_t iterations) {
+        WriteConfig();
+        Sections sections;
+        Parse(sections);
+        for (size_t i = 0; i < iterations; i++)
+        {
+            Bench::DoNotOptimize(std::strtol(sections["section 2"]["i3"].c_str(), nullptr, 0));
+        }
+    });
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,271 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    kernelTest.cpp
+ * @brief   Checks the scheduling of the kernel, on its POSIX port.
+ *
+ * The kernel and the port are the firmware's, only one of the threads runs at a time and the
+ * tick comes from a pthread. The checks run in the "controller" thread, at osPriorityNormal:
+ *  - Preemption: a thread of higher priority runs as soon as it's created or released, one of
+ *    lower priority only when the controller blocks.
+ *  - Priority inheritance, through a chain: A (High) waits on M1, held by B (BelowNormal),
+ *    which waits on M2, held by C (Low). C must run at High ahead of a ready thread of Normal
+ *    priority, then every thread must go back to its own priority, also when A times out.
+ *  - Wake-up latency: from a semaphore release to the waiter, and from osDelay() to the tick,
+ *    with a thread of lower priority keeping the CPU busy.
+ *
+ * The kernel never returns from osKernelStart(), the controller exits the process: with 1 if a
+ * check failed. Each thread takes one of the OS_MAX_THREADS slots for good, they are all used.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "Processes/os/cmsis_os.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t HANDOFFS = 1000;
+constexpr uint32_t DELAYS   = 50;
+constexpr uint32_t DELAY    = 10;    //!< In ticks, of 1 ms.
+//! Bounds of the latencies, loose enough for a loaded machine.
+constexpr double MAX_HANDOFF_AVG = 1.0;     //!< In ms.
+constexpr double MAX_HANDOFF     = 20.0;    //!< In ms.
+constexpr double MAX_OVERSLEEP   = 20.0;    //!< In ms, past DELAY.
+constexpr int    TIMEOUT         = 60;      //!< In seconds, for the whole test.
+
+bool        s_passed = true;
+std::string s_order;    //!< Letters appended by the threads as they run.
+
+osSemaphoreId_t   s_wake       = nullptr;
+osSemaphoreId_t   s_goC        = nullptr;
+osMutexId_t       s_m1         = nullptr;
+osMutexId_t       s_m2         = nullptr;
+osThreadId_t      s_a          = nullptr;
+osThreadId_t      s_b          = nullptr;
+osThreadId_t      s_c          = nullptr;
+std::atomic<bool> s_spin       = true;
+Clock::time_point s_released;
+osStatus_t        s_timedOut   = osOK;
+osPriority_t      s_cOnTimeout = osPriorityNone;
+
+std::vector<double> s_handoffs;    //!< In ms.
+
+double Ms(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void Expect(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "Kernel: %s\n", what);
+        s_passed = false;
+    }
+}
+
+osThreadId_t Start(osThreadFunc_t func, const char* name, osPriority_t priority)
+{
+    osThreadAttr_t attr = {};
+    attr.name           = name;
+    attr.priority       = priority;
+    osThreadId_t thread = osThreadNew(func, nullptr, &attr);
+    if (thread == nullptr)
+    {
+        std::fprintf(stderr, "Kernel: unable to create %s\n", name);
+        std::exit(1);
+    }
+    return thread;
+}
+
+/*****************************************************************************/
+/* Threads */
+void High(void*)
+{
+    s_order += 'H';
+    osSemaphoreAcquire(s_wake, osWaitForever);
+    s_order += 'h';
+    for (uint32_t i = 0; i < HANDOFFS; i++)
+    {
+        osSemaphoreAcquire(s_wake, osWaitForever);
+        s_handoffs.push_back(Ms(Clock::now() - s_released));
+    }
+}
+
+void Low(void*)
+{
+    s_order += 'L';
+    while (s_spin)
+    {
+        osThreadYield();
+    }
+}
+
+void ChainC(void*)
+{
+    osMutexAcquire(s_m2, osWaitForever);
+    osSemaphoreAcquire(s_goC, osWaitForever);
+    s_order += 'C';
+    osMutexRelease(s_m2);
+    s_order += 'c';
+}
+
+void ChainB(void*)
+{
+    osMutexAcquire(s_m1, osWaitForever);
+    osMutexAcquire(s_m2, osWaitForever);
+    s_order += 'B';
+    osMutexRelease(s_m2);
+    osMutexRelease(s_m1);
+}
+
+void ChainA(void*)
+{
+    s_timedOut   = osMutexAcquire(s_m1, 5);
+    s_cOnTimeout = osThreadGetPriority(s_c);
+    osMutexAcquire(s_m1, osWaitForever);
+    s_order += 'A';
+    osMutexRelease(s_m1);
+}
+
+void Medium(void*)
+{
+    // Whether M runs before the controller or not, C is released from a thread of its priority.
+    osSemaphoreRelease(s_goC);
+    s_order += 'M';
+}
+
+/*****************************************************************************/
+/* Checks */
+void CheckPreemption()
+{
+    Start(High, "high", osPriorityHigh);
+    s_order += '1';
+    Start(Low, "low", osPriorityLow);
+    s_order += '2';
+    osSemaphoreRelease(s_wake);
+    s_order += '3';
+
+    Expect(s_order == "H12h3", "a thread of higher priority didn't preempt the controller");
+    std::printf("Preemption: %s\n", s_order.c_str());
+}
+
+void CheckHandoff()
+{
+    for (uint32_t i = 0; i < HANDOFFS; i++)
+    {
+        s_released = Clock::now();
+        osSemaphoreRelease(s_wake);
+    }
+    Expect(s_handoffs.size() == HANDOFFS, "the waiter wasn't woken by every release");
+
+    double sum = 0.0;
+    for (double ms : s_handoffs)
+    {
+        sum += ms;
+    }
+    double avg = s_handoffs.empty() ? 0.0 : sum / s_handoffs.size();
+    double max = s_handoffs.empty() ? 0.0 : *std::max_element(s_handoffs.begin(), s_handoffs.end());
+    std::printf("Release to waiter: %.3f ms on average, %.3f ms at most\n", avg, max);
+    Expect(avg <= MAX_HANDOFF_AVG && max <= MAX_HANDOFF, "the waiter was woken too late");
+}
+
+void CheckDelay()
+{
+    // The low thread yields in a loop, the tick must still take the CPU back from it.
+    double min = 1e9;
+    double max = 0.0;
+    for (uint32_t i = 0; i < DELAYS; i++)
+    {
+        Clock::time_point start = Clock::now();
+        osDelay(DELAY);
+        double ms = Ms(Clock::now() - start);
+        min       = std::min(min, ms);
+        max       = std::max(max, ms);
+    }
+    s_spin = false;
+    std::printf("osDelay(%u): %.3f ms to %.3f ms\n", static_cast<unsigned>(DELAY), min, max);
+    Expect(s_order.find('L') != std::string::npos, "the low thread never ran");
+    // The first tick can come right away, the delay is DELAY - 1 to DELAY ticks.
+    Expect(min >= DELAY - 1.0 - 0.5, "osDelay() returned early");
+    Expect(max <= DELAY + MAX_OVERSLEEP, "osDelay() returned too late");
+}
+
+void CheckInheritance()
+{
+    s_order.clear();
+    s_c = Start(ChainC, "C", osPriorityLow);
+    osDelay(2);
+    s_b = Start(ChainB, "B", osPriorityBelowNormal);
+    osDelay(2);
+    Expect(osThreadGetPriority(s_c) == osPriorityBelowNormal, "C didn't inherit B's priority");
+
+    s_a = Start(ChainA, "A", osPriorityHigh);
+    Expect(osThreadGetPriority(s_b) == osPriorityHigh, "B didn't inherit A's priority");
+    Expect(osThreadGetPriority(s_c) == osPriorityHigh, "C didn't inherit A's priority through B");
+
+    // A times out and waits again: the chain goes back to its priorities, then up again.
+    osDelay(20);
+    Expect(s_timedOut == osErrorTimeout, "A's first wait didn't time out");
+    Expect(s_cOnTimeout == osPriorityBelowNormal, "C kept A's priority after the time out");
+    Expect(osThreadGetPriority(s_c) == osPriorityHigh, "C didn't inherit A's priority again");
+
+    // C runs at A's priority, ahead of M, and so do B and A in turn.
+    Start(Medium, "M", osPriorityNormal);
+    osDelay(5);
+
+    std::printf("Inheritance: %s\n", s_order.c_str());
+    Expect(s_order == "CBAMc", "C didn't run at A's priority, ahead of M");
+    Expect(osThreadGetPriority(s_b) == osPriorityBelowNormal, "B kept an inherited priority");
+    Expect(osThreadGetPriority(s_c) == osPriorityLow, "C kept an inherited priority");
+}
+
+void Controller(void*)
+{
+    CheckPreemption();
+    CheckHandoff();
+    CheckDelay();
+    CheckInheritance();
+
+    std::printf("%s\n", s_passed ? "passed" : "FAILED");
+    std::fflush(stdout);
+    std::exit(s_passed ? 0 : 1);
+}
+}    // namespace
+
+int main()
+{
+    // A deadlock in the kernel ends the test instead of hanging it.
+    alarm(TIMEOUT);
+
+    s_handoffs.reserve(HANDOFFS);
+    osKernelInitialize();
+    s_wake = osSemaphoreNew(HANDOFFS + 1, 0, nullptr);
+    s_goC  = osSemaphoreNew(1, 0, nullptr);
+    s_m1   = osMutexNew(nullptr);
+    s_m2   = osMutexNew(nullptr);
+    Start(Controller, "controller", osPriorityNormal);
+    osKernelStart();
+    return 1;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,249 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    kvBench.cpp
+ * @brief   The KvStore of the settings, over a SimFlash.
+ *
+ * The flash is made of smaller sectors than the target's, so that the sectors fill up and are
+ * reclaimed often. The io B/op of the cases that write is what the flash is programmed and
+ * erased for each value set: the write amplification, times the size of a record.
+ *
+ * "kv/power cut" cuts the power at a random point of every operation, then mounts the store
+ * again and checks that it holds either the value from before or the one from after the
+ * operation, and every other value unchanged. It also erases the next sector ahead of time
+ * (KvStore::PrepareNext()) before some of them, and cuts the power during half of those erases.
+ * A mismatch stops hostBench.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+#include "simFlash.h"
+
+#include "Processes/services/kvStore.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t KEYS        = 64;
+constexpr size_t SECTORS     = 4;
+constexpr size_t SECTOR_SIZE = 16 * 1024;
+
+std::string s_keys[KEYS];
+
+void Fail(const char* what, const std::string& key = {})
+{
+    std::fprintf(stderr, "KvStore corrupted: %s %s\n", what, key.c_str());
+    std::exit(2);
+}
+
+std::string_view MakeValue(char* buffer, size_t size, size_t key, size_t version)
+{
+    int length = std::snprintf(buffer, size, "value %zu of %s", version, s_keys[key].c_str());
+    return {buffer, static_cast<size_t>(length)};
+}
+
+/**
+ * @brief A store with every key set, shared by the cases that don't check its content.
+ */
+KvStore& PopulatedStore()
+{
+    static SimFlash s_flash(SECTORS, SECTOR_SIZE);
+    static KvStore  s_store(s_flash);
+    if (!s_store.IsMounted())
+    {
+        char buffer[KvStore::MAX_VALUE];
+        if (!s_store.Mount())
+        {
+            Fail("Mount");
+        }
+        for (size_t key = 0; key < KEYS; key++)
+        {
+            if (!s_store.Set(s_keys[key], MakeValue(buffer, sizeof(buffer), key, 0)))
+            {
+                Fail("Set", s_keys[key]);
+            }
+        }
+    }
+    return s_store;
+}
+
+/**
+ * @brief Every operation gives a key a new value.
+ */
+void Set(size_t iterations)
+{
+    static size_t s_version = 0;
+    KvStore&      store     = PopulatedStore();
+    char          buffer[KvStore::MAX_VALUE];
+    for (size_t i = 0; i < iterations; i++)
+    {
+        size_t key = i % KEYS;
+        if (!store.Set(s_keys[key], MakeValue(buffer, sizeof(buffer), key, ++s_version)))
+        {
+            Fail("Set", s_keys[key]);
+        }
+    }
+}
+
+/**
+ * @brief Sets a key to the value it already has, nothing is written.
+ */
+void SetUnchanged(size_t iterations)
+{
+    KvStore&         store = PopulatedStore();
+    std::string_view value;
+    if (!store.Get(s_keys[0], value))
+    {
+        Fail("Get", s_keys[0]);
+    }
+    std::string copy(value);
+    for (size_t i = 0; i < iterations; i++)
+    {
+        Bench::DoNotOptimize(store.Set(s_keys[0], copy));
+    }
+}
+
+void Get(size_t iterations)
+{
+    KvStore&         store = PopulatedStore();
+    std::string_view value;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if (!store.Get(s_keys[(i * 7) % KEYS], value))
+        {
+            Fail("Get", s_keys[(i * 7) % KEYS]);
+        }
+        Bench::DoNotOptimize(value);
+    }
+}
+
+/**
+ * @brief Reads every sector and indexes the keys, as at boot.
+ */
+void Mount(size_t iterations)
+{
+    KvStore& store = PopulatedStore();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if (!store.Mount())
+        {
+            Fail("Mount");
+        }
+    }
+}
+
+void PowerCut(size_t iterations)
+{
+    static SimFlash                           s_flash(3, 4096);
+    static KvStore                            s_store(s_flash);
+    static std::map<std::string, std::string> s_model;
+    static std::mt19937                       s_rng(5678);
+    static size_t                             s_version = 0;
+    constexpr size_t                          USED_KEYS = 24;
+
+    char buffer[KvStore::MAX_VALUE];
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if (!s_store.IsMounted() && !s_store.Mount())
+        {
+            Fail("Mount");
+        }
+
+        // The settings erase the next sector ahead of time, a cut there mustn't lose anything.
+        if (s_rng() % 4 == 0)
+        {
+            s_flash.CutPowerAfter(s_rng() % 2);
+            bool prepared = s_store.PrepareNext();
+            bool cut      = !s_flash.IsPowered();
+            s_flash.RestorePower();
+            if (!prepared && !cut)
+            {
+                Fail("PrepareNext");
+            }
+            if (cut && !s_store.Mount())
+            {
+                Fail("Mount after a power cut");
+            }
+        }
+
+        // An operation programs about 16 words, a reclaim hundreds.
+        size_t            key    = s_rng() % USED_KEYS;
+        bool              erase  = s_rng() % 8 == 0;
+        std::string_view  value  = MakeValue(buffer, sizeof(buffer), key, ++s_version);
+        const std::string before = s_model.count(s_keys[key]) != 0 ? s_model[s_keys[key]] : "";
+        s_flash.CutPowerAfter(1 + s_rng() % 256);
+        bool done = erase ? s_store.Erase(s_keys[key]) : s_store.Set(s_keys[key], value);
+        bool cut  = !s_flash.IsPowered();
+        s_flash.RestorePower();
+        if (!done && !cut)
+        {
+            Fail("Set or Erase", s_keys[key]);
+        }
+
+        if (cut && !s_store.Mount())
+        {
+            Fail("Mount after a power cut");
+        }
+        std::string_view stored;
+        bool             found = s_store.Get(s_keys[key], stored);
+        bool             after = erase ? !found : found && stored == value;
+        bool isBefore = before.empty() ? !found : found && stored == std::string_view(before);
+        if (!after && !(cut && isBefore))
+        {
+            Fail("the key has neither its old nor its new value:", s_keys[key]);
+        }
+        if (found)
+        {
+            s_model[s_keys[key]] = std::string(stored);
+        }
+        else
+        {
+            s_model.erase(s_keys[key]);
+        }
+
+        if (s_store.GetStats().keys != s_model.size())
+        {
+            Fail("keys were lost or came back");
+        }
+        for (const auto& [name, expected] : s_model)
+        {
+            if (!s_store.Get(name, stored) || stored != expected)
+            {
+                Fail("a key that wasn't touched changed:", name);
+            }
+        }
+        if (s_flash.GetViolations() != 0)
+        {
+            Fail("bits were programmed back to 1");
+        }
+    }
+}
+
+const bool s_registered = [] {
+    for (size_t key = 0; key < KEYS; key++)
+    {
+        s_keys[key] = "section " + std::to_string(key % 8) + "=name " + std::to_string(key);
+    }
+    Bench::Register("kv/set", 0, Set, &SimFlash::GetTransferredBytes);
+    Bench::Register("kv/set unchanged", 0, SetUnchanged, &SimFlash::GetTransferredBytes);
+    Bench::Register("kv/get", 0, Get);
+    Bench::Register("kv/mount", SECTORS * SECTOR_SIZE, Mount);
+    Bench::Register("kv/power cut", 0, PowerCut, &SimFlash::GetTransferredBytes);
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    linkBench.cpp
+ * @brief   Framing of the command link: CRC and COBS over a FileTransfer block.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+
+#include "Processes/services/cobs.h"
+#include "Processes/services/crc32.h"
+
+#include <cstring>
+#include <random>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t FRAME_SIZE = 1031;    //!< A FileTransfer block, with its header and CRC.
+
+uint8_t s_frame[FRAME_SIZE];
+uint8_t s_encoded[Cobs::MaxEncodedSize(FRAME_SIZE)];
+uint8_t s_decoded[Cobs::MaxEncodedSize(FRAME_SIZE)];
+
+size_t Encode()
+{
+    size_t len = 0;
+    Cobs::Encode(s_frame, sizeof(s_frame), [&](const uint8_t* data, size_t n) {
+        std::memcpy(&s_encoded[len], data, n);
+        len += n;
+    });
+    return len;
+}
+
+const bool s_registered = [] {
+    std::mt19937 rng(1234);
+    for (uint8_t& byte : s_frame)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    Bench::Register("link/crc32", FRAME_SIZE, [](size_t iterations) {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            Bench::DoNotOptimize(Crc32::Compute(s_frame, sizeof(s_frame)));
+        }
+    });
+    Bench::Register("link/cobs encode", FRAME_SIZE, [](size_t iterations) {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            Bench::DoNotOptimize(Encode());
+        }
+    });
+    Bench::Register("link/cobs decode", FRAME_SIZE, [](size_t iterations) {
+        size_t len = Encode();
+        for (size_t i = 0; i < iterations; i++)
+        {
+            std::memcpy(s_decoded, s_encoded, len);
+            Bench::DoNotOptimize(Cobs::DecodeInPlace(s_decoded, len));
+        }
+    });
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    logBench.cpp
+ * @brief   Formatting of the application's log lines, as done by AppLog::Log (log.h).
+ *
+ * A line is measured first, then formatted into the room reserved for it: both passes are
+ * timed. The sink stands in for the UART's ring.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+
+#include "Processes/services/format.h"
+
+#include <cstring>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+class RingSink : public Fmt::Sink
+{
+public:
+    void Write(const char* data, size_t len) override
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            m_ring[m_head++ % sizeof(m_ring)] = data[i];
+        }
+    }
+
+private:
+    char   m_ring[2048] = {};
+    size_t m_head       = 0;
+};
+
+RingSink s_ring;
+
+template<typename S, typename... Args>
+void Log(S fmt, const Args&... args)
+{
+    size_t len = Fmt::FormattedSize(fmt, args...);
+    Bench::DoNotOptimize(len);
+    Fmt::FormatTo(s_ring, fmt, args...);
+}
+
+template<typename S, typename... Args>
+uint64_t LineSize(S fmt, const Args&... args)
+{
+    return Fmt::FormattedSize(fmt, args...);
+}
+
+const bool s_registered = [] {
+    Bench::Register("log/integers",
+                    LineSize(FMT_STRING("[{}] [DEBUG]: i1: {}\n\r"), 123456u, -42),
+                    [](size_t iterations) {
+                        for (size_t i = 0; i < iterations; i++)
+                        {
+                            Log(FMT_STRING("[{}] [DEBUG]: i1: {}\n\r"), i, -42);
+                        }
+                    });
+    Bench::Register("log/float",
+                    LineSize(FMT_STRING("[{}] [INFO]: POST OK! {:.3} seconds.\n\r"), 1234u, 1.5f),
+                    [](size_t iterations) {
+                        for (size_t i = 0; i < iterations; i++)
+                        {
+                            Log(FMT_STRING("[{}] [INFO]: POST OK! {:.3} seconds.\n\r"),
+                                i,
+                                static_cast<float>(i % 5000) / 1000.0f);
+                        }
+                    });
+    Bench::Register("log/strings",
+                    LineSize(FMT_STRING("[{}] [DEBUG]: Has {} - {}: {}\n\r"),
+                             1234u,
+                             "section 1",
+                             "s1",
+                             "true"),
+                    [](size_t iterations) {
+                        for (size_t i = 0; i < iterations; i++)
+                        {
+                            Log(FMT_STRING("[{}] [DEBUG]: Has {} - {}: {}\n\r"),
+                                i,
+                                "section 1",
+                                "s1",
+                                "true");
+                        }
+                    });
+    Bench::Register("log/hex",
+                    LineSize(FMT_STRING("[{}] [DEBUG]: reg 0x{:08x} = {:5}\n\r"), 1234u, 0u, 1234u),
+                    [](size_t iterations) {
+                        for (size_t i = 0; i < iterations; i++)
+                        {
+                            Log(FMT_STRING("[{}] [DEBUG]: reg 0x{:08x} = {:5}\n\r"),
+                                i,
+                                static_cast<uint32_t>(i),
+                                1234u);
+                        }
+                    });
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,222 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    ramDisk.cpp
+ * @brief   Source of the RamDisk, and the diskio functions FatFs is linked against on the host.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "ramDisk.h"
+
+#include "diskio.h"
+#include "ff.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr size_t RUN_SIZE = RamDisk::SECTORS_PER_RUN * RamDisk::SECTOR_SIZE;
+
+// Allocated with calloc, so the disk doesn't count against the heap usage of the cases.
+struct FreeRun
+{
+    void operator()(uint8_t* run) const { std::free(run); }
+};
+using Run = std::unique_ptr<uint8_t[], FreeRun>;
+
+// Runs of sectors never written are null, and read as zeros.
+std::vector<Run> s_runs;
+uint32_t         s_sectorCount = 0;
+uint64_t         s_transferred = 0;
+FATFS            s_fs;
+
+Run NewRun()
+{
+    return Run(static_cast<uint8_t*>(std::calloc(RUN_SIZE, 1)));
+}
+
+uint8_t* Sector(DWORD sector, bool write)
+{
+    Run& run = s_runs[sector / RamDisk::SECTORS_PER_RUN];
+    if (run == nullptr)
+    {
+        if (!write)
+        {
+            return nullptr;
+        }
+        run = NewRun();
+    }
+    return &run[(sector % RamDisk::SECTORS_PER_RUN) * RamDisk::SECTOR_SIZE];
+}
+
+void Resize(uint64_t bytes)
+{
+    s_sectorCount = static_cast<uint32_t>(bytes / RamDisk::SECTOR_SIZE);
+    s_runs.resize((s_sectorCount + RamDisk::SECTORS_PER_RUN - 1) / RamDisk::SECTORS_PER_RUN);
+}
+
+bool Load(const char* path)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Can't open the image %s\n", path);
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    Resize(static_cast<uint64_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+
+    uint8_t run[RUN_SIZE];
+    for (size_t i = 0; i < s_runs.size(); i++)
+    {
+        size_t read = std::fread(run, 1, sizeof(run), file);
+        bool   used = false;
+        for (size_t j = 0; j < read && !used; j++)
+        {
+            used = run[j] != 0;
+        }
+        if (used)
+        {
+            s_runs[i] = NewRun();
+            std::memcpy(s_runs[i].get(), run, read);
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool Format()
+{
+    Resize(RamDisk::DEFAULT_SIZE);
+
+    static uint8_t work[RamDisk::CLUSTER_SIZE];
+    FRESULT        res = f_mkfs("", FM_FAT32, RamDisk::CLUSTER_SIZE, work, sizeof(work));
+    if (res != FR_OK)
+    {
+        std::fprintf(stderr, "f_mkfs failed: %d\n", res);
+        return false;
+    }
+    return true;
+}
+
+bool DoMount()
+{
+    const char* image = std::getenv("BENCH_FAT_IMAGE");
+    if (image != nullptr ? !Load(image) : !Format())
+    {
+        return false;
+    }
+
+    FRESULT res = f_mount(&s_fs, "", 1);
+    if (res != FR_OK)
+    {
+        std::fprintf(stderr, "f_mount failed: %d\n", res);
+        return false;
+    }
+    return true;
+}
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+namespace RamDisk
+{
+bool Mount()
+{
+    static const bool s_mounted = DoMount();
+    return s_mounted;
+}
+
+bool Remount()
+{
+    // The file objects and the sector window of the old mount are dropped, not written.
+    return Mount() && f_mount(&s_fs, "", 1) == FR_OK;
+}
+
+uint64_t GetTransferredBytes()
+{
+    return s_transferred;
+}
+}    // namespace RamDisk
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+extern "C" DSTATUS disk_initialize(BYTE)
+{
+    return s_sectorCount != 0 ? 0 : STA_NOINIT;
+}
+
+extern "C" DSTATUS disk_status(BYTE)
+{
+    return s_sectorCount != 0 ? 0 : STA_NOINIT;
+}
+
+extern "C" DRESULT disk_read(BYTE, BYTE* buff, DWORD sector, UINT count)
+{
+    if (sector + count > s_sectorCount)
+    {
+        return RES_PARERR;
+    }
+    for (UINT i = 0; i < count; i++, buff += RamDisk::SECTOR_SIZE)
+    {
+        const uint8_t* data = Sector(sector + i, false);
+        if (data != nullptr)
+        {
+            std::memcpy(buff, data, RamDisk::SECTOR_SIZE);
+        }
+        else
+        {
+            std::memset(buff, 0, RamDisk::SECTOR_SIZE);
+        }
+    }
+    s_transferred += count * RamDisk::SECTOR_SIZE;
+    return RES_OK;
+}
+
+extern "C" DRESULT disk_write(BYTE, const BYTE* buff, DWORD sector, UINT count)
+{
+    if (sector + count > s_sectorCount)
+    {
+        return RES_PARERR;
+    }
+    for (UINT i = 0; i < count; i++, buff += RamDisk::SECTOR_SIZE)
+    {
+        std::memcpy(Sector(sector + i, true), buff, RamDisk::SECTOR_SIZE);
+    }
+    s_transferred += count * RamDisk::SECTOR_SIZE;
+    return RES_OK;
+}
+
+extern "C" DRESULT disk_ioctl(BYTE, BYTE cmd, void* buff)
+{
+    switch (cmd)
+    {
+        case CTRL_SYNC: return RES_OK;
+        case GET_SECTOR_COUNT: *static_cast<DWORD*>(buff) = s_sectorCount; return RES_OK;
+        case GET_SECTOR_SIZE: *static_cast<WORD*>(buff) = RamDisk::SECTOR_SIZE; return RES_OK;
+        case GET_BLOCK_SIZE: *static_cast<DWORD*>(buff) = RamDisk::SECTORS_PER_RUN; return RES_OK;
+        default: return RES_PARERR;
+    }
+}
+
+extern "C" DWORD get_fattime()
+{
+    return 0;    // Like FATFS/App/fatfs.c, the board has no RTC.
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    ramDisk.h
+ * @brief   Disk image in memory, behind FatFs' diskio interface, for the host benchmarks.
+ *
+ * By default, the image is a blank 4 GiB volume formatted like an SDHC card (FAT32, 32 KiB
+ * clusters). Its sectors are only allocated once written, so it costs little memory. When the
+ * environment variable BENCH_FAT_IMAGE names a file, e.g. a dump of the card
+ * (dd if=/dev/sdX of=card.img), the volume is loaded from it instead. The file is not modified.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_RAMDISK_H
+#    define NILAIINI_BENCH_RAMDISK_H
+
+/*****************************************************************************/
+/* Includes */
+#    include <cstdint>
+
+/*****************************************************************************/
+/* Exported types */
+namespace RamDisk
+{
+static constexpr uint32_t SECTOR_SIZE     = 512;
+static constexpr uint64_t DEFAULT_SIZE    = uint64_t(4) << 30;
+static constexpr uint32_t CLUSTER_SIZE    = 32768;
+static constexpr uint32_t SECTORS_PER_RUN = 128;    //!< Granularity of the allocation.
+
+/**
+ * @brief Creates or loads the image, and mounts it as the default drive.
+ *        The first call does the work, the next ones return its result.
+ */
+bool Mount();
+
+/**
+ * @brief Mounts the volume again, as after a power cut: what FatFs held in RAM and didn't write
+ *        yet is lost, the open files with it.
+ */
+bool Remount();
+
+/**
+ * @brief Bytes read and written through the diskio interface since the start.
+ *        Matches Bench::IoCounter.
+ */
+uint64_t GetTransferredBytes();
+}    // namespace RamDisk
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_RAMDISK_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    simFlash.cpp
+ * @brief   Source of the SimFlash.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "simFlash.h"
+
+#include <cstring>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+uint64_t s_transferred = 0;
+}    // namespace
+
+/*****************************************************************************/
+/* Public Method Definitions                                                 */
+/*****************************************************************************/
+SimFlash::SimFlash(size_t sectorCount, size_t sectorSize)
+: m_sectorCount(sectorCount), m_sectorSize(sectorSize), m_memory(sectorCount * sectorSize, 0xFF)
+{
+}
+
+const uint8_t* SimFlash::GetSector(size_t sector) const
+{
+    return &m_memory[sector * m_sectorSize];
+}
+
+bool SimFlash::Erase(size_t sector)
+{
+    uint8_t* base = &m_memory[sector * m_sectorSize];
+    if (!UsePower())
+    {
+        // Cut during the erase: some words are erased, the others are left as they were.
+        for (size_t offset = 0; offset < m_sectorSize; offset += sizeof(uint32_t))
+        {
+            if ((m_rng() & 1) != 0)
+            {
+                std::memset(&base[offset], 0xFF, sizeof(uint32_t));
+            }
+        }
+        return false;
+    }
+    std::memset(base, 0xFF, m_sectorSize);
+    s_transferred += m_sectorSize;
+    return true;
+}
+
+bool SimFlash::Program(size_t sector, size_t offset, const void* data, size_t size)
+{
+    if (offset % sizeof(uint32_t) != 0 || size % sizeof(uint32_t) != 0 ||
+        offset + size > m_sectorSize)
+    {
+        m_violations++;
+        return false;
+    }
+
+    uint8_t*       out = &m_memory[sector * m_sectorSize + offset];
+    const uint8_t* in  = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i += sizeof(uint32_t))
+    {
+        uint32_t word    = 0;
+        uint32_t current = 0;
+        std::memcpy(&word, &in[i], sizeof(word));
+        std::memcpy(&current, &out[i], sizeof(current));
+        if ((current & word) != word)
+        {
+            m_violations++;
+        }
+
+        if (!UsePower())
+        {
+            // Cut while programming the word: only some of its bits are cleared.
+            word |= m_rng();
+            current &= word;
+            std::memcpy(&out[i], &current, sizeof(current));
+            return false;
+        }
+        current &= word;
+        std::memcpy(&out[i], &current, sizeof(current));
+        s_transferred += sizeof(word);
+    }
+    return true;
+}
+
+uint64_t SimFlash::GetTransferredBytes()
+{
+    return s_transferred;
+}
+
+/*****************************************************************************/
+/* Private Method Definitions                                                */
+/*****************************************************************************/
+/**
+ * @returns False once the power is cut.
+ */
+bool SimFlash::UsePower()
+{
+    if (m_powerLeft == NEVER)
+    {
+        return true;
+    }
+    if (m_powerLeft == 0)
+    {
+        return false;
+    }
+    return --m_powerLeft != 0;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    simFlash.h
+ * @brief   NOR flash in memory, behind KvStore::Flash, for the host benchmarks.
+ *
+ * Behaves like the internal flash: erasing sets a sector to 0xFF, programming can only clear
+ * bits. Programming a bit back to 1 is counted as a violation, the store must never try.
+ *
+ * The power can be cut after a given number of words programmed or sectors erased. The one
+ * that was going on is left half done: a word with only some of its bits cleared, a sector
+ * with only some of its words erased. Everything then fails until the power is restored.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#ifndef NILAIINI_BENCH_SIMFLASH_H
+#    define NILAIINI_BENCH_SIMFLASH_H
+
+/*****************************************************************************/
+/* Includes */
+#    include "Processes/services/kvStore.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <random>
+#    include <vector>
+
+/*****************************************************************************/
+/* Exported types */
+class SimFlash : public KvStore::Flash
+{
+public:
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    SimFlash(size_t sectorCount, size_t sectorSize);
+    ~SimFlash() override = default;
+
+    [[nodiscard]] size_t         GetSectorCount() const override { return m_sectorCount; }
+    [[nodiscard]] size_t         GetSectorSize() const override { return m_sectorSize; }
+    [[nodiscard]] const uint8_t* GetSector(size_t sector) const override;
+
+    bool Erase(size_t sector) override;
+    bool Program(size_t sector, size_t offset, const void* data, size_t size) override;
+
+    /**
+     * @brief Cuts the power during the @p operations-th word programmed or sector erased from
+     *        now, 0 cuts it right away.
+     */
+    void CutPowerAfter(uint64_t operations) { m_powerLeft = operations; }
+    void RestorePower() { m_powerLeft = NEVER; }
+    [[nodiscard]] bool IsPowered() const { return m_powerLeft != 0; }
+
+    [[nodiscard]] uint64_t GetViolations() const { return m_violations; }
+
+    /**
+     * @brief Bytes programmed and erased by every SimFlash since the start.
+     *        Matches Bench::IoCounter.
+     */
+    static uint64_t GetTransferredBytes();
+
+private:
+    size_t               m_sectorCount;
+    size_t               m_sectorSize;
+    std::vector<uint8_t> m_memory;
+    uint64_t             m_powerLeft  = NEVER;
+    uint64_t             m_violations = 0;
+    std::mt19937         m_rng{42};
+
+private:
+    bool UsePower();
+};
+
+/* Have a wonderful day :) */
+#endif /* NILAIINI_BENCH_SIMFLASH_H */
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,191 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    tlsfBench.cpp
+ * @brief   The Tlsf allocator against the host's malloc, on the same random churn.
+ *
+ * The churn mimics what IniParser and std::map do to the heap: strings and nodes of 8 to 300
+ * bytes, allocated and freed in random order, with a reallocation and an aligned allocation
+ * now and then. Each run fills the blocks with a pattern and verifies it before freeing them,
+ * then checks the Tlsf's lists against its blocks: a corrupted heap stops hostBench.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "benchmark.h"
+
+#include "Processes/services/tlsf.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <type_traits>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t HEAP_SIZE = 48 * 1024;
+constexpr size_t SLOTS     = 256;
+constexpr size_t MAX_SIZE  = 300;
+
+struct Slot
+{
+    uint8_t* ptr  = nullptr;
+    size_t   size = 0;
+};
+
+alignas(8) uint8_t s_heap[HEAP_SIZE];
+
+struct TlsfHeap
+{
+    Tlsf tlsf;
+
+    void* Allocate(size_t size) { return tlsf.Allocate(size); }
+    void* AllocateAligned(size_t size) { return tlsf.AllocateAligned(64, size); }
+    void* Reallocate(void* ptr, size_t size) { return tlsf.Reallocate(ptr, size); }
+    void  Free(void* ptr) { tlsf.Free(ptr); }
+    bool  Check() const { return tlsf.Check(); }
+};
+
+struct HostHeap
+{
+    void* Allocate(size_t size) { return std::malloc(size); }
+    void* AllocateAligned(size_t size) { return std::aligned_alloc(64, (size + 63) & ~63); }
+    void* Reallocate(void* ptr, size_t size) { return std::realloc(ptr, size); }
+    void  Free(void* ptr) { std::free(ptr); }
+    bool  Check() const { return true; }
+};
+
+void Fail(const char* what)
+{
+    std::fprintf(stderr, "Heap corrupted: %s\n", what);
+    std::exit(2);
+}
+
+void Fill(const Slot& slot)
+{
+    std::memset(slot.ptr, static_cast<int>(slot.size), slot.size);
+}
+
+void Verify(const Slot& slot)
+{
+    for (size_t i = 0; i < slot.size; i++)
+    {
+        if (slot.ptr[i] != static_cast<uint8_t>(slot.size))
+        {
+            Fail("a block was overwritten");
+        }
+    }
+}
+
+/**
+ * @brief One operation: frees a random slot if it's taken, fills it otherwise.
+ */
+template<typename Heap>
+Bench::Body Churn()
+{
+    return [](size_t iterations) {
+        static Heap s_heapUnderTest;
+        if constexpr (std::is_same_v<Heap, TlsfHeap>)
+        {
+            if (!s_heapUnderTest.tlsf.Init(s_heap, sizeof(s_heap)))
+            {
+                Fail("Init");
+            }
+        }
+
+        std::mt19937 rng(1234);
+        Slot         slots[SLOTS];
+        for (size_t i = 0; i < iterations; i++)
+        {
+            Slot&    slot = slots[rng() % SLOTS];
+            uint32_t kind = rng() % 16;
+            if (slot.ptr != nullptr && kind != 0)
+            {
+                Verify(slot);
+                s_heapUnderTest.Free(slot.ptr);
+                slot = {};
+                continue;
+            }
+
+            size_t size = 8 + rng() % MAX_SIZE;
+            void*  ptr  = nullptr;
+            if (slot.ptr != nullptr)
+            {
+                Verify(slot);
+                ptr = s_heapUnderTest.Reallocate(slot.ptr, size);
+                if (ptr == nullptr)
+                {
+                    continue;    // Still holds the old block.
+                }
+            }
+            else
+            {
+                ptr = kind == 1 ? s_heapUnderTest.AllocateAligned(size)
+                                : s_heapUnderTest.Allocate(size);
+                if (ptr == nullptr)
+                {
+                    continue;
+                }
+            }
+            slot = {static_cast<uint8_t*>(ptr), size};
+            Fill(slot);
+        }
+
+        for (Slot& slot : slots)
+        {
+            if (slot.ptr != nullptr)
+            {
+                Verify(slot);
+                s_heapUnderTest.Free(slot.ptr);
+            }
+        }
+        if (!s_heapUnderTest.Check())
+        {
+            Fail("the lists don't match the blocks");
+        }
+    };
+}
+
+/**
+ * @brief Allocates and frees one block of 24 bytes, the size of a std::map node.
+ */
+void TlsfPair(size_t iterations)
+{
+    static Tlsf s_tlsf;
+    s_tlsf.Init(s_heap, sizeof(s_heap));
+    for (size_t i = 0; i < iterations; i++)
+    {
+        void* ptr = s_tlsf.Allocate(24);
+        Bench::DoNotOptimize(ptr);
+        s_tlsf.Free(ptr);
+    }
+}
+
+void MallocPair(size_t iterations)
+{
+    for (size_t i = 0; i < iterations; i++)
+    {
+        void* ptr = std::malloc(24);
+        Bench::DoNotOptimize(ptr);
+        std::free(ptr);
+    }
+}
+
+const bool s_registered = [] {
+    Bench::Register("heap/tlsf churn", 0, Churn<TlsfHeap>());
+    Bench::Register("heap/malloc churn", 0, Churn<HostHeap>());
+    Bench::Register("heap/tlsf pair", 0, TlsfPair);
+    Bench::Register("heap/malloc pair", 0, MallocPair);
+    return true;
+}();
+}    // namespace
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,259 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    uploadLoopback.cpp
+ * @brief   Uploads files with tools/upload.py to the FileTransfer, over a pty.
+ *
+ * The target's side is the firmware's FrameLink and FileTransfer, on HostUart and a RamDisk:
+ * the frames are decoded in the RX ring from the "interrupts" of Poll(), and Run() writes the
+ * buffers to the volume in between, as the main loop does. The log lines of the FileTransfer go
+ * on the same pty. upload.py runs on the other end, with pyserial, as it does with the board.
+ *
+ * Each scenario uploads a file of random bytes, which isn't made of whole blocks, over the
+ * previous one, with frames lost or corrupted in both directions. upload.py must succeed, and
+ * the file on the volume must have the same size, bytes and CRC-32 as the one sent, without
+ * UPLOAD.TMP left behind. Exits with 1 otherwise.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "hostUart.h"
+#include "ramDisk.h"
+
+#include "Processes/drivers/uartRxDma.h"
+#include "Processes/drivers/uartTxDma.h"
+#include "Processes/services/crc32.h"
+#include "Processes/services/fileTransfer.h"
+#include "Processes/services/frameLink.h"
+
+#include "NilaiTFO/services/filesystem.h"
+
+#include "ff.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/* Private defines */
+namespace
+{
+constexpr const char* NAME      = "LOOP.BIN";
+constexpr const char* TEMP_NAME = "UPLOAD.TMP";    //!< FileTransfer's.
+constexpr size_t      FILE_SIZE = 200 * FileTransfer::BLOCK_SIZE + 123;
+constexpr double      TIMEOUT   = 120.0;    //!< Per upload, in seconds.
+
+struct Scenario
+{
+    const char* name;
+    double      loss;    //!< Of the frames, in each direction.
+};
+
+const Scenario SCENARIOS[] = {
+  {"no loss", 0.0},
+  {"2% loss", 0.02},
+  {"10% loss", 0.10},
+};
+
+const auto s_start = std::chrono::steady_clock::now();
+
+struct Pty
+{
+    int         master = -1;
+    int         slave  = -1;    //!< Kept open, reading the master fails once nobody has it.
+    const char* path   = nullptr;
+};
+
+bool OpenPty(Pty& pty)
+{
+    pty.master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty.master < 0 || grantpt(pty.master) != 0 || unlockpt(pty.master) != 0)
+    {
+        return false;
+    }
+    pty.path  = ptsname(pty.master);
+    pty.slave = open(pty.path, O_RDWR | O_NOCTTY);
+    if (pty.slave < 0)
+    {
+        return false;
+    }
+    // No echo nor line editing before pyserial sets the port up.
+    termios settings = {};
+    tcgetattr(pty.slave, &settings);
+    cfmakeraw(&settings);
+    tcsetattr(pty.slave, TCSANOW, &settings);
+    return fcntl(pty.master, F_SETFL, fcntl(pty.master, F_GETFL) | O_NONBLOCK) == 0;
+}
+
+bool WriteTemp(const std::vector<uint8_t>& data, char* path)
+{
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        return false;
+    }
+    bool written = write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    close(fd);
+    return written;
+}
+
+pid_t StartUpload(const Pty& pty, const char* file)
+{
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // Only the result is of interest, not the progress.
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        execlp("python3", "python3", UPLOAD_SCRIPT, pty.path, file, "--name", NAME, nullptr);
+        std::perror("python3");
+        _exit(127);
+    }
+    return pid;
+}
+
+/**
+ * @brief Runs the target until upload.py exits.
+ * @returns Its exit status, -1 if it timed out.
+ */
+int RunTarget(pid_t upload, FileTransfer& transfer)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(TIMEOUT);
+    int  status   = 0;
+    while (waitpid(upload, &status, WNOHANG) == 0)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            kill(upload, SIGKILL);
+            waitpid(upload, &status, 0);
+            return -1;
+        }
+        HostUart::Poll();
+        transfer.Run();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+bool Check(const std::vector<uint8_t>& data)
+{
+    FIL file;
+    if (f_open(&file, NAME, FA_READ) != FR_OK)
+    {
+        std::fprintf(stderr, "Upload: %s wasn't created\n", NAME);
+        return false;
+    }
+    std::vector<uint8_t> stored(f_size(&file));
+    UINT                 read = 0;
+    FRESULT res = f_read(&file, stored.data(), static_cast<UINT>(stored.size()), &read);
+    f_close(&file);
+    if (res != FR_OK || read != stored.size() || stored.size() != data.size())
+    {
+        std::fprintf(
+          stderr, "Upload: %zu bytes stored instead of %zu\n", stored.size(), data.size());
+        return false;
+    }
+    uint32_t crc      = Crc32::Compute(stored.data(), stored.size());
+    uint32_t expected = Crc32::Compute(data.data(), data.size());
+    if (stored != data || crc != expected)
+    {
+        std::fprintf(stderr,
+                     "Upload: the content differs, CRC 0x%08X instead of 0x%08X\n",
+                     static_cast<unsigned>(crc),
+                     static_cast<unsigned>(expected));
+        return false;
+    }
+    FILINFO info;
+    if (f_stat(TEMP_NAME, &info) != FR_NO_FILE)
+    {
+        std::fprintf(stderr, "Upload: %s was left behind\n", TEMP_NAME);
+        return false;
+    }
+    return true;
+}
+}    // namespace
+
+extern "C" uint32_t HAL_GetTick()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - s_start)
+                                   .count());
+}
+
+bool cep::Filesystem::IsMounted()
+{
+    return true;
+}
+
+int main()
+{
+    static UART_HandleTypeDef s_uart = {};
+    static DMA_HandleTypeDef  s_rxDma = {};
+    static DMA_HandleTypeDef  s_txDma = {};
+    static UartTxDma          s_tx(&s_uart, &s_txDma);
+    static UartRxDma          s_rx(&s_uart, &s_rxDma, "uartRx");
+    static FileTransfer       s_transfer("fileTransfer");
+
+    Pty pty;
+    if (!RamDisk::Mount() || !OpenPty(pty))
+    {
+        std::perror("Upload: unable to set up the volume or the pty");
+        return 1;
+    }
+    FrameLink::Init(&FileTransfer::OnFrame);
+
+    std::mt19937 rng(2468);
+    bool         passed = true;
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        std::vector<uint8_t> data(FILE_SIZE);
+        for (uint8_t& byte : data)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+        char path[] = "/tmp/uploadLoopbackXXXXXX";
+        if (!WriteTemp(data, path))
+        {
+            std::perror("Upload: unable to write the file to send");
+            return 1;
+        }
+
+        HostUart::Attach(pty.master, scenario.loss, rng());
+        auto   start   = std::chrono::steady_clock::now();
+        int    status  = RunTarget(StartUpload(pty, path), s_transfer);
+        double elapsed =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        unlink(path);
+
+        HostUart::Stats stats = HostUart::GetStats();
+        bool            ok    = status == 0 && Check(data);
+        std::printf("%-10s %s in %.2f s, %u frames lost to the target, %u from it\n",
+                    scenario.name,
+                    ok ? "passed" : "FAILED",
+                    elapsed,
+                    stats.lostRx,
+                    stats.lostTx);
+        if (status != 0)
+        {
+            std::fprintf(stderr, "Upload: upload.py exited with %d\n", status);
+        }
+        passed = passed && ok;
+    }
+    return passed ? 0 : 1;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
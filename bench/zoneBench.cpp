@@ -0,0 +1,95 @@
+/**
+ ******************************************************************************
+ * @addtogroup bench
+ * @{
+ * @file    zoneBench.cpp
+ * @brief   Times the hot paths of the command link with the Profiler's zones, on the host.
+ *
+ * The zones are the same as on target, only backed by std::chrono: the numbers are in
+ * nanoseconds instead of cycles.
+ *
+ * @date 2026/10/18
+ *
+ ******************************************************************************
+ */
+#include "Processes/services/cobs.h"
+#include "Processes/services/crc32.h"
+#include "Processes/services/profiler.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+/*****************************************************************************/
+/* Private functions */
+namespace
+{
+constexpr size_t ITERATIONS = 20000;
+constexpr size_t FRAME_SIZE = 1031;    //!< A FileTransfer block, with its header and CRC.
+
+volatile uint32_t g_sink = 0;
+
+void PrintZones()
+{
+    std::printf("%-14s %8s %8s %8s %8s %8s %8s\n", "zone", "count", "min", "avg", "p50", "p99",
+                "max");
+    for (Profiler::Zone* zone = Profiler::GetFirstZone(); zone != nullptr; zone = zone->GetNext())
+    {
+        Profiler::Stats stats = zone->GetStats();
+        std::printf("%-14s %8u %8u %8u %8u %8u %8u\n",
+                    zone->GetName(),
+                    stats.count,
+                    stats.min,
+                    stats.avg,
+                    stats.p50,
+                    stats.p99,
+                    stats.max);
+    }
+    std::printf("(ns per call)\n");
+}
+}    // namespace
+
+int main()
+{
+    Profiler::Init();
+
+    std::mt19937 rng(1234);
+    uint8_t      frame[FRAME_SIZE];
+    uint8_t      encoded[Cobs::MaxEncodedSize(FRAME_SIZE)];
+    for (uint8_t& byte : frame)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    for (size_t i = 0; i < ITERATIONS; i++)
+    {
+        {
+            PROFILE_ZONE("crc32 1 KiB");
+            g_sink = g_sink + Crc32::Compute(frame, sizeof(frame));
+        }
+
+        size_t len = 0;
+        {
+            PROFILE_ZONE("cobs encode");
+            Cobs::Encode(frame,
+                         sizeof(frame),
+                         [&](const uint8_t* data, size_t n)
+                         {
+                             std::memcpy(&encoded[len], data, n);
+                             len += n;
+                         });
+        }
+        {
+            PROFILE_ZONE("cobs decode");
+            g_sink = g_sink + Cobs::DecodeInPlace(encoded, len);
+        }
+    }
+
+    PrintZones();
+    return 0;
+}
+
+/**
+ * @}
+ */
+/****** END OF FILE ******/
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+Packs files into an asset bundle for the DATA_FLASH (see Processes/services/assetFs.h).
+
+The paths in the bundle are those of the files relative to the packed directory, uppercased and
+with '/' as separator, as they would be on the SD card. The bundle is then flashed on its own,
+at the start of the second bank:
+    openocd -f <board>.cfg -c "program build/assets.bin 0x08100000 verify reset exit"
+
+Usage:
+    assetpack.py assets/ build/assets.bin
+    assetpack.py --list build/assets.bin
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = 0x3142414E    # "NAB1"
+VERSION = 2
+ALIGN = 4
+MAX_SIZE = 2048 * 1024    # _Assets_Size in the linker script.
+
+HEADER = struct.Struct("<IHHIIII")
+ENTRY = struct.Struct("<IIIII")
+
+
+def fnv1a(path):
+    value = 2166136261
+    for byte in path.upper().encode("ascii"):
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def collect(root):
+    files = []
+    for directory, _, names in os.walk(root):
+        for name in names:
+            full = os.path.join(directory, name)
+            path = os.path.relpath(full, root).replace(os.sep, "/").upper()
+            files.append((path, full))
+    return files
+
+
+def pack(files):
+    entries = sorted(((fnv1a(path), path, full) for path, full in files))
+    for (_, first, _), (_, second, _) in zip(entries, entries[1:]):
+        if first == second:
+            sys.exit("Two files are packed as {}".format(first))
+
+    names = bytearray()
+    name_offsets = []
+    names_start = HEADER.size + ENTRY.size * len(entries)
+    for _, path, _ in entries:
+        name_offsets.append(names_start + len(names))
+        names += path.encode("ascii") + b"\0"
+
+    data_offset = names_start + len(names)
+    data = bytearray()
+    index = bytearray()
+    for (hash_, _, full), name in zip(entries, name_offsets):
+        data += b"\0" * (-(data_offset + len(data)) % ALIGN)
+        with open(full, "rb") as f:
+            content = f.read()
+        index += ENTRY.pack(hash_, name, data_offset + len(data), len(content), zlib.crc32(content))
+        data += content
+
+    size = data_offset + len(data)
+    header = HEADER.pack(MAGIC, VERSION, len(entries), size, data_offset,
+                         zlib.crc32(bytes(index + names)), zlib.crc32(bytes(data)))
+    return header + index + names + data
+
+
+def list_bundle(bundle):
+    magic, version, count, size, _, _, _ = HEADER.unpack_from(bundle)
+    if magic != MAGIC or version != VERSION:
+        sys.exit("Not an asset bundle")
+    print("{} files, {} bytes".format(count, size))
+    for i in range(count):
+        _, name, offset, length, _ = ENTRY.unpack_from(bundle, HEADER.size + i * ENTRY.size)
+        path = bundle[name:bundle.index(b"\0", name)].decode("ascii")
+        print("{:>10} @0x{:06X}  {}".format(length, offset, path))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="Directory to pack, or the bundle with --list")
+    parser.add_argument("output", nargs="?", help="Bundle to write")
+    parser.add_argument("--list", action="store_true", help="List the files of a bundle")
+    args = parser.parse_args()
+
+    if args.list:
+        with open(args.input, "rb") as f:
+            list_bundle(f.read())
+        return
+    if args.output is None:
+        parser.error("the output bundle is required")
+
+    files = collect(args.input)
+    bundle = pack(files)
+    if len(bundle) > MAX_SIZE:
+        sys.exit("The bundle takes {} bytes, only {} fit".format(len(bundle), MAX_SIZE))
+    with open(args.output, "wb") as f:
+        f.write(bundle)
+    print("{} files, {} bytes".format(len(files), len(bundle)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+"""
+Reference decoders of the compressed audio the firmware plays (see Processes/services/imaAdpcm.h
+and Processes/services/qoa.h), to check it bit for bit.
+
+IMA-ADPCM is decoded by Python's audioop, an implementation of the IMA reference decoder of its
+own. QOA is a line by line transcription of the decoder of the reference qoa.h (qoaformat.org).
+Both output 16-bit stereo, mono on both channels, as the firmware's decoders do.
+
+"vectors" decodes the streams that bench/codecBench.cpp generates, from the same xorshift32, and
+prints the CRC32 of their output: the values codecBench.cpp expects.
+
+Usage:
+    audioref.py decode SOUNDS/BOOT.WAV boot.raw
+    audioref.py vectors
+"""
+
+import argparse
+import struct
+import sys
+import warnings
+import zlib
+
+with warnings.catch_warnings():
+    warnings.simplefilter("ignore", DeprecationWarning)
+    import audioop
+
+WAVE_FORMAT_IMA_ADPCM = 0x0011
+
+
+def to_stereo(channels):
+    """Interleaves the channels' samples as 16-bit stereo."""
+    if len(channels) == 1:
+        channels = channels * 2
+    out = bytearray()
+    for left, right in zip(*channels):
+        out += struct.pack("<hh", left, right)
+    return bytes(out)
+
+
+# --- IMA-ADPCM ---------------------------------------------------------------------------------
+
+def ima_frames_per_block(block_align, channels):
+    if block_align < 4 * channels:
+        return 0
+    return 1 + (block_align - 4 * channels) // (4 * channels) * 8
+
+
+def ima_decode(data, channels, block_align):
+    out = [[] for _ in range(channels)]
+    for start in range(0, len(data), block_align):
+        block = data[start:start + block_align]
+        frames = ima_frames_per_block(len(block), channels)
+        if frames == 0:
+            break
+        groups = (frames - 1) // 8
+        for channel in range(channels):
+            sample, index = struct.unpack_from("<hB", block, channel * 4)
+            # The nibbles of the channel, high nibble first for audioop.
+            nibbles = bytearray()
+            for group in range(groups):
+                offset = 4 * channels * (1 + group) + 4 * channel
+                nibbles += bytes(((b & 0x0F) << 4) | (b >> 4) for b in block[offset:offset + 4])
+            decoded, _ = audioop.adpcm2lin(bytes(nibbles), 2, (sample, min(index, 88)))
+            out[channel].append(sample)
+            out[channel] += struct.unpack("<%dh" % (len(decoded) // 2), decoded)
+    return to_stereo(out)
+
+
+def wav_decode(file):
+    if file[0:4] != b"RIFF" or file[8:12] != b"WAVE":
+        raise ValueError("not a WAVE file")
+    fmt = None
+    offset = 12
+    while offset + 8 <= len(file):
+        tag, size = struct.unpack_from("<4sI", file, offset)
+        body = file[offset + 8:offset + 8 + size]
+        if tag == b"fmt ":
+            fmt = struct.unpack_from("<HHIIHH", body)
+        elif tag == b"data":
+            if fmt is None or fmt[0] != WAVE_FORMAT_IMA_ADPCM:
+                raise ValueError("not IMA-ADPCM")
+            return ima_decode(body, fmt[1], fmt[4])
+        offset += 8 + size + (size & 1)
+    raise ValueError("no data chunk")
+
+
+# --- QOA ---------------------------------------------------------------------------------------
+
+QOA_SLICE_LEN = 20
+QOA_LMS_LEN = 4
+QOA_SCALEFACTOR_TAB = [1, 7, 21, 45, 84, 138, 211, 304, 421, 562, 731, 928, 1157, 1419, 1715,
+                       2048]
+QOA_DEQUANT_LIST = [0.75, -0.75, 2.5, -2.5, 4.5, -4.5, 7, -7]
+
+
+def qoa_round(x):
+    return int(-((-x + 0.5) // 1)) if x < 0 else int((x + 0.5) // 1)
+
+
+QOA_DEQUANT_TAB = [[qoa_round(s * d) for d in QOA_DEQUANT_LIST] for s in QOA_SCALEFACTOR_TAB]
+
+
+def qoa_clamp_s16(v):
+    return max(-32768, min(32767, v))
+
+
+def qoa_lms_predict(lms):
+    prediction = sum(w * h for w, h in zip(lms["weights"], lms["history"]))
+    # The reference uses ints: the firmware's int32_t must not overflow either.
+    assert -2**31 <= prediction < 2**31, "the LMS overflows an int"
+    return prediction >> 13
+
+
+def qoa_lms_update(lms, sample, residual):
+    delta = residual >> 4
+    for i in range(QOA_LMS_LEN):
+        lms["weights"][i] += -delta if lms["history"][i] < 0 else delta
+    lms["history"] = lms["history"][1:] + [sample]
+
+
+def qoa_unpack(value):
+    out = []
+    for _ in range(QOA_LMS_LEN):
+        out.append(struct.unpack(">h", struct.pack(">H", value >> 48))[0])
+        value = (value << 16) & 0xFFFFFFFFFFFFFFFF
+    return out
+
+
+def qoa_decode(file):
+    magic, samples = struct.unpack_from(">4sI", file, 0)
+    if magic != b"qoaf" or samples == 0:
+        raise ValueError("not a QOA file, or streamed")
+    channels = file[8]
+    out = [[] for _ in range(channels)]
+    offset = 8
+    while offset < len(file):
+        header, = struct.unpack_from(">Q", file, offset)
+        frame_samples = (header >> 16) & 0xFFFF
+        frame_size = header & 0xFFFF
+        if header >> 56 != channels:
+            raise ValueError("the channels change")
+        p = offset + 8
+        lms = []
+        for _ in range(channels):
+            history, weights = struct.unpack_from(">QQ", file, p)
+            lms.append({"history": qoa_unpack(history), "weights": qoa_unpack(weights)})
+            p += 16
+
+        sample_data = [0] * (frame_samples * channels)
+        for sample_index in range(0, frame_samples, QOA_SLICE_LEN):
+            for c in range(channels):
+                slice_, = struct.unpack_from(">Q", file, p)
+                p += 8
+                scalefactor = (slice_ >> 60) & 0xF
+                slice_ = (slice_ << 4) & 0xFFFFFFFFFFFFFFFF
+                slice_start = sample_index * channels + c
+                slice_end = min(sample_index + QOA_SLICE_LEN, frame_samples) * channels + c
+                for si in range(slice_start, slice_end, channels):
+                    predicted = qoa_lms_predict(lms[c])
+                    quantized = (slice_ >> 61) & 0x7
+                    dequantized = QOA_DEQUANT_TAB[scalefactor][quantized]
+                    reconstructed = qoa_clamp_s16(predicted + dequantized)
+                    sample_data[si] = reconstructed
+                    slice_ = (slice_ << 3) & 0xFFFFFFFFFFFFFFFF
+                    qoa_lms_update(lms[c], reconstructed, dequantized)
+        for c in range(channels):
+            out[c] += sample_data[c::channels]
+        offset += frame_size
+    return to_stereo(out)
+
+
+# --- Vectors of codecBench.cpp -----------------------------------------------------------------
+
+class XorShift32:
+    def __init__(self, seed):
+        self.state = seed
+
+    def __call__(self):
+        x = self.state
+        x ^= (x << 13) & 0xFFFFFFFF
+        x ^= x >> 17
+        x ^= (x << 5) & 0xFFFFFFFF
+        self.state = x
+        return x
+
+
+def ima_vector(channels, block_align, size, seed):
+    """Random nibbles, behind headers with valid step indices."""
+    rng = XorShift32(seed)
+    data = bytearray(rng() & 0xFF for _ in range(size))
+    for start in range(0, size, block_align):
+        for channel in range(channels):
+            index = start + channel * 4 + 2
+            if index + 1 < size:
+                data[index] %= 89
+                data[index + 1] = 0
+    return bytes(data)
+
+
+def qoa_vector(channels, frames, seed):
+    """Random residuals of scale factors 0 to 3, from a random LMS state."""
+    rng = XorShift32(seed)
+    out = bytearray(b"qoaf" + struct.pack(">I", sum(frames)))
+    for samples in frames:
+        slices = (samples + QOA_SLICE_LEN - 1) // QOA_SLICE_LEN * channels
+        size = 8 + 16 * channels + 8 * slices
+        out += struct.pack(">Q", channels << 56 | 48000 << 32 | samples << 16 | size)
+        for _ in range(channels * 2 * QOA_LMS_LEN):
+            value = struct.unpack(">h", struct.pack(">H", rng() & 0xFFFF))[0] >> 2
+            out += struct.pack(">h", value)
+        for _ in range(slices):
+            slice_ = bytearray(rng() & 0xFF for _ in range(8))
+            slice_[0] &= 0x3F
+            out += slice_
+    return bytes(out)
+
+
+IMA_VECTORS = [
+    # channels, block_align, size, seed
+    (1, 256, 256 * 3 + 4 + 4 * 5 + 3, 1),
+    (2, 512, 512 * 2 + 8 + 8 * 7 + 5, 2),
+]
+
+QOA_VECTORS = [
+    # channels, frame samples, seed
+    (1, [5120, 5120, 1337], 3),
+    (2, [5120, 999], 4),
+]
+
+
+def print_vectors():
+    for channels, block_align, size, seed in IMA_VECTORS:
+        pcm = ima_decode(ima_vector(channels, block_align, size, seed), channels, block_align)
+        print("ima %d ch, %d B blocks: %d frames, crc 0x%08X"
+              % (channels, block_align, len(pcm) // 4, zlib.crc32(pcm)))
+    for channels, frames, seed in QOA_VECTORS:
+        pcm = qoa_decode(qoa_vector(channels, frames, seed))
+        print("qoa %d ch, %s: %d frames, crc 0x%08X"
+              % (channels, frames, len(pcm) // 4, zlib.crc32(pcm)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+    decode = commands.add_parser("decode", help="Decodes a .wav or .qoa to raw 16-bit stereo.")
+    decode.add_argument("input")
+    decode.add_argument("output")
+    commands.add_parser("vectors", help="Prints the CRC32s that codecBench.cpp expects.")
+    args = parser.parse_args()
+
+    if args.command == "vectors":
+        print_vectors()
+        return 0
+
+    with open(args.input, "rb") as f:
+        file = f.read()
+    pcm = qoa_decode(file) if file[0:4] == b"qoaf" else wav_decode(file)
+    with open(args.output, "wb") as f:
+        f.write(pcm)
+    print("%d frames, crc 0x%08X" % (len(pcm) // 4, zlib.crc32(pcm)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+Decodes the binary logs sent when APP_LOG_BINARY is set (see Processes/services/binaryLog.h).
+
+The format strings are read from the .nilai_log_fmt section of the firmware's ELF, the log stream
+from a capture file, a serial port or stdin. Plain text found between the frames is printed as is.
+
+Usage:
+    logdecode.py NilaiIni.elf capture.bin
+    logdecode.py NilaiIni.elf /dev/ttyUSB0 --baud 460800
+    cat capture.bin | logdecode.py NilaiIni.elf
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SECTION_NAME = ".nilai_log_fmt"
+FRAME_START = 0xB1
+FIELD_SEPARATOR = "\x1f"
+
+# Replacement field of the format engine (Processes/services/format.h), or an escaped brace.
+FIELD_RE = re.compile(r"\{\{|\}\}|\{(?::([<>]?)(0?)(\d*)(?:\.(\d+))?([a-zA-Z]?))?\}")
+
+# Fmt::Arg::Type tags, in order: struct format and size of the value.
+ARG_TYPES = [
+    ("int", "<i", 4),
+    ("uint", "<I", 4),
+    ("int64", "<q", 8),
+    ("uint64", "<Q", 8),
+    ("float", "<f", 4),
+    ("bool", "<?", 1),
+    ("char", "<c", 1),
+    ("string", None, 0),
+    ("pointer", "<I", 4),
+]
+
+
+def read_section(elf_path, name):
+    """Returns the content of a section of an ELF file (32 or 64-bit, little-endian)."""
+    with open(elf_path, "rb") as f:
+        data = f.read()
+
+    if data[:4] != b"\x7fELF":
+        raise ValueError(f"{elf_path} is not an ELF file")
+    is64 = data[4] == 2
+    if is64:
+        shoff, = struct.unpack_from("<Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x3A)
+        header_fmt, name_at, offset_at, size_at = "<IIQQQQ", 0, 4, 5
+    else:
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        header_fmt, name_at, offset_at, size_at = "<IIIIII", 0, 4, 5
+
+    headers = [struct.unpack_from(header_fmt, data, shoff + i * shentsize) for i in range(shnum)]
+    strtab = headers[shstrndx]
+    names = data[strtab[offset_at]:strtab[offset_at] + strtab[size_at]]
+
+    for header in headers:
+        start = header[name_at]
+        section_name = names[start:names.index(b"\0", start)].decode()
+        if section_name == name:
+            return data[header[offset_at]:header[offset_at] + header[size_at]]
+    raise ValueError(f"{elf_path} has no {name} section, was it built with APP_LOG_BINARY?")
+
+
+def load_table(elf_path):
+    """Maps the offset of each format string to its (level, location, format)."""
+    section = read_section(elf_path, SECTION_NAME)
+    table = {}
+    offset = 0
+    while offset < len(section):
+        end = section.find(b"\0", offset)
+        if end < 0:
+            break
+        entry = section[offset:end].decode(errors="replace")
+        if entry:
+            level, location, fmt = entry.split(FIELD_SEPARATOR, 2)
+            table[offset] = (level, location, fmt)
+        offset = end + 1
+    return table
+
+
+def unpack_args(data):
+    """Unpacks the tagged arguments of a frame."""
+    args = []
+    pos = 0
+    while pos < len(data):
+        kind, fmt, size = ARG_TYPES[data[pos]]
+        pos += 1
+        if kind == "string":
+            end = data.index(b"\0", pos) if b"\0" in data[pos:] else len(data)
+            args.append((kind, data[pos:end].decode(errors="replace")))
+            pos = end + 1
+        else:
+            value, = struct.unpack_from(fmt, data, pos)
+            args.append((kind, value.decode(errors="replace") if kind == "char" else value))
+            pos += size
+    return args
+
+
+def format_arg(kind, value, align, zero, width, precision, conversion):
+    """Formats one argument the way the format engine does."""
+    if kind == "float":
+        conversion = "f"
+        precision = precision or "6"
+    elif kind == "pointer":
+        value = f"0x{value:08x}"
+        kind, conversion = "string", ""
+    elif kind == "bool":
+        if conversion == "d":
+            value = int(value)
+        else:
+            value, conversion = ("true" if value else "false"), ""
+    elif kind == "char" and conversion in ("d", "x", "X"):
+        value = ord(value)
+    elif kind in ("int", "uint", "int64", "uint64") and conversion == "c":
+        value = chr(value & 0xFF)
+        conversion = ""
+    spec = align + zero + width + ("." + precision if precision else "") + conversion
+    return format(value, spec)
+
+
+def format_message(fmt, args):
+    """Replaces the fields of the format string by the arguments."""
+    remaining = iter(args)
+
+    def replace(match):
+        if match.group(0) in ("{{", "}}"):
+            return match.group(0)[0]
+        kind, value = next(remaining)
+        align, zero, width, precision, conversion = match.groups(default="")
+        return format_arg(kind, value, align, zero, width, precision, conversion)
+
+    return FIELD_RE.sub(replace, fmt)
+
+
+def decode(stream, table, output, follow=False):
+    """Splits the stream in frames and text, and writes the decoded lines to output."""
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if follow:
+                continue    # Serial port timeout.
+            break
+        buffer += chunk
+
+        while buffer:
+            start = buffer.find(bytes([FRAME_START]))
+            if start != 0:
+                text = buffer if start < 0 else buffer[:start]
+                output.write(text.decode(errors="replace"))
+                del buffer[:len(text)]
+                continue
+
+            if len(buffer) < 2 or len(buffer) < buffer[1] + 3:
+                break    # Incomplete frame, wait for more data.
+
+            length = buffer[1]
+            payload = bytes(buffer[2:2 + length])
+            checksum = 0
+            for byte in payload:
+                checksum ^= byte
+            if length < 6 or checksum != buffer[2 + length]:
+                # Not a frame after all, resynchronize on the next start byte.
+                del buffer[:1]
+                continue
+            del buffer[:length + 3]
+
+            log_id, tick = struct.unpack_from("<HI", payload)
+            if log_id not in table:
+                output.write(f"[{tick}] [?]: unknown log ID {log_id}, is the ELF up to date?\n")
+                continue
+            level, location, fmt = table[log_id]
+            try:
+                message = format_message(fmt, unpack_args(payload[6:]))
+            except (struct.error, ValueError, TypeError, IndexError, StopIteration) as e:
+                message = f"{fmt} (undecodable arguments: {e})"
+            output.write(f"[{tick}] [{level}]: {message}\n")
+        output.flush()
+
+
+def open_input(source, baud):
+    """Returns the stream to decode and whether it's a serial port that never ends."""
+    if source is None or source == "-":
+        return sys.stdin.buffer, False
+    if os.path.exists(source) and not source.startswith("/dev/"):
+        return open(source, "rb"), False
+    try:
+        import serial
+    except ImportError:
+        sys.exit("Reading from a serial port requires pyserial (pip install pyserial)")
+    return serial.Serial(source, baud, timeout=0.1), True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="Firmware ELF that produced the logs")
+    parser.add_argument("source", nargs="?", help="Capture file or serial port, stdin if omitted")
+    parser.add_argument("--baud", type=int, default=460800, help="Baud rate of the serial port")
+    parser.add_argument("--locations", action="store_true", help="Print the file:line of logs")
+    args = parser.parse_args()
+
+    table = load_table(args.elf)
+    if args.locations:
+        table = {k: (level, location, f"{fmt} ({location})")
+                 for k, (level, location, fmt) in table.items()}
+    stream, follow = open_input(args.source, args.baud)
+    decode(stream, table, sys.stdout, follow)
+
+
+if __name__ == "__main__":
+    main()
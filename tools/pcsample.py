@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+"""
+Samples where the target spends its time and symbolizes the samples against the firmware (see
+Processes/services/pcSampler.h).
+
+The functions are named from the ELF through nm, the object files they come from are read from
+the .map written by the link. Either one is enough: without the ELF the functions are taken from
+the map, which lists every function in its own section since the firmware is built with
+-ffunction-sections.
+
+Usage:
+    pcsample.py /dev/ttyUSB0 --elf build/derisking_sd_dac_i2s.elf --map build/derisking_sd_dac_i2s.map
+    pcsample.py /dev/ttyUSB0 --map build/derisking_sd_dac_i2s.map --seconds 30 --rate 20000
+    pcsample.py --load samples.csv --elf build/derisking_sd_dac_i2s.elf
+"""
+
+import argparse
+import bisect
+import collections
+import csv
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import time
+
+from upload import Link
+from umo import CommandError, request
+
+START, STOP, SAMPLES = 0x20, 0x21, 0x22
+SLOT_COUNT = 512
+
+
+class Symbols:
+    """Address ranges, sorted, each with a name."""
+
+    def __init__(self, ranges):
+        ranges.sort()
+        self.starts = [start for start, _, _ in ranges]
+        self.ranges = ranges
+
+    def lookup(self, address):
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i < 0:
+            return None
+        start, end, name = self.ranges[i]
+        if end is None:
+            end = self.starts[i + 1] if i + 1 < len(self.starts) else start + 0x1000
+        return name if address < end else None
+
+
+def demangle(names):
+    tool = shutil.which("arm-none-eabi-c++filt") or shutil.which("c++filt")
+    if tool is None or not names:
+        return {name: name for name in names}
+    out = subprocess.run([tool], input="\n".join(names), capture_output=True, text=True).stdout
+    return dict(zip(names, out.splitlines()))
+
+
+def read_elf(path, nm):
+    """Functions of the ELF, from nm."""
+    out = subprocess.run([nm, "-n", "-S", "-C", "--defined-only", path], capture_output=True,
+                         text=True, check=True).stdout
+    ranges = []
+    for line in out.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in "tTwW":
+            start = int(fields[0], 16) & ~1    # Thumb functions have their bit 0 set.
+            ranges.append((start, start + int(fields[1], 16), fields[3]))
+        elif len(fields) == 3 and fields[1] in "tTwW":
+            ranges.append((int(fields[0], 16) & ~1, None, fields[2]))
+    return Symbols(ranges)
+
+
+SECTION = re.compile(r"^ (\.\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*))?$")
+CONTINUATION = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$")
+SYMBOL = re.compile(r"^\s+0x([0-9a-f]+)\s+([A-Za-z_][\w.$]*)$")
+
+
+def read_map(path):
+    """Returns (functions, object files) of the map's input sections."""
+    sections = []    # (start, end, section name, object file)
+    symbols = []     # (address, name)
+    pending = None
+    with open(path, errors="replace") as f:
+        in_memory_map = False
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                in_memory_map = True
+                continue
+            if not in_memory_map:
+                continue
+
+            match = SECTION.match(line)
+            if match:
+                pending = match.group(1)
+                if match.group(2) is not None:
+                    sections.append((int(match.group(2), 16), int(match.group(3), 16),
+                                     pending, match.group(4)))
+                    pending = None
+                continue
+            match = CONTINUATION.match(line)
+            if match and pending is not None:
+                sections.append((int(match.group(1), 16), int(match.group(2), 16), pending,
+                                 match.group(3)))
+                pending = None
+                continue
+            match = SYMBOL.match(line)
+            if match:
+                symbols.append((int(match.group(1), 16), match.group(2)))
+
+    sections = [(start, start + size, name, obj) for start, size, name, obj in sections
+                if size != 0 and (name.startswith(".text") or name.startswith(".ramfunc"))]
+    sections.sort()
+    symbols.sort()
+    starts = [start for start, _ in symbols]
+
+    functions = []
+    for start, end, name, _ in sections:
+        inside = symbols[bisect.bisect_left(starts, start):bisect.bisect_left(starts, end)]
+        if inside:
+            bounds = [address for address, _ in inside[1:]] + [end]
+            functions += [(address, bound, symbol)
+                          for (address, symbol), bound in zip(inside, bounds)]
+            if inside[0][0] > start:
+                functions.append((start, inside[0][0], name))
+        else:
+            # With -ffunction-sections, static functions only show as their section.
+            prefix = ".ramfunc." if name.startswith(".ramfunc.") else ".text."
+            functions.append((start, end, name[len(prefix):] if name.startswith(prefix) else name))
+
+    names = demangle(sorted({name for _, _, name in functions}))
+    functions = [(start, end, names.get(name, name)) for start, end, name in functions]
+    objects = [(start, end, short_object(obj)) for start, end, _, obj in sections]
+    return Symbols(functions), Symbols(objects)
+
+
+def short_object(path):
+    """CMakeFiles/x.elf.dir/Middlewares/.../ff.c.obj -> ff.c, lib_a-memcpy.o stays as is."""
+    member = re.search(r"\(([^)]+)\)$", path)
+    if member:
+        return member.group(1)
+    name = os.path.basename(path)
+    for suffix in (".obj", ".o"):
+        if name.endswith(suffix):
+            return name[:-len(suffix)]
+    return name
+
+
+def collect(link, rate, seconds):
+    request(link, START, struct.pack("<H", rate))
+    end = time.monotonic() + seconds
+    while time.monotonic() < end:
+        time.sleep(min(0.5, max(0, end - time.monotonic())))
+        sys.stderr.write("\rSampling... {:.0f} s left ".format(max(0, end - time.monotonic())))
+    sys.stderr.write("\n")
+    request(link, STOP)
+
+    samples = {}
+    slot = 0
+    total = dropped = 0
+    while slot < SLOT_COUNT:
+        reply = request(link, SAMPLES, struct.pack("<H", slot))
+        slot, total, dropped = struct.unpack_from("<HII", reply)
+        for pc, count in struct.iter_unpack("<II", reply[10:]):
+            samples[pc] = count
+    return samples, total, dropped
+
+
+def report(samples, total, dropped, functions, objects, top):
+    counted = sum(samples.values())
+    print("{} samples, {} distinct PCs, {} dropped".format(total, len(samples), dropped))
+    if counted == 0:
+        return
+
+    by_function = collections.Counter()
+    by_object = collections.Counter()
+    for pc, count in samples.items():
+        function = functions.lookup(pc) if functions else None
+        by_function[function or "0x{:08x}".format(pc)] += count
+        obj = objects.lookup(pc) if objects else None
+        by_object[obj or "?"] += count
+
+    print("\n{:>6} {:>8}  {}".format("%", "samples", "function"))
+    for name, count in by_function.most_common(top):
+        print("{:>6.2f} {:>8}  {}".format(100 * count / counted, count, name))
+    if objects:
+        print("\n{:>6} {:>8}  {}".format("%", "samples", "object"))
+        for name, count in by_object.most_common(top):
+            print("{:>6.2f} {:>8}  {}".format(100 * count / counted, count, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", nargs="?", help="Serial port of the target, or a pty")
+    parser.add_argument("--baud", type=int, default=460800, help="Baud rate of the serial port")
+    parser.add_argument("--rate", type=int, default=10000, help="Samples per second")
+    parser.add_argument("--seconds", type=float, default=10, help="How long to sample")
+    parser.add_argument("--elf", help="Firmware, to name the functions")
+    parser.add_argument("--map", help="Map of the link, to name the object files")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain")
+    parser.add_argument("--top", type=int, default=25, help="Lines per table")
+    parser.add_argument("--save", help="Write the raw samples to a CSV")
+    parser.add_argument("--load", help="Symbolize a CSV written by --save instead of sampling")
+    parser.add_argument("--verbose", action="store_true", help="Print the target's logs")
+    args = parser.parse_args()
+
+    if args.load:
+        with open(args.load) as f:
+            rows = list(csv.reader(f))
+        total, dropped = int(rows[0][1]), int(rows[0][2])
+        samples = {int(pc, 16): int(count) for pc, count in rows[1:]}
+    elif args.port:
+        try:
+            import serial
+        except ImportError:
+            sys.exit("pcsample.py requires pyserial (pip install pyserial)")
+        with serial.Serial(args.port, args.baud, timeout=0.05) as port:
+            try:
+                samples, total, dropped = collect(Link(port, args.verbose), args.rate,
+                                                  args.seconds)
+            except CommandError as e:
+                sys.exit("Sampling failed: {}".format(e))
+    else:
+        parser.error("a port or --load is required")
+
+    if args.save:
+        with open(args.save, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["total", total, dropped])
+            writer.writerows(("0x{:08x}".format(pc), count) for pc, count in sorted(samples.items()))
+
+    functions, objects = None, None
+    if args.map:
+        functions, objects = read_map(args.map)
+    if args.elf:
+        functions = read_elf(args.elf, args.nm)
+    report(samples, total, dropped, functions, objects, args.top)
+
+
+if __name__ == "__main__":
+    main()
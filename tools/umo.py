@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""
+Sends commands to the target's dispatcher over the log UART (see
+Processes/services/umoDispatcher.h).
+
+Usage:
+    umo.py /dev/ttyUSB0 ping
+    umo.py /dev/ttyUSB0 stats
+    umo.py /dev/ttyUSB0 config AUDIO volume
+    umo.py /dev/ttyUSB0 profile
+    umo.py /dev/ttyUSB0 profile --reset
+    umo.py /dev/ttyUSB0 disk --log
+    umo.py /dev/ttyUSB0 mem
+    umo.py /dev/ttyUSB0 sdbench
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+from upload import Link
+
+PING, GET_STATS, GET_CONFIG, GET_PROFILE, RESET_PROFILE = 0x01, 0x02, 0x03, 0x04, 0x05
+GET_DISK_STATS, GET_MEMORY = 0x06, 0x07
+START_SD_BENCHMARK, GET_SD_BENCHMARK = 0x28, 0x29
+RESPONSE, ERROR_ID = 0x80, 0xFF
+
+ERRORS = {1: "unknown command", 2: "busy", 3: "invalid request", 4: "not found"}
+STATS = ["uptime (ms)", "frames received", "CRC errors", "framing errors", "RX overruns",
+         "log messages dropped", "unknown commands"]
+DISK_OPS = ["read", "write", "ioctl"]
+DISK_OP_FIELDS = ["calls", "errors", "sectors", "multi", "B/s", "avg us", "p50 us", "p99 us",
+                  "max us"]
+DISK_LINK = ["busy waits", "busy timeouts", "busy time (ms)", "longest busy (us)",
+             "token timeouts", "token wait (ms)", "failed commands", "init retries",
+             "rejected blocks"]
+DISK_STATS_LOG, DISK_STATS_RESET = 0x01, 0x02
+MEMORY = ["heap in use (B)", "heap peak (B)", "blocks", "allocations", "failed allocations",
+          "arena (B)", "free in arena (B)", "largest free block (B)", "stack reserved (B)",
+          "stack used (B)", "stack headroom (B)"]
+MEMORY_LOG = 0x01
+SD_BENCHMARK_STATES = ["idle", "running", "passed", "failed", "error"]
+
+TIMEOUT = 1.0
+RETRIES = 3
+
+
+class CommandError(Exception):
+    pass
+
+
+def request(link, command, body=b""):
+    """Returns the body of the response to a command."""
+    for _ in range(RETRIES):
+        link.send(command, body)
+        deadline = time.monotonic() + TIMEOUT
+        while time.monotonic() < deadline:
+            for frame_id, reply in link.receive():
+                if frame_id == command | RESPONSE:
+                    return reply
+                if frame_id == ERROR_ID and len(reply) == 2 and reply[0] == command:
+                    raise CommandError(ERRORS.get(reply[1], "error {}".format(reply[1])))
+    raise CommandError("no answer from the target")
+
+
+def ping(link, _args):
+    payload = bytes(range(16))
+    start = time.monotonic()
+    if request(link, PING, payload) != payload:
+        raise CommandError("corrupted echo")
+    print("pong in {:.1f} ms".format((time.monotonic() - start) * 1e3))
+
+
+def stats(link, _args):
+    reply = request(link, GET_STATS)
+    for name, value in zip(STATS, struct.unpack("<{}I".format(len(reply) // 4), reply)):
+        print("{:<18} {}".format(name, value))
+
+
+def config(link, args):
+    body = args.section.encode("ascii") + b"\x00" + args.key.encode("ascii") + b"\x00"
+    print(request(link, GET_CONFIG, body).decode("ascii", "replace"))
+
+
+def profile(link, args):
+    if args.reset:
+        request(link, RESET_PROFILE)
+        return
+
+    header = struct.Struct("<BB7I")
+    rows = []
+    index, count = 0, 1
+    while index < count:
+        reply = request(link, GET_PROFILE, bytes([index]))
+        _, count, per_second, *values = header.unpack_from(reply)
+        name = reply[header.size:].decode("ascii", "replace")
+        n, *ticks = values
+        rows.append((name, n, [t * 1e6 / per_second for t in ticks]))
+        index += 1
+
+    print("{:<16} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}".format(
+        "zone", "count", "min", "avg", "max", "p50", "p99"))
+    for name, n, times in sorted(rows):
+        print("{:<16} {:>8} ".format(name, n) + " ".join("{:>10.2f}".format(t) for t in times))
+    print("(µs)")
+
+
+def disk(link, args):
+    flags = (DISK_STATS_LOG if args.log else 0) | (DISK_STATS_RESET if args.reset else 0)
+    reply = request(link, GET_DISK_STATS, bytes([flags]))
+    values = struct.unpack("<{}I".format(len(reply) // 4), reply)
+
+    print("{:<6}".format("") + "".join("{:>10}".format(field) for field in DISK_OP_FIELDS))
+    for i, op in enumerate(DISK_OPS):
+        row = values[i * len(DISK_OP_FIELDS):(i + 1) * len(DISK_OP_FIELDS)]
+        print("{:<6}".format(op) + "".join("{:>10}".format(value) for value in row))
+    print()
+    for name, value in zip(DISK_LINK, values[len(DISK_OPS) * len(DISK_OP_FIELDS):]):
+        print("{:<18} {}".format(name, value))
+
+
+def mem(link, args):
+    owners = []
+    first, count = 0, 1
+    flags = MEMORY_LOG if args.log else 0
+    while first < count:
+        # Logged once, with the first page.
+        reply = request(link, GET_MEMORY, bytes([first, flags if first == 0 else 0]))
+        values = struct.unpack_from("<{}I".format(len(MEMORY)), reply)
+        pos = len(MEMORY) * 4
+        count = reply[pos]
+        pos += 2
+        while pos < len(reply):
+            counters = struct.unpack_from("<4I", reply, pos)
+            name_len = reply[pos + 16]
+            name = reply[pos + 17:pos + 17 + name_len].decode(errors="replace")
+            owners.append((name,) + counters)
+            pos += 17 + name_len
+        if len(owners) == first:
+            raise CommandError("truncated answer")
+        first = len(owners)
+
+    for name, value in zip(MEMORY, values):
+        print("{:<24} {}".format(name, value))
+    print()
+    print("{:<20} {:>8} {:>8} {:>10} {:>10}".format("owner", "allocs", "frees", "alloc B",
+                                                    "live B"))
+    for name, allocs, frees, allocated, freed in owners:
+        print("{:<20} {:>8} {:>8} {:>10} {:>10}".format(name, allocs, frees, allocated,
+                                                        allocated - freed))
+
+
+def sdbench(link, _args):
+    request(link, START_SD_BENCHMARK)
+    while True:
+        time.sleep(0.5)
+        reply = request(link, GET_SD_BENCHMARK)
+        state, test, count = reply[0], reply[1], reply[2]
+        if state != 1:
+            break
+        sys.stderr.write("\rTest {}/{} ".format(test + 1, count))
+    sys.stderr.write("\n")
+
+    write, read, write_p99, read_p99, busy = struct.unpack_from("<5I", reply, 3)
+    print("sequential write   {} B/s".format(write))
+    print("sequential read    {} B/s".format(read))
+    print("random write p99   {} us".format(write_p99))
+    print("random read p99    {} us".format(read_p99))
+    print("longest busy wait  {} us".format(busy))
+    print("card {} (full report in SDBENCH.TXT)".format(
+        SD_BENCHMARK_STATES[state] if state < len(SD_BENCHMARK_STATES) else state))
+    if state != 2:
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="Serial port of the target, or a pty")
+    parser.add_argument("--baud", type=int, default=460800, help="Baud rate of the serial port")
+    parser.add_argument("--verbose", action="store_true", help="Print the target's logs")
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("ping", help="Measure the round trip").set_defaults(run=ping)
+    commands.add_parser("stats", help="Print the link's counters").set_defaults(run=stats)
+    config_parser = commands.add_parser("config", help="Read a value of cfg.ini")
+    config_parser.add_argument("section")
+    config_parser.add_argument("key")
+    config_parser.set_defaults(run=config)
+    profile_parser = commands.add_parser("profile", help="Print the profiler's zones")
+    profile_parser.add_argument("--reset", action="store_true", help="Clear the zones instead")
+    profile_parser.set_defaults(run=profile)
+    disk_parser = commands.add_parser("disk", help="Print the SD card driver's counters")
+    disk_parser.add_argument("--log", action="store_true", help="Also log them on the target")
+    disk_parser.add_argument("--reset", action="store_true", help="Clear them once read")
+    disk_parser.set_defaults(run=disk)
+    mem_parser = commands.add_parser("mem", help="Print the heap and stack usage, per owner")
+    mem_parser.add_argument("--log", action="store_true", help="Also log it on the target")
+    mem_parser.set_defaults(run=mem)
+    sdbench_parser = commands.add_parser("sdbench", help="Benchmark the SD card, exit 1 on fail")
+    sdbench_parser.set_defaults(run=sdbench)
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("umo.py requires pyserial (pip install pyserial)")
+
+    with serial.Serial(args.port, args.baud, timeout=0.05) as port:
+        try:
+            args.run(Link(port, args.verbose), args)
+        except CommandError as e:
+            sys.exit("{}: {}".format(args.command, e))
+
+
+if __name__ == "__main__":
+    main()
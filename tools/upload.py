@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""
+Uploads a file to the SD card over the log UART (see Processes/services/fileTransfer.h).
+
+The blocks are streamed within the window granted by the target, which writes one buffer to the
+card while it receives the next. Lost frames are recovered by going back to the first block
+that wasn't acknowledged. The target's log lines, sent on the same UART, are skipped over, or
+printed with --verbose.
+
+Usage:
+    upload.py /dev/ttyUSB0 cfg.ini
+    upload.py /dev/ttyUSB0 build/music.wav --name AUDIO/MUSIC.WAV --baud 921600
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+BLOCK_SIZE = 1024
+
+OPEN, DATA, CLOSE, ABORT = 0x10, 0x11, 0x12, 0x13
+ACK, NAK, DONE = 0x18, 0x19, 0x1A
+
+STATUSES = ["ok", "no SD card", "unable to create the file", "write failed", "CRC mismatch",
+            "aborted", "timed out", "invalid frame"]
+
+RETRY_TIMEOUT = 0.5    # Seconds without progress before sending again.
+MAX_RETRIES = 20
+
+
+def cobs_encode(data):
+    out = bytearray()
+    pos = 0
+    while True:
+        run = 0
+        while pos + run < len(data) and run < 254 and data[pos + run] != 0:
+            run += 1
+        out.append(run + 1)
+        out += data[pos:pos + run]
+        pos += run
+        if pos == len(data):
+            break
+        if run < 254:
+            pos += 1
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        code = data[pos]
+        pos += 1
+        if code == 0 or pos + code - 1 > len(data):
+            return None
+        out += data[pos:pos + code - 1]
+        pos += code - 1
+        if code != 0xFF and pos != len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Link:
+    """FrameLink (Processes/services/frameLink.h) on top of a serial port."""
+
+    def __init__(self, port, verbose):
+        self.port = port
+        self.verbose = verbose
+        self.pending = bytearray()
+
+    def send(self, frame_id, body=b""):
+        frame = bytes([frame_id]) + body
+        frame += struct.pack("<I", zlib.crc32(frame))
+        self.port.write(b"\x00" + cobs_encode(frame) + b"\x00")
+
+    def receive(self):
+        """Returns the frames received so far, as (id, body)."""
+        self.pending += self.port.read(max(1, self.port.in_waiting))
+        *chunks, self.pending = self.pending.split(b"\x00")
+        frames = []
+        for chunk in chunks:
+            frame = cobs_decode(chunk) if chunk else None
+            if (frame is not None and len(frame) >= 5 and
+                    zlib.crc32(frame[:-4]) == struct.unpack("<I", frame[-4:])[0]):
+                frames.append((frame[0], frame[1:-4]))
+            elif chunk and self.verbose:
+                # Log lines of the target.
+                sys.stderr.write(chunk.decode("ascii", "replace"))
+        return frames
+
+
+def unwrap(seq, reference):
+    """Extends a 16-bit sequence number to the one closest to the reference."""
+    return reference + ((seq - reference + 0x8000) & 0xFFFF) - 0x8000
+
+
+def fail(message):
+    sys.exit("Upload failed: " + message)
+
+
+def check_done(body):
+    status = body[0] if body else 255
+    if status != 0:
+        fail(STATUSES[status] if status < len(STATUSES) else "status {}".format(status))
+
+
+def open_file(link, name, size):
+    """Returns the credit of the first ACK."""
+    body = struct.pack("<I", size) + name.encode("ascii")
+    for _ in range(MAX_RETRIES):
+        link.send(OPEN, body)
+        deadline = time.monotonic() + RETRY_TIMEOUT
+        while time.monotonic() < deadline:
+            for frame_id, reply in link.receive():
+                if frame_id == ACK and len(reply) == 4:
+                    seq, credit = struct.unpack("<HH", reply)
+                    if seq == 0:
+                        return credit
+                elif frame_id == DONE:
+                    check_done(reply)
+    fail("no answer from the target")
+
+
+def send_blocks(link, data, credit, progress):
+    blocks = [data[i:i + BLOCK_SIZE] for i in range(0, len(data), BLOCK_SIZE)]
+    base = 0          # First block not acknowledged.
+    next_block = 0    # Next block to send.
+    window_end = credit
+    last_progress = time.monotonic()
+    retries = 0
+
+    while base < len(blocks):
+        while next_block < min(window_end, len(blocks)):
+            link.send(DATA, struct.pack("<H", next_block & 0xFFFF) + blocks[next_block])
+            next_block += 1
+
+        for frame_id, reply in link.receive():
+            if frame_id == ACK and len(reply) == 4:
+                seq, credit = struct.unpack("<HH", reply)
+                seq = unwrap(seq, base)
+                if base < seq <= next_block:
+                    base = seq
+                    last_progress = time.monotonic()
+                    retries = 0
+                    progress(min(base * BLOCK_SIZE, len(data)))
+                if seq >= base:
+                    # The end of the window never moves back, stale ACKs are harmless.
+                    window_end = max(window_end, seq + credit)
+            elif frame_id == NAK and len(reply) == 2:
+                seq = unwrap(struct.unpack("<H", reply)[0], base)
+                if base <= seq < next_block:
+                    next_block = seq
+            elif frame_id == DONE:
+                check_done(reply)
+
+        if time.monotonic() - last_progress > RETRY_TIMEOUT:
+            retries += 1
+            if retries > MAX_RETRIES:
+                fail("the target stopped answering")
+            # Start over from the first block that wasn't acknowledged. It's sent even if the
+            # window looks closed, in case the ACK that reopened it got lost.
+            next_block = base
+            window_end = max(window_end, base + 1)
+            last_progress = time.monotonic()
+
+
+def close_file(link, crc):
+    for _ in range(MAX_RETRIES):
+        link.send(CLOSE, struct.pack("<I", crc))
+        deadline = time.monotonic() + 2 * RETRY_TIMEOUT
+        while time.monotonic() < deadline:
+            for frame_id, reply in link.receive():
+                if frame_id == DONE:
+                    check_done(reply)
+                    return
+    fail("no answer to the close")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="Serial port of the target, or a pty")
+    parser.add_argument("file", help="File to upload")
+    parser.add_argument("--name", help="Path on the SD card, the file's name by default")
+    parser.add_argument("--baud", type=int, default=460800, help="Baud rate of the serial port")
+    parser.add_argument("--verbose", action="store_true", help="Print the target's logs")
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("upload.py requires pyserial (pip install pyserial)")
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+    name = args.name or os.path.basename(args.file).upper()
+
+    port = serial.Serial(args.port, args.baud, timeout=0.01)
+    link = Link(port, args.verbose)
+    start = time.monotonic()
+
+    def progress(done):
+        rate = done / max(time.monotonic() - start, 1e-3)
+        sys.stdout.write("\r{}: {}/{} bytes, {:.1f} KiB/s".format(name, done, len(data),
+                                                                  rate / 1024))
+        sys.stdout.flush()
+
+    try:
+        credit = open_file(link, name, len(data))
+        send_blocks(link, data, credit, progress)
+        close_file(link, zlib.crc32(data))
+    except KeyboardInterrupt:
+        link.send(ABORT)
+        sys.exit("\nAborted")
+
+    progress(len(data))
+    print("\nDone in {:.2f} s".format(time.monotonic() - start))
+
+
+if __name__ == "__main__":
+    main()